@@ -0,0 +1,109 @@
+/********************************************************************************
+ * This code is used for robot control
+*********************************************************************************
+ * Author        Data            Version
+ * Liren         2026/10/17      1.0
+********************************************************************************/
+#include <stdio.h>
+#include <stdint.h>
+#include <stdarg.h>
+#include <time.h>
+
+#include "RocLog.h"
+
+
+/*********************************************************************************
+ *  Description:
+ *              Get the host tick time in ms, which replaces HAL_GetTick
+ *
+ *  Parameter:
+ *              None
+ *
+ *  Return:
+ *              The monotonic tick time in ms
+ *
+ *  Author:
+ *              ROC LiRen(2026.10.17)
+**********************************************************************************/
+static uint32_t RocHostTickGet(void)
+{
+    struct timespec Now;
+
+    clock_gettime(CLOCK_MONOTONIC, &Now);
+
+    return (uint32_t)(Now.tv_sec * 1000U + Now.tv_nsec / 1000000U);
+}
+
+/*********************************************************************************
+ *  Description:
+ *              Print one log line to the host console
+ *
+ *  Parameter:
+ *              pLevel: the log level prefix
+ *              function: the function name of the caller
+ *              line: the line number of the caller
+ *              fmt: the log format
+ *              arg_ptr: the log arguments
+ *
+ *  Return:
+ *              The printf result
+ *
+ *  Author:
+ *              ROC LiRen(2026.10.17)
+**********************************************************************************/
+static ROC_RESULT RocHostLogPrint(const char *pLevel, const char *function, uint32_t line, const char *fmt, va_list arg_ptr)
+{
+    char        Buffer[ROC_MAX_BUFFER_SIZE] = {0};
+
+    vsnprintf(Buffer, ROC_MAX_BUFFER_SIZE, fmt, arg_ptr);
+
+    return printf("[%010u] %s%s[%u]: %s \r\n", RocHostTickGet(), pLevel, function, line, Buffer);
+}
+
+ROC_RESULT RocLogI(const char *function, uint32_t line, const char *fmt, ...)
+{
+    ROC_RESULT  Ret = RET_OK;
+    va_list     arg_ptr;
+
+    va_start(arg_ptr, fmt);
+    Ret = RocHostLogPrint("", function, line, fmt, arg_ptr);
+    va_end(arg_ptr);
+
+    return Ret;
+}
+
+ROC_RESULT RocLogW(const char *function, uint32_t line, const char *fmt, ...)
+{
+    ROC_RESULT  Ret = RET_OK;
+    va_list     arg_ptr;
+
+    va_start(arg_ptr, fmt);
+    Ret = RocHostLogPrint("[WARN]", function, line, fmt, arg_ptr);
+    va_end(arg_ptr);
+
+    return Ret;
+}
+
+ROC_RESULT RocLogE(const char *function, uint32_t line, const char *fmt, ...)
+{
+    ROC_RESULT  Ret = RET_OK;
+    va_list     arg_ptr;
+
+    va_start(arg_ptr, fmt);
+    Ret = RocHostLogPrint("[ERROR]", function, line, fmt, arg_ptr);
+    va_end(arg_ptr);
+
+    return Ret;
+}
+
+ROC_RESULT RocLogN(const char *function, uint32_t line, const char *fmt, ...)
+{
+    ROC_RESULT  Ret = RET_OK;
+    va_list     arg_ptr;
+
+    va_start(arg_ptr, fmt);
+    Ret = RocHostLogPrint("[NOTIFY]", function, line, fmt, arg_ptr);
+    va_end(arg_ptr);
+
+    return Ret;
+}
@@ -0,0 +1,957 @@
+/********************************************************************************
+ * This code is used for robot control
+*********************************************************************************
+ * Author        Data            Version
+ * Liren         2026/10/17      1.0
+********************************************************************************/
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+
+#include "RocImuFusion.h"
+
+
+/* The log is text, one sample every line, the prefix before "IMU:" is skipped:
+   [IMU:] <ms> <gyro x y z> <accel x y z> [<quaternion w x y z>]
+   the gyro and the accel are the raw signed data of the MPU6050 in the range of
+   RocMpu6050RegInit, the quaternion is the q30 reference attitude, the DMP one
+   of the logs of ROC_MPU6050_SAMPLE_LOG or the true one of the synthetic log.
+   '#' starts a comment line. */
+#define ROC_IMU_REPLAY_MAX_SAMPLES          (600U * 1000U)  // 10 minutes at 1 kHz
+#define ROC_IMU_REPLAY_MAX_LINE_SIZE        256U
+#define ROC_IMU_REPLAY_GYRO_TO_RADIAN       (2000.0F / 32768.0F / ROC_IMU_REPLAY_RADIAN_TO_ANGLE)
+#define ROC_IMU_REPLAY_ACCEL_1G             16384.0F        // The 2 g range
+#define ROC_IMU_REPLAY_RADIAN_TO_ANGLE      57.29578F
+#define ROC_IMU_REPLAY_Q30                  1073741824.0
+
+/* The tilt error under it is settled, the settle time is the boot time of the
+   filter till the tilt error is under it for ever */
+#define ROC_IMU_REPLAY_SETTLE_ANGLE         1.0F            // degree
+
+/* The yaw is stable as ROC_MPU6050_YAW_STABLE_WINDOW and ROC_MPU6050_YAW_STABLE_DRIFT
+   of the robot, the fusion yaw moves less than the drift over the window */
+#define ROC_IMU_REPLAY_YAW_STABLE_WINDOW    1000U           // ms
+#define ROC_IMU_REPLAY_YAW_STABLE_DRIFT     0.1F            // degree
+
+/* The accel offset over it is the tilt of the standing start, as
+   ROC_MPU6050_BIAS_ACCEL_MAX of the robot */
+#define ROC_IMU_REPLAY_BIAS_ACCEL_MAX       0.04F           // g
+
+/* The synthetic log: standing still, then a walk with the body sway, the bounce
+   of the steps and two turns, with the gyro bias and the sensor noise */
+#define ROC_IMU_REPLAY_SYN_RATE             1000U           // Hz
+#define ROC_IMU_REPLAY_SYN_TIME             20U             // s
+#define ROC_IMU_REPLAY_SYN_STAND_TIME       2.0F            // s
+#define ROC_IMU_REPLAY_SYN_SUB_STEPS        10U             // Integration steps of the true attitude every sample
+#define ROC_IMU_REPLAY_SYN_SWAY_ANGLE       5.0F            // Roll and pitch sway, degree
+#define ROC_IMU_REPLAY_SYN_SWAY_FREQ        1.5F            // Hz
+#define ROC_IMU_REPLAY_SYN_BOUNCE           0.05F           // Vertical accel of the steps, g
+#define ROC_IMU_REPLAY_SYN_TURN_RATE        45.0F           // dps
+#define ROC_IMU_REPLAY_SYN_GYRO_BIAS        0.5F            // dps
+#define ROC_IMU_REPLAY_SYN_GYRO_NOISE       0.05F           // dps RMS
+#define ROC_IMU_REPLAY_SYN_ACCEL_NOISE      0.004F          // g RMS
+#define ROC_IMU_REPLAY_SYN_INIT_TILT        3.0F            // Roll at the boot, degree
+
+
+typedef struct _ROC_IMU_REPLAY_SAMPLE_s
+{
+    uint32_t                    TimeStamp;              // ms
+    int16_t                     Gyro[3];
+    int16_t                     Accel[3];
+    float                       RefQuat[4];             // Reference attitude W, X, Y, Z
+
+}ROC_IMU_REPLAY_SAMPLE_s;
+
+typedef struct _ROC_IMU_REPLAY_RESULT_s
+{
+    float                       SettleTime;             // s, negative if never settled
+    float                       YawStableTime;          // s, negative if never stable
+    float                       TiltRms;                // Tilt error RMS after the settle, degree
+    float                       TiltMax;                // Tilt error max after the settle, degree
+    float                       YawEnd;                 // Yaw error at the end, degree
+    float                       YawMax;                 // Yaw error max, degree
+    double                      UpdateNs;               // Time of one fusion update
+
+}ROC_IMU_REPLAY_RESULT_s;
+
+
+static ROC_IMU_REPLAY_SAMPLE_s  g_ImuReplaySample[ROC_IMU_REPLAY_MAX_SAMPLES];
+
+/* The state of the noise generator, the synthetic log is the same every run */
+static uint32_t g_ImuReplaySeed = 1U;
+
+/* The biases of the standing start, removed before the fusion as the robot does
+   with the biases of RocMpu6050BiasCalibrate */
+static float    g_ImuReplayGyroBias[3] = {0};
+static float    g_ImuReplayAccelBias[3] = {0};
+
+
+/*********************************************************************************
+ *  Description:
+ *              Get the monotonic time in ns
+ *
+ *  Parameter:
+ *              None
+ *
+ *  Return:
+ *              The current time in ns
+ *
+ *  Author:
+ *              ROC LiRen(2026.10.17)
+**********************************************************************************/
+static uint64_t RocImuReplayTimeNsGet(void)
+{
+    struct timespec Now;
+
+    clock_gettime(CLOCK_MONOTONIC, &Now);
+
+    return (uint64_t)Now.tv_sec * 1000000000ULL + (uint64_t)Now.tv_nsec;
+}
+
+/*********************************************************************************
+ *  Description:
+ *              Get the gaussian noise of the unit RMS, it is the sum of the
+ *              uniform noise
+ *
+ *  Parameter:
+ *              None
+ *
+ *  Return:
+ *              The noise
+ *
+ *  Author:
+ *              ROC LiRen(2026.10.17)
+**********************************************************************************/
+static float RocImuReplayNoiseGet(void)
+{
+    uint8_t     i = 0;
+    float       Sum = 0;
+
+    for(i = 0; i < 12; i++)
+    {
+        g_ImuReplaySeed = g_ImuReplaySeed * 1664525U + 1013904223U;
+        Sum += (float)(g_ImuReplaySeed >> 8) / 16777216.0F;
+    }
+
+    return Sum - 6.0F;
+}
+
+/*********************************************************************************
+ *  Description:
+ *              Get the gravity direction in the body frame of the attitude
+ *
+ *  Parameter:
+ *              q: the quaternion W, X, Y, Z
+ *              v: the unit gravity direction
+ *
+ *  Return:
+ *              None
+ *
+ *  Author:
+ *              ROC LiRen(2026.10.17)
+**********************************************************************************/
+static void RocImuReplayGravityGet(const float *q, float *v)
+{
+    v[0] = 2.0F * (q[1] * q[3] - q[0] * q[2]);
+    v[1] = 2.0F * (q[0] * q[1] + q[2] * q[3]);
+    v[2] = q[0] * q[0] - q[1] * q[1] - q[2] * q[2] + q[3] * q[3];
+}
+
+/*********************************************************************************
+ *  Description:
+ *              Get the yaw of the attitude
+ *
+ *  Parameter:
+ *              q: the quaternion W, X, Y, Z
+ *
+ *  Return:
+ *              The yaw in degree
+ *
+ *  Author:
+ *              ROC LiRen(2026.10.17)
+**********************************************************************************/
+static float RocImuReplayYawGet(const float *q)
+{
+    return atan2f(2.0F * (q[1] * q[2] + q[0] * q[3]), 1.0F - 2.0F * (q[2] * q[2] + q[3] * q[3])) * ROC_IMU_REPLAY_RADIAN_TO_ANGLE;
+}
+
+/*********************************************************************************
+ *  Description:
+ *              Wrap the angle to -180 ~ 180 degree
+ *
+ *  Parameter:
+ *              Angle: the angle in degree
+ *
+ *  Return:
+ *              The wrapped angle
+ *
+ *  Author:
+ *              ROC LiRen(2026.10.17)
+**********************************************************************************/
+static float RocImuReplayAngleWrap(float Angle)
+{
+    while(180.0F < Angle)
+    {
+        Angle -= 360.0F;
+    }
+
+    while(-180.0F > Angle)
+    {
+        Angle += 360.0F;
+    }
+
+    return Angle;
+}
+
+/*********************************************************************************
+ *  Description:
+ *              Load the raw IMU log
+ *
+ *  Parameter:
+ *              pPath: the log file path
+ *              pNum: the number of the loaded samples
+ *              pHasRef: true if every sample has the reference quaternion
+ *
+ *  Return:
+ *              RET_OK if the whole log is loaded
+ *
+ *  Author:
+ *              ROC LiRen(2026.10.17)
+**********************************************************************************/
+static ROC_RESULT RocImuReplayLogLoad(const char *pPath, uint32_t *pNum, uint8_t *pHasRef)
+{
+    FILE                    *pFile = NULL;
+    uint32_t                Line = 0;
+    uint32_t                Num = 0;
+    int                     Cnt = 0;
+    int                     Fields = 0;
+    int                     Raw[6];
+    long                    Quat[4];
+    char                    Buffer[ROC_IMU_REPLAY_MAX_LINE_SIZE];
+    char                    *pText = NULL;
+    ROC_IMU_REPLAY_SAMPLE_s *pSample = NULL;
+
+    pFile = fopen(pPath, "r");
+    if(NULL == pFile)
+    {
+        printf("Can not open %s!\r\n", pPath);
+
+        return RET_ERROR;
+    }
+
+    *pHasRef = ROC_TRUE;
+
+    while(NULL != fgets(Buffer, sizeof(Buffer), pFile))
+    {
+        Line++;
+
+        pText = strstr(Buffer, "IMU:");
+        pText = (NULL == pText) ? Buffer : pText + 4;
+
+        Cnt = 0;
+        sscanf(pText, " %n", &Cnt);
+        if(('\0' == pText[Cnt]) || ('#' == pText[Cnt]))
+        {
+            continue;
+        }
+
+        if(ROC_IMU_REPLAY_MAX_SAMPLES <= Num)
+        {
+            printf("%s:%u: more than %u samples!\r\n", pPath, Line, ROC_IMU_REPLAY_MAX_SAMPLES);
+            fclose(pFile);
+
+            return RET_ERROR;
+        }
+
+        pSample = &g_ImuReplaySample[Num];
+        memset(pSample, 0, sizeof(*pSample));
+
+        Fields = sscanf(pText, "%u %d %d %d %d %d %d %ld %ld %ld %ld", &pSample->TimeStamp,
+                        &Raw[0], &Raw[1], &Raw[2], &Raw[3], &Raw[4], &Raw[5],
+                        &Quat[0], &Quat[1], &Quat[2], &Quat[3]);
+        if((7 != Fields) && (11 != Fields))
+        {
+            printf("%s:%u: expect 7 or 11 fields!\r\n", pPath, Line);
+            fclose(pFile);
+
+            return RET_ERROR;
+        }
+
+        for(Cnt = 0; Cnt < 3; Cnt++)
+        {
+            pSample->Gyro[Cnt] = (int16_t)Raw[Cnt];
+            pSample->Accel[Cnt] = (int16_t)Raw[Cnt + 3];
+        }
+
+        if(11 == Fields)
+        {
+            for(Cnt = 0; Cnt < 4; Cnt++)
+            {
+                pSample->RefQuat[Cnt] = (float)(Quat[Cnt] / ROC_IMU_REPLAY_Q30);
+            }
+        }
+        else
+        {
+            *pHasRef = ROC_FALSE;
+        }
+
+        Num++;
+    }
+
+    fclose(pFile);
+
+    if(0 == Num)
+    {
+        printf("%s: no sample!\r\n", pPath);
+
+        return RET_ERROR;
+    }
+
+    *pNum = Num;
+
+    return RET_OK;
+}
+
+/*********************************************************************************
+ *  Description:
+ *              Get the raw data of the sensor, the value is saturated as the
+ *              ADC of the MPU6050
+ *
+ *  Parameter:
+ *              Value: the value in the raw unit
+ *
+ *  Return:
+ *              The raw data
+ *
+ *  Author:
+ *              ROC LiRen(2026.10.17)
+**********************************************************************************/
+static int16_t RocImuReplayRawGet(float Value)
+{
+    Value = roundf(Value);
+
+    if(32767.0F < Value)
+    {
+        return 32767;
+    }
+
+    if(-32768.0F > Value)
+    {
+        return -32768;
+    }
+
+    return (int16_t)Value;
+}
+
+/*********************************************************************************
+ *  Description:
+ *              Make the synthetic log, the true attitude is the reference
+ *
+ *  Parameter:
+ *              pPath: the log file path, NULL is not to write it
+ *              pNum: the number of the samples
+ *
+ *  Return:
+ *              RET_OK if the log is made
+ *
+ *  Author:
+ *              ROC LiRen(2026.10.17)
+**********************************************************************************/
+static ROC_RESULT RocImuReplayLogMake(const char *pPath, uint32_t *pNum)
+{
+    uint32_t                i = 0;
+    uint32_t                j = 0;
+    uint32_t                k = 0;
+    uint32_t                Num = ROC_IMU_REPLAY_SYN_RATE * ROC_IMU_REPLAY_SYN_TIME;
+    float                   t = 0;
+    float                   Dt = 1.0F / (ROC_IMU_REPLAY_SYN_RATE * ROC_IMU_REPLAY_SYN_SUB_STEPS);
+    float                   w = 0;
+    float                   Walk = 0;
+    float                   Bounce = 0;
+    double                  q[4];
+    double                  r[4];
+    double                  Norm = 0;
+    float                   Rate[3];
+    float                   v[3];
+    FILE                    *pFile = NULL;
+    ROC_IMU_REPLAY_SAMPLE_s *pSample = NULL;
+
+    if(ROC_IMU_REPLAY_MAX_SAMPLES < Num)
+    {
+        return RET_ERROR;
+    }
+
+    /* The boot attitude is a little rolled, the yaw is 0 */
+    q[0] = cos(ROC_IMU_REPLAY_SYN_INIT_TILT * 0.5 / ROC_IMU_REPLAY_RADIAN_TO_ANGLE);
+    q[1] = sin(ROC_IMU_REPLAY_SYN_INIT_TILT * 0.5 / ROC_IMU_REPLAY_RADIAN_TO_ANGLE);
+    q[2] = 0;
+    q[3] = 0;
+
+    w = 2.0F * (float)M_PI * ROC_IMU_REPLAY_SYN_SWAY_FREQ;
+
+    for(i = 0; i < Num; i++)
+    {
+        for(j = 0; j < ROC_IMU_REPLAY_SYN_SUB_STEPS; j++)
+        {
+            t = (float)(i * ROC_IMU_REPLAY_SYN_SUB_STEPS + j) * Dt;
+            Walk = (ROC_IMU_REPLAY_SYN_STAND_TIME <= t) ? 1.0F : 0;
+
+            /* The body rates of the sway, and the turn of 90 degree at the
+               third and the eleventh second of the walk, back at the
+               sixth and the fourteenth */
+            Rate[0] = Walk * ROC_IMU_REPLAY_SYN_SWAY_ANGLE / ROC_IMU_REPLAY_RADIAN_TO_ANGLE * w * cosf(w * t);
+            Rate[1] = Walk * ROC_IMU_REPLAY_SYN_SWAY_ANGLE / ROC_IMU_REPLAY_RADIAN_TO_ANGLE * w * sinf(w * t);
+            Rate[2] = 0;
+
+            if(((5.0F <= t) && (7.0F > t)) || ((13.0F <= t) && (15.0F > t)))
+            {
+                Rate[2] = ROC_IMU_REPLAY_SYN_TURN_RATE / ROC_IMU_REPLAY_RADIAN_TO_ANGLE;
+            }
+            else if(((8.0F <= t) && (10.0F > t)) || ((16.0F <= t) && (18.0F > t)))
+            {
+                Rate[2] = -ROC_IMU_REPLAY_SYN_TURN_RATE / ROC_IMU_REPLAY_RADIAN_TO_ANGLE;
+            }
+
+            r[0] = 0.5 * (-q[1] * Rate[0] - q[2] * Rate[1] - q[3] * Rate[2]);
+            r[1] = 0.5 * ( q[0] * Rate[0] + q[2] * Rate[2] - q[3] * Rate[1]);
+            r[2] = 0.5 * ( q[0] * Rate[1] - q[1] * Rate[2] + q[3] * Rate[0]);
+            r[3] = 0.5 * ( q[0] * Rate[2] + q[1] * Rate[1] - q[2] * Rate[0]);
+
+            Norm = 0;
+            for(k = 0; k < 4; k++)
+            {
+                q[k] += r[k] * Dt;
+                Norm += q[k] * q[k];
+            }
+
+            for(k = 0; k < 4; k++)
+            {
+                q[k] /= Norm > 0 ? sqrt(Norm) : 1.0;
+            }
+        }
+
+        pSample = &g_ImuReplaySample[i];
+
+        pSample->TimeStamp = i * 1000U / ROC_IMU_REPLAY_SYN_RATE;
+
+        for(j = 0; j < 4; j++)
+        {
+            pSample->RefQuat[j] = (float)q[j];
+        }
+
+        RocImuReplayGravityGet(pSample->RefQuat, v);
+
+        /* The bounce of the steps is along the earth vertical, two steps
+           every sway cycle */
+        Bounce = 1.0F + Walk * ROC_IMU_REPLAY_SYN_BOUNCE * sinf(2.0F * w * t);
+
+        for(j = 0; j < 3; j++)
+        {
+            pSample->Gyro[j] = RocImuReplayRawGet((Rate[j] * ROC_IMU_REPLAY_RADIAN_TO_ANGLE + ROC_IMU_REPLAY_SYN_GYRO_BIAS
+                                                   + ROC_IMU_REPLAY_SYN_GYRO_NOISE * RocImuReplayNoiseGet())
+                                                  / (ROC_IMU_REPLAY_GYRO_TO_RADIAN * ROC_IMU_REPLAY_RADIAN_TO_ANGLE));
+            pSample->Accel[j] = RocImuReplayRawGet((v[j] * Bounce + ROC_IMU_REPLAY_SYN_ACCEL_NOISE * RocImuReplayNoiseGet())
+                                                   * ROC_IMU_REPLAY_ACCEL_1G);
+        }
+    }
+
+    *pNum = Num;
+
+    if(NULL == pPath)
+    {
+        return RET_OK;
+    }
+
+    pFile = fopen(pPath, "w");
+    if(NULL == pFile)
+    {
+        printf("Can not open %s!\r\n", pPath);
+
+        return RET_ERROR;
+    }
+
+    fprintf(pFile, "# Synthetic raw IMU log of RocImuFusionReplay: <ms> <gyro xyz> <accel xyz> <true q30 wxyz>\n");
+
+    for(i = 0; i < Num; i++)
+    {
+        pSample = &g_ImuReplaySample[i];
+
+        fprintf(pFile, "%u %d %d %d %d %d %d %ld %ld %ld %ld\n", pSample->TimeStamp,
+                pSample->Gyro[0], pSample->Gyro[1], pSample->Gyro[2],
+                pSample->Accel[0], pSample->Accel[1], pSample->Accel[2],
+                lround(pSample->RefQuat[0] * ROC_IMU_REPLAY_Q30), lround(pSample->RefQuat[1] * ROC_IMU_REPLAY_Q30),
+                lround(pSample->RefQuat[2] * ROC_IMU_REPLAY_Q30), lround(pSample->RefQuat[3] * ROC_IMU_REPLAY_Q30));
+    }
+
+    fclose(pFile);
+
+    return RET_OK;
+}
+
+/*********************************************************************************
+ *  Description:
+ *              Calibrate the biases by the average of the standing start of the
+ *              log as RocMpu6050BiasCalibrate, the gravity is not the bias
+ *
+ *  Parameter:
+ *              Num: the number of the samples
+ *              CalTime: the standing time of the log start in ms
+ *
+ *  Return:
+ *              RET_ERROR if no sample is in the standing time
+ *
+ *  Author:
+ *              ROC LiRen(2026.10.17)
+**********************************************************************************/
+static ROC_RESULT RocImuReplayBiasCalibrate(uint32_t Num, uint32_t CalTime)
+{
+    uint32_t                i = 0;
+    uint32_t                j = 0;
+    uint32_t                Count = 0;
+    double                  GyroSum[3] = {0};
+    double                  AccelSum[3] = {0};
+    ROC_IMU_REPLAY_SAMPLE_s *pSample = NULL;
+
+    for(i = 0; i < Num; i++)
+    {
+        pSample = &g_ImuReplaySample[i];
+
+        if(CalTime < pSample->TimeStamp - g_ImuReplaySample[0].TimeStamp)
+        {
+            break;
+        }
+
+        for(j = 0; j < 3; j++)
+        {
+            GyroSum[j] += pSample->Gyro[j];
+            AccelSum[j] += pSample->Accel[j];
+        }
+
+        Count++;
+    }
+
+    if(0 == Count)
+    {
+        printf("No sample in the calibration time!\r\n");
+
+        return RET_ERROR;
+    }
+
+    AccelSum[2] += (0 < AccelSum[2]) ? -(double)ROC_IMU_REPLAY_ACCEL_1G * Count : (double)ROC_IMU_REPLAY_ACCEL_1G * Count;
+
+    for(j = 0; j < 3; j++)
+    {
+        g_ImuReplayGyroBias[j] = (float)(GyroSum[j] / Count);
+        g_ImuReplayAccelBias[j] = (float)(AccelSum[j] / Count);
+    }
+
+    for(j = 0; j < 3; j++)
+    {
+        if(ROC_IMU_REPLAY_BIAS_ACCEL_MAX * ROC_IMU_REPLAY_ACCEL_1G < fabsf(g_ImuReplayAccelBias[j]))
+        {
+            printf("accel(%u) offset %.4f g is the tilt, the accel bias is not removed\r\n",
+                   j, g_ImuReplayAccelBias[j] / ROC_IMU_REPLAY_ACCEL_1G);
+
+            memset(g_ImuReplayAccelBias, 0, sizeof(g_ImuReplayAccelBias));
+
+            break;
+        }
+    }
+
+    printf("bias of %u samples  gyro: %.3f %.3f %.3f dps  accel: %.4f %.4f %.4f g\r\n", Count,
+           g_ImuReplayGyroBias[0] * ROC_IMU_REPLAY_GYRO_TO_RADIAN * ROC_IMU_REPLAY_RADIAN_TO_ANGLE,
+           g_ImuReplayGyroBias[1] * ROC_IMU_REPLAY_GYRO_TO_RADIAN * ROC_IMU_REPLAY_RADIAN_TO_ANGLE,
+           g_ImuReplayGyroBias[2] * ROC_IMU_REPLAY_GYRO_TO_RADIAN * ROC_IMU_REPLAY_RADIAN_TO_ANGLE,
+           g_ImuReplayAccelBias[0] / ROC_IMU_REPLAY_ACCEL_1G, g_ImuReplayAccelBias[1] / ROC_IMU_REPLAY_ACCEL_1G,
+           g_ImuReplayAccelBias[2] / ROC_IMU_REPLAY_ACCEL_1G);
+
+    return RET_OK;
+}
+
+/*********************************************************************************
+ *  Description:
+ *              Replay the log through the fusion
+ *
+ *  Parameter:
+ *              pFusion: the pointer to the fusion with the gains
+ *              Num: the number of the samples
+ *              Decimate: the fusion runs on every Decimate samples
+ *              HasRef: true if the log has the reference attitude
+ *              pResult: the pointer to the replay result
+ *
+ *  Return:
+ *              None
+ *
+ *  Author:
+ *              ROC LiRen(2026.10.17)
+**********************************************************************************/
+static void RocImuReplayRun(ROC_IMU_FUSION_s *pFusion, uint32_t Num, uint32_t Decimate, uint8_t HasRef,
+                            ROC_IMU_REPLAY_RESULT_s *pResult)
+{
+    uint32_t                i = 0;
+    uint32_t                j = 0;
+    uint32_t                Count = 0;
+    uint32_t                LastTime = 0;
+    uint32_t                SettleTime = 0;
+    uint8_t                 IsSettled = ROC_FALSE;
+    uint8_t                 HasYawOffset = ROC_FALSE;
+    uint8_t                 IsYawWin = ROC_FALSE;
+    uint32_t                YawWinTime = 0;
+    float                   YawWinAngle = 0;
+    float                   FusionYaw = 0;
+    float                   Dt = 0;
+    float                   Tilt = 0;
+    float                   Yaw = 0;
+    float                   YawOffset = 0;
+    float                   Dot = 0;
+    double                  TiltSum = 0;
+    uint64_t                StartTime = 0;
+    uint64_t                RunTime = 0;
+    float                   Gyro[3];
+    float                   Accel[3];
+    float                   v[3];
+    float                   VRef[3];
+    ROC_IMU_REPLAY_SAMPLE_s *pSample = NULL;
+
+    memset(pResult, 0, sizeof(*pResult));
+    pResult->SettleTime = -1.0F;
+    pResult->YawStableTime = -1.0F;
+
+    LastTime = g_ImuReplaySample[0].TimeStamp;
+
+    for(i = 0; i < Num; i += Decimate)
+    {
+        pSample = &g_ImuReplaySample[i];
+
+        Dt = (float)(pSample->TimeStamp - LastTime) * 0.001F;
+        LastTime = pSample->TimeStamp;
+
+        for(j = 0; j < 3; j++)
+        {
+            Gyro[j] = ((float)pSample->Gyro[j] - g_ImuReplayGyroBias[j]) * ROC_IMU_REPLAY_GYRO_TO_RADIAN;
+            Accel[j] = (float)pSample->Accel[j] - g_ImuReplayAccelBias[j];
+        }
+
+        StartTime = RocImuReplayTimeNsGet();
+        RocImuFusionUpdate(pFusion, Gyro, Accel, Dt);
+        RunTime += RocImuReplayTimeNsGet() - StartTime;
+
+        /* The first stable yaw window as RocMpu6050YawStableCheck */
+        if(0 > pResult->YawStableTime)
+        {
+            FusionYaw = RocImuReplayYawGet(pFusion->Quat);
+
+            if((ROC_TRUE != IsYawWin)
+                || (ROC_IMU_REPLAY_YAW_STABLE_DRIFT < fabsf(RocImuReplayAngleWrap(FusionYaw - YawWinAngle))))
+            {
+                IsYawWin = ROC_TRUE;
+                YawWinAngle = FusionYaw;
+                YawWinTime = pSample->TimeStamp;
+            }
+            else if(ROC_IMU_REPLAY_YAW_STABLE_WINDOW <= pSample->TimeStamp - YawWinTime)
+            {
+                pResult->YawStableTime = (float)(YawWinTime - g_ImuReplaySample[0].TimeStamp) * 0.001F;
+            }
+        }
+
+        if(ROC_TRUE != HasRef)
+        {
+            continue;
+        }
+
+        RocImuReplayGravityGet(pFusion->Quat, v);
+        RocImuReplayGravityGet(pSample->RefQuat, VRef);
+
+        Dot = v[0] * VRef[0] + v[1] * VRef[1] + v[2] * VRef[2];
+        Dot = (1.0F < Dot) ? 1.0F : Dot;
+        Tilt = acosf(Dot) * ROC_IMU_REPLAY_RADIAN_TO_ANGLE;
+
+        /* The yaw of the fusion starts at 0, the offset to the reference is
+           of the first sample */
+        Yaw = RocImuReplayYawGet(pFusion->Quat) - RocImuReplayYawGet(pSample->RefQuat);
+        if(ROC_TRUE != HasYawOffset)
+        {
+            YawOffset = Yaw;
+            HasYawOffset = ROC_TRUE;
+        }
+
+        Yaw = RocImuReplayAngleWrap(Yaw - YawOffset);
+
+        pResult->YawEnd = Yaw;
+        if(pResult->YawMax < fabsf(Yaw))
+        {
+            pResult->YawMax = fabsf(Yaw);
+        }
+
+        if(ROC_IMU_REPLAY_SETTLE_ANGLE <= Tilt)
+        {
+            IsSettled = ROC_FALSE;
+            TiltSum = 0;
+            Count = 0;
+            pResult->TiltMax = 0;
+
+            continue;
+        }
+
+        if(ROC_TRUE != IsSettled)
+        {
+            IsSettled = ROC_TRUE;
+            SettleTime = pSample->TimeStamp;
+        }
+
+        TiltSum += (double)Tilt * Tilt;
+        Count++;
+
+        if(pResult->TiltMax < Tilt)
+        {
+            pResult->TiltMax = Tilt;
+        }
+    }
+
+    if(ROC_TRUE == IsSettled)
+    {
+        pResult->SettleTime = (float)(SettleTime - g_ImuReplaySample[0].TimeStamp) * 0.001F;
+        pResult->TiltRms = (float)sqrt(TiltSum / Count);
+    }
+
+    pResult->UpdateNs = (double)RunTime / ((Num + Decimate - 1) / Decimate);
+}
+
+/*********************************************************************************
+ *  Description:
+ *              Print the replay result
+ *
+ *  Parameter:
+ *              pFusion: the pointer to the fusion with the gains
+ *              Rate: the fusion rate in Hz
+ *              HasRef: true if the log has the reference attitude
+ *              pResult: the pointer to the replay result
+ *
+ *  Return:
+ *              None
+ *
+ *  Author:
+ *              ROC LiRen(2026.10.17)
+**********************************************************************************/
+static void RocImuReplayResultPrint(const ROC_IMU_FUSION_s *pFusion, float Rate, uint8_t HasRef,
+                                    const ROC_IMU_REPLAY_RESULT_s *pResult)
+{
+    printf("%-8s  gain: %6.3f  rate: %6.1f Hz  update: %5.1f ns",
+           (ROC_IMU_FUSION_MODE_MAHONY == pFusion->Mode) ? "mahony" : "madgwick",
+           (ROC_IMU_FUSION_MODE_MAHONY == pFusion->Mode) ? pFusion->Kp : pFusion->Beta,
+           Rate, pResult->UpdateNs);
+
+    if(0 > pResult->YawStableTime)
+    {
+        printf("  yaw never stable");
+    }
+    else
+    {
+        printf("  yaw stable: %6.3f s", pResult->YawStableTime);
+    }
+
+    if(ROC_TRUE != HasRef)
+    {
+        printf("  attitude: %.4f %.4f %.4f %.4f\r\n", pFusion->Quat[0], pFusion->Quat[1], pFusion->Quat[2], pFusion->Quat[3]);
+
+        return;
+    }
+
+    if(0 > pResult->SettleTime)
+    {
+        printf("  never settled\r\n");
+
+        return;
+    }
+
+    printf("  settle: %6.3f s  tilt rms: %5.2f  max: %5.2f  yaw end: %6.2f  max: %6.2f deg\r\n",
+           pResult->SettleTime, pResult->TiltRms, pResult->TiltMax, pResult->YawEnd, pResult->YawMax);
+}
+
+/*********************************************************************************
+ *  Description:
+ *              IMU fusion replay entry.
+ *              Usage: RocImuFusionReplay [-i log] [-o synthetic log] [-m mahony|madgwick]
+ *                                        [-k gain] [-j integral gain] [-d decimate]
+ *                                        [-c calibration ms] [-s]
+ *              The log is replayed through the fusion of RocImuFusion.c as it
+ *              runs on the robot with ROC_MPU6050_RAW_FUSION. Without a log the
+ *              synthetic one is made, "-o" writes it. "-k" is the Kp of the
+ *              Mahony or the Beta of the Madgwick filter, "-j" the Ki of the
+ *              Mahony filter, "-d" fuses only every
+ *              Nth sample for the lower rate. "-s" sweeps the gains and the
+ *              rates of both filters. "-c" removes the biases of the first ms
+ *              of the log, the robot stands still, as the stored biases of the
+ *              warm boot. The time to the stable yaw is always printed. With
+ *              the reference attitude of the log
+ *              the settle time from the boot, the tilt error after it and
+ *              the yaw drift are printed, the higher gain settles faster and
+ *              follows the accel, the lower one is smoother.
+ *
+ *  Parameter:
+ *              argc: the number of the arguments
+ *              argv: the arguments
+ *
+ *  Return:
+ *              The exit status
+ *
+ *  Author:
+ *              ROC LiRen(2026.10.17)
+**********************************************************************************/
+int main(int argc, char *argv[])
+{
+    int                     i = 0;
+    uint32_t                m = 0;
+    uint32_t                g = 0;
+    uint32_t                d = 0;
+    uint32_t                Num = 0;
+    uint32_t                Decimate = 1;
+    uint32_t                CalTime = 0;
+    uint8_t                 HasRef = ROC_TRUE;
+    uint8_t                 IsSweep = ROC_FALSE;
+    uint8_t                 IsUsage = ROC_FALSE;
+    float                   Gain = -1.0F;
+    float                   IntGain = -1.0F;
+    float                   Rate = 0;
+    const char              *pLogPath = NULL;
+    const char              *pSynPath = NULL;
+    ROC_IMU_FUSION_MODE_e   Mode = ROC_IMU_FUSION_MODE_MAHONY;
+    ROC_IMU_FUSION_s        Fusion;
+    ROC_IMU_REPLAY_RESULT_s Result;
+
+    static const float      SweepGain[ROC_IMU_FUSION_MODE_NUM][4] =
+    {
+        {0.25F, 0.5F, 1.0F, 2.0F},          // Mahony Kp
+        {0.025F, 0.05F, 0.1F, 0.2F},        // Madgwick Beta
+    };
+    static const uint32_t   SweepDecimate[] = {1, 5, 10};
+
+    for(i = 1; i < argc; i++)
+    {
+        if((0 == strcmp(argv[i], "-i")) && (i + 1 < argc))
+        {
+            pLogPath = argv[++i];
+        }
+        else if((0 == strcmp(argv[i], "-o")) && (i + 1 < argc))
+        {
+            pSynPath = argv[++i];
+        }
+        else if((0 == strcmp(argv[i], "-m")) && (i + 1 < argc) && (0 == strcmp(argv[i + 1], "mahony")))
+        {
+            Mode = ROC_IMU_FUSION_MODE_MAHONY;
+            i++;
+        }
+        else if((0 == strcmp(argv[i], "-m")) && (i + 1 < argc) && (0 == strcmp(argv[i + 1], "madgwick")))
+        {
+            Mode = ROC_IMU_FUSION_MODE_MADGWICK;
+            i++;
+        }
+        else if((0 == strcmp(argv[i], "-k")) && (i + 1 < argc))
+        {
+            Gain = strtof(argv[++i], NULL);
+        }
+        else if((0 == strcmp(argv[i], "-j")) && (i + 1 < argc))
+        {
+            IntGain = strtof(argv[++i], NULL);
+        }
+        else if((0 == strcmp(argv[i], "-d")) && (i + 1 < argc))
+        {
+            Decimate = (uint32_t)strtoul(argv[++i], NULL, 0);
+        }
+        else if((0 == strcmp(argv[i], "-c")) && (i + 1 < argc))
+        {
+            CalTime = (uint32_t)strtoul(argv[++i], NULL, 0);
+        }
+        else if(0 == strcmp(argv[i], "-s"))
+        {
+            IsSweep = ROC_TRUE;
+        }
+        else
+        {
+            IsUsage = ROC_TRUE;
+            break;
+        }
+    }
+
+    if((ROC_TRUE == IsUsage) || (0 == Decimate) || ((NULL != pLogPath) && (NULL != pSynPath)))
+    {
+        printf("Usage: %s [-i log] [-o synthetic log] [-m mahony|madgwick]\r\n", argv[0]);
+        printf("       [-k gain] [-j integral gain] [-d decimate] [-c calibration ms] [-s]\r\n");
+        printf("       the synthetic log is only made without the input log\r\n");
+
+        return EXIT_FAILURE;
+    }
+
+    if(NULL != pLogPath)
+    {
+        if(RET_OK != RocImuReplayLogLoad(pLogPath, &Num, &HasRef))
+        {
+            return EXIT_FAILURE;
+        }
+    }
+    else if(RET_OK != RocImuReplayLogMake(pSynPath, &Num))
+    {
+        return EXIT_FAILURE;
+    }
+
+    if(1U < Num)
+    {
+        Rate = (float)(Num - 1U) * 1000.0F / (float)(g_ImuReplaySample[Num - 1U].TimeStamp - g_ImuReplaySample[0].TimeStamp);
+    }
+
+    printf("samples: %u  rate: %.1f Hz  reference: %s\r\n", Num, Rate, (ROC_TRUE == HasRef) ? "yes" : "no");
+
+    if((0 != CalTime) && (RET_OK != RocImuReplayBiasCalibrate(Num, CalTime)))
+    {
+        return EXIT_FAILURE;
+    }
+
+    if(ROC_TRUE != IsSweep)
+    {
+        RocImuFusionInit(&Fusion, Mode);
+
+        if(0 <= Gain)
+        {
+            Fusion.Kp = Gain;
+            Fusion.Beta = Gain;
+        }
+
+        if(0 <= IntGain)
+        {
+            Fusion.Ki = IntGain;
+        }
+
+        RocImuReplayRun(&Fusion, Num, Decimate, HasRef, &Result);
+        RocImuReplayResultPrint(&Fusion, Rate / Decimate, HasRef, &Result);
+
+        return EXIT_SUCCESS;
+    }
+
+    for(m = 0; m < ROC_IMU_FUSION_MODE_NUM; m++)
+    {
+        for(d = 0; d < sizeof(SweepDecimate) / sizeof(SweepDecimate[0]); d++)
+        {
+            for(g = 0; g < sizeof(SweepGain[0]) / sizeof(SweepGain[0][0]); g++)
+            {
+                RocImuFusionInit(&Fusion, (ROC_IMU_FUSION_MODE_e)m);
+
+                Fusion.Kp = SweepGain[m][g];
+                Fusion.Beta = SweepGain[m][g];
+
+                if(0 <= IntGain)
+                {
+                    Fusion.Ki = IntGain;
+                }
+
+                RocImuReplayRun(&Fusion, Num, SweepDecimate[d], HasRef, &Result);
+                RocImuReplayResultPrint(&Fusion, Rate / SweepDecimate[d], HasRef, &Result);
+            }
+        }
+    }
+
+    return EXIT_SUCCESS;
+}
+
@@ -0,0 +1,1192 @@
+/********************************************************************************
+ * This code is used for robot control
+*********************************************************************************
+ * Author        Data            Version
+ * Liren         2026/10/17      1.0
+********************************************************************************/
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+
+#include "RocRobotDhAlgorithm.h"
+#include "RocRobotGaitCycle.h"
+#include "RocRobotTransition.h"
+#include "RocRobotStability.h"
+#include "RocRobotProfile.h"
+
+
+/* The trace is little endian: one header, then one record every control tick.
+   Header: "ROCT", version(u16), legs(u16), joints(u16), record size(u16), ticks(u32)
+   Record: tick(u32), gait type(u8), move status(u8), gait step(u8), reserved(u8),
+           LegCurPos X/Y/Z of all legs(f32 * 18), servo PWM of all joints(i16 * 18) */
+#define ROC_GAIT_SIM_TRACE_MAGIC        "ROCT"
+#define ROC_GAIT_SIM_TRACE_VERSION      1U
+#define ROC_GAIT_SIM_HEADER_SIZE        16U
+#define ROC_GAIT_SIM_RECORD_SIZE        (8U + ROC_ROBOT_CNT_LEGS * 3U * 4U + ROC_ROBOT_CNT_LEGS * ROC_ROBOT_LEG_JOINT_NUM * 2U)
+
+#define ROC_GAIT_SIM_MAX_SEGMENTS       256U
+#define ROC_GAIT_SIM_MAX_LINE_SIZE      256U
+#define ROC_GAIT_SIM_NAME_SIZE          32U
+
+#define ROC_GAIT_SIM_CHECK_CYCLE_STEPS  8U      // Gait steps of one cycle fed to the stability monitor
+#define ROC_GAIT_SIM_CHECK_CYCLES       16U     // Cycles of the speed-down and of the recovery
+#define ROC_GAIT_SIM_CHECK_EPSILON      1e-4F
+#define ROC_GAIT_SIM_CHECK_QUAD_MARGIN  0.0F    // mm, the COG is in the support triangle of the quad ripple gaits
+
+
+typedef struct _ROC_GAIT_SIM_SEGMENT_s
+{
+    uint32_t                    Ticks;                  // Control ticks to run the segment
+    ROC_ROBOT_GAIT_TYPE_e       GaitType;
+    ROC_ROBOT_MOVE_STATUS_e     MoveStatus;
+    ROC_ROBOT_COORD_s           Travel;                 // TravelLength X, Y, Z and the turn angle A
+    float                       LiftHeight;
+    ROC_ROBOT_COORD_s           BodyRot;                // Pitch, roll, yaw of the body
+
+}ROC_GAIT_SIM_SEGMENT_s;
+
+typedef struct _ROC_GAIT_SIM_NAME_s
+{
+    const char                  *pName;
+    int32_t                     Value;
+
+}ROC_GAIT_SIM_NAME_s;
+
+typedef struct _ROC_GAIT_SIM_MARGIN_s
+{
+    float                       Min;                    // Minimum static stability margin of the segment, mm
+    float                       Sum;                    // Sum of the margin of the gait ticks
+    float                       MinScale;               // Minimum travel scale of the stability monitor
+    float                       MaxIkError;             // Maximum feet error of the IK clamping, mm
+    float                       MaxPwmError;            // Maximum feet error of the PWM quantisation, mm
+    uint32_t                    Ticks;                  // Gait ticks of the segment
+
+}ROC_GAIT_SIM_MARGIN_s;
+
+
+static const ROC_GAIT_SIM_NAME_s g_GaitSimGaitName[] =
+{
+    {"RIPPLE_12",           ROC_ROBOT_GAIT_HEXP_MODE_RIPPLE_12},
+    {"TRIPOD_8",            ROC_ROBOT_GAIT_HEXP_MODE_TRIPOD_8},
+    {"TRIPLE_12",           ROC_ROBOT_GAIT_HEXP_MODE_TRIPLE_12},
+    {"TRIPLE_16",           ROC_ROBOT_GAIT_HEXP_MODE_TRIPLE_16},
+    {"WAVE_24",             ROC_ROBOT_GAIT_HEXP_MODE_WAVE_24},
+    {"TRIPOD_6",            ROC_ROBOT_GAIT_HEXP_MODE_TRIPOD_6},
+    {"CIRCLE_6",            ROC_ROBOT_GAIT_HEXP_MODE_CIRCLE_6},
+#ifdef ROC_ROBOT_GAIT_QUAD_MODE_ENABLE
+    {"QUAD_RIPPLE_4",       ROC_ROBOT_GAIT_QUAD_MODE_RIPPLE_4},
+    {"QUAD_SM_RIPPLE_4",    ROC_ROBOT_GAIT_QUAD_MODE_SM_RIPPLE_4},
+    {"QUAD_AMBLE_4",        ROC_ROBOT_GAIT_QUAD_MODE_AMBLE_4},
+    {"QUAD_SM_AMBLE_4",     ROC_ROBOT_GAIT_QUAD_MODE_SM_AMBLE_4},
+#endif
+};
+
+static const ROC_GAIT_SIM_NAME_s g_GaitSimMoveName[] =
+{
+    {"STAND",               ROC_ROBOT_MOVE_STATUS_STANDING},
+    {"FORWARD",             ROC_ROBOT_MOVE_STATUS_FORWALKING},
+    {"BACKWARD",            ROC_ROBOT_MOVE_STATUS_BAKWALKING},
+    {"CIRCLE",              ROC_ROBOT_MOVE_STATUS_CIRCLING},
+};
+
+/* The built-in script, it runs every gait forward, and the body rotation, the
+   backward walk, the side walk and the circle on the default gait */
+static const ROC_GAIT_SIM_SEGMENT_s g_GaitSimDefaultScript[] =
+{
+    {24,    ROC_ROBOT_GAIT_HEXP_MODE_TRIPOD_6,      ROC_ROBOT_MOVE_STATUS_STANDING,     {0,   0,  0,  0}, 0,  {0,  0,  0,  0}},
+    {240,   ROC_ROBOT_GAIT_HEXP_MODE_RIPPLE_12,     ROC_ROBOT_MOVE_STATUS_FORWALKING,   {0,  25,  0,  0}, 45, {0,  0,  0,  0}},
+    {160,   ROC_ROBOT_GAIT_HEXP_MODE_TRIPOD_8,      ROC_ROBOT_MOVE_STATUS_FORWALKING,   {0,  25,  0,  0}, 45, {0,  0,  0,  0}},
+    {240,   ROC_ROBOT_GAIT_HEXP_MODE_TRIPLE_12,     ROC_ROBOT_MOVE_STATUS_FORWALKING,   {0,  25,  0,  0}, 45, {0,  0,  0,  0}},
+    {320,   ROC_ROBOT_GAIT_HEXP_MODE_TRIPLE_16,     ROC_ROBOT_MOVE_STATUS_FORWALKING,   {0,  25,  0,  0}, 45, {0,  0,  0,  0}},
+    {480,   ROC_ROBOT_GAIT_HEXP_MODE_WAVE_24,       ROC_ROBOT_MOVE_STATUS_FORWALKING,   {0,  25,  0,  0}, 45, {0,  0,  0,  0}},
+    {120,   ROC_ROBOT_GAIT_HEXP_MODE_TRIPOD_6,      ROC_ROBOT_MOVE_STATUS_FORWALKING,   {0,  25,  0,  0}, 45, {0,  0,  0,  0}},
+    {120,   ROC_ROBOT_GAIT_HEXP_MODE_TRIPOD_6,      ROC_ROBOT_MOVE_STATUS_FORWALKING,   {0,  25,  0,  0}, 45, {8, -5, 12,  0}},
+    {120,   ROC_ROBOT_GAIT_HEXP_MODE_TRIPOD_6,      ROC_ROBOT_MOVE_STATUS_BAKWALKING,   {0, -25,  0,  0}, 45, {0,  0,  0,  0}},
+    {120,   ROC_ROBOT_GAIT_HEXP_MODE_TRIPOD_6,      ROC_ROBOT_MOVE_STATUS_FORWALKING,   {15, 15,  0,  0}, 45, {0,  0,  0,  0}},
+    {120,   ROC_ROBOT_GAIT_HEXP_MODE_CIRCLE_6,      ROC_ROBOT_MOVE_STATUS_CIRCLING,     {0,   0,  0, 20}, 45, {0,  0,  0,  0}},
+#ifdef ROC_ROBOT_GAIT_QUAD_MODE_ENABLE
+    {160,   ROC_ROBOT_GAIT_QUAD_MODE_RIPPLE_4,      ROC_ROBOT_MOVE_STATUS_FORWALKING,   {0,  25,  0,  0}, 45, {0,  0,  0,  0}},
+    {240,   ROC_ROBOT_GAIT_QUAD_MODE_SM_RIPPLE_4,   ROC_ROBOT_MOVE_STATUS_FORWALKING,   {0,  25,  0,  0}, 45, {0,  0,  0,  0}},
+    {80,    ROC_ROBOT_GAIT_QUAD_MODE_AMBLE_4,       ROC_ROBOT_MOVE_STATUS_FORWALKING,   {0,  25,  0,  0}, 45, {0,  0,  0,  0}},
+    {120,   ROC_ROBOT_GAIT_QUAD_MODE_SM_AMBLE_4,    ROC_ROBOT_MOVE_STATUS_FORWALKING,   {0,  25,  0,  0}, 45, {0,  0,  0,  0}},
+#endif
+};
+
+#ifdef ROC_ROBOT_GAIT_QUAD_MODE_ENABLE
+/* The quad ripple gaits of the check, the body shift on the circle follows
+   the lift order of the legs, and keeps the COG in the support triangle */
+static const ROC_GAIT_SIM_SEGMENT_s g_GaitSimQuadCheckScript[] =
+{
+    {24,    ROC_ROBOT_GAIT_QUAD_MODE_RIPPLE_4,      ROC_ROBOT_MOVE_STATUS_STANDING,     {0,   0,  0,  0}, 0,  {0,  0,  0,  0}},
+    {160,   ROC_ROBOT_GAIT_QUAD_MODE_RIPPLE_4,      ROC_ROBOT_MOVE_STATUS_FORWALKING,   {0,  25,  0,  0}, 45, {0,  0,  0,  0}},
+    {240,   ROC_ROBOT_GAIT_QUAD_MODE_SM_RIPPLE_4,   ROC_ROBOT_MOVE_STATUS_FORWALKING,   {0,  25,  0,  0}, 45, {0,  0,  0,  0}},
+    {160,   ROC_ROBOT_GAIT_QUAD_MODE_RIPPLE_4,      ROC_ROBOT_MOVE_STATUS_BAKWALKING,   {0, -25,  0,  0}, 45, {0,  0,  0,  0}},
+};
+#endif
+
+static const ROC_GAIT_SIM_NAME_s g_GaitSimSwingName[] =
+{
+    {"table",               ROC_ROBOT_GAIT_SWING_NUM},
+    {"cycloid",             ROC_ROBOT_GAIT_SWING_CYCLOID},
+    {"bezier",              ROC_ROBOT_GAIT_SWING_BEZIER},
+};
+
+static ROC_GAIT_SIM_SEGMENT_s g_GaitSimScript[ROC_GAIT_SIM_MAX_SEGMENTS];
+
+/* The static stability margin of every segment of the last script run */
+static ROC_GAIT_SIM_MARGIN_s g_GaitSimMargin[ROC_GAIT_SIM_MAX_SEGMENTS];
+
+/* The gait table steps, or the continuous gait with the swing trajectory */
+static ROC_ROBOT_GAIT_SWING_e g_GaitSimSwing = ROC_ROBOT_GAIT_SWING_NUM;
+
+/* The control tick in ms of the continuous gait, 0 is the gait nominal speed */
+static uint16_t g_GaitSimTickMs = 0;
+
+/* The gait ticks of the transition between the segments, 0 switches at once */
+static uint16_t g_GaitSimBlendTicks = ROC_ROBOT_TRANSITION_TICK_DEFAULT;
+
+
+/*********************************************************************************
+ *  Description:
+ *              Get the host monotonic time in ns
+ *
+ *  Parameter:
+ *              None
+ *
+ *  Return:
+ *              The current time in ns
+ *
+ *  Author:
+ *              ROC LiRen(2026.10.17)
+**********************************************************************************/
+static uint64_t RocGaitSimTimeNsGet(void)
+{
+    struct timespec Now;
+
+    clock_gettime(CLOCK_MONOTONIC, &Now);
+
+    return (uint64_t)Now.tv_sec * 1000000000ULL + (uint64_t)Now.tv_nsec;
+}
+
+/*********************************************************************************
+ *  Description:
+ *              Find the value of the name in the name table
+ *
+ *  Parameter:
+ *              pTable: the name table
+ *              Num: the number of the table entries
+ *              pName: the name to find
+ *              pValue: the value of the name
+ *
+ *  Return:
+ *              RET_OK if the name is found
+ *
+ *  Author:
+ *              ROC LiRen(2026.10.17)
+**********************************************************************************/
+static ROC_RESULT RocGaitSimNameFind(const ROC_GAIT_SIM_NAME_s *pTable, uint32_t Num, const char *pName, int32_t *pValue)
+{
+    uint32_t    i = 0;
+
+    for(i = 0; i < Num; i++)
+    {
+        if(0 == strcmp(pTable[i].pName, pName))
+        {
+            *pValue = pTable[i].Value;
+
+            return RET_OK;
+        }
+    }
+
+    return RET_ERROR;
+}
+
+/*********************************************************************************
+ *  Description:
+ *              Load the script file, every line is one segment:
+ *              <ticks> <gait> <move> <x> <y> <z> <turn> <lift> <pitch> <roll> <yaw>
+ *              the gait and move are the names of g_GaitSimGaitName and
+ *              g_GaitSimMoveName, '#' starts a comment line
+ *
+ *  Parameter:
+ *              pPath: the script file path
+ *              pNum: the number of the loaded segments
+ *
+ *  Return:
+ *              RET_OK if the whole script is loaded
+ *
+ *  Author:
+ *              ROC LiRen(2026.10.17)
+**********************************************************************************/
+static ROC_RESULT RocGaitSimScriptLoad(const char *pPath, uint32_t *pNum)
+{
+    FILE                    *pFile = NULL;
+    uint32_t                Line = 0;
+    uint32_t                Num = 0;
+    int32_t                 Value = 0;
+    int                     Cnt = 0;
+    char                    Buffer[ROC_GAIT_SIM_MAX_LINE_SIZE];
+    char                    GaitName[ROC_GAIT_SIM_NAME_SIZE];
+    char                    MoveName[ROC_GAIT_SIM_NAME_SIZE];
+    ROC_GAIT_SIM_SEGMENT_s  *pSeg = NULL;
+
+    pFile = fopen(pPath, "r");
+    if(NULL == pFile)
+    {
+        printf("Can not open %s!\r\n", pPath);
+
+        return RET_ERROR;
+    }
+
+    while(NULL != fgets(Buffer, sizeof(Buffer), pFile))
+    {
+        Line++;
+
+        Cnt = 0;
+        sscanf(Buffer, " %n", &Cnt);
+        if(('\0' == Buffer[Cnt]) || ('#' == Buffer[Cnt]))
+        {
+            continue;
+        }
+
+        if(ROC_GAIT_SIM_MAX_SEGMENTS <= Num)
+        {
+            printf("%s:%u: more than %u segments!\r\n", pPath, Line, ROC_GAIT_SIM_MAX_SEGMENTS);
+            fclose(pFile);
+
+            return RET_ERROR;
+        }
+
+        pSeg = &g_GaitSimScript[Num];
+        memset(pSeg, 0, sizeof(*pSeg));
+
+        Cnt = sscanf(Buffer, "%u %31s %31s %f %f %f %f %f %f %f %f", &pSeg->Ticks, GaitName, MoveName,
+                     &pSeg->Travel.X, &pSeg->Travel.Y, &pSeg->Travel.Z, &pSeg->Travel.A, &pSeg->LiftHeight,
+                     &pSeg->BodyRot.X, &pSeg->BodyRot.Y, &pSeg->BodyRot.Z);
+        if(11 != Cnt)
+        {
+            printf("%s:%u: expect 11 fields!\r\n", pPath, Line);
+            fclose(pFile);
+
+            return RET_ERROR;
+        }
+
+        if(RET_OK != RocGaitSimNameFind(g_GaitSimGaitName, sizeof(g_GaitSimGaitName) / sizeof(g_GaitSimGaitName[0]), GaitName, &Value))
+        {
+            printf("%s:%u: unknown gait %s!\r\n", pPath, Line, GaitName);
+            fclose(pFile);
+
+            return RET_ERROR;
+        }
+        pSeg->GaitType = (ROC_ROBOT_GAIT_TYPE_e)Value;
+
+        if(RET_OK != RocGaitSimNameFind(g_GaitSimMoveName, sizeof(g_GaitSimMoveName) / sizeof(g_GaitSimMoveName[0]), MoveName, &Value))
+        {
+            printf("%s:%u: unknown move %s!\r\n", pPath, Line, MoveName);
+            fclose(pFile);
+
+            return RET_ERROR;
+        }
+        pSeg->MoveStatus = (ROC_ROBOT_MOVE_STATUS_e)Value;
+
+        Num++;
+    }
+
+    fclose(pFile);
+
+    *pNum = Num;
+
+    return RET_OK;
+}
+
+/*********************************************************************************
+ *  Description:
+ *              Put the little endian value to the trace buffer
+ *
+ *  Parameter:
+ *              pBuf: the trace buffer
+ *              Value: the value
+ *              Size: the byte size of the value
+ *
+ *  Return:
+ *              The buffer after the value
+ *
+ *  Author:
+ *              ROC LiRen(2026.10.17)
+**********************************************************************************/
+static uint8_t *RocGaitSimTracePut(uint8_t *pBuf, uint32_t Value, uint32_t Size)
+{
+    uint32_t    i = 0;
+
+    for(i = 0; i < Size; i++)
+    {
+        pBuf[i] = (uint8_t)(Value >> (8 * i));
+    }
+
+    return pBuf + Size;
+}
+
+/*********************************************************************************
+ *  Description:
+ *              Write the trace header
+ *
+ *  Parameter:
+ *              pFile: the trace file
+ *              Ticks: the number of the records
+ *
+ *  Return:
+ *              None
+ *
+ *  Author:
+ *              ROC LiRen(2026.10.17)
+**********************************************************************************/
+static void RocGaitSimTraceHeaderWrite(FILE *pFile, uint32_t Ticks)
+{
+    uint8_t     Header[ROC_GAIT_SIM_HEADER_SIZE];
+    uint8_t     *pBuf = Header;
+
+    memcpy(pBuf, ROC_GAIT_SIM_TRACE_MAGIC, 4);
+    pBuf = RocGaitSimTracePut(pBuf + 4, ROC_GAIT_SIM_TRACE_VERSION, 2);
+    pBuf = RocGaitSimTracePut(pBuf, ROC_ROBOT_CNT_LEGS, 2);
+    pBuf = RocGaitSimTracePut(pBuf, ROC_ROBOT_LEG_JOINT_NUM, 2);
+    pBuf = RocGaitSimTracePut(pBuf, ROC_GAIT_SIM_RECORD_SIZE, 2);
+    RocGaitSimTracePut(pBuf, Ticks, 4);
+
+    fwrite(Header, 1, sizeof(Header), pFile);
+}
+
+/*********************************************************************************
+ *  Description:
+ *              Pack the robot state of one control tick to a trace record
+ *
+ *  Parameter:
+ *              pRecord: the record buffer of ROC_GAIT_SIM_RECORD_SIZE bytes
+ *              Tick: the control tick number
+ *              pMoveCtrl: the robot move control state
+ *
+ *  Return:
+ *              None
+ *
+ *  Author:
+ *              ROC LiRen(2026.10.17)
+**********************************************************************************/
+static void RocGaitSimTraceRecordPack(uint8_t *pRecord, uint32_t Tick, const ROC_ROBOT_MOVE_CTRL_s *pMoveCtrl)
+{
+    uint32_t    i = 0;
+    uint32_t    j = 0;
+    uint32_t    Bits = 0;
+    uint8_t     *pBuf = pRecord;
+
+    pBuf = RocGaitSimTracePut(pBuf, Tick, 4);
+    pBuf = RocGaitSimTracePut(pBuf, (uint32_t)pMoveCtrl->CurState.GaitType, 1);
+    pBuf = RocGaitSimTracePut(pBuf, (uint32_t)pMoveCtrl->CurState.MoveStatus, 1);
+    pBuf = RocGaitSimTracePut(pBuf, pMoveCtrl->CurState.GaitStep, 1);
+    pBuf = RocGaitSimTracePut(pBuf, 0, 1);
+
+    for(i = 0; i < ROC_ROBOT_CNT_LEGS; i++)
+    {
+        memcpy(&Bits, &pMoveCtrl->CurState.LegCurPos[i].X, 4);
+        pBuf = RocGaitSimTracePut(pBuf, Bits, 4);
+        memcpy(&Bits, &pMoveCtrl->CurState.LegCurPos[i].Y, 4);
+        pBuf = RocGaitSimTracePut(pBuf, Bits, 4);
+        memcpy(&Bits, &pMoveCtrl->CurState.LegCurPos[i].Z, 4);
+        pBuf = RocGaitSimTracePut(pBuf, Bits, 4);
+    }
+
+    for(i = 0; i < ROC_ROBOT_CNT_LEGS; i++)
+    {
+        for(j = 0; j < ROC_ROBOT_LEG_JOINT_NUM; j++)
+        {
+            pBuf = RocGaitSimTracePut(pBuf, (uint16_t)pMoveCtrl->CurServo.RobotLeg[i].RobotJoint[j], 2);
+        }
+    }
+}
+
+/*********************************************************************************
+ *  Description:
+ *              Run one control tick, the same as RocRobotMoveCtrlCore does
+ *
+ *  Parameter:
+ *              pSeg: the current script segment
+ *              pMoveCtrl: the robot move control state
+ *
+ *  Return:
+ *              None
+ *
+ *  Author:
+ *              ROC LiRen(2026.10.17)
+**********************************************************************************/
+static void RocGaitSimTickRun(const ROC_GAIT_SIM_SEGMENT_s *pSeg, ROC_ROBOT_MOVE_CTRL_s *pMoveCtrl)
+{
+    RocRobotCtrlDeltaMoveCoorInput(pSeg->Travel.X, pSeg->Travel.Y, pSeg->Travel.Z, pSeg->Travel.A, pSeg->LiftHeight);
+
+    switch(pSeg->MoveStatus)
+    {
+        case ROC_ROBOT_MOVE_STATUS_FORWALKING:
+        case ROC_ROBOT_MOVE_STATUS_BAKWALKING:
+        {
+            RocRobotGaitSeqUpdate();
+
+#ifdef ROC_ROBOT_CLOSED_LOOP_CONTROL
+            RocRobotClosedLoopWalkCalculate(&pMoveCtrl->CurServo);
+#else
+            RocRobotOpenLoopWalkCalculate(&pMoveCtrl->CurServo);
+#endif
+            break;
+        }
+
+        case ROC_ROBOT_MOVE_STATUS_CIRCLING:
+        {
+            RocRobotGaitSeqUpdate();
+
+            RocRobotOpenLoopCircleCalculate(&pMoveCtrl->CurServo);
+
+            break;
+        }
+
+        default:
+        {
+            RocRobotSingleLegCtrl(&pMoveCtrl->CurServo);
+
+            break;
+        }
+    }
+}
+
+/*********************************************************************************
+ *  Description:
+ *              Run the whole script, and record every control tick to the trace
+ *
+ *  Parameter:
+ *              pScript: the script segments
+ *              Num: the number of the segments
+ *              pFile: the trace file, NULL for no trace
+ *
+ *  Return:
+ *              The number of the control ticks
+ *
+ *  Author:
+ *              ROC LiRen(2026.10.17)
+**********************************************************************************/
+static uint32_t RocGaitSimScriptRun(const ROC_GAIT_SIM_SEGMENT_s *pScript, uint32_t Num, FILE *pFile)
+{
+    uint32_t                i = 0;
+    uint32_t                j = 0;
+    uint32_t                Tick = 0;
+    uint8_t                 Record[ROC_GAIT_SIM_RECORD_SIZE];
+    ROC_ROBOT_MOVE_CTRL_s   *pMoveCtrl = NULL;
+    ROC_GAIT_SIM_MARGIN_s   *pMargin = NULL;
+
+    memset(g_GaitSimMargin, 0, sizeof(g_GaitSimMargin));
+
+    RocRobotAlgoCtrlInit();
+    RocRobotTransitionTickNumSet(g_GaitSimBlendTicks);
+    pMoveCtrl = RocRobotCtrlInfoGet();
+
+    if(ROC_ROBOT_GAIT_SWING_NUM != g_GaitSimSwing)
+    {
+        RocRobotGaitCycleSwingSet(g_GaitSimSwing);
+        RocRobotGaitModeSet(ROC_ROBOT_GAIT_MODE_CYCLE);
+    }
+
+    /* Stand on all legs, the single leg control is not scripted */
+    RocRobotSingleLegSelect(ROC_ROBOT_CNT_LEGS);
+
+    for(i = 0; i < Num; i++)
+    {
+        if((0 == i) || (pScript[i].GaitType != pMoveCtrl->CurState.GaitType))
+        {
+            RocRobotGaitTypeSet(pScript[i].GaitType);
+
+            /* The cycle time is kept, a shorter tick evaluates the gait more often */
+            if((ROC_ROBOT_GAIT_SWING_NUM != g_GaitSimSwing) && (0 != g_GaitSimTickMs))
+            {
+                pMoveCtrl->CurGait.NomGaitSpeed = g_GaitSimTickMs;
+            }
+        }
+        else
+        {
+            /* A new segment is a new command, the same as a remote command change */
+            RocRobotTransitionStart();
+        }
+
+        RocRobotMoveStatus_Set(pScript[i].MoveStatus);
+        pMoveCtrl->CurState.BodyRot = pScript[i].BodyRot;
+
+        for(j = 0; j < pScript[i].Ticks; j++)
+        {
+            ROC_ROBOT_PROFILE_BEGIN(ROC_ROBOT_PROFILE_SCOPE_MOVE_CTRL);
+            RocGaitSimTickRun(&pScript[i], pMoveCtrl);
+            ROC_ROBOT_PROFILE_END(ROC_ROBOT_PROFILE_SCOPE_MOVE_CTRL);
+
+            /* The margin is updated by the gait ticks only */
+            if(ROC_ROBOT_MOVE_STATUS_STANDING != pScript[i].MoveStatus)
+            {
+                pMargin = &g_GaitSimMargin[i];
+
+                if((0 == pMargin->Ticks) || (pMoveCtrl->CurState.StabilityMargin < pMargin->Min))
+                {
+                    pMargin->Min = pMoveCtrl->CurState.StabilityMargin;
+                }
+
+                if((0 == pMargin->Ticks) || (RocRobotStabilityScaleGet() < pMargin->MinScale))
+                {
+                    pMargin->MinScale = RocRobotStabilityScaleGet();
+                }
+
+#ifdef ROC_ROBOT_KINEMATIC_CHECK
+                if(pMoveCtrl->CurState.IkError > pMargin->MaxIkError)
+                {
+                    pMargin->MaxIkError = pMoveCtrl->CurState.IkError;
+                }
+
+                if(pMoveCtrl->CurState.PwmError > pMargin->MaxPwmError)
+                {
+                    pMargin->MaxPwmError = pMoveCtrl->CurState.PwmError;
+                }
+#endif
+
+                pMargin->Sum += pMoveCtrl->CurState.StabilityMargin;
+                pMargin->Ticks++;
+            }
+
+            if(NULL != pFile)
+            {
+                RocGaitSimTraceRecordPack(Record, Tick, pMoveCtrl);
+                fwrite(Record, 1, sizeof(Record), pFile);
+            }
+
+            Tick++;
+        }
+    }
+
+    return Tick;
+}
+
+/*********************************************************************************
+ *  Description:
+ *              Print the minimum and the mean static stability margin, the
+ *              minimum travel scale and the maximum IK and PWM feet error of
+ *              every walking segment of the last script run
+ *
+ *  Parameter:
+ *              pScript: the script segments
+ *              Num: the number of the segments
+ *
+ *  Return:
+ *              None
+ *
+ *  Author:
+ *              ROC LiRen(2026.10.17)
+**********************************************************************************/
+static void RocGaitSimMarginReport(const ROC_GAIT_SIM_SEGMENT_s *pScript, uint32_t Num)
+{
+    uint32_t    i = 0;
+    uint32_t    j = 0;
+    const char  *pName = NULL;
+
+    for(i = 0; i < Num; i++)
+    {
+        if(0 == g_GaitSimMargin[i].Ticks)
+        {
+            continue;
+        }
+
+        pName = "?";
+
+        for(j = 0; j < sizeof(g_GaitSimGaitName) / sizeof(g_GaitSimGaitName[0]); j++)
+        {
+            if(g_GaitSimGaitName[j].Value == (int32_t)pScript[i].GaitType)
+            {
+                pName = g_GaitSimGaitName[j].pName;
+            }
+        }
+
+        printf("segment %2u %-16s margin min: %6.1f mm  mean: %6.1f mm  scale min: %.2f  ik err max: %.2f mm  pwm err max: %.2f mm\r\n",
+                i, pName, g_GaitSimMargin[i].Min, g_GaitSimMargin[i].Sum / g_GaitSimMargin[i].Ticks, g_GaitSimMargin[i].MinScale,
+                g_GaitSimMargin[i].MaxIkError, g_GaitSimMargin[i].MaxPwmError);
+    }
+}
+
+/*********************************************************************************
+ *  Description:
+ *              Compare two trace records, the leg positions are compared by
+ *              value, so a signed zero is the same position as zero
+ *
+ *  Parameter:
+ *              pRecord: the record of the new trace
+ *              pRefRecord: the record of the reference trace
+ *
+ *  Return:
+ *              ROC_TRUE if the records are the same
+ *
+ *  Author:
+ *              ROC LiRen(2026.10.17)
+**********************************************************************************/
+static uint8_t RocGaitSimRecordIsSame(const uint8_t *pRecord, const uint8_t *pRefRecord)
+{
+    uint32_t    i = 0;
+    float       Pos = 0;
+    float       RefPos = 0;
+
+    if(0 != memcmp(pRecord, pRefRecord, 8))
+    {
+        return ROC_FALSE;
+    }
+
+    for(i = 0; i < ROC_ROBOT_CNT_LEGS * 3U; i++)
+    {
+        memcpy(&Pos, &pRecord[8U + i * 4U], sizeof(Pos));
+        memcpy(&RefPos, &pRefRecord[8U + i * 4U], sizeof(RefPos));
+
+        if(Pos != RefPos)
+        {
+            return ROC_FALSE;
+        }
+    }
+
+    if(0 != memcmp(&pRecord[8U + ROC_ROBOT_CNT_LEGS * 3U * 4U], &pRefRecord[8U + ROC_ROBOT_CNT_LEGS * 3U * 4U],
+                    ROC_ROBOT_CNT_LEGS * ROC_ROBOT_LEG_JOINT_NUM * 2U))
+    {
+        return ROC_FALSE;
+    }
+
+    return ROC_TRUE;
+}
+
+/*********************************************************************************
+ *  Description:
+ *              Compare two traces record by record, print the first different
+ *              tick and the number of the different ticks
+ *
+ *  Parameter:
+ *              pPath: the new trace
+ *              pRefPath: the reference trace
+ *
+ *  Return:
+ *              RET_OK if the traces are the same
+ *
+ *  Author:
+ *              ROC LiRen(2026.10.17)
+**********************************************************************************/
+static ROC_RESULT RocGaitSimTraceCompare(const char *pPath, const char *pRefPath)
+{
+    FILE        *pFile = NULL;
+    FILE        *pRefFile = NULL;
+    uint32_t    Tick = 0;
+    uint32_t    DiffCnt = 0;
+    uint32_t    FirstDiff = 0;
+    size_t      Len = 0;
+    size_t      RefLen = 0;
+    uint8_t     Header[ROC_GAIT_SIM_HEADER_SIZE];
+    uint8_t     RefHeader[ROC_GAIT_SIM_HEADER_SIZE];
+    uint8_t     Record[ROC_GAIT_SIM_RECORD_SIZE];
+    uint8_t     RefRecord[ROC_GAIT_SIM_RECORD_SIZE];
+
+    pFile = fopen(pPath, "rb");
+    pRefFile = fopen(pRefPath, "rb");
+    if((NULL == pFile) || (NULL == pRefFile))
+    {
+        printf("Can not open %s or %s!\r\n", pPath, pRefPath);
+
+        if(NULL != pFile)
+        {
+            fclose(pFile);
+        }
+
+        if(NULL != pRefFile)
+        {
+            fclose(pRefFile);
+        }
+
+        return RET_ERROR;
+    }
+
+    Len = fread(Header, 1, sizeof(Header), pFile);
+    RefLen = fread(RefHeader, 1, sizeof(RefHeader), pRefFile);
+
+    /* The tick count in the header may differ, the records tell it */
+    if((Len != sizeof(Header)) || (RefLen != sizeof(RefHeader)) || (0 != memcmp(Header, RefHeader, 12)))
+    {
+        printf("The trace format of %s is not the same as %s!\r\n", pPath, pRefPath);
+        fclose(pFile);
+        fclose(pRefFile);
+
+        return RET_ERROR;
+    }
+
+    while(1)
+    {
+        Len = fread(Record, 1, sizeof(Record), pFile);
+        RefLen = fread(RefRecord, 1, sizeof(RefRecord), pRefFile);
+
+        if((Len != sizeof(Record)) || (RefLen != sizeof(RefRecord)))
+        {
+            break;
+        }
+
+        if(ROC_TRUE != RocGaitSimRecordIsSame(Record, RefRecord))
+        {
+            if(0 == DiffCnt)
+            {
+                FirstDiff = Tick;
+            }
+
+            DiffCnt++;
+        }
+
+        Tick++;
+    }
+
+    fclose(pFile);
+    fclose(pRefFile);
+
+    if(0 != DiffCnt)
+    {
+        printf("trace differs: %u of %u ticks, first at tick %u\r\n", DiffCnt, Tick, FirstDiff);
+    }
+
+    if(Len != RefLen)
+    {
+        printf("trace length differs after %u ticks\r\n", Tick);
+    }
+
+    if((0 != DiffCnt) || (Len != RefLen))
+    {
+        return RET_ERROR;
+    }
+
+    printf("trace matches: %u ticks\r\n", Tick);
+
+    return RET_OK;
+}
+
+/*********************************************************************************
+ *  Description:
+ *              Feed the stability monitor the gait cycles of one margin
+ *
+ *  Parameter:
+ *              Margin: the static stability margin of every tick in mm
+ *              FeetNum: the number of the feet on the floor
+ *              Cycles: the number of the gait cycles
+ *
+ *  Return:
+ *              None
+ *
+ *  Author:
+ *              ROC LiRen(2026.10.17)
+**********************************************************************************/
+static void RocGaitSimStabilityCycleFeed(float Margin, uint8_t FeetNum, uint32_t Cycles)
+{
+    uint32_t    i = 0;
+    uint32_t    Step = 0;
+
+    for(i = 0; i < Cycles; i++)
+    {
+        for(Step = 0; Step < ROC_GAIT_SIM_CHECK_CYCLE_STEPS; Step++)
+        {
+            RocRobotStabilityMonitorUpdate(Margin, FeetNum, (float)Step);
+        }
+    }
+}
+
+/*********************************************************************************
+ *  Description:
+ *              Check the travel scale and the command scaling at one point of
+ *              the stability check, the X, Y and turn of the walking gaits are
+ *              scaled, the Z is the body pose and never scaled
+ *
+ *  Parameter:
+ *              pName: the name of the check point
+ *              pMoveCtrl: the robot move control
+ *              MoveStatus: the move status of the command
+ *              Scale: the expected travel scale
+ *
+ *  Return:
+ *              RET_OK if the scale and the command are as expected
+ *
+ *  Author:
+ *              ROC LiRen(2026.10.17)
+**********************************************************************************/
+static ROC_RESULT RocGaitSimStabilityPointCheck(const char *pName, ROC_ROBOT_MOVE_CTRL_s *pMoveCtrl,
+                                                ROC_ROBOT_MOVE_STATUS_e MoveStatus, float Scale)
+{
+    float       CmdScale = 1.0F;
+    float       Error = 0.0F;
+    uint16_t    GaitSpeed = 0;
+    const ROC_ROBOT_COORD_s Cmd = {10.0F, 40.0F, 20.0F, 8.0F};
+
+    RocRobotMoveStatus_Set(MoveStatus);
+    RocRobotCtrlDeltaMoveCoorInput(Cmd.X, Cmd.Y, Cmd.Z, Cmd.A, ROC_ROBOT_DEFAULT_FEET_LIFT);
+
+    if(ROC_ROBOT_MOVE_STATUS_STANDING != MoveStatus)
+    {
+        CmdScale = Scale;
+    }
+
+    Error = Fabs(RocRobotStabilityScaleGet() - Scale);
+    Error = fmaxf(Error, Fabs(pMoveCtrl->CurState.TravelLength.X - Cmd.X * CmdScale));
+    Error = fmaxf(Error, Fabs(pMoveCtrl->CurState.TravelLength.Y - Cmd.Y * CmdScale));
+    Error = fmaxf(Error, Fabs(pMoveCtrl->CurState.TravelLength.Z - Cmd.Z));
+    Error = fmaxf(Error, Fabs(pMoveCtrl->CurState.TravelLength.A - Cmd.A * CmdScale));
+
+    GaitSpeed = RocRobotStabilityGaitSpeedGet(pMoveCtrl->CurGait.NomGaitSpeed);
+
+    if((ROC_GAIT_SIM_CHECK_EPSILON < Error)
+        || (GaitSpeed != (uint16_t)(pMoveCtrl->CurGait.NomGaitSpeed / Scale)))
+    {
+        printf("stability check %s failed: scale %.3f, expect %.3f, travel %.2f %.2f %.2f %.2f, gait speed %u ms\r\n",
+                pName, RocRobotStabilityScaleGet(), Scale,
+                pMoveCtrl->CurState.TravelLength.X, pMoveCtrl->CurState.TravelLength.Y,
+                pMoveCtrl->CurState.TravelLength.Z, pMoveCtrl->CurState.TravelLength.A, GaitSpeed);
+
+        return RET_ERROR;
+    }
+
+    printf("stability check %-10s scale: %.2f  gait speed: %u ms\r\n", pName, Scale, GaitSpeed);
+
+    return RET_OK;
+}
+
+/*********************************************************************************
+ *  Description:
+ *              Check the stability monitor: the gait cycles under the low margin
+ *              cut the travel scale down to the minimum, and stretch the gait
+ *              speed, the ticks with less than three feet on the floor are left
+ *              out, and the cycles over the high margin raise the scale back. The
+ *              walking command is scaled, the standing one and the Z are not.
+ *
+ *  Parameter:
+ *              None
+ *
+ *  Return:
+ *              RET_OK if the monitor works as expected
+ *
+ *  Author:
+ *              ROC LiRen(2026.10.17)
+**********************************************************************************/
+static ROC_RESULT RocGaitSimStabilityCheck(void)
+{
+    uint32_t                i = 0;
+    uint32_t                FailNum = 0;
+    float                   Scale = 1.0F;
+    ROC_ROBOT_MOVE_CTRL_s   *pMoveCtrl = NULL;
+
+    RocRobotAlgoCtrlInit();
+    RocRobotGaitTypeSet(ROC_ROBOT_GAIT_HEXP_MODE_TRIPOD_6);
+    pMoveCtrl = RocRobotCtrlInfoGet();
+
+    if(RET_OK != RocGaitSimStabilityPointCheck("init", pMoveCtrl, ROC_ROBOT_MOVE_STATUS_FORWALKING, 1.0F))
+    {
+        FailNum++;
+    }
+
+    /* The dynamic phases of the amble gaits don't cut the scale */
+    RocGaitSimStabilityCycleFeed(ROC_ROBOT_STABILITY_MARGIN_LOW - 5.0F, 2, ROC_GAIT_SIM_CHECK_CYCLES);
+    if(RET_OK != RocGaitSimStabilityPointCheck("two feet", pMoveCtrl, ROC_ROBOT_MOVE_STATUS_FORWALKING, 1.0F))
+    {
+        FailNum++;
+    }
+
+    for(i = 0; i < ROC_GAIT_SIM_CHECK_CYCLES; i++)
+    {
+        RocGaitSimStabilityCycleFeed(ROC_ROBOT_STABILITY_MARGIN_LOW - 1.0F, ROC_ROBOT_CNT_LEGS, 1);
+
+        /* The cut is made when the next cycle starts */
+        if(0 != i)
+        {
+            Scale = fmaxf(Scale - ROC_ROBOT_STABILITY_SCALE_DOWN, ROC_ROBOT_STABILITY_SCALE_MIN);
+        }
+    }
+
+    if(RET_OK != RocGaitSimStabilityPointCheck("low", pMoveCtrl, ROC_ROBOT_MOVE_STATUS_FORWALKING, Scale))
+    {
+        FailNum++;
+    }
+
+    if(RET_OK != RocGaitSimStabilityPointCheck("circle", pMoveCtrl, ROC_ROBOT_MOVE_STATUS_CIRCLING, Scale))
+    {
+        FailNum++;
+    }
+
+    if(RET_OK != RocGaitSimStabilityPointCheck("standing", pMoveCtrl, ROC_ROBOT_MOVE_STATUS_STANDING, Scale))
+    {
+        FailNum++;
+    }
+
+    /* The margin between the low and the high one keeps the scale */
+    RocGaitSimStabilityCycleFeed((ROC_ROBOT_STABILITY_MARGIN_LOW + ROC_ROBOT_STABILITY_MARGIN_HIGH) / 2.0F,
+                                 ROC_ROBOT_CNT_LEGS, ROC_GAIT_SIM_CHECK_CYCLES);
+    Scale = fmaxf(Scale - ROC_ROBOT_STABILITY_SCALE_DOWN, ROC_ROBOT_STABILITY_SCALE_MIN);
+    if(RET_OK != RocGaitSimStabilityPointCheck("hold", pMoveCtrl, ROC_ROBOT_MOVE_STATUS_FORWALKING, Scale))
+    {
+        FailNum++;
+    }
+
+    for(i = 0; i < 2 * ROC_GAIT_SIM_CHECK_CYCLES; i++)
+    {
+        RocGaitSimStabilityCycleFeed(ROC_ROBOT_STABILITY_MARGIN_HIGH + 1.0F, ROC_ROBOT_CNT_LEGS, 1);
+
+        if(0 != i)
+        {
+            Scale = fminf(Scale + ROC_ROBOT_STABILITY_SCALE_UP, 1.0F);
+        }
+    }
+
+    if(RET_OK != RocGaitSimStabilityPointCheck("recovered", pMoveCtrl, ROC_ROBOT_MOVE_STATUS_BAKWALKING, Scale))
+    {
+        FailNum++;
+    }
+
+    if((0 != FailNum) || (ROC_GAIT_SIM_CHECK_EPSILON < Fabs(1.0F - Scale)))
+    {
+        printf("stability check failed\r\n");
+
+        return RET_ERROR;
+    }
+
+    printf("stability check passed\r\n");
+
+    return RET_OK;
+}
+
+#ifdef ROC_ROBOT_GAIT_QUAD_MODE_ENABLE
+/*********************************************************************************
+ *  Description:
+ *              Check the static stability margin of the quad ripple gaits in the
+ *              gait table and the continuous gait: the body shift on the circle
+ *              keeps the COG in the triangle of the three feet on the floor only
+ *              when the legs are lifted in the circular order of GaitLegNr
+ *
+ *  Parameter:
+ *              None
+ *
+ *  Return:
+ *              RET_OK if the margin of every walking segment is over
+ *              ROC_GAIT_SIM_CHECK_QUAD_MARGIN
+ *
+ *  Author:
+ *              ROC LiRen(2026.10.17)
+**********************************************************************************/
+static ROC_RESULT RocGaitSimQuadMarginCheck(void)
+{
+    uint32_t                i = 0;
+    uint32_t                j = 0;
+    uint32_t                FailNum = 0;
+    uint32_t                Num = sizeof(g_GaitSimQuadCheckScript) / sizeof(g_GaitSimQuadCheckScript[0]);
+    ROC_ROBOT_GAIT_SWING_e  Swing = g_GaitSimSwing;
+    const ROC_ROBOT_GAIT_SWING_e SwingList[] = {ROC_ROBOT_GAIT_SWING_NUM, ROC_ROBOT_GAIT_SWING_CYCLOID};
+
+    for(i = 0; i < sizeof(SwingList) / sizeof(SwingList[0]); i++)
+    {
+        g_GaitSimSwing = SwingList[i];
+
+        RocGaitSimScriptRun(g_GaitSimQuadCheckScript, Num, NULL);
+
+        for(j = 0; j < Num; j++)
+        {
+            if(0 == g_GaitSimMargin[j].Ticks)
+            {
+                continue;
+            }
+
+            printf("quad margin check %-7s segment %u  margin min: %6.1f mm\r\n",
+                    (ROC_ROBOT_GAIT_SWING_NUM == SwingList[i]) ? "table" : "cycloid", j, g_GaitSimMargin[j].Min);
+
+            if(ROC_GAIT_SIM_CHECK_QUAD_MARGIN >= g_GaitSimMargin[j].Min)
+            {
+                FailNum++;
+            }
+        }
+    }
+
+    g_GaitSimSwing = Swing;
+
+    if(0 != FailNum)
+    {
+        printf("quad margin check failed: the COG is out of the support triangle\r\n");
+
+        return RET_ERROR;
+    }
+
+    printf("quad margin check passed\r\n");
+
+    return RET_OK;
+}
+#endif
+
+/*********************************************************************************
+ *  Description:
+ *              Gait simulator entry.
+ *              Usage: RocRobotGaitSim [-s script] [-o trace] [-r reference trace] [-n loops]
+ *                                     [-g table|cycloid|bezier] [-t tick ms] [-b blend ticks] [-c]
+ *              Without a script the built-in one runs. The loops only repeat the
+ *              script for profiling, the trace has the first loop. "-g" selects
+ *              the gait table or the continuous gait with its swing, and "-t"
+ *              the control tick of the continuous gait. "-b" sets the
+ *              gait ticks of the transition between the segments, 0 is the
+ *              switch at once of the old firmware. The minimum and the mean
+ *              static stability margin of every walking segment are printed.
+ *              "-c" runs the stability monitor check and the margin check of
+ *              the quad ripple gaits instead of the script.
+ *
+ *  Parameter:
+ *              argc: the number of the arguments
+ *              argv: the arguments
+ *
+ *  Return:
+ *              The exit status
+ *
+ *  Author:
+ *              ROC LiRen(2026.10.17)
+**********************************************************************************/
+int main(int argc, char *argv[])
+{
+    int                             i = 0;
+    int32_t                         Value = 0;
+    uint32_t                        Loop = 0;
+    uint32_t                        Loops = 1;
+    uint32_t                        Num = 0;
+    uint32_t                        Ticks = 0;
+    uint64_t                        StartTime = 0;
+    uint64_t                        RunTime = 0;
+    const char                      *pScriptPath = NULL;
+    const char                      *pTracePath = NULL;
+    const char                      *pRefPath = NULL;
+    uint8_t                         IsStabilityCheck = ROC_FALSE;
+    const ROC_GAIT_SIM_SEGMENT_s    *pScript = g_GaitSimDefaultScript;
+    FILE                            *pFile = NULL;
+
+    Num = sizeof(g_GaitSimDefaultScript) / sizeof(g_GaitSimDefaultScript[0]);
+
+    for(i = 1; i < argc; i++)
+    {
+        if((0 == strcmp(argv[i], "-s")) && (i + 1 < argc))
+        {
+            pScriptPath = argv[++i];
+        }
+        else if((0 == strcmp(argv[i], "-o")) && (i + 1 < argc))
+        {
+            pTracePath = argv[++i];
+        }
+        else if((0 == strcmp(argv[i], "-r")) && (i + 1 < argc))
+        {
+            pRefPath = argv[++i];
+        }
+        else if((0 == strcmp(argv[i], "-n")) && (i + 1 < argc))
+        {
+            Loops = (uint32_t)strtoul(argv[++i], NULL, 0);
+        }
+        else if((0 == strcmp(argv[i], "-g")) && (i + 1 < argc)
+            && (RET_OK == RocGaitSimNameFind(g_GaitSimSwingName, sizeof(g_GaitSimSwingName) / sizeof(g_GaitSimSwingName[0]), argv[i + 1], &Value)))
+        {
+            g_GaitSimSwing = (ROC_ROBOT_GAIT_SWING_e)Value;
+            i++;
+        }
+        else if((0 == strcmp(argv[i], "-t")) && (i + 1 < argc))
+        {
+            g_GaitSimTickMs = (uint16_t)strtoul(argv[++i], NULL, 0);
+        }
+        else if((0 == strcmp(argv[i], "-b")) && (i + 1 < argc))
+        {
+            g_GaitSimBlendTicks = (uint16_t)strtoul(argv[++i], NULL, 0);
+        }
+        else if(0 == strcmp(argv[i], "-c"))
+        {
+            IsStabilityCheck = ROC_TRUE;
+        }
+        else
+        {
+            Loops = 0;
+            break;
+        }
+    }
+
+    if((0 == Loops) || ((NULL != pRefPath) && (NULL == pTracePath)))
+    {
+        printf("Usage: %s [-s script] [-o trace] [-r reference trace] [-n loops]\r\n", argv[0]);
+        printf("       [-g table|cycloid|bezier] [-t tick ms] [-b blend ticks] [-c]\r\n");
+        printf("       the reference trace needs the trace output\r\n");
+
+        return EXIT_FAILURE;
+    }
+
+    if(ROC_TRUE == IsStabilityCheck)
+    {
+        if(RET_OK != RocGaitSimStabilityCheck())
+        {
+            return EXIT_FAILURE;
+        }
+
+#ifdef ROC_ROBOT_GAIT_QUAD_MODE_ENABLE
+        if(RET_OK != RocGaitSimQuadMarginCheck())
+        {
+            return EXIT_FAILURE;
+        }
+#endif
+
+        return EXIT_SUCCESS;
+    }
+
+    if(NULL != pScriptPath)
+    {
+        if(RET_OK != RocGaitSimScriptLoad(pScriptPath, &Num))
+        {
+            return EXIT_FAILURE;
+        }
+
+        pScript = g_GaitSimScript;
+    }
+
+    if(NULL != pTracePath)
+    {
+        pFile = fopen(pTracePath, "wb");
+        if(NULL == pFile)
+        {
+            printf("Can not open %s!\r\n", pTracePath);
+
+            return EXIT_FAILURE;
+        }
+
+        RocGaitSimTraceHeaderWrite(pFile, 0);
+    }
+
+    RocRobotProfileInit();
+
+    for(Loop = 0; Loop < Loops; Loop++)
+    {
+        StartTime = RocGaitSimTimeNsGet();
+        Ticks = RocGaitSimScriptRun(pScript, Num, (0 == Loop) ? pFile : NULL);
+        RunTime += RocGaitSimTimeNsGet() - StartTime;
+    }
+
+    if(NULL != pFile)
+    {
+        fseek(pFile, 0, SEEK_SET);
+        RocGaitSimTraceHeaderWrite(pFile, Ticks);
+        fclose(pFile);
+    }
+
+    printf("segments: %u  ticks: %u  loops: %u  tick: %.1f ns  rate: %.0f ticks/s\r\n",
+            Num, Ticks, Loops,
+            (double)RunTime / ((uint64_t)Ticks * Loops),
+            (double)Ticks * Loops * 1e9 / (double)RunTime);
+
+    RocRobotProfileReport();
+
+    RocGaitSimMarginReport(pScript, Num);
+
+    if(NULL != pRefPath)
+    {
+        if(RET_OK != RocGaitSimTraceCompare(pTracePath, pRefPath))
+        {
+            return EXIT_FAILURE;
+        }
+    }
+
+    return EXIT_SUCCESS;
+}
+
@@ -0,0 +1,222 @@
+/********************************************************************************
+ * This code is used for robot control
+*********************************************************************************
+ * Author        Data            Version
+ * Liren         2026/10/17      1.0
+********************************************************************************/
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdarg.h>
+#include <string.h>
+#include <math.h>
+
+#include "RocRobotGeometryDesc.h"
+
+
+#define ROC_GEOMETRY_CONST_PI           3.14159265358979
+#define ROC_GEOMETRY_ANGLE_TO_RADIAN    (ROC_GEOMETRY_CONST_PI / 180)
+
+#define ROC_GEOMETRY_MAX_FILE_SIZE      8192
+
+#define ROC_GEOMETRY_LEG_ENTRY(Name, HipInitAngle, XSign, YSign)   {#Name, (HipInitAngle), (XSign), (YSign)},
+
+
+typedef struct _ROC_GEOMETRY_LEG_DESC_s
+{
+    const char  *pName;
+    double      HipInitAngle;
+    int32_t     XSign;
+    int32_t     YSign;
+
+}ROC_GEOMETRY_LEG_DESC_s;
+
+
+static const ROC_GEOMETRY_LEG_DESC_s g_GeometryLeg[] =
+{
+    ROC_ROBOT_GEOMETRY_LEG_LIST(ROC_GEOMETRY_LEG_ENTRY)
+};
+
+static char g_GeometryText[ROC_GEOMETRY_MAX_FILE_SIZE];
+static char g_GeometryRefText[ROC_GEOMETRY_MAX_FILE_SIZE];
+
+
+/*********************************************************************************
+ *  Description:
+ *              Append the formatted text to the generated header
+ *
+ *  Parameter:
+ *              pLen: the pointer to the current length of the text
+ *              fmt: the text format
+ *
+ *  Return:
+ *              None
+ *
+ *  Author:
+ *              ROC LiRen(2026.10.17)
+**********************************************************************************/
+static void RocGeometryPrint(size_t *pLen, const char *fmt, ...)
+{
+    va_list arg_ptr;
+
+    va_start(arg_ptr, fmt);
+    *pLen += (size_t)vsnprintf(g_GeometryText + *pLen, ROC_GEOMETRY_MAX_FILE_SIZE - *pLen, fmt, arg_ptr);
+    va_end(arg_ptr);
+}
+
+/*********************************************************************************
+ *  Description:
+ *              Generate the text of RocRobotGeometry.h from the geometry description
+ *
+ *  Parameter:
+ *              None
+ *
+ *  Return:
+ *              The length of the generated text
+ *
+ *  Author:
+ *              ROC LiRen(2026.10.17)
+**********************************************************************************/
+static size_t RocGeometryGenerate(void)
+{
+    size_t      Len = 0;
+    size_t      i = 0;
+    double      Width = 0;
+    double      Height = 0;
+    double      HipAngle = 0;
+    double      InitX = 0;
+    double      InitY = 0;
+    double      InitZ = 0;
+    double      OffsetX = 0;
+    double      OffsetY = 0;
+    double      OffsetZ = 0;
+
+    Width = ROC_ROBOT_DH_CONST_A1 + ROC_ROBOT_DH_CONST_A2 * cos(ROC_ROBOT_INIT_DOWN_ANGLE * ROC_GEOMETRY_ANGLE_TO_RADIAN)
+            + ROC_ROBOT_FEET_WIDTH;
+    Height = ROC_ROBOT_DH_CONST_A2 * sin(ROC_ROBOT_INIT_DOWN_ANGLE * ROC_GEOMETRY_ANGLE_TO_RADIAN) + ROC_ROBOT_LEG_HEIGHT;
+
+    RocGeometryPrint(&Len, "/********************************************************************************\n");
+    RocGeometryPrint(&Len, " * This code is used for robot control\n");
+    RocGeometryPrint(&Len, "*********************************************************************************\n");
+    RocGeometryPrint(&Len, " * Generated by RocRobotGeometryGen from RocRobotGeometryDesc.h, do not edit.\n");
+    RocGeometryPrint(&Len, "********************************************************************************/\n");
+    RocGeometryPrint(&Len, "#ifndef __ROC_ROBOT_GEOMETRY_H\n");
+    RocGeometryPrint(&Len, "#define __ROC_ROBOT_GEOMETRY_H\n\n\n");
+
+    RocGeometryPrint(&Len, "#define ROC_ROBOT_WIDTH                             (%.6fF)\n", Width);
+    RocGeometryPrint(&Len, "#define ROC_ROBOT_HEIGHT                            (%.6fF)\n\n\n", Height);
+
+    for(i = 0; i < sizeof(g_GeometryLeg) / sizeof(g_GeometryLeg[0]); i++)
+    {
+        HipAngle = g_GeometryLeg[i].HipInitAngle * ROC_GEOMETRY_ANGLE_TO_RADIAN;
+
+        InitX = Width * cos(HipAngle);
+        InitY = Width * sin(HipAngle);
+        InitZ = -Height;
+
+        OffsetX = g_GeometryLeg[i].XSign * ROC_ROBOT_BODY_LENGTH_OFFSET * cos(HipAngle);
+        OffsetY = g_GeometryLeg[i].YSign * ROC_ROBOT_BODY_LENGTH_OFFSET * sin(HipAngle);
+        OffsetZ = ROC_ROBOT_BODY_HEIGHT_OFFSET;
+
+        /* "+ 0.0" prints the negative zero as 0.000000 */
+        RocGeometryPrint(&Len, "#define ROC_ROBOT_%s_INIT_X                    (%.6fF)\n", g_GeometryLeg[i].pName, InitX + 0.0);
+        RocGeometryPrint(&Len, "#define ROC_ROBOT_%s_INIT_Y                    (%.6fF)\n", g_GeometryLeg[i].pName, InitY + 0.0);
+        RocGeometryPrint(&Len, "#define ROC_ROBOT_%s_INIT_Z                    (%.6fF)\n", g_GeometryLeg[i].pName, InitZ + 0.0);
+        RocGeometryPrint(&Len, "#define ROC_ROBOT_%s_OFFSET_X                  (%.6fF)\n", g_GeometryLeg[i].pName, OffsetX + 0.0);
+        RocGeometryPrint(&Len, "#define ROC_ROBOT_%s_OFFSET_Y                  (%.6fF)\n", g_GeometryLeg[i].pName, OffsetY + 0.0);
+        RocGeometryPrint(&Len, "#define ROC_ROBOT_%s_OFFSET_Z                  (%.6fF)\n\n", g_GeometryLeg[i].pName, OffsetZ + 0.0);
+    }
+
+    RocGeometryPrint(&Len, "\n/* ROC_ROBOT_LEG_GEOMETRY_s of all legs in the order of ROC_ROBOT_LEG_e */\n");
+    RocGeometryPrint(&Len, "#define ROC_ROBOT_GEOMETRY_LEG_TABLE                                        \\\n");
+    RocGeometryPrint(&Len, "{                                                                           \\\n");
+
+    for(i = 0; i < sizeof(g_GeometryLeg) / sizeof(g_GeometryLeg[0]); i++)
+    {
+        RocGeometryPrint(&Len, "    {   /* ROC_ROBOT_%s_LEG */                                          \\\n", g_GeometryLeg[i].pName);
+        RocGeometryPrint(&Len, "        {ROC_ROBOT_%s_INIT_X, ROC_ROBOT_%s_INIT_Y, ROC_ROBOT_%s_INIT_Z},   \\\n",
+                g_GeometryLeg[i].pName, g_GeometryLeg[i].pName, g_GeometryLeg[i].pName);
+        RocGeometryPrint(&Len, "        {ROC_ROBOT_%s_OFFSET_X %c ROC_ROBOT_%s_INIT_X,                     \\\n",
+                g_GeometryLeg[i].pName, (g_GeometryLeg[i].XSign > 0) ? '+' : '-', g_GeometryLeg[i].pName);
+        RocGeometryPrint(&Len, "         ROC_ROBOT_%s_OFFSET_Y %c ROC_ROBOT_%s_INIT_Y,                     \\\n",
+                g_GeometryLeg[i].pName, (g_GeometryLeg[i].YSign > 0) ? '+' : '-', g_GeometryLeg[i].pName);
+        RocGeometryPrint(&Len, "         ROC_ROBOT_%s_OFFSET_Z + ROC_ROBOT_%s_INIT_Z},                     \\\n",
+                g_GeometryLeg[i].pName, g_GeometryLeg[i].pName);
+        RocGeometryPrint(&Len, "    },                                                                      \\\n");
+    }
+
+    RocGeometryPrint(&Len, "}\n\n\n");
+    RocGeometryPrint(&Len, "#endif\n\n");
+
+    return Len;
+}
+
+/*********************************************************************************
+ *  Description:
+ *              Geometry generator entry.
+ *              Usage: RocRobotGeometryGen <output header> [checked-in header]
+ *              The checked-in header is used by the Keil build, the generator
+ *              fails if it is not the same as the generated one.
+ *
+ *  Parameter:
+ *              argc: the number of the arguments
+ *              argv: the arguments
+ *
+ *  Return:
+ *              The exit status
+ *
+ *  Author:
+ *              ROC LiRen(2026.10.17)
+**********************************************************************************/
+int main(int argc, char *argv[])
+{
+    size_t  Len = 0;
+    size_t  RefLen = 0;
+    FILE    *pFile = NULL;
+
+    if(argc < 2)
+    {
+        printf("Usage: %s <output header> [checked-in header]\r\n", argv[0]);
+
+        return EXIT_FAILURE;
+    }
+
+    Len = RocGeometryGenerate();
+    if(Len >= ROC_GEOMETRY_MAX_FILE_SIZE)
+    {
+        printf("The geometry header is too large!\r\n");
+
+        return EXIT_FAILURE;
+    }
+
+    pFile = fopen(argv[1], "wb");
+    if(NULL == pFile)
+    {
+        printf("Can not open %s!\r\n", argv[1]);
+
+        return EXIT_FAILURE;
+    }
+
+    fwrite(g_GeometryText, 1, Len, pFile);
+    fclose(pFile);
+
+    if(argc > 2)
+    {
+        pFile = fopen(argv[2], "rb");
+        if(NULL != pFile)
+        {
+            RefLen = fread(g_GeometryRefText, 1, ROC_GEOMETRY_MAX_FILE_SIZE, pFile);
+            fclose(pFile);
+        }
+
+        if((RefLen != Len) || (0 != memcmp(g_GeometryText, g_GeometryRefText, Len)))
+        {
+            printf("%s is out of date with RocRobotGeometryDesc.h, build the target RocRobotGeometryUpdate!\r\n", argv[2]);
+
+            return EXIT_FAILURE;
+        }
+    }
+
+    return EXIT_SUCCESS;
+}
+
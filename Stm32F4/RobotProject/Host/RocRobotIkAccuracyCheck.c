@@ -0,0 +1,442 @@
+/********************************************************************************
+ * This code is used for robot control
+*********************************************************************************
+ * Author        Data            Version
+ * Liren         2026/10/17      1.0
+********************************************************************************/
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <math.h>
+#include <time.h>
+
+#include "RocRobotDhAlgorithm.h"
+
+
+#define ROC_CHECK_REF_PI                3.1415926
+#define ROC_CHECK_REF_ANGLE_TO_RADIAN   (ROC_CHECK_REF_PI / 180)
+
+#define ROC_CHECK_LEG_REACH             ((int32_t)(ROC_ROBOT_DH_CONST_A1 + ROC_ROBOT_DH_CONST_A2 + ROC_ROBOT_DH_CONST_A3) + 1)
+#define ROC_CHECK_SWEEP_DEFAULT_STEP    2       // feet sweep step in the leg workspace, mm
+
+#define ROC_CHECK_MAX_PWM_DELTA         1       // the PWM can not move more than one count
+#define ROC_CHECK_MAX_FK_ERROR          0.01    // the FK of a reachable IK result is back on the feet, mm
+
+#define ROC_CHECK_TRIG_SAMPLE_NUM       1000000
+
+
+typedef struct _ROC_CHECK_RESULT_s
+{
+    uint32_t    PointNum;
+    uint32_t    OutsideNum;                     // sweep points out of the reachable workspace, not solved
+    uint32_t    BatchNum;
+    uint32_t    PwmDiffNum;
+    int32_t     MaxPwmDelta;
+    double      MaxAngleError[ROC_ROBOT_LEG_JOINT_NUM];
+    double      MaxFkError;                     // FK error of the reachable points, it is the solver error
+    double      MaxPwmError;                    // feet error of the PWM quantisation of the reachable points
+    double      SumPwmError;
+    uint64_t    RefTime;
+    uint64_t    TestTime;
+
+}ROC_CHECK_RESULT_s;
+
+
+/*********************************************************************************
+ *  Description:
+ *              Get the host monotonic time in ns
+ *
+ *  Parameter:
+ *              None
+ *
+ *  Return:
+ *              The current time in ns
+ *
+ *  Author:
+ *              ROC LiRen(2026.10.17)
+**********************************************************************************/
+static uint64_t RocCheckTimeNsGet(void)
+{
+    struct timespec Now;
+
+    clock_gettime(CLOCK_MONOTONIC, &Now);
+
+    return (uint64_t)Now.tv_sec * 1000000000ULL + (uint64_t)Now.tv_nsec;
+}
+
+/*********************************************************************************
+ *  Description:
+ *              The double precision reference of the leg inverse kinematic, it
+ *              is the solver of the robot before the single precision change
+ *
+ *  Parameter:
+ *              x: the expected X position of the robot leg tiptoe
+ *              y: the expected Y position of the robot leg tiptoe
+ *              z: the expected Z position of the robot leg tiptoe
+ *              pJointAngle: the pointer to the three joint angle result
+ *
+ *  Return:
+ *              None
+ *
+ *  Author:
+ *              ROC LiRen(2026.10.17)
+**********************************************************************************/
+static void RocCheckRefLegInverseKinematic(double x, double y, double z, double *pJointAngle)
+{
+    double  a = 0;
+    double  e = 0;
+    double  f = 0;
+    double  h = 0;
+    double  j = 0;
+
+    pJointAngle[ROC_ROBOT_LEG_HIP_JOINT] = atan(y / x) / ROC_CHECK_REF_ANGLE_TO_RADIAN;
+
+    a = x * cos(pJointAngle[ROC_ROBOT_LEG_HIP_JOINT] * ROC_CHECK_REF_ANGLE_TO_RADIAN)
+        + y * sin(pJointAngle[ROC_ROBOT_LEG_HIP_JOINT] * ROC_CHECK_REF_ANGLE_TO_RADIAN) - ROC_ROBOT_DH_CONST_A1;
+
+    pJointAngle[ROC_ROBOT_LEG_ANKLE_JOINT] = acos((a * a + (z - ROC_ROBOT_DH_CONST_D1) * (z - ROC_ROBOT_DH_CONST_D1)
+                        - (double)ROC_ROBOT_DH_CONST_A3 * ROC_ROBOT_DH_CONST_A3 - ROC_ROBOT_DH_CONST_A2 * ROC_ROBOT_DH_CONST_A2)
+                        / (2 * ROC_ROBOT_DH_CONST_A2 * (double)ROC_ROBOT_DH_CONST_A3)) / ROC_CHECK_REF_ANGLE_TO_RADIAN;
+
+    if((pJointAngle[ROC_ROBOT_LEG_ANKLE_JOINT] > 0) && (pJointAngle[ROC_ROBOT_LEG_ANKLE_JOINT] <= 180))
+    {
+        pJointAngle[ROC_ROBOT_LEG_ANKLE_JOINT] = -pJointAngle[ROC_ROBOT_LEG_ANKLE_JOINT];
+    }
+
+    e = cos(pJointAngle[ROC_ROBOT_LEG_ANKLE_JOINT] * ROC_CHECK_REF_ANGLE_TO_RADIAN);
+    f = sin(pJointAngle[ROC_ROBOT_LEG_ANKLE_JOINT] * ROC_CHECK_REF_ANGLE_TO_RADIAN);
+    h = (e * ROC_ROBOT_DH_CONST_A3 + ROC_ROBOT_DH_CONST_A2) * (z - ROC_ROBOT_DH_CONST_D1) - a * f * ROC_ROBOT_DH_CONST_A3;
+    j = a * (ROC_ROBOT_DH_CONST_A3 * e + ROC_ROBOT_DH_CONST_A2) + ROC_ROBOT_DH_CONST_A3 * f * (z - ROC_ROBOT_DH_CONST_D1);
+
+    pJointAngle[ROC_ROBOT_LEG_KNEE_JOINT] = atan2(h, j) / ROC_CHECK_REF_ANGLE_TO_RADIAN;
+}
+
+/*********************************************************************************
+ *  Description:
+ *              Solve one batch of the reachable feet positions and compare the
+ *              result of the kinematics library with the double precision
+ *              reference. The IK result goes back through the forward kinematic,
+ *              both the angle and the PWM.
+ *
+ *  Parameter:
+ *              pFeetPos: the pointer to the feet positions, one for each leg
+ *              pResult: the pointer to the check result
+ *
+ *  Return:
+ *              None
+ *
+ *  Author:
+ *              ROC LiRen(2026.10.17)
+**********************************************************************************/
+static void RocCheckBatchRun(const ROC_ROBOT_FEET_POS_s *pFeetPos, ROC_CHECK_RESULT_s *pResult)
+{
+    uint8_t                 i = 0;
+    uint8_t                 j = 0;
+    int32_t                 PwmDelta = 0;
+    double                  RefAngle[ROC_ROBOT_CNT_LEGS][ROC_ROBOT_LEG_JOINT_NUM];
+    uint64_t                StartTime = 0;
+    ROC_ROBOT_JOINT_ANGLE_s TestAngle;
+    ROC_ROBOT_JOINT_ANGLE_s RefAngleFloat;
+    ROC_ROBOT_SERVO_s       TestServo;
+    ROC_ROBOT_SERVO_s       RefServo;
+    ROC_ROBOT_JOINT_ANGLE_s PwmAngle;
+    ROC_ROBOT_FEET_POS_s    IkFeetPos;
+    ROC_ROBOT_FEET_POS_s    PwmFeetPos;
+    double                  FkError = 0;
+    double                  PwmError = 0;
+
+    StartTime = RocCheckTimeNsGet();
+    for(i = 0; i < ROC_ROBOT_CNT_LEGS; i++)
+    {
+        RocCheckRefLegInverseKinematic(pFeetPos->X[i], pFeetPos->Y[i], pFeetPos->Z[i], RefAngle[i]);
+    }
+    pResult->RefTime += RocCheckTimeNsGet() - StartTime;
+
+    StartTime = RocCheckTimeNsGet();
+    RocRobotLegInverseKinematicBatch(pFeetPos, &TestAngle);
+    pResult->TestTime += RocCheckTimeNsGet() - StartTime;
+
+    pResult->BatchNum++;
+
+    for(i = 0; i < ROC_ROBOT_CNT_LEGS; i++)
+    {
+        for(j = 0; j < ROC_ROBOT_LEG_JOINT_NUM; j++)
+        {
+            RefAngleFloat.Angle[i][j] = (float)RefAngle[i][j];
+        }
+    }
+
+    RocRobotJointAngleToPwm(&TestAngle, &TestServo);
+    RocRobotJointAngleToPwm(&RefAngleFloat, &RefServo);
+
+    /* The round trip of the forward kinematic */
+    RocRobotLegForwardKinematicBatch(&TestAngle, &IkFeetPos);
+    RocRobotPwmToJointAngle(&TestServo, &PwmAngle);
+    RocRobotLegForwardKinematicBatch(&PwmAngle, &PwmFeetPos);
+
+    for(i = 0; i < ROC_ROBOT_CNT_LEGS; i++)
+    {
+        FkError = sqrt((IkFeetPos.X[i] - pFeetPos->X[i]) * (IkFeetPos.X[i] - pFeetPos->X[i])
+                    + (IkFeetPos.Y[i] - pFeetPos->Y[i]) * (IkFeetPos.Y[i] - pFeetPos->Y[i])
+                    + (IkFeetPos.Z[i] - pFeetPos->Z[i]) * (IkFeetPos.Z[i] - pFeetPos->Z[i]));
+
+        for(j = 0; j < ROC_ROBOT_LEG_JOINT_NUM; j++)
+        {
+            if(fabs(TestAngle.Angle[i][j] - RefAngle[i][j]) > pResult->MaxAngleError[j])
+            {
+                pResult->MaxAngleError[j] = fabs(TestAngle.Angle[i][j] - RefAngle[i][j]);
+            }
+
+            PwmDelta = abs(TestServo.RobotLeg[i].RobotJoint[j] - RefServo.RobotLeg[i].RobotJoint[j]);
+
+            if(PwmDelta != 0)
+            {
+                pResult->PwmDiffNum++;
+            }
+
+            if(PwmDelta > pResult->MaxPwmDelta)
+            {
+                pResult->MaxPwmDelta = PwmDelta;
+            }
+        }
+
+        PwmError = sqrt((PwmFeetPos.X[i] - IkFeetPos.X[i]) * (PwmFeetPos.X[i] - IkFeetPos.X[i])
+                    + (PwmFeetPos.Y[i] - IkFeetPos.Y[i]) * (PwmFeetPos.Y[i] - IkFeetPos.Y[i])
+                    + (PwmFeetPos.Z[i] - IkFeetPos.Z[i]) * (PwmFeetPos.Z[i] - IkFeetPos.Z[i]));
+
+        pResult->MaxFkError = fmax(pResult->MaxFkError, FkError);
+        pResult->MaxPwmError = fmax(pResult->MaxPwmError, PwmError);
+        pResult->SumPwmError += PwmError;
+
+        pResult->PointNum++;
+    }
+}
+
+/*********************************************************************************
+ *  Description:
+ *              Check the feet position is in the reachable workspace of the leg:
+ *              the reference IK has a solution, and the servos of the leg can
+ *              turn to its joint angles
+ *
+ *  Parameter:
+ *              Leg: the leg of the feet, the PWM mapping differs by leg
+ *              x: the X position of the robot leg tiptoe
+ *              y: the Y position of the robot leg tiptoe
+ *              z: the Z position of the robot leg tiptoe
+ *
+ *  Return:
+ *              ROC_TRUE if the position is reachable
+ *
+ *  Author:
+ *              ROC LiRen(2026.10.17)
+**********************************************************************************/
+static uint8_t RocCheckPointIsReachable(uint8_t Leg, double x, double y, double z)
+{
+    uint8_t                 j = 0;
+    double                  RefAngle[ROC_ROBOT_LEG_JOINT_NUM];
+    ROC_ROBOT_JOINT_ANGLE_s Angle = {0};
+    ROC_ROBOT_SERVO_s       Servo;
+
+    RocCheckRefLegInverseKinematic(x, y, z, RefAngle);
+
+    for(j = 0; j < ROC_ROBOT_LEG_JOINT_NUM; j++)
+    {
+        if(isnan(RefAngle[j]))
+        {
+            return ROC_FALSE;
+        }
+
+        Angle.Angle[Leg][j] = (float)RefAngle[j];
+    }
+
+    RocRobotJointAngleToPwm(&Angle, &Servo);
+
+    for(j = 0; j < ROC_ROBOT_LEG_JOINT_NUM; j++)
+    {
+        if((Servo.RobotLeg[Leg].RobotJoint[j] < ROC_SERVO_MIN_PWM_VAL)
+            || (Servo.RobotLeg[Leg].RobotJoint[j] > ROC_SERVO_MAX_PWM_VAL))
+        {
+            return ROC_FALSE;       // the servo can not reach the joint angle
+        }
+    }
+
+    return ROC_TRUE;
+}
+
+/*********************************************************************************
+ *  Description:
+ *              Sweep the feet through the box around the leg, only the points
+ *              in the reachable workspace are solved, the IK of the others is
+ *              clamped and has nothing to compare. Every six reachable
+ *              positions are solved as one batch, one for each leg.
+ *
+ *  Parameter:
+ *              Step: the sweep step in mm
+ *              pResult: the pointer to the check result
+ *
+ *  Return:
+ *              None
+ *
+ *  Author:
+ *              ROC LiRen(2026.10.17)
+**********************************************************************************/
+static void RocCheckWorkspaceRun(int32_t Step, ROC_CHECK_RESULT_s *pResult)
+{
+    int32_t                 x = 0;
+    int32_t                 y = 0;
+    int32_t                 z = 0;
+    uint8_t                 Slot = 0;
+    ROC_ROBOT_FEET_POS_s    FeetPos;
+
+    for(z = -ROC_CHECK_LEG_REACH; z <= ROC_CHECK_LEG_REACH; z += Step)
+    {
+        for(y = -ROC_CHECK_LEG_REACH; y <= ROC_CHECK_LEG_REACH; y += Step)
+        {
+            for(x = Step; x <= ROC_CHECK_LEG_REACH; x += Step)     // the feet is always outside of the hip
+            {
+                if(ROC_TRUE != RocCheckPointIsReachable(Slot, x, y, z))
+                {
+                    pResult->OutsideNum++;
+
+                    continue;
+                }
+
+                FeetPos.X[Slot] = (float)x;
+                FeetPos.Y[Slot] = (float)y;
+                FeetPos.Z[Slot] = (float)z;
+
+                Slot++;
+                if(ROC_ROBOT_CNT_LEGS == Slot)
+                {
+                    RocCheckBatchRun(&FeetPos, pResult);
+
+                    Slot = 0;
+                }
+            }
+        }
+    }
+}
+
+#ifdef ROC_ROBOT_MATH_USE_TRIG_LUT
+/*********************************************************************************
+ *  Description:
+ *              Measure the max error of the trigonometry lookup tables against
+ *              the double precision libm
+ *
+ *  Parameter:
+ *              None
+ *
+ *  Return:
+ *              None
+ *
+ *  Author:
+ *              ROC LiRen(2026.10.17)
+**********************************************************************************/
+static void RocCheckTrigLutRun(void)
+{
+    uint32_t    i = 0;
+    double      t = 0;
+    double      MaxSinErr = 0;
+    double      MaxAtanErr = 0;
+    double      MaxAtan2Err = 0;
+    double      MaxAcosErr = 0;
+    float       x = 0;
+
+    for(i = 0; i <= ROC_CHECK_TRIG_SAMPLE_NUM; i++)
+    {
+        t = (double)i / ROC_CHECK_TRIG_SAMPLE_NUM;
+
+        x = (float)((t - 0.5) * 8 * ROC_CHECK_REF_PI);                 // [-4 * PI, 4 * PI]
+        MaxSinErr = fmax(MaxSinErr, fabs(RocRobotTrigLutSin(x) - sin(x)));
+        MaxSinErr = fmax(MaxSinErr, fabs(RocRobotTrigLutCos(x) - cos(x)));
+
+        x = (float)((t - 0.5) * 200);                                  // [-100, 100]
+        MaxAtanErr = fmax(MaxAtanErr, fabs(RocRobotTrigLutAtan(x) - atan(x)));
+
+        x = (float)((t - 0.5) * 2 * ROC_CHECK_REF_PI);                 // angle of the unit circle
+        MaxAtan2Err = fmax(MaxAtan2Err, fabs(RocRobotTrigLutAtan2(sinf(x), cosf(x)) - atan2(sinf(x), cosf(x))));
+
+        x = (float)((t - 0.5) * 2);                                    // [-1, 1]
+        MaxAcosErr = fmax(MaxAcosErr, fabs(RocRobotTrigLutAcos(x) - acos(x)));
+        MaxAcosErr = fmax(MaxAcosErr, fabs(RocRobotTrigLutAsin(x) - asin(x)));
+    }
+
+    printf("trig lut max error  sin/cos: %.3e  atan: %.3e rad  atan2: %.3e rad  acos/asin: %.3e rad\r\n",
+            MaxSinErr, MaxAtanErr, MaxAtan2Err, MaxAcosErr);
+}
+#endif
+
+/*********************************************************************************
+ *  Description:
+ *              IK accuracy check entry, sweep the feet through the leg workspace
+ *              and compare the kinematics library with the double reference,
+ *              then check the round trip of the forward kinematic.
+ *              Usage: RocRobotIkAccuracyCheck [step in mm]
+ *
+ *  Parameter:
+ *              argc: the number of the arguments
+ *              argv: the arguments
+ *
+ *  Return:
+ *              EXIT_SUCCESS if no PWM value moves more than ROC_CHECK_MAX_PWM_DELTA
+ *              and the FK of every reachable point is back on the feet
+ *
+ *  Author:
+ *              ROC LiRen(2026.10.17)
+**********************************************************************************/
+int main(int argc, char *argv[])
+{
+    int32_t             Step = ROC_CHECK_SWEEP_DEFAULT_STEP;
+    uint32_t            SolveNum = 0;
+    ROC_CHECK_RESULT_s  Result = {0};
+
+    if(argc > 1)
+    {
+        Step = (int32_t)strtol(argv[1], NULL, 0);
+    }
+
+    if(Step <= 0)
+    {
+        printf("Usage: %s [step in mm]\r\n", argv[0]);
+
+        return EXIT_FAILURE;
+    }
+
+    RocRobotAlgoCtrlInit();
+
+#ifdef ROC_ROBOT_MATH_USE_TRIG_LUT
+    RocCheckTrigLutRun();
+#endif
+
+    RocCheckWorkspaceRun(Step, &Result);
+
+    SolveNum = Result.BatchNum * ROC_ROBOT_CNT_LEGS;
+
+    printf("workspace step: %d mm  points: %u  outside: %u\r\n", Step, Result.PointNum, Result.OutsideNum);
+    printf("max angle error  hip: %.6f  knee: %.6f  ankle: %.6f deg\r\n",
+            Result.MaxAngleError[ROC_ROBOT_LEG_HIP_JOINT],
+            Result.MaxAngleError[ROC_ROBOT_LEG_KNEE_JOINT],
+            Result.MaxAngleError[ROC_ROBOT_LEG_ANKLE_JOINT]);
+    printf("pwm differ: %u of %u  max pwm delta: %d\r\n",
+            Result.PwmDiffNum, Result.PointNum * ROC_ROBOT_LEG_JOINT_NUM, Result.MaxPwmDelta);
+    printf("fk round trip  max solver error: %.4f mm  max pwm error: %.2f mm  mean pwm error: %.2f mm\r\n",
+            Result.MaxFkError, Result.MaxPwmError, Result.SumPwmError / Result.PointNum);
+    printf("leg solve  reference(double): %.1f ns  kinematics: %.1f ns\r\n",
+            (double)Result.RefTime / SolveNum, (double)Result.TestTime / SolveNum);
+
+    if(Result.MaxPwmDelta > ROC_CHECK_MAX_PWM_DELTA)
+    {
+        printf("FAIL: the pwm moves more than %d count\r\n", ROC_CHECK_MAX_PWM_DELTA);
+
+        return EXIT_FAILURE;
+    }
+
+    if(Result.MaxFkError > ROC_CHECK_MAX_FK_ERROR)
+    {
+        printf("FAIL: the fk of the ik is more than %.2f mm off the feet\r\n", ROC_CHECK_MAX_FK_ERROR);
+
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,235 @@
+/********************************************************************************
+ * This code is used for robot control
+*********************************************************************************
+ * Author        Data            Version
+ * Liren         2026/10/17      1.0
+********************************************************************************/
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <time.h>
+#include <math.h>
+
+#include "RocRobotDhAlgorithm.h"
+
+
+#define ROC_BENCH_DEFAULT_TICKS         200000U
+
+
+typedef void (*ROC_BENCH_CALCULATE_f)(ROC_ROBOT_SERVO_s *pRobotServo);
+
+typedef struct _ROC_BENCH_CASE_s
+{
+    const char                  *pName;
+    ROC_ROBOT_MOVE_STATUS_e     MoveStatus;
+    ROC_BENCH_CALCULATE_f       Calculate;
+
+}ROC_BENCH_CASE_s;
+
+
+static const ROC_BENCH_CASE_s g_BenchCase[] =
+{
+    {"OpenLoopWalk",    ROC_ROBOT_MOVE_STATUS_FORWALKING,   RocRobotOpenLoopWalkCalculate},
+    {"OpenLoopCircle",  ROC_ROBOT_MOVE_STATUS_CIRCLING,     RocRobotOpenLoopCircleCalculate},
+#ifdef ROC_ROBOT_CLOSED_LOOP_CONTROL
+    {"ClosedLoopWalk",  ROC_ROBOT_MOVE_STATUS_FORWALKING,   RocRobotClosedLoopWalkCalculate},
+#endif
+};
+
+static volatile int16_t g_BenchSink = 0;
+
+
+/*********************************************************************************
+ *  Description:
+ *              Get the host monotonic time in ns
+ *
+ *  Parameter:
+ *              None
+ *
+ *  Return:
+ *              The current time in ns
+ *
+ *  Author:
+ *              ROC LiRen(2026.10.17)
+**********************************************************************************/
+static uint64_t RocBenchTimeNsGet(void)
+{
+    struct timespec Now;
+
+    clock_gettime(CLOCK_MONOTONIC, &Now);
+
+    return (uint64_t)Now.tv_sec * 1000000000ULL + (uint64_t)Now.tv_nsec;
+}
+
+/*********************************************************************************
+ *  Description:
+ *              Run one benchmark case: every tick updates the gait sequence and
+ *              solves the IK of all legs, just like RocRobotMoveCtrlCore does
+ *
+ *  Parameter:
+ *              pCase: the pointer to the benchmark case
+ *              Ticks: the number of control ticks to run
+ *
+ *  Return:
+ *              None
+ *
+ *  Author:
+ *              ROC LiRen(2026.10.17)
+**********************************************************************************/
+static void RocBenchCaseRun(const ROC_BENCH_CASE_s *pCase, uint32_t Ticks)
+{
+    uint32_t                i = 0;
+    uint64_t                StartTime = 0;
+    uint64_t                GaitTime = 0;
+    uint64_t                IkTime = 0;
+    ROC_ROBOT_MOVE_CTRL_s   *pMoveCtrl = NULL;
+
+    RocRobotAlgoCtrlInit();
+    pMoveCtrl = RocRobotCtrlInfoGet();
+
+    RocRobotMoveStatus_Set(pCase->MoveStatus);
+
+    if(ROC_ROBOT_MOVE_STATUS_CIRCLING == pCase->MoveStatus)
+    {
+        RocRobotCtrlDeltaMoveCoorInput(0, 0, 0, ROC_ROBOT_DEFAULT_TURN_ANGLE, ROC_ROBOT_DEFAULT_FEET_LIFT);
+    }
+    else
+    {
+        RocRobotCtrlDeltaMoveCoorInput(0, ROC_ROBOT_DEFAULT_LEG_STEP, 0, 0, ROC_ROBOT_DEFAULT_FEET_LIFT);
+    }
+
+    for(i = 0; i < Ticks; i++)
+    {
+        StartTime = RocBenchTimeNsGet();
+        RocRobotGaitSeqUpdate();
+        GaitTime += RocBenchTimeNsGet() - StartTime;
+
+        StartTime = RocBenchTimeNsGet();
+        pCase->Calculate(&pMoveCtrl->CurServo);
+        IkTime += RocBenchTimeNsGet() - StartTime;
+
+        g_BenchSink += pMoveCtrl->CurServo.RobotLeg[i % ROC_ROBOT_CNT_LEGS].RobotJoint[ROC_ROBOT_LEG_KNEE_JOINT];
+    }
+
+    printf("%-16s ticks: %8u  tick: %9.1f ns  gait: %8.1f ns  ik: %9.1f ns  leg solve: %8.1f ns\r\n",
+            pCase->pName, Ticks,
+            (double)(GaitTime + IkTime) / Ticks,
+            (double)GaitTime / Ticks,
+            (double)IkTime / Ticks,
+            (double)IkTime / ((uint64_t)Ticks * ROC_ROBOT_CNT_LEGS));
+}
+
+/*********************************************************************************
+ *  Description:
+ *              Run the batch IK solver alone, the feet of all legs sweep a small
+ *              circle around the stand position. The batch FK solver and the
+ *              round trip check of the IK result are timed on the same feet.
+ *
+ *  Parameter:
+ *              Ticks: the number of batch solves to run
+ *
+ *  Return:
+ *              None
+ *
+ *  Author:
+ *              ROC LiRen(2026.10.17)
+**********************************************************************************/
+static void RocBenchBatchIkRun(uint32_t Ticks)
+{
+    uint32_t                i = 0;
+    uint8_t                 j = 0;
+    float                   Phase = 0;
+    uint64_t                StartTime = 0;
+    uint64_t                IkTime = 0;
+    uint64_t                FkTime = 0;
+    uint64_t                CheckTime = 0;
+    float                   IkError = 0;
+    float                   PwmError = 0;
+    ROC_ROBOT_FEET_POS_s    FeetPos;
+    ROC_ROBOT_FEET_POS_s    FkFeetPos;
+    ROC_ROBOT_JOINT_ANGLE_s JointAngle;
+    ROC_ROBOT_SERVO_s       RobotServo;
+
+    for(i = 0; i < Ticks; i++)
+    {
+        Phase = (float)(i % 360U) * ROC_ROBOT_ANGLE_TO_RADIAN;
+
+        for(j = 0; j < ROC_ROBOT_CNT_LEGS; j++)
+        {
+            FeetPos.X[j] = ROC_ROBOT_RIG_MID_INIT_X + 20 * cosf(Phase + j);
+            FeetPos.Y[j] = ROC_ROBOT_RIG_MID_INIT_Y + 20 * sinf(Phase + j);
+            FeetPos.Z[j] = ROC_ROBOT_RIG_MID_INIT_Z + 10 * sinf(Phase);
+        }
+
+        StartTime = RocBenchTimeNsGet();
+        RocRobotLegInverseKinematicBatch(&FeetPos, &JointAngle);
+        IkTime += RocBenchTimeNsGet() - StartTime;
+
+        StartTime = RocBenchTimeNsGet();
+        RocRobotLegForwardKinematicBatch(&JointAngle, &FkFeetPos);
+        FkTime += RocBenchTimeNsGet() - StartTime;
+
+        RocRobotJointAngleToPwm(&JointAngle, &RobotServo);
+
+        StartTime = RocBenchTimeNsGet();
+        RocRobotKinematicRoundTripCheck(&FeetPos, &JointAngle, &RobotServo, &IkError, &PwmError);
+        CheckTime += RocBenchTimeNsGet() - StartTime;
+
+        g_BenchSink += (int16_t)JointAngle.Angle[i % ROC_ROBOT_CNT_LEGS][ROC_ROBOT_LEG_KNEE_JOINT];
+        g_BenchSink += (int16_t)(FkFeetPos.Z[i % ROC_ROBOT_CNT_LEGS] + IkError + PwmError);
+    }
+
+    printf("%-16s ticks: %8u  batch: %8.1f ns  leg solve: %8.1f ns\r\n",
+            "LegIkBatch", Ticks,
+            (double)IkTime / Ticks,
+            (double)IkTime / ((uint64_t)Ticks * ROC_ROBOT_CNT_LEGS));
+    printf("%-16s ticks: %8u  batch: %8.1f ns  leg solve: %8.1f ns\r\n",
+            "LegFkBatch", Ticks,
+            (double)FkTime / Ticks,
+            (double)FkTime / ((uint64_t)Ticks * ROC_ROBOT_CNT_LEGS));
+    printf("%-16s ticks: %8u  batch: %8.1f ns  leg solve: %8.1f ns\r\n",
+            "RoundTripCheck", Ticks,
+            (double)CheckTime / Ticks,
+            (double)CheckTime / ((uint64_t)Ticks * ROC_ROBOT_CNT_LEGS));
+}
+
+/*********************************************************************************
+ *  Description:
+ *              Kinematics benchmark entry, usage: RocRobotKinematicsBench [ticks]
+ *
+ *  Parameter:
+ *              argc: the number of the arguments
+ *              argv: the arguments
+ *
+ *  Return:
+ *              The exit status
+ *
+ *  Author:
+ *              ROC LiRen(2026.10.17)
+**********************************************************************************/
+int main(int argc, char *argv[])
+{
+    uint32_t    i = 0;
+    uint32_t    Ticks = ROC_BENCH_DEFAULT_TICKS;
+
+    if(argc > 1)
+    {
+        Ticks = (uint32_t)strtoul(argv[1], NULL, 0);
+    }
+
+    if(0 == Ticks)
+    {
+        printf("Usage: %s [ticks]\r\n", argv[0]);
+
+        return EXIT_FAILURE;
+    }
+
+    for(i = 0; i < sizeof(g_BenchCase) / sizeof(g_BenchCase[0]); i++)
+    {
+        RocBenchCaseRun(&g_BenchCase[i], Ticks);
+    }
+
+    RocBenchBatchIkRun(Ticks);
+
+    return EXIT_SUCCESS;
+}
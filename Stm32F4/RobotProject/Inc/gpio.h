@@ -89,6 +89,10 @@ extern "C" {
 #define ROC_ROBOT_RELAY_PIN                 GPIO_PIN_6
 #define ROC_ROBOT_RELAY_PORT                GPIOC
 
+#define ROC_MPU6050_INT_PIN                 GPIO_PIN_5
+#define ROC_MPU6050_INT_PORT                GPIOC
+#define ROC_MPU6050_INT_IRQN                EXTI9_5_IRQn
+
 /* USER CODE END Includes */
 
 /* USER CODE BEGIN Private defines */
@@ -58,6 +58,13 @@ extern "C" {
     void SysTick_Handler(void);
     void DMA1_Stream1_IRQHandler(void);
     void DMA1_Stream3_IRQHandler(void);
+    void DMA1_Stream2_IRQHandler(void);
+    void DMA1_Stream7_IRQHandler(void);
+    void I2C1_EV_IRQHandler(void);
+    void I2C1_ER_IRQHandler(void);
+    void I2C2_EV_IRQHandler(void);
+    void I2C2_ER_IRQHandler(void);
+    void EXTI9_5_IRQHandler(void);
     void USART2_IRQHandler(void);
     void USART3_IRQHandler(void);
     void TIM6_DAC_IRQHandler(void);
@@ -17,11 +17,16 @@
 #include "RocServo.h"
 #include "RocMotor.h"
 #include "RocBeeper.h"
+#include "RocAt24c02.h"
 #include "RocTftLcd.h"
 #include "RocBattery.h"
 #include "RocPca9685.h"
 #include "RocMpu6050.h"
 #include "RocBluetooth.h"
+#include "RocRobotProfile.h"
+#include "RocRobotSchedule.h"
+#include "RocRobotTransition.h"
+#include "RocRobotStability.h"
 #include "RocRobotControl.h"
 
 
@@ -30,9 +35,34 @@ ROC_ROBOT_CTRL_s g_RobotCtrl =
     {0},
     {0},
     ROC_ROBOT_RUN_MODE_HEXAPOD,
+    ROC_ROBOT_RUN_MODE_HEXAPOD,
     {0},
     NULL
 };
+
+/* The power on poses, one pose per gait tick, then the robot transforms to the car */
+static const ROC_ROBOT_POWER_ON_POSE_s g_RobotPowerOnPose[] =
+{
+    {ROC_ROBOT_DEFAULT_FEET_LIFT,           ROC_ROBOT_CNT_LEGS},
+    {ROC_ROBOT_DEFAULT_FEET_LIFT * 1.8F,    ROC_ROBOT_CNT_LEGS},
+    {ROC_ROBOT_DEFAULT_FEET_LIFT,           ROC_ROBOT_CNT_LEGS},
+    {0,                                     ROC_ROBOT_CNT_LEGS},
+    {0,                                     ROC_ROBOT_RIG_FRO_LEG},
+    {0,                                     ROC_ROBOT_RIG_MID_LEG},
+    {0,                                     ROC_ROBOT_RIG_HIN_LEG},
+    {0,                                     ROC_ROBOT_LEF_FRO_LEG},
+    {0,                                     ROC_ROBOT_LEF_MID_LEG},
+    {0,                                     ROC_ROBOT_LEF_HIN_LEG},
+    {0,                                     ROC_ROBOT_CNT_LEGS},
+    {0,                                     ROC_ROBOT_CNT_LEGS},
+    {ROC_ROBOT_DEFAULT_FEET_LIFT,           ROC_ROBOT_CNT_LEGS},
+};
+
+#define ROC_ROBOT_POWER_ON_POSE_NUM     (sizeof(g_RobotPowerOnPose) / sizeof(g_RobotPowerOnPose[0]))
+
+/* The power on pose step, UINT8_MAX until RocRobotStartRun starts the poses */
+static uint8_t g_RobotPowerOnStep = UINT8_MAX;
+
 /*********************************************************************************
  *  Description:
  *              Robot init success beeper aciton
@@ -155,33 +185,50 @@ static uint8_t RocRobotCtrlFlagGet(uint8_t FlagNum)
 
 /*********************************************************************************
  *  Description:
- *              Get current robot IMU euler angle
+ *              Get current robot IMU attitude quaternion
  *
  *  Parameter:
  *              *ImuDat: the pointer to the robot IMU data structure
  *
  *  Return:
- *              The IMU sensor get status
+ *              RET_OK if a new IMU sample is got
  *
  *  Author:
  *              ROC LiRen(2019.04.15)
 **********************************************************************************/
-static ROC_RESULT RocRobotImuEulerAngleGet(ROC_ROBOT_IMU_DATA_s *ImuDat)
+static ROC_RESULT RocRobotImuQuatGet(ROC_ROBOT_IMU_DATA_s *ImuDat)
 {
     ROC_RESULT Ret = RET_OK;
 
-    Ret = RocMpu6050EulerAngleGet(&ImuDat->Pitch, &ImuDat->Roll, &ImuDat->Yaw);
-    if(RET_OK != Ret)
-    {
-        //ROC_LOGE("Robot get the IMU angle is in error(%d)! Be careful!", Ret); /* For the FIFO overflow problem */
-    }
+    /* The newest packet of the IMU stream, the attitude is kept without a new one */
+    Ret = RocMpu6050QuatGet(ImuDat->Quat);
 
     return Ret;
 }
 
 /*********************************************************************************
  *  Description:
- *              Transmit the robot walk information
+ *              Update the robot IMU euler angle from the quaternion, it is only
+ *              called for the display and the report
+ *
+ *  Parameter:
+ *              *ImuDat: the pointer to the robot IMU data structure
+ *
+ *  Return:
+ *              None
+ *
+ *  Author:
+ *              ROC LiRen(2026.10.17)
+**********************************************************************************/
+static void RocRobotImuEulerAngleUpdate(ROC_ROBOT_IMU_DATA_s *ImuDat)
+{
+    RocMpu6050QuatToEuler(ImuDat->Quat, &ImuDat->Pitch, &ImuDat->Roll, &ImuDat->Yaw);
+}
+
+/*********************************************************************************
+ *  Description:
+ *              Transmit the robot walk information, the IMU angle and the static
+ *              stability margin in mm
  *
  *  Parameter:
  *              *ImuDat: the pointer to the robot IMU data structure
@@ -195,8 +242,13 @@ static ROC_RESULT RocRobotImuEulerAngleGet(ROC_ROBOT_IMU_DATA_s *ImuDat)
 static void RocRemoteWaklInfoTransmit(ROC_ROBOT_IMU_DATA_s *ImuDat)
 {
     uint8_t     i = 0;
+    int16_t     Margin = 0;
     uint8_t     SendBuf[ROC_REMOTE_MAX_NUM_LEN_SEND] = {ROC_NONE};
 
+    Margin = (int16_t)g_RobotCtrl.MoveCtrl->CurState.StabilityMargin;
+
+    RocRobotImuEulerAngleUpdate(ImuDat);
+
     SendBuf[0] = 0x55;
     SendBuf[1] = 0x53;
     SendBuf[2] = (uint8_t)(ImuDat->Roll * 32768 / 180);
@@ -205,8 +257,8 @@ static void RocRemoteWaklInfoTransmit(ROC_ROBOT_IMU_DATA_s *ImuDat)
     SendBuf[5] = (uint8_t)(ImuDat->Pitch * 32768 / 180) >> 8;
     SendBuf[6] = (uint8_t)(ImuDat->Yaw * 32768 / 180);
     SendBuf[7] = (uint8_t)(ImuDat->Yaw * 32768 / 180) >> 8;
-    SendBuf[8] = 0;
-    SendBuf[9] = 0;
+    SendBuf[8] = (uint8_t)Margin;
+    SendBuf[9] = (uint8_t)(Margin >> 8);
 
     for(i = 0; i < ROC_REMOTE_MAX_NUM_LEN_SEND -2; i++)
     {
@@ -240,6 +292,8 @@ static void RocRobotMotionTrackOnLcdDraw(ROC_PHOENIX_STATE_s *pRobotCurstate)
         RocTftLcdAllClear(ROC_TFT_LCD_COLOR_DEFAULT_BAK);
     }
 
+    RocRobotImuEulerAngleUpdate(&pRobotCurstate->CurImuAngle);
+
     RocTftLcdDrawPoint(DrawXCor, (uint16_t)(pRobotCurstate->CurImuAngle.Yaw + 100), ROC_TFT_LCD_COLOR_DEFAULT_FOR);
 
     DrawXCor++;
@@ -334,6 +388,59 @@ static uint8_t RocRobotJoystickAdcGet(uint16_t* JoysticAdcDat)
     }
 }
 
+/*********************************************************************************
+ *  Description:
+ *              Set the gait speed by the joystick magnitude, the speed changes
+ *              continuously from ROC_ROBOT_RUN_SPEED_SLOW in the center to
+ *              ROC_ROBOT_RUN_SPEED_FAST at the edge
+ *
+ *  Parameter:
+ *              pJoystickAdc: the pointer to the joystick adc channel value
+ *
+ *  Return:
+ *              None
+ *
+ *  Author:
+ *              ROC LiRen(2026.10.17)
+**********************************************************************************/
+static void RocRobotJoystickSpeedUpdate(uint16_t *pJoystickAdc)
+{
+    int32_t Magnitude = 0;
+    int32_t Delta = 0;
+    int32_t Range = ROC_ROBOT_JOYSTICK_ADC_CENTER - ROC_ROBOT_JOYSTICK_ADC_DEAD_ZONE;
+    int32_t SlowSpeed = (int32_t)ROC_ROBOT_RUN_SPEED_SLOW;
+    int32_t FastSpeed = (int32_t)ROC_ROBOT_RUN_SPEED_FAST;
+
+    Magnitude = (int32_t)pJoystickAdc[ROC_ROBOT_JOYSTICK_SPEED_ADC_X] - ROC_ROBOT_JOYSTICK_ADC_CENTER;
+    if(Magnitude < 0)
+    {
+        Magnitude = -Magnitude;
+    }
+
+    Delta = (int32_t)pJoystickAdc[ROC_ROBOT_JOYSTICK_SPEED_ADC_Y] - ROC_ROBOT_JOYSTICK_ADC_CENTER;
+    if(Delta < 0)
+    {
+        Delta = -Delta;
+    }
+
+    if(Delta > Magnitude)
+    {
+        Magnitude = Delta;
+    }
+
+    Magnitude = Magnitude - ROC_ROBOT_JOYSTICK_ADC_DEAD_ZONE;
+    if(Magnitude < 0)
+    {
+        Magnitude = 0;
+    }
+    else if(Magnitude > Range)
+    {
+        Magnitude = Range;
+    }
+
+    g_RobotCtrl.MoveCtrl->CurGait.NomGaitSpeed = (uint16_t)(SlowSpeed - (SlowSpeed - FastSpeed) * Magnitude / Range);
+}
+
 /*********************************************************************************
  *  Description:
  *              Input cmd to let robot standing
@@ -734,32 +841,6 @@ static ROC_RESULT RocRobotCtrlCmdIsChanged(void)
     }
 }
 
-/*********************************************************************************
- *  Description:
- *              Switch the move context to forbid mutation action
- *
- *  Parameter:
- *              None
- *
- *  Return:
- *              None
- *
- *  Author:
- *              ROC LiRen(2019.04.06)
-**********************************************************************************/
-static void RocRobotMoveContextSwitch(ROC_ROBOT_MOVE_CTRL_s *pRobotCtrl)
-{
-    uint8_t i = 0;
-
-    for(i = 0; i < ROC_ROBOT_CNT_LEGS; i++)
-    {
-        pRobotCtrl->CurState.LegCurPos[i].X = pRobotCtrl->CurState.TravelLength.X / 2;
-        pRobotCtrl->CurState.LegCurPos[i].Y = pRobotCtrl->CurState.TravelLength.Y / 2;
-        pRobotCtrl->CurState.LegCurPos[i].Z = pRobotCtrl->CurState.TravelLength.Z / 2;
-        pRobotCtrl->CurState.LegCurPos[i].A = pRobotCtrl->CurState.TravelLength.A / 2;
-    }
-}
-
 #if 0
 /*********************************************************************************
  *  Description:
@@ -860,6 +941,77 @@ static void RocRobotBodyRotateTest(void)
 }
 #endif
 
+/*********************************************************************************
+ *  Description:
+ *              Start the robot transform between the car and the legged mode,
+ *              the feet and the ankles move in ROC_ROBOT_CTRL_TRANSFORM_TICK gait
+ *              ticks while the control goes on, the run mode changes when the
+ *              transform is finished
+ *
+ *  Parameter:
+ *              RunMode: the run mode to transform to
+ *
+ *  Return:
+ *              None
+ *
+ *  Author:
+ *              ROC LiRen(2026.10.17)
+**********************************************************************************/
+static void RocRobotTransformStart(ROC_ROBOT_RUN_MODE_e RunMode)
+{
+    if((g_RobotCtrl.TransformMode != g_RobotCtrl.RunMode) || (RunMode == g_RobotCtrl.RunMode))
+    {
+        return;
+    }
+
+    g_RobotCtrl.TransformMode = RunMode;
+
+    /* All the legs follow the remote input in the power on status */
+    RocRobotMoveStatus_Set(ROC_ROBOT_MOVE_STATUS_POWER_ON);
+    RocRobotSingleLegSelect(ROC_ROBOT_CNT_LEGS);
+
+    g_RobotCtrl.RemoteCtrl.X = 0;
+    g_RobotCtrl.RemoteCtrl.Y = 0;
+    g_RobotCtrl.RemoteCtrl.Z = (ROC_ROBOT_RUN_MODE_CAR == RunMode) ? (ROC_ROBOT_DEFAULT_FEET_LIFT * ROC_ROBOT_CTRL_TRANSFORM_STEP) : 0;
+    g_RobotCtrl.RemoteCtrl.A = 0;
+    g_RobotCtrl.RemoteCtrl.H = 0;
+
+    RocRobotTransitionCarStart((ROC_ROBOT_RUN_MODE_CAR == RunMode) ? ROC_TRUE : ROC_FALSE, ROC_ROBOT_CTRL_TRANSFORM_TICK);
+}
+
+/*********************************************************************************
+ *  Description:
+ *              Change the run mode when the transform is finished, the car stays
+ *              in the transform status with the wheels down
+ *
+ *  Parameter:
+ *              None
+ *
+ *  Return:
+ *              None
+ *
+ *  Author:
+ *              ROC LiRen(2026.10.17)
+**********************************************************************************/
+static void RocRobotTransformCheck(void)
+{
+    if((g_RobotCtrl.TransformMode == g_RobotCtrl.RunMode) || (ROC_TRUE == RocRobotTransitionIsBusy()))
+    {
+        return;
+    }
+
+    RocRobotRunModeSet(g_RobotCtrl.TransformMode);
+
+    if(ROC_ROBOT_RUN_MODE_CAR == g_RobotCtrl.TransformMode)
+    {
+        RocRobotMoveStatus_Set(ROC_ROBOT_MOVE_STATUS_TRANSFORM);
+    }
+    else
+    {
+        RocRobotMoveStatus_Set(ROC_ROBOT_MOVE_STATUS_STANDING);
+    }
+}
+
 /*********************************************************************************
  *  Description:
  *              Robot move core
@@ -897,10 +1049,11 @@ static void RocRobotMoveCtrlCore(ROC_ROBOT_MOVE_CTRL_s *pRobotCtrl)
         case ROC_ROBOT_MOVE_STATUS_FORWALKING:
         case ROC_ROBOT_MOVE_STATUS_BAKWALKING:
         {
+            /* The feet are blended to the new command without going home */
             ChangeStatus = RocRobotCtrlCmdIsChanged();
             if(ROC_TRUE == ChangeStatus)
             {
-               RocRobotMoveContextSwitch(pRobotCtrl);
+               RocRobotTransitionStart();
             }
 
             RocRobotGaitSeqUpdate();
@@ -920,10 +1073,11 @@ static void RocRobotMoveCtrlCore(ROC_ROBOT_MOVE_CTRL_s *pRobotCtrl)
 
         case ROC_ROBOT_MOVE_STATUS_CIRCLING:
         {
+            /* The feet are blended to the new command without going home */
             ChangeStatus = RocRobotCtrlCmdIsChanged();
             if(ROC_TRUE == ChangeStatus)
             {
-               RocRobotMoveContextSwitch(pRobotCtrl);
+               RocRobotTransitionStart();
             }
 
             RocRobotGaitSeqUpdate();
@@ -939,12 +1093,19 @@ static void RocRobotMoveCtrlCore(ROC_ROBOT_MOVE_CTRL_s *pRobotCtrl)
         }
     }
 
-    //RocServoSpeedSet(g_RobotCtrl.MoveCtrl->CurGait.NomGaitSpeed);
+    RocRobotTransformCheck();
+
+    /* The new speed starts from the next servo step without stopping the timer,
+       the stability monitor slows it down when the margin is low */
+    RocServoSpeedSet(RocRobotStabilityGaitSpeedGet(g_RobotCtrl.MoveCtrl->CurGait.NomGaitSpeed));
 }
 
 /*********************************************************************************
  *  Description:
- *              Robot run special gait sequence when power on
+ *              Run the power on poses, one pose is taken on every gait release
+ *              and the gait task moves to it. After the last pose the robot
+ *              transforms to the car. It runs in the timer interrupt and never
+ *              waits.
  *
  *  Parameter:
  *              None
@@ -957,73 +1118,106 @@ static void RocRobotMoveCtrlCore(ROC_ROBOT_MOVE_CTRL_s *pRobotCtrl)
 **********************************************************************************/
 static void RocRobotPowerOnGaitSeq_Run(void)
 {
-    uint8_t i = 0;
+    const ROC_ROBOT_POWER_ON_POSE_s *pPose = NULL;
 
-    ROC_ROBOT_LEG_e SelectNum = ROC_ROBOT_CNT_LEGS;
+    if((ROC_ROBOT_POWER_ON_POSE_NUM < g_RobotPowerOnStep) || (ROC_TRUE != RocRobotScheduleGaitIsReleased()))
+    {
+        return;
+    }
 
-    g_RobotCtrl.RemoteCtrl.X = 0;
-    g_RobotCtrl.RemoteCtrl.Y = 0;
-    g_RobotCtrl.RemoteCtrl.Z = ROC_ROBOT_DEFAULT_FEET_LIFT;
-    g_RobotCtrl.RemoteCtrl.A = 0;
-    g_RobotCtrl.RemoteCtrl.H = 0;
-    HAL_Delay(ROC_ROBOT_RUN_SPEED_POWER_ON);
+    if(ROC_ROBOT_POWER_ON_POSE_NUM > g_RobotPowerOnStep)
+    {
+        pPose = &g_RobotPowerOnPose[g_RobotPowerOnStep];
 
-    g_RobotCtrl.RemoteCtrl.X = 0;
-    g_RobotCtrl.RemoteCtrl.Y = 0;
-    g_RobotCtrl.RemoteCtrl.Z = ROC_ROBOT_DEFAULT_FEET_LIFT * 1.8;
-    g_RobotCtrl.RemoteCtrl.A = 0;
-    g_RobotCtrl.RemoteCtrl.H = 0;
-    HAL_Delay(ROC_ROBOT_RUN_SPEED_POWER_ON);
+        g_RobotCtrl.RemoteCtrl.X = 0;
+        g_RobotCtrl.RemoteCtrl.Y = 0;
+        g_RobotCtrl.RemoteCtrl.Z = pPose->FeetLift;
+        g_RobotCtrl.RemoteCtrl.A = 0;
+        g_RobotCtrl.RemoteCtrl.H = 0;
 
-    g_RobotCtrl.RemoteCtrl.X = 0;
-    g_RobotCtrl.RemoteCtrl.Y = 0;
-    g_RobotCtrl.RemoteCtrl.Z = ROC_ROBOT_DEFAULT_FEET_LIFT;
-    g_RobotCtrl.RemoteCtrl.A = 0;
-    g_RobotCtrl.RemoteCtrl.H = 0;
-    HAL_Delay(ROC_ROBOT_RUN_SPEED_POWER_ON);
+        RocRobotSingleLegSelect(pPose->SelectLeg);
+    }
+    else
+    {
+        g_RobotCtrl.MoveCtrl->CurGait.NomGaitSpeed = ROC_ROBOT_RUN_SPEED_DEFAULT;
 
-    g_RobotCtrl.RemoteCtrl.X = 0;
-    g_RobotCtrl.RemoteCtrl.Y = 0;
-    g_RobotCtrl.RemoteCtrl.Z = 0;
-    g_RobotCtrl.RemoteCtrl.A = 0;
-    g_RobotCtrl.RemoteCtrl.H = 0;
-    HAL_Delay(ROC_ROBOT_RUN_SPEED_POWER_ON);
+        RocRobotTransformStart(ROC_ROBOT_RUN_MODE_CAR);
+    }
+
+    g_RobotPowerOnStep++;
+}
+
+/*********************************************************************************
+ *  Description:
+ *              Robot control init
+ *
+ *  Parameter:
+ *              None
+ *
+ *  Return:
+ *              None
+ *
+ *  Author:
+ *              ROC LiRen(2018.12.16)
+**********************************************************************************/
+static ROC_RESULT RocRobotControlInit(void)
+{
+    ROC_RESULT Ret = RET_OK;
+
+    g_RobotCtrl.MoveCtrl = RocRobotCtrlInfoGet();
 
-    for(SelectNum = ROC_ROBOT_RIG_FRO_LEG; SelectNum < ROC_ROBOT_CNT_LEGS; SelectNum++)
+    RocRobotOpenLoopWalkCalculate(&g_RobotCtrl.MoveCtrl->CurServo);
+
+    Ret = RocServoInit((int16_t *)(&g_RobotCtrl.MoveCtrl->CurServo));
+    if(RET_OK != Ret)
     {
-        RocRobotSingleLegSelect(SelectNum);
-        HAL_Delay(ROC_ROBOT_RUN_SPEED_POWER_ON);
-    }
+        ROC_LOGE("Robot hardware is in error, the system will not run!");
 
-    RocRobotSingleLegSelect(ROC_ROBOT_CNT_LEGS);
-    HAL_Delay(ROC_ROBOT_RUN_SPEED_POWER_ON);
+        return Ret;
+    }
 
-    for(i = 0; i < (ROC_ROBOT_CTRL_TRANSFORM_STEP + 1); i++)
+    Ret = RocRobotScheduleInit(RocServoStepNumGet(), ROC_ROBOT_SCHEDULE_GAIT_PHASE);
+    if(RET_OK != Ret)
     {
-        g_RobotCtrl.RemoteCtrl.X = 0;
-        g_RobotCtrl.RemoteCtrl.Y = 0;
-        g_RobotCtrl.RemoteCtrl.Z = ROC_ROBOT_DEFAULT_FEET_LIFT * i;
-        g_RobotCtrl.RemoteCtrl.A = 0;
-        g_RobotCtrl.RemoteCtrl.H = 0;
-        HAL_Delay(ROC_ROBOT_RUN_SPEED_POWER_ON);
+        ROC_LOGE("Robot schedule is in error, the system will not run!");
     }
 
-    RocRobotMoveStatus_Set(ROC_ROBOT_MOVE_STATUS_TRANSFORM);
+    return Ret;
+}
 
-    g_RobotCtrl.MoveCtrl->CurServo.RobotLeg[ROC_ROBOT_RIG_FRO_LEG].RobotJoint[ROC_ROBOT_LEG_ANKLE_JOINT] -= ROC_ROBOT_CTRL_LEG_LEFT_STEP;
-    g_RobotCtrl.MoveCtrl->CurServo.RobotLeg[ROC_ROBOT_RIG_MID_LEG].RobotJoint[ROC_ROBOT_LEG_ANKLE_JOINT] -= ROC_ROBOT_CTRL_LEG_LEFT_STEP;
-    g_RobotCtrl.MoveCtrl->CurServo.RobotLeg[ROC_ROBOT_RIG_HIN_LEG].RobotJoint[ROC_ROBOT_LEG_ANKLE_JOINT] -= ROC_ROBOT_CTRL_LEG_LEFT_STEP;
-    g_RobotCtrl.MoveCtrl->CurServo.RobotLeg[ROC_ROBOT_LEF_FRO_LEG].RobotJoint[ROC_ROBOT_LEG_ANKLE_JOINT] += ROC_ROBOT_CTRL_LEG_LEFT_STEP;
-    g_RobotCtrl.MoveCtrl->CurServo.RobotLeg[ROC_ROBOT_LEF_MID_LEG].RobotJoint[ROC_ROBOT_LEG_ANKLE_JOINT] += ROC_ROBOT_CTRL_LEG_LEFT_STEP;
-    g_RobotCtrl.MoveCtrl->CurServo.RobotLeg[ROC_ROBOT_LEF_HIN_LEG].RobotJoint[ROC_ROBOT_LEG_ANKLE_JOINT] += ROC_ROBOT_CTRL_LEG_LEFT_STEP;
-    HAL_Delay(ROC_ROBOT_RUN_SPEED_POWER_ON);
+/*********************************************************************************
+ *  Description:
+ *              Robot start running
+ *
+ *  Parameter:
+ *              None
+ *
+ *  Return:
+ *              None
+ *
+ *  Author:
+ *              ROC LiRen(2018.12.16)
+**********************************************************************************/
+static ROC_RESULT RocRobotStartRun(void)
+{
+    ROC_RESULT Ret = RET_OK;
+
+    RocRobotRunModeSet(ROC_ROBOT_RUN_MODE_HEXAPOD);
+
+    RocRobotSingleLegSelect(ROC_ROBOT_CNT_LEGS);
 
-    RocRobotRunModeSet(ROC_ROBOT_RUN_MODE_CAR);
+    g_RobotCtrl.MoveCtrl->CurGait.NomGaitSpeed = ROC_ROBOT_RUN_SPEED_POWER_ON;
+    RocServoSpeedSet(g_RobotCtrl.MoveCtrl->CurGait.NomGaitSpeed);
+
+    /* The power on poses run in the servo timer, the default speed is set by them */
+    g_RobotPowerOnStep = 0;
+
+    return Ret;
 }
 
 /*********************************************************************************
  *  Description:
- *              Robot transform from car mode to hexapod mode
+ *              Robot start running
  *
  *  Parameter:
  *              None
@@ -1032,158 +1226,315 @@ static void RocRobotPowerOnGaitSeq_Run(void)
  *              None
  *
  *  Author:
- *              ROC LiRen(2019.04.06)
+ *              ROC LiRen(2018.12.16)
 **********************************************************************************/
-static void RocRobotCarTransformRun(void)
+static ROC_RESULT RocRobotStopRun(void)
 {
-    static uint8_t Index = 0;
+    ROC_RESULT Ret = RET_OK;
 
-    if(ROC_TRUE == RocServoTurnIsFinshed())
+    RocServoOutputDisable();
+
+    RocServoSpeedSet(0);
+
+    Ret = RocServoTimerStop();
+    if(RET_OK != Ret)
     {
-        RocRobotMoveStatus_Set(ROC_ROBOT_MOVE_STATUS_POWER_ON);
+        ROC_LOGE("Robot stop servo motor in error!");
+    }
 
-        g_RobotCtrl.RemoteCtrl.X = 0;
-        g_RobotCtrl.RemoteCtrl.Y = 0;
-        g_RobotCtrl.RemoteCtrl.Z = (ROC_ROBOT_CTRL_TRANSFORM_STEP * ROC_ROBOT_CTRL_TRANSFORM_DELAY - Index)
-                                    * ROC_ROBOT_DEFAULT_FEET_LIFT / ROC_ROBOT_CTRL_TRANSFORM_DELAY;
-        g_RobotCtrl.RemoteCtrl.A = 0;
-        g_RobotCtrl.RemoteCtrl.H = 0;
+    return Ret;
+}
+/*********************************************************************************
+ *  Description:
+ *              Transmit the profile statistics of one scope to the remote, every
+ *              frame is: header, ROC_REMOTE_PROFILE_HEADER, scope, frame index,
+ *              two little endian uint32 values.
+ *              Frame 0: count, mean ns. Frame 1: min ns, max ns.
+ *              Frame 2 to 9: two histogram bins per frame.
+ *
+ *  Parameter:
+ *              Scope: the profile scope
+ *
+ *  Return:
+ *              None
+ *
+ *  Author:
+ *              ROC LiRen(2026.10.17)
+**********************************************************************************/
+static void RocRobotProfileScopeTransmit(ROC_ROBOT_PROFILE_SCOPE_e Scope)
+{
+    uint8_t                     i = 0;
+    uint8_t                     j = 0;
+    uint32_t                    Value[2] = {0};
+    uint8_t                     SendBuf[ROC_REMOTE_MAX_NUM_LEN_SEND] = {ROC_NONE};
+    ROC_ROBOT_PROFILE_STAT_s    Stat;
+
+    if(RET_OK != RocRobotProfileStatGet(Scope, &Stat))
+    {
+        return;
+    }
 
-        if(Index == ROC_ROBOT_CTRL_TRANSFORM_STEP * ROC_ROBOT_CTRL_TRANSFORM_DELAY)
+    for(i = 0; i < ROC_ROBOT_PROFILE_FRAME_NUM; i++)
+    {
+        if(0 == i)
         {
-            RocRobotRunModeSet(ROC_ROBOT_RUN_MODE_HEXAPOD);
-            RocRobotMoveStatus_Set(ROC_ROBOT_MOVE_STATUS_STANDING);
+            Value[0] = Stat.Count;
+            Value[1] = Stat.MeanNs;
         }
-
-        if(Index == ROC_ROBOT_CTRL_TRANSFORM_STEP * ROC_ROBOT_CTRL_TRANSFORM_DELAY)
+        else if(1 == i)
         {
-            Index = 0;
+            Value[0] = Stat.MinNs;
+            Value[1] = Stat.MaxNs;
         }
         else
         {
-            Index++;
+            Value[0] = Stat.Hist[2 * (i - 2)];
+            Value[1] = Stat.Hist[2 * (i - 2) + 1];
         }
+
+        SendBuf[0] = ROC_JOYSTICK_FRAME_HEADER;
+        SendBuf[1] = ROC_REMOTE_PROFILE_HEADER;
+        SendBuf[2] = (uint8_t)Scope;
+        SendBuf[3] = i;
+
+        for(j = 0; j < 4; j++)
+        {
+            SendBuf[4 + j] = (uint8_t)(Value[0] >> (8 * j));
+            SendBuf[8 + j] = (uint8_t)(Value[1] >> (8 * j));
+        }
+
+        RocRemoteDataTransmit(SendBuf, ROC_REMOTE_MAX_NUM_LEN_SEND);
     }
 }
 
 /*********************************************************************************
  *  Description:
- *              Robot transform from hexapod mode to car mode
+ *              Transmit the schedule statistics of one task to the remote, the
+ *              frame is the same as the profile scope frame, and the scope is
+ *              ROC_ROBOT_PROFILE_SCHED_SCOPE + task.
+ *              Frame 0: run, miss. Frame 1: min latency ns, max latency ns.
+ *              Frame 2: mean latency ns, jitter ns.
  *
  *  Parameter:
- *              None
+ *              Task: the schedule task
  *
  *  Return:
  *              None
  *
  *  Author:
- *              ROC LiRen(2019.07.24)
+ *              ROC LiRen(2026.10.17)
 **********************************************************************************/
-static void RocRobotHexapodTransformRun(void)
+static void RocRobotScheduleTaskTransmit(ROC_ROBOT_SCHEDULE_TASK_e Task)
 {
-    static uint8_t Index = 0;
+    uint8_t                     i = 0;
+    uint8_t                     j = 0;
+    uint32_t                    Value[2 * ROC_ROBOT_PROFILE_SCHED_FRAME_NUM] = {0};
+    uint8_t                     SendBuf[ROC_REMOTE_MAX_NUM_LEN_SEND] = {ROC_NONE};
+    ROC_ROBOT_SCHEDULE_STAT_s   Stat;
+
+    if(RET_OK != RocRobotScheduleStatGet(Task, &Stat))
+    {
+        return;
+    }
+
+    Value[0] = Stat.RunNum;
+    Value[1] = Stat.MissNum;
+    Value[2] = Stat.LatencyMinNs;
+    Value[3] = Stat.LatencyMaxNs;
+    Value[4] = Stat.LatencyMeanNs;
+    Value[5] = Stat.JitterNs;
 
-    if(ROC_TRUE == RocServoTurnIsFinshed())
+    for(i = 0; i < ROC_ROBOT_PROFILE_SCHED_FRAME_NUM; i++)
     {
-        RocRobotMoveStatus_Set(ROC_ROBOT_MOVE_STATUS_POWER_ON);
+        SendBuf[0] = ROC_JOYSTICK_FRAME_HEADER;
+        SendBuf[1] = ROC_REMOTE_PROFILE_HEADER;
+        SendBuf[2] = (uint8_t)(ROC_ROBOT_PROFILE_SCHED_SCOPE + Task);
+        SendBuf[3] = i;
 
-        if(ROC_ROBOT_CTRL_TRANSFORM_STEP * ROC_ROBOT_CTRL_TRANSFORM_DELAY >= Index)
+        for(j = 0; j < 4; j++)
         {
-            g_RobotCtrl.RemoteCtrl.X = 0;
-            g_RobotCtrl.RemoteCtrl.Y = 0;
-            g_RobotCtrl.RemoteCtrl.Z = ROC_ROBOT_DEFAULT_FEET_LIFT * Index / ROC_ROBOT_CTRL_TRANSFORM_DELAY;
-            g_RobotCtrl.RemoteCtrl.A = 0;
-            g_RobotCtrl.RemoteCtrl.H = 0;
+            SendBuf[4 + j] = (uint8_t)(Value[2 * i] >> (8 * j));
+            SendBuf[8 + j] = (uint8_t)(Value[2 * i + 1] >> (8 * j));
         }
-        else if((ROC_ROBOT_CTRL_TRANSFORM_STEP + 1) * ROC_ROBOT_CTRL_TRANSFORM_DELAY == Index)
-        {
-            RocRobotRunModeSet(ROC_ROBOT_RUN_MODE_CAR);
-            RocRobotMoveStatus_Set(ROC_ROBOT_MOVE_STATUS_TRANSFORM);
 
-            g_RobotCtrl.MoveCtrl->CurServo.RobotLeg[ROC_ROBOT_RIG_FRO_LEG].RobotJoint[ROC_ROBOT_LEG_ANKLE_JOINT] -= ROC_ROBOT_CTRL_LEG_LEFT_STEP;
-            g_RobotCtrl.MoveCtrl->CurServo.RobotLeg[ROC_ROBOT_RIG_MID_LEG].RobotJoint[ROC_ROBOT_LEG_ANKLE_JOINT] -= ROC_ROBOT_CTRL_LEG_LEFT_STEP;
-            g_RobotCtrl.MoveCtrl->CurServo.RobotLeg[ROC_ROBOT_RIG_HIN_LEG].RobotJoint[ROC_ROBOT_LEG_ANKLE_JOINT] -= ROC_ROBOT_CTRL_LEG_LEFT_STEP;
-            g_RobotCtrl.MoveCtrl->CurServo.RobotLeg[ROC_ROBOT_LEF_FRO_LEG].RobotJoint[ROC_ROBOT_LEG_ANKLE_JOINT] += ROC_ROBOT_CTRL_LEG_LEFT_STEP;
-            g_RobotCtrl.MoveCtrl->CurServo.RobotLeg[ROC_ROBOT_LEF_MID_LEG].RobotJoint[ROC_ROBOT_LEG_ANKLE_JOINT] += ROC_ROBOT_CTRL_LEG_LEFT_STEP;
-            g_RobotCtrl.MoveCtrl->CurServo.RobotLeg[ROC_ROBOT_LEF_HIN_LEG].RobotJoint[ROC_ROBOT_LEG_ANKLE_JOINT] += ROC_ROBOT_CTRL_LEG_LEFT_STEP;
-        }
+        RocRemoteDataTransmit(SendBuf, ROC_REMOTE_MAX_NUM_LEN_SEND);
+    }
+}
 
-        if(Index == (ROC_ROBOT_CTRL_TRANSFORM_STEP + 1) * ROC_ROBOT_CTRL_TRANSFORM_DELAY)
+/*********************************************************************************
+ *  Description:
+ *              Handle the profile query from the remote UART, the query frame is:
+ *              header, ROC_REMOTE_PROFILE_HEADER, scope, command.
+ *              The scope ROC_ROBOT_PROFILE_ALL_SCOPE queries all the scopes and
+ *              the schedule tasks, the reset command resets both.
+ *
+ *  Parameter:
+ *              pRemoteData: the pointer to the received frame
+ *
+ *  Return:
+ *              None
+ *
+ *  Author:
+ *              ROC LiRen(2026.10.17)
+**********************************************************************************/
+static void RocRobotProfileQueryHandle(uint8_t *pRemoteData)
+{
+    uint8_t Scope = 0;
+
+    if(ROC_ROBOT_PROFILE_CMD_RESET == pRemoteData[3])
+    {
+        RocRobotProfileReset();
+        RocRobotScheduleReset();
+    }
+    else if(ROC_ROBOT_PROFILE_ALL_SCOPE == pRemoteData[2])
+    {
+        for(Scope = 0; Scope < ROC_ROBOT_PROFILE_SCOPE_NUM; Scope++)
         {
-            Index = 0;
+            RocRobotProfileScopeTransmit((ROC_ROBOT_PROFILE_SCOPE_e)Scope);
         }
-        else
+
+        for(Scope = 0; Scope < ROC_ROBOT_SCHEDULE_TASK_NUM; Scope++)
         {
-            Index++;
+            RocRobotScheduleTaskTransmit((ROC_ROBOT_SCHEDULE_TASK_e)Scope);
         }
     }
+    else if(ROC_ROBOT_PROFILE_SCHED_SCOPE <= pRemoteData[2])
+    {
+        RocRobotScheduleTaskTransmit((ROC_ROBOT_SCHEDULE_TASK_e)(pRemoteData[2] - ROC_ROBOT_PROFILE_SCHED_SCOPE));
+    }
+    else
+    {
+        RocRobotProfileScopeTransmit((ROC_ROBOT_PROFILE_SCOPE_e)pRemoteData[2]);
+    }
 }
 
 /*********************************************************************************
  *  Description:
- *              Robot control init
+ *              Answer the gait command to the remote, the answer frame is:
+ *              header, ROC_REMOTE_GAIT_HEADER, command | ROC_ROBOT_GAIT_CMD_ACK,
+ *              result, gait type
  *
  *  Parameter:
- *              None
+ *              Cmd:      the gait command
+ *              Ret:      the command result
+ *              GaitType: the gait type
  *
  *  Return:
  *              None
  *
  *  Author:
- *              ROC LiRen(2018.12.16)
+ *              ROC LiRen(2026.10.17)
 **********************************************************************************/
-static ROC_RESULT RocRobotControlInit(void)
+static void RocRobotGaitDescAckTransmit(uint8_t Cmd, ROC_RESULT Ret, uint8_t GaitType)
 {
-    ROC_RESULT Ret = RET_OK;
-
-    g_RobotCtrl.MoveCtrl = RocRobotCtrlInfoGet();
-
-    RocRobotOpenLoopWalkCalculate(&g_RobotCtrl.MoveCtrl->CurServo);
+    uint8_t SendBuf[ROC_REMOTE_MAX_NUM_LEN_SEND] = {ROC_NONE};
 
-    Ret = RocServoInit((int16_t *)(&g_RobotCtrl.MoveCtrl->CurServo));
-    if(RET_OK != Ret)
-    {
-        ROC_LOGE("Robot hardware is in error, the system will not run!");
-    }
+    SendBuf[0] = ROC_JOYSTICK_FRAME_HEADER;
+    SendBuf[1] = ROC_REMOTE_GAIT_HEADER;
+    SendBuf[2] = Cmd | ROC_ROBOT_GAIT_CMD_ACK;
+    SendBuf[3] = (RET_OK == Ret) ? ROC_FALSE : ROC_TRUE;
+    SendBuf[4] = GaitType;
 
-    return Ret;
+    RocRemoteDataTransmit(SendBuf, ROC_REMOTE_MAX_NUM_LEN_SEND);
 }
 
 /*********************************************************************************
  *  Description:
- *              Robot start running
+ *              Handle the gait descriptor command from the remote UART, the frame
+ *              is: header, ROC_REMOTE_GAIT_HEADER, command, index, 8 data bytes.
+ *              Write: the index is the descriptor part from 0, the descriptor
+ *              is validated, used and stored after the last part.
+ *              Read: the index is the gait type, the descriptor of the working
+ *              gait is sent in the same parts as the write.
+ *              Erase: the index is the gait type or ROC_ROBOT_GAIT_DESC_ALL_GAIT,
+ *              the default gait is restored.
  *
  *  Parameter:
- *              None
+ *              pRemoteData: the pointer to the received frame
  *
  *  Return:
  *              None
  *
  *  Author:
- *              ROC LiRen(2018.12.16)
+ *              ROC LiRen(2026.10.17)
 **********************************************************************************/
-static ROC_RESULT RocRobotStartRun(void)
+static void RocRobotGaitDescCmdHandle(uint8_t *pRemoteData)
 {
-    ROC_RESULT Ret = RET_OK;
+    uint8_t                     i = 0;
+    uint8_t                     Cmd = pRemoteData[2];
+    uint8_t                     Index = pRemoteData[3];
+    uint8_t                     SendBuf[ROC_REMOTE_MAX_NUM_LEN_SEND] = {ROC_NONE};
+    ROC_RESULT                  Ret = RET_OK;
+    ROC_PHOENIX_GAIT_s          Gait;
+    static uint8_t              Desc[ROC_ROBOT_GAIT_DESC_LEN];
+    static uint8_t              DescPart = 0;
+
+    if(ROC_ROBOT_GAIT_CMD_WRITE == Cmd)
+    {
+        /* The first part restarts the descriptor */
+        if(0 == Index)
+        {
+            DescPart = 0;
+        }
 
-    RocRobotRunModeSet(ROC_ROBOT_RUN_MODE_HEXAPOD);
+        if(DescPart != Index)
+        {
+            DescPart = 0;
 
-    RocRobotSingleLegSelect(ROC_ROBOT_CNT_LEGS);
+            RocRobotGaitDescAckTransmit(Cmd, RET_ERROR, ROC_ROBOT_GAIT_DESC_ALL_GAIT);
 
-    g_RobotCtrl.MoveCtrl->CurGait.NomGaitSpeed = ROC_ROBOT_RUN_SPEED_POWER_ON;
-    RocServoSpeedSet(g_RobotCtrl.MoveCtrl->CurGait.NomGaitSpeed);
+            return;
+        }
 
-    RocRobotPowerOnGaitSeq_Run();
+        memcpy(&Desc[Index * ROC_ROBOT_GAIT_FRAME_DATA_LEN], &pRemoteData[4], ROC_ROBOT_GAIT_FRAME_DATA_LEN);
 
-    g_RobotCtrl.MoveCtrl->CurGait.NomGaitSpeed = ROC_ROBOT_RUN_SPEED_DEFAULT;
-    RocServoSpeedSet(g_RobotCtrl.MoveCtrl->CurGait.NomGaitSpeed);
+        DescPart++;
 
-    return Ret;
+        if(ROC_ROBOT_GAIT_FRAME_NUM == DescPart)
+        {
+            DescPart = 0;
+
+            Ret = RocRobotGaitDescSave(Desc);
+
+            RocRobotGaitDescAckTransmit(Cmd, Ret, Desc[ROC_ROBOT_GAIT_DESC_TYPE_BYTE]);
+        }
+    }
+    else if(ROC_ROBOT_GAIT_CMD_READ == Cmd)
+    {
+        Ret = RocRobotGaitTableGet((ROC_ROBOT_GAIT_TYPE_e)Index, &Gait);
+        if(RET_OK != Ret)
+        {
+            RocRobotGaitDescAckTransmit(Cmd, Ret, Index);
+
+            return;
+        }
+
+        RocRobotGaitDescEncode((ROC_ROBOT_GAIT_TYPE_e)Index, &Gait, Desc);
+
+        for(i = 0; i < ROC_ROBOT_GAIT_FRAME_NUM; i++)
+        {
+            SendBuf[0] = ROC_JOYSTICK_FRAME_HEADER;
+            SendBuf[1] = ROC_REMOTE_GAIT_HEADER;
+            SendBuf[2] = Cmd;
+            SendBuf[3] = i;
+
+            memcpy(&SendBuf[4], &Desc[i * ROC_ROBOT_GAIT_FRAME_DATA_LEN], ROC_ROBOT_GAIT_FRAME_DATA_LEN);
+
+            RocRemoteDataTransmit(SendBuf, ROC_REMOTE_MAX_NUM_LEN_SEND);
+        }
+    }
+    else if(ROC_ROBOT_GAIT_CMD_ERASE == Cmd)
+    {
+        Ret = RocRobotGaitDescErase(Index);
+
+        RocRobotGaitDescAckTransmit(Cmd, Ret, Index);
+    }
 }
 
 /*********************************************************************************
  *  Description:
- *              Robot start running
+ *              Handle the command frame from the remote UART, the joystick
+ *              frames are left to RocRobotRemoteControl
  *
  *  Parameter:
  *              None
@@ -1192,24 +1543,43 @@ static ROC_RESULT RocRobotStartRun(void)
  *              None
  *
  *  Author:
- *              ROC LiRen(2018.12.16)
+ *              ROC LiRen(2026.10.17)
 **********************************************************************************/
-static ROC_RESULT RocRobotStopRun(void)
+static void RocRobotRemoteCmdHandle(void)
 {
-    ROC_RESULT Ret = RET_OK;
+    uint8_t *RemoteData = NULL;
 
-    RocServoOutputDisable();
+    if(ROC_TRUE != RocRemoteRecvIsFinshed())
+    {
+        return;
+    }
 
-    RocServoSpeedSet(0);
+    RemoteData = RocRemoteDataReceive();
 
-    Ret = RocServoTimerStop();
-    if(RET_OK != Ret)
+    if(ROC_JOYSTICK_FRAME_HEADER != RemoteData[0])
     {
-        ROC_LOGE("Robot stop servo motor in error!");
+        return;
     }
 
-    return Ret;
+    if(ROC_REMOTE_PROFILE_HEADER == RemoteData[1])
+    {
+#ifdef ROC_ROBOT_PROFILE_ENABLE
+        RocRobotProfileQueryHandle(RemoteData);
+#endif
+    }
+    else if(ROC_REMOTE_GAIT_HEADER == RemoteData[1])
+    {
+        RocRobotGaitDescCmdHandle(RemoteData);
+    }
+    else
+    {
+        return;
+    }
+
+    /* Clear the command, so it is not run again or taken as the joystick data */
+    RemoteData[1] = ROC_NONE;
 }
+
 /*********************************************************************************
  *  Description:
  *              Robot remote control function
@@ -1227,8 +1597,15 @@ static void RocRobotRemoteControl(void)
 {
     uint8_t RobotBleCtrlCmd = ROC_NONE;
     uint8_t RobotRemoteCmd = ROC_NONE;
+    uint8_t RobotRemoteAdcIsValid = ROC_NONE;
     uint16_t RobotRemoteAdc[4] = {ROC_NONE};
 
+    /* The commands wait until the robot has transformed */
+    if(g_RobotCtrl.TransformMode != g_RobotCtrl.RunMode)
+    {
+        return;
+    }
+
     RobotBleCtrlCmd = RocBluetoothCtrlCmd_Get();
 
     switch(RobotBleCtrlCmd)
@@ -1241,7 +1618,7 @@ static void RocRobotRemoteControl(void)
             }
             else if(ROC_ROBOT_RUN_MODE_CAR == RocRobotRunModeGet())
             {
-                RocRobotCarTransformRun();
+                RocRobotTransformStart(ROC_ROBOT_RUN_MODE_HEXAPOD);
             }
 
             break;
@@ -1338,7 +1715,12 @@ static void RocRobotRemoteControl(void)
     }
 
     RobotRemoteCmd = RocRobotJoystickCmdGet();
-    RocRobotJoystickAdcGet(RobotRemoteAdc);
+    RobotRemoteAdcIsValid = RocRobotJoystickAdcGet(RobotRemoteAdc);
+
+    if((ROC_TRUE == RobotRemoteAdcIsValid) && (ROC_ROBOT_RUN_MODE_HEXAPOD == RocRobotRunModeGet()))
+    {
+        RocRobotJoystickSpeedUpdate(RobotRemoteAdc);
+    }
 
     switch(RobotRemoteCmd)
     {
@@ -1350,7 +1732,7 @@ static void RocRobotRemoteControl(void)
             }
             else if(ROC_ROBOT_RUN_MODE_CAR == RocRobotRunModeGet())
             {
-                RocRobotCarTransformRun();
+                RocRobotTransformStart(ROC_ROBOT_RUN_MODE_HEXAPOD);
             }
 
             break;
@@ -1360,7 +1742,7 @@ static void RocRobotRemoteControl(void)
         {
             if(ROC_ROBOT_RUN_MODE_HEXAPOD == RocRobotRunModeGet())
             {
-                RocRobotHexapodTransformRun();
+                RocRobotTransformStart(ROC_ROBOT_RUN_MODE_CAR);
             }
             else if(ROC_ROBOT_RUN_MODE_CAR == RocRobotRunModeGet())
             {
@@ -1623,6 +2005,12 @@ void RocRobotInit(void)
         while(1);
     }
 
+    Ret = RocRobotProfileInit();
+    if(RET_OK != Ret)
+    {
+        ROC_LOGW("Robot profile is not available!");
+    }
+
     Ret = RocRobotAlgoCtrlInit();
     if(RET_OK != Ret)
     {
@@ -1631,6 +2019,17 @@ void RocRobotInit(void)
         while(1);
     }
 
+    Ret = RocAt24c02Init();
+    if(RET_OK == Ret)
+    {
+        Ret = RocRobotGaitDescLoad();
+    }
+
+    if(RET_OK != Ret)
+    {
+        ROC_LOGW("Robot gait descriptors are not loaded, the default gaits are used!");
+    }
+
     Ret = RocRobotControlInit();
     if(RET_OK != Ret)
     {
@@ -1658,6 +2057,44 @@ void RocRobotInit(void)
     }
 }
 
+/*********************************************************************************
+ *  Description:
+ *              Run the servo task on every released servo tick, and the gait
+ *              task after the servo tick releasing it, the gait task computes
+ *              the next move while the servo is still running the present one
+ *
+ *  Parameter:
+ *              None
+ *
+ *  Return:
+ *              None
+ *
+ *  Author:
+ *              ROC LiRen(2026.10.17)
+**********************************************************************************/
+static void RocRobotServoGaitTaskEntry(void)
+{
+    uint8_t Step = 0;
+
+    while(ROC_TRUE == RocRobotScheduleServoIsReady(&Step))
+    {
+        ROC_ROBOT_PROFILE_BEGIN(ROC_ROBOT_PROFILE_SCOPE_SERVO_CTRL);
+        RocServoControl((int16_t *)(&g_RobotCtrl.MoveCtrl->CurServo), Step);
+        ROC_ROBOT_PROFILE_END(ROC_ROBOT_PROFILE_SCOPE_SERVO_CTRL);
+
+        RocRobotScheduleTaskEnd(ROC_ROBOT_SCHEDULE_TASK_SERVO);
+
+        if(ROC_TRUE == RocRobotScheduleGaitIsReady())
+        {
+            ROC_ROBOT_PROFILE_BEGIN(ROC_ROBOT_PROFILE_SCOPE_MOVE_CTRL);
+            RocRobotMoveCtrlCore(g_RobotCtrl.MoveCtrl);
+            ROC_ROBOT_PROFILE_END(ROC_ROBOT_PROFILE_SCOPE_MOVE_CTRL);
+
+            RocRobotScheduleTaskEnd(ROC_ROBOT_SCHEDULE_TASK_GAIT);
+        }
+    }
+}
+
 /*********************************************************************************
  *  Description:
  *              Robot power on control task entry
@@ -1673,12 +2110,9 @@ void RocRobotInit(void)
 **********************************************************************************/
 static void RocRobotPowerOnTaskEntry(void)
 {
-    if(ROC_TRUE == RocServoTurnIsFinshed())
-    {
-        RocRobotMoveCtrlCore(g_RobotCtrl.MoveCtrl);
-    }
+    RocRobotPowerOnGaitSeq_Run();
 
-    RocServoControl((int16_t *)(&g_RobotCtrl.MoveCtrl->CurServo));
+    RocRobotServoGaitTaskEntry();
 }
 
 /*********************************************************************************
@@ -1722,6 +2156,45 @@ static void RocBatteryCheckTaskEntry(void)
 #endif
 }
 
+/*********************************************************************************
+ *  Description:
+ *              Robot servo fault check task entry, report the servo PWM fault
+ *              latched in the servo timer interrupt and its recovery
+ *
+ *  Parameter:
+ *              None
+ *
+ *  Return:
+ *              None
+ *
+ *  Author:
+ *              ROC LiRen(2026.10.17)
+**********************************************************************************/
+static void RocServoFaultCheckTaskEntry(void)
+{
+    static uint8_t              LastIsFault = ROC_FALSE;
+    uint8_t                     IsFault = ROC_FALSE;
+    ROC_PCA9685_FRAME_STAT_s    FrameStat;
+
+    IsFault = RocServoPwmFaultGet();
+
+    if(LastIsFault != IsFault)
+    {
+        LastIsFault = IsFault;
+
+        RocPca9685FrameStatGet(&FrameStat);
+
+        if(ROC_TRUE == IsFault)
+        {
+            ROC_LOGE("Servo PWM out is in error(0x%x), and servo output is disabled!", FrameStat.ErrorCode);
+        }
+        else
+        {
+            ROC_LOGN("Servo PWM out is recovered after %d errors, and servo output is enabled.", FrameStat.ErrorNum);
+        }
+    }
+}
+
 /*********************************************************************************
  *  Description:
  *              Robot LCD display information task entry
@@ -1745,6 +2218,8 @@ static void RocRobotLcdShowInfoTaskEntry(void)
     {
         g_RobotCtrl.CtrlTime.LcdTimeIsReady = ROC_FALSE;
 
+        ROC_ROBOT_PROFILE_BEGIN(ROC_ROBOT_PROFILE_SCOPE_LCD_SHOW);
+
         RemoteCmd = RocRobotJoystickCmdGet();
         Ret = RocRobotJoystickAdcGet(RemoteAdc);
 
@@ -1767,6 +2242,8 @@ static void RocRobotLcdShowInfoTaskEntry(void)
             RocTftLcdDrawGbk16Num(280, 5, ROC_TFT_LCD_COLOR_DEFAULT_FOR, ROC_TFT_LCD_COLOR_DEFAULT_BAK, RemoteAdc[3]);
         }
 
+        RocRobotImuEulerAngleUpdate(&g_RobotCtrl.MoveCtrl->CurState.CurImuAngle);
+
         RocTftLcdDrawGbk16Str(10, 25, ROC_TFT_LCD_COLOR_DEFAULT_FOR, ROC_TFT_LCD_COLOR_DEFAULT_BAK, "Pitch:");
         RocTftLcdDrawGbk16Str(65, 25, ROC_TFT_LCD_COLOR_DEFAULT_FOR, ROC_TFT_LCD_COLOR_DEFAULT_BAK, "      ");
         RocTftLcdDrawGbk16Num(65, 25, ROC_TFT_LCD_COLOR_WHITE, ROC_TFT_LCD_COLOR_BLUE, g_RobotCtrl.MoveCtrl->CurState.CurImuAngle.Pitch);
@@ -1780,6 +2257,8 @@ static void RocRobotLcdShowInfoTaskEntry(void)
 //        ROC_LOGN("Pitch: %.2f, Roll: %.2f, Yaw: %.2f", g_RobotCtrl.MoveCtrl->CurState.CurImuAngle.Pitch,
 //                                                       g_RobotCtrl.MoveCtrl->CurState.CurImuAngle.Roll,
 //                                                       g_RobotCtrl.MoveCtrl->CurState.CurImuAngle.Yaw);
+
+        ROC_ROBOT_PROFILE_END(ROC_ROBOT_PROFILE_SCOPE_LCD_SHOW);
     }
 }
 
@@ -1810,23 +2289,28 @@ static void RocRobotCtrlTaskEntry(void)
         LastExeTime = CurExeTime;
 #endif
 
+        ROC_ROBOT_PROFILE_BEGIN(ROC_ROBOT_PROFILE_SCOPE_CTRL_TICK);
+
         RocLedToggle(ROC_LED_DEBUG);
 
+        ROC_ROBOT_PROFILE_BEGIN(ROC_ROBOT_PROFILE_SCOPE_REMOTE_CTRL);
         RocRobotRemoteControl();
+        ROC_ROBOT_PROFILE_END(ROC_ROBOT_PROFILE_SCOPE_REMOTE_CTRL);
 
-        if(ROC_TRUE == RocServoTurnIsFinshed())
-        {
-            RocRobotMoveCtrlCore(g_RobotCtrl.MoveCtrl);
-        }
+        RocRobotServoGaitTaskEntry();
 
-        RocServoControl((int16_t *)(&g_RobotCtrl.MoveCtrl->CurServo));
+        ROC_ROBOT_PROFILE_END(ROC_ROBOT_PROFILE_SCOPE_CTRL_TICK);
+
+        RocRobotRemoteCmdHandle();
 
         g_RobotCtrl.CtrlTime.CtrlTimeIsReady = ROC_FALSE;
     }
     else
     {
 #ifdef ROC_ROBOT_CLOSED_LOOP_CONTROL
-        RocRobotImuEulerAngleGet(&g_RobotCtrl.MoveCtrl->CurState.CurImuAngle);
+        ROC_ROBOT_PROFILE_BEGIN(ROC_ROBOT_PROFILE_SCOPE_IMU_READ);
+        RocRobotImuQuatGet(&g_RobotCtrl.MoveCtrl->CurState.CurImuAngle);
+        ROC_ROBOT_PROFILE_END(ROC_ROBOT_PROFILE_SCOPE_IMU_READ);
 #endif
     }
 }
@@ -1856,6 +2340,8 @@ void HAL_TIM_PeriodElapsedCallback(TIM_HandleTypeDef *htim)
     {
         ROC_ROBOT_MOVE_STATUS_e     MoveStatus;
 
+        RocRobotScheduleTick();
+
         MoveStatus = RocRobotMoveStatus_Get();
 
         if((ROC_FALSE == PowerOnIsFinshed)
@@ -1906,6 +2392,8 @@ void RocRobotMain(void)
 {
     RocRobotCtrlTaskEntry();
 
+    RocServoFaultCheckTaskEntry();
+
     RocBatteryCheckTaskEntry();
 
     RocRobotLcdShowInfoTaskEntry();
@@ -10,6 +10,7 @@
 
 #include "RocRemoteControl.h"
 #include "RocRobotDhAlgorithm.h"
+#include "RocRobotGaitDesc.h"
 
 
 #define ROC_ROBOT_CONTROL_DEBUG
@@ -17,10 +18,28 @@
 
 #define ROC_ROBOT_CTRL_TIME_LCD_TICK    10
 
-#define ROC_ROBOT_CTRL_TRANSFORM_STEP   2
+#define ROC_ROBOT_CTRL_TRANSFORM_STEP   2       /* The car pose lifts the feet by the steps of ROC_ROBOT_DEFAULT_FEET_LIFT */
 #define ROC_ROBOT_CTRL_TRANSFORM_DELAY  4
+#define ROC_ROBOT_CTRL_TRANSFORM_TICK   (ROC_ROBOT_CTRL_TRANSFORM_STEP * ROC_ROBOT_CTRL_TRANSFORM_DELAY)
 
-#define ROC_ROBOT_CTRL_LEG_LEFT_STEP    20
+#define ROC_ROBOT_JOYSTICK_ADC_CENTER   2048    /* The 12 bits joystick ADC in the center */
+#define ROC_ROBOT_JOYSTICK_ADC_DEAD_ZONE    100
+#define ROC_ROBOT_JOYSTICK_SPEED_ADC_X  0       /* The ADC channels of the stick setting the speed */
+#define ROC_ROBOT_JOYSTICK_SPEED_ADC_Y  1
+
+#define ROC_ROBOT_PROFILE_CMD_READ      0
+#define ROC_ROBOT_PROFILE_CMD_RESET     1
+#define ROC_ROBOT_PROFILE_ALL_SCOPE     0xFF
+#define ROC_ROBOT_PROFILE_FRAME_NUM     (2 + ROC_ROBOT_PROFILE_HIST_BIN_NUM / 2)
+#define ROC_ROBOT_PROFILE_SCHED_SCOPE   0x10    /* The scope of the first schedule task */
+#define ROC_ROBOT_PROFILE_SCHED_FRAME_NUM   3
+
+#define ROC_ROBOT_GAIT_CMD_WRITE        0
+#define ROC_ROBOT_GAIT_CMD_READ         1
+#define ROC_ROBOT_GAIT_CMD_ERASE        2
+#define ROC_ROBOT_GAIT_CMD_ACK          0x80    /* Or-ed to the command of the answer */
+#define ROC_ROBOT_GAIT_FRAME_DATA_LEN   8
+#define ROC_ROBOT_GAIT_FRAME_NUM        (ROC_ROBOT_GAIT_DESC_LEN / ROC_ROBOT_GAIT_FRAME_DATA_LEN)
 
 
 typedef enum _ROC_ROBOT_RUN_MODE_e
@@ -62,11 +81,19 @@ typedef struct _ROC_ROBOT_CTRL_TIME_s
 
 }ROC_ROBOT_CTRL_TIME_s;
 
+typedef struct _ROC_ROBOT_POWER_ON_POSE_s
+{
+    float                    FeetLift;          // The feet lift of all legs
+    ROC_ROBOT_LEG_e          SelectLeg;         // The leg lifted alone, ROC_ROBOT_CNT_LEGS for all legs
+
+}ROC_ROBOT_POWER_ON_POSE_s;
+
 typedef struct _ROC_ROBOT_CTRL_s
 {
     ROC_ROBOT_CTRL_FlAG_s    CtrlFlag;
     ROC_ROBOT_CTRL_TIME_s    CtrlTime;
     ROC_ROBOT_RUN_MODE_e     RunMode;
+    ROC_ROBOT_RUN_MODE_e     TransformMode;     // The run mode the robot is transforming to
     ROC_REMOTE_CTRL_INPUT_s  RemoteCtrl;
     ROC_ROBOT_MOVE_CTRL_s    *MoveCtrl;
     float                    BatVoltage;
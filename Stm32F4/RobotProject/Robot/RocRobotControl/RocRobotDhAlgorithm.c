@@ -6,17 +6,19 @@
 ********************************************************************************/
 #include <stdint.h>
 #include <stdlib.h>
+#include <string.h>
 #include <math.h>
 
 #include "RocLog.h"
 #include "RocRobotMath.h"
-#include "RocTftLcd.h"
-#include "RocMpu6050.h"
 #include "RocRobotDhAlgorithm.h"
+#include "RocRobotGaitCycle.h"
+#include "RocRobotStability.h"
+#include "RocRobotTransition.h"
 
 
 #ifdef ROC_ROBOT_GAIT_QUAD_MODE_ENABLE
-static ROC_PHOENIX_GAIT_s g_RobotGait[] =
+static const ROC_PHOENIX_GAIT_s g_RobotGaitDefault[ROC_ROBOT_GAIT_TYPE_NUM] =
 {
     [ROC_ROBOT_GAIT_HEXP_MODE_RIPPLE_12]    = {ROC_ROBOT_RUN_SPEED_DEFAULT, 12, 3,  2,  2,  8,  3,  0,  0,  0,  1,  {7, 11, 3,  1,  5,  9}, "Ripple 12"},   // Ripple 12
     [ROC_ROBOT_GAIT_HEXP_MODE_TRIPOD_8]     = {ROC_ROBOT_RUN_SPEED_DEFAULT, 8,  3,  2,  2,  4,  3,  0,  0,  0,  1,  {1, 5,  1,  5,  1,  5}, "Tripod 8"},    // Tripod 8 steps
@@ -26,13 +28,16 @@ static ROC_PHOENIX_GAIT_s g_RobotGait[] =
     [ROC_ROBOT_GAIT_HEXP_MODE_TRIPOD_6]     = {ROC_ROBOT_RUN_SPEED_DEFAULT, 6,  2,  1,  2,  4,  1,  0,  0,  0,  1,  {1, 4,  1,  4,  1,  4}, "Tripod 6"},    // Tripod 6 steps
     [ROC_ROBOT_GAIT_HEXP_MODE_CIRCLE_6]     = {ROC_ROBOT_RUN_SPEED_DEFAULT, 6,  2,  1,  2,  4,  1,  0,  0,  0,  1,  {1, 4,  1,  4,  1,  4}, "Circle 6"},    // In-situ circle 6 steps
 
-    [ROC_ROBOT_GAIT_QUAD_MODE_RIPPLE_4]     = {ROC_ROBOT_RUN_SPEED_DEFAULT, 8,  2,  1,  2,  6,  1,  0,  0,  0,  1,  {7, 0,  1,  3,  0,  5}, "Ripple 4"},        // Ripple
-    [ROC_ROBOT_GAIT_QUAD_MODE_SM_RIPPLE_4]  = {ROC_ROBOT_RUN_SPEED_DEFAULT, 12, 2,  1,  2,  10, 1,  0,  0,  0,  1,  {7, 0,  1,  4,  0,  10},"Smooth Ripple 4"}, // Smooth Ripple
+    /* The ripple legs are lifted in the circular order LH, RH, RF, LF, the body shift turns on the circle with
+       them, so the COG is away from the lifted leg. The old order RH, LF, LH, RF crosses the circle and puts
+       the COG out of the support triangle, see RocRobotGaitSim -c. */
+    [ROC_ROBOT_GAIT_QUAD_MODE_RIPPLE_4]     = {ROC_ROBOT_RUN_SPEED_DEFAULT, 8,  2,  1,  2,  6,  1,  450, 450, ROC_ROBOT_QUAD_MODE_COG_RADIUS, 1, {5, 0,  3,  7,  0,  1}, "Ripple 4"},        // Ripple
+    [ROC_ROBOT_GAIT_QUAD_MODE_SM_RIPPLE_4]  = {ROC_ROBOT_RUN_SPEED_DEFAULT, 12, 2,  1,  2,  10, 1,  450, 300, ROC_ROBOT_QUAD_MODE_COG_RADIUS, 1, {7, 0,  4,  10, 0,  1}, "Smooth Ripple 4"}, // Smooth Ripple
     [ROC_ROBOT_GAIT_QUAD_MODE_AMBLE_4]      = {ROC_ROBOT_RUN_SPEED_DEFAULT, 4,  2,  1,  2,  2,  1,  0,  0,  0,  1,  {3, 0,  1,  1,  0,  3}, "Amble 4"},         // Amble
     [ROC_ROBOT_GAIT_QUAD_MODE_SM_AMBLE_4]   = {ROC_ROBOT_RUN_SPEED_DEFAULT, 6,  3,  2,  2,  3,  2,  0,  0,  0,  1,  {1, 0,  4,  4,  0,  1}, "Smooth Amble 4"},  // Smooth Amble
 };
 #else
-static ROC_PHOENIX_GAIT_s g_RobotGait[] =
+static const ROC_PHOENIX_GAIT_s g_RobotGaitDefault[ROC_ROBOT_GAIT_TYPE_NUM] =
 {
     [ROC_ROBOT_GAIT_HEXP_MODE_RIPPLE_12]    = {ROC_ROBOT_RUN_SPEED_DEFAULT, 12, 3,  2,  2,  8,  3, {7,  11, 3,  1,  5,  9}, "Ripple 12"},   // Ripple 12
     [ROC_ROBOT_GAIT_HEXP_MODE_TRIPOD_8]     = {ROC_ROBOT_RUN_SPEED_DEFAULT, 8,  3,  2,  2,  4,  3, {1,  5,  1,  5,  1,  5}, "Tripod 8"},    // Tripod 8 steps
@@ -44,11 +49,87 @@ static ROC_PHOENIX_GAIT_s g_RobotGait[] =
 };
 #endif
 
+/* The working gait table, the default gaits may be replaced by the descriptors
+   loaded from the EEPROM or the remote */
+static ROC_PHOENIX_GAIT_s g_RobotGait[ROC_ROBOT_GAIT_TYPE_NUM];
+
+
+/* Per-leg mirror and servo direction, the joint PWM is:
+   JointCenter + (JointInitAngle + JointSign * IK angle) * ROC_ROBOT_ROTATE_ANGLE_TO_PWM */
+static const ROC_ROBOT_LEG_CONFIG_s g_RobotLegCfg[ROC_ROBOT_CNT_LEGS] =
+{
+    /* ROC_ROBOT_RIG_FRO_LEG */
+    { 1,  1, ROC_FALSE, ROC_ROBOT_FRO_HIP_INIT_ANGLE,
+        {ROC_ROBOT_RIG_FRO_HIP_CENTER, ROC_ROBOT_RIG_FRO_LEG_CENTER, ROC_ROBOT_RIG_FRO_FET_CENTER},
+        {ROC_ROBOT_FRO_HIP_INIT_ANGLE, ROC_ROBOT_FRO_LEG_INIT_ANGLE, ROC_ROBOT_FRO_FET_INIT_ANGLE},
+        {-1, -1,  1}},
+    /* ROC_ROBOT_RIG_MID_LEG */
+    { 1,  1, ROC_TRUE,  ROC_ROBOT_MID_HIP_INIT_ANGLE,
+        {ROC_ROBOT_RIG_MID_HIP_CENTER, ROC_ROBOT_RIG_MID_LEG_CENTER, ROC_ROBOT_RIG_MID_FET_CENTER},
+        {ROC_ROBOT_MID_HIP_INIT_ANGLE, -ROC_ROBOT_MID_LEG_INIT_ANGLE, ROC_ROBOT_MID_FET_INIT_ANGLE},
+        {-1, -1,  1}},
+    /* ROC_ROBOT_RIG_HIN_LEG */
+    { 1, -1, ROC_FALSE, ROC_ROBOT_HIN_HIP_INIT_ANGLE,
+        {ROC_ROBOT_RIG_HIN_HIP_CENTER, ROC_ROBOT_RIG_HIN_LEG_CENTER, ROC_ROBOT_RIG_HIN_FET_CENTER},
+        {-ROC_ROBOT_HIN_HIP_INIT_ANGLE, ROC_ROBOT_HIN_LEG_INIT_ANGLE, ROC_ROBOT_HIN_FET_INIT_ANGLE},
+        { 1, -1,  1}},
+    /* ROC_ROBOT_LEF_FRO_LEG */
+    {-1,  1, ROC_FALSE, ROC_ROBOT_FRO_HIP_INIT_ANGLE,
+        {ROC_ROBOT_LEF_FRO_HIP_CENTER, ROC_ROBOT_LEF_FRO_LEG_CENTER, ROC_ROBOT_LEF_FRO_FET_CENTER},
+        {-ROC_ROBOT_FRO_HIP_INIT_ANGLE, -ROC_ROBOT_FRO_LEG_INIT_ANGLE, -ROC_ROBOT_FRO_FET_INIT_ANGLE},
+        { 1,  1, -1}},
+    /* ROC_ROBOT_LEF_MID_LEG */
+    {-1,  1, ROC_TRUE,  ROC_ROBOT_MID_HIP_INIT_ANGLE,
+        {ROC_ROBOT_LEF_MID_HIP_CENTER, ROC_ROBOT_LEF_MID_LEG_CENTER, ROC_ROBOT_LEF_MID_FET_CENTER},
+        {-ROC_ROBOT_MID_HIP_INIT_ANGLE, ROC_ROBOT_MID_LEG_INIT_ANGLE, -ROC_ROBOT_MID_FET_INIT_ANGLE},
+        { 1,  1, -1}},
+    /* ROC_ROBOT_LEF_HIN_LEG */
+    {-1, -1, ROC_FALSE, ROC_ROBOT_HIN_HIP_INIT_ANGLE,
+        {ROC_ROBOT_LEF_HIN_HIP_CENTER, ROC_ROBOT_LEF_HIN_LEG_CENTER, ROC_ROBOT_LEF_HIN_FET_CENTER},
+        {ROC_ROBOT_HIN_HIP_INIT_ANGLE, -ROC_ROBOT_HIN_LEG_INIT_ANGLE, -ROC_ROBOT_HIN_FET_INIT_ANGLE},
+        {-1,  1, -1}},
+};
+
+
+/* Generated from RocRobotGeometryDesc.h, no trigonometry on the constant angles at runtime */
+static const ROC_ROBOT_LEG_GEOMETRY_s g_RobotLegGeometry[ROC_ROBOT_CNT_LEGS] = ROC_ROBOT_GEOMETRY_LEG_TABLE;
+
+
+/* The leg position coefficients of the gait phases, for walking and circling:
+   XyKeep, RotKeep, AKeep, XFactor, YFactor, RotFactor, AFactor, TravelDiv, ZLift.
+   The position is Keep * position + Factor * travel / TravelDiv */
+static const ROC_ROBOT_GAIT_PHASE_s g_RobotGaitPhase[2][ROC_ROBOT_GAIT_PHASE_NUM] =
+{
+    {
+        [ROC_ROBOT_GAIT_PHASE_LIFT]         = {0, 0, 1,  0,  0,  0,  0, ROC_ROBOT_GAIT_DIV_LIFT, ROC_ROBOT_GAIT_LIFT_FULL},
+        [ROC_ROBOT_GAIT_PHASE_HALF_REAR]    = {0, 0, 1, -1, -1, -1,  0, ROC_ROBOT_GAIT_DIV_LIFT, ROC_ROBOT_GAIT_LIFT_HALF},
+        [ROC_ROBOT_GAIT_PHASE_HALF_FRONT]   = {0, 0, 1,  1,  1,  1,  0, ROC_ROBOT_GAIT_DIV_LIFT, ROC_ROBOT_GAIT_LIFT_HALF},
+        [ROC_ROBOT_GAIT_PHASE_HALF_REAR_5]  = {0, 0, 1, -1, -1, -1,  0, ROC_ROBOT_GAIT_DIV_HALF, ROC_ROBOT_GAIT_LIFT_HALF_5},
+        [ROC_ROBOT_GAIT_PHASE_HALF_FRONT_5] = {0, 0, 1,  1,  1,  1,  0, ROC_ROBOT_GAIT_DIV_HALF, ROC_ROBOT_GAIT_LIFT_HALF_5},
+        [ROC_ROBOT_GAIT_PHASE_FRONT_DOWN]   = {0, 0, 1,  1,  1,  1,  0, ROC_ROBOT_GAIT_DIV_HALF, ROC_ROBOT_GAIT_LIFT_GROUND},
+        [ROC_ROBOT_GAIT_PHASE_SLIDE]        = {1, 1, 1, -1, -1, -1,  0, ROC_ROBOT_GAIT_DIV_SLID, ROC_ROBOT_GAIT_LIFT_GROUND},
+    },
+    {   /* ROC_ROBOT_MOVE_STATUS_CIRCLING, the legs turn with the angle A */
+        [ROC_ROBOT_GAIT_PHASE_LIFT]         = {0, 0, 1,  0,  0,  0,  0, ROC_ROBOT_GAIT_DIV_LIFT, ROC_ROBOT_GAIT_LIFT_FULL},
+        [ROC_ROBOT_GAIT_PHASE_HALF_REAR]    = {0, 0, 0,  0,  0, -1, -1, ROC_ROBOT_GAIT_DIV_LIFT, ROC_ROBOT_GAIT_LIFT_HALF},
+        [ROC_ROBOT_GAIT_PHASE_HALF_FRONT]   = {0, 0, 0,  0,  0, -1,  1, ROC_ROBOT_GAIT_DIV_LIFT, ROC_ROBOT_GAIT_LIFT_HALF},
+        [ROC_ROBOT_GAIT_PHASE_HALF_REAR_5]  = {0, 0, 1, -1, -1, -1,  0, ROC_ROBOT_GAIT_DIV_HALF, ROC_ROBOT_GAIT_LIFT_HALF_5},
+        [ROC_ROBOT_GAIT_PHASE_HALF_FRONT_5] = {0, 0, 1,  1,  1,  1,  0, ROC_ROBOT_GAIT_DIV_HALF, ROC_ROBOT_GAIT_LIFT_HALF_5},
+        [ROC_ROBOT_GAIT_PHASE_FRONT_DOWN]   = {0, 0, 1,  1,  1,  1,  0, ROC_ROBOT_GAIT_DIV_HALF, ROC_ROBOT_GAIT_LIFT_GROUND},
+        [ROC_ROBOT_GAIT_PHASE_SLIDE]        = {0, 1, 1,  0,  0, -1, -1, ROC_ROBOT_GAIT_DIV_SLID, ROC_ROBOT_GAIT_LIFT_GROUND},
+    },
+};
+
+/* The compiled gait: the phase of every leg in every gait step, the last index
+   is ROC_TRUE for the leg behind the body, which is put down at FrontDownPos */
+static uint8_t g_RobotGaitPhaseTable[ROC_ROBOT_GAIT_MAX_STEPS][ROC_ROBOT_CNT_LEGS][2];
+
 
-static float                    g_DhAngleBuffer[3];
-static float                    g_BodyIkPos[3] = {0};
 static ROC_ROBOT_MOVE_CTRL_s    g_RobotMoveCtrl = {0};
 
+
+static ROC_RESULT RocRobotGaitPhaseCompile(const ROC_PHOENIX_GAIT_s *pGait);
+
 /*********************************************************************************
  *  Description:
  *              Select the robot gait type
@@ -64,284 +145,415 @@ static ROC_ROBOT_MOVE_CTRL_s    g_RobotMoveCtrl = {0};
 **********************************************************************************/
 static ROC_RESULT RocRobotGaitSelect(void)
 {
+    ROC_RESULT  Ret = RET_OK;
+
     g_RobotMoveCtrl.CurGait = g_RobotGait[g_RobotMoveCtrl.CurState.GaitType];
 
-    return RET_OK;
+    Ret = RocRobotGaitPhaseCompile(&g_RobotMoveCtrl.CurGait);
+    if(RET_OK != Ret)
+    {
+        return Ret;
+    }
+
+    return RocRobotGaitCycleInit(&g_RobotMoveCtrl.CurGait);
 }
 
 /*********************************************************************************
  *  Description:
- *              Update the robot leg position
+ *              Get the gait of the working gait table
  *
  *  Parameter:
- *              CurLegNum: the selected leg to control
+ *              GaitType: the gait type
+ *              pGait:    the pointer to the gait
  *
  *  Return:
- *              None
+ *              RET_ERROR if the gait type is invalid
  *
  *  Author:
- *              ROC LiRen(2019.03.30)
+ *              ROC LiRen(2026.10.17)
 **********************************************************************************/
-static void RocRobotGaitPosUpdate(uint8_t CurLegNum)
+ROC_RESULT RocRobotGaitTableGet(ROC_ROBOT_GAIT_TYPE_e GaitType, ROC_PHOENIX_GAIT_s *pGait)
 {
-    // Try to reduce the number of time we look at g_RobotMoveCtrl.CurGait.GaitLegNr and g_RobotMoveCtrl.CurState.GaitStep
-    int16_t LegStep = g_RobotMoveCtrl.CurState.GaitStep - g_RobotMoveCtrl.CurGait.GaitLegNr[CurLegNum];
-    uint8_t GaitPos = 0;
+    if(ROC_ROBOT_GAIT_TYPE_NUM <= GaitType)
+    {
+        return RET_ERROR;
+    }
 
-#if 0
-    //Gait in motion
-    if ((g_RobotMoveCtrl.CurState.TravelRequest
-            && (g_RobotMoveCtrl.CurGait.NrLiftedPos == 1
-            || g_RobotMoveCtrl.CurGait.NrLiftedPos == 3
-            || g_RobotMoveCtrl.CurGait.NrLiftedPos == 5)
-            && g_RobotMoveCtrl.CurState.GaitStep == g_RobotMoveCtrl.CurGait.GaitLegNr[CurLegNum])
-            || (!g_RobotMoveCtrl.CurState.TravelRequest
-            && g_RobotMoveCtrl.CurState.GaitStep == g_RobotMoveCtrl.CurGait.GaitLegNr[CurLegNum]
-            && ((fabs(g_RobotMoveCtrl.CurState.LegCurPos[CurLegNum].X) > 2)
-            || (fabs(g_RobotMoveCtrl.CurState.LegCurPos[CurLegNum].Y) > 2)
-            || (fabs(g_RobotMoveCtrl.CurState.GaitRot[CurLegNum]) > 2))))
-    {
-        g_RobotMoveCtrl.CurState.LegCurPos[CurLegNum].X = 0;
-        g_RobotMoveCtrl.CurState.LegCurPos[CurLegNum].Y = 0;
-        g_RobotMoveCtrl.CurState.LegCurPos[CurLegNum].Z = g_RobotMoveCtrl.CurState.LegLiftHeight;
-        g_RobotMoveCtrl.CurState.GaitRot[CurLegNum] = 0;
-
-        GaitPos = 1;
-    }
-    else if (((g_RobotMoveCtrl.CurGait.NrLiftedPos == 2
-            && g_RobotMoveCtrl.CurState.GaitStep == g_RobotMoveCtrl.CurGait.GaitLegNr[CurLegNum])
-            || (g_RobotMoveCtrl.CurGait.NrLiftedPos >= 3
-            && (g_RobotMoveCtrl.CurState.GaitStep == g_RobotMoveCtrl.CurGait.GaitLegNr[CurLegNum] - 1
-            || g_RobotMoveCtrl.CurState.GaitStep == g_RobotMoveCtrl.CurGait.GaitLegNr[CurLegNum] + (g_RobotMoveCtrl.CurGait.StepsInGait - 1))))
-            && g_RobotMoveCtrl.CurState.TravelRequest)
-    {    //Optional Half heigth Rear (2, 3, 5 lifted positions)
-        if(ROC_ROBOT_MOVE_STATUS_CIRCLING != g_RobotMoveCtrl.CurState.MoveStatus)
-        {
-            g_RobotMoveCtrl.CurState.LegCurPos[CurLegNum].X = -g_RobotMoveCtrl.CurState.TravelLength.X / g_RobotMoveCtrl.CurGait.LiftDivFactor;
-            g_RobotMoveCtrl.CurState.LegCurPos[CurLegNum].Y = -g_RobotMoveCtrl.CurState.TravelLength.Y / g_RobotMoveCtrl.CurGait.LiftDivFactor;
-            g_RobotMoveCtrl.CurState.LegCurPos[CurLegNum].Z = 3 * g_RobotMoveCtrl.CurState.LegLiftHeight / (3 + g_RobotMoveCtrl.CurGait.HalfLiftHeight);     //Easier to shift between div factor: /1 (3/3), /2 (3/6) and 3/4
-            g_RobotMoveCtrl.CurState.GaitRot[CurLegNum] = -g_RobotMoveCtrl.CurState.TravelLength.Z / g_RobotMoveCtrl.CurGait.LiftDivFactor;
-        }
-        else
-        {
-            g_RobotMoveCtrl.CurState.LegCurPos[CurLegNum].X = 0;
-            g_RobotMoveCtrl.CurState.LegCurPos[CurLegNum].Y = 0;
-            g_RobotMoveCtrl.CurState.LegCurPos[CurLegNum].Z = 3 * g_RobotMoveCtrl.CurState.LegLiftHeight / (3 + g_RobotMoveCtrl.CurGait.HalfLiftHeight);
-            g_RobotMoveCtrl.CurState.LegCurPos[CurLegNum].A = -g_RobotMoveCtrl.CurState.TravelLength.A / g_RobotMoveCtrl.CurGait.LiftDivFactor;
-            g_RobotMoveCtrl.CurState.GaitRot[CurLegNum] = -g_RobotMoveCtrl.CurState.TravelLength.Z / g_RobotMoveCtrl.CurGait.LiftDivFactor;
-        }
+    *pGait = g_RobotGait[GaitType];
+
+    return RET_OK;
+}
 
-        GaitPos = 2;
+/*********************************************************************************
+ *  Description:
+ *              Replace the gait of the working gait table, the gait name is
+ *              kept. The running gait restarts from the first step with the
+ *              new gait.
+ *
+ *  Parameter:
+ *              GaitType: the gait type
+ *              pGait:    the pointer to the new gait, NULL restores the default
+ *
+ *  Return:
+ *              RET_ERROR if the gait type is invalid
+ *
+ *  Author:
+ *              ROC LiRen(2026.10.17)
+**********************************************************************************/
+ROC_RESULT RocRobotGaitTableSet(ROC_ROBOT_GAIT_TYPE_e GaitType, const ROC_PHOENIX_GAIT_s *pGait)
+{
+    if(ROC_ROBOT_GAIT_TYPE_NUM <= GaitType)
+    {
+        ROC_LOGE("Robot gait type(%d) is invalid!", GaitType);
+
+        return RET_ERROR;
     }
-    else if ((g_RobotMoveCtrl.CurGait.NrLiftedPos >= 2)
-            && (g_RobotMoveCtrl.CurState.GaitStep == g_RobotMoveCtrl.CurGait.GaitLegNr[CurLegNum] + 1
-            || g_RobotMoveCtrl.CurState.GaitStep == g_RobotMoveCtrl.CurGait.GaitLegNr[CurLegNum] - (g_RobotMoveCtrl.CurGait.StepsInGait-1))
-            && g_RobotMoveCtrl.CurState.TravelRequest)
-    {    // Optional Half heigth front (2, 3, 5 lifted positions)
-        if(ROC_ROBOT_MOVE_STATUS_CIRCLING != g_RobotMoveCtrl.CurState.MoveStatus)
-        {
-            g_RobotMoveCtrl.CurState.LegCurPos[CurLegNum].X = g_RobotMoveCtrl.CurState.TravelLength.X / g_RobotMoveCtrl.CurGait.LiftDivFactor;
-            g_RobotMoveCtrl.CurState.LegCurPos[CurLegNum].Y = g_RobotMoveCtrl.CurState.TravelLength.Y / g_RobotMoveCtrl.CurGait.LiftDivFactor;
-            g_RobotMoveCtrl.CurState.LegCurPos[CurLegNum].Z = 3 * g_RobotMoveCtrl.CurState.LegLiftHeight / (3 + g_RobotMoveCtrl.CurGait.HalfLiftHeight); // Easier to shift between div factor: /1 (3/3), /2 (3/6) and 3/4
-            g_RobotMoveCtrl.CurState.GaitRot[CurLegNum] = g_RobotMoveCtrl.CurState.TravelLength.Z / g_RobotMoveCtrl.CurGait.LiftDivFactor;
-        }
-        else
-        {
-            g_RobotMoveCtrl.CurState.LegCurPos[CurLegNum].X = 0;
-            g_RobotMoveCtrl.CurState.LegCurPos[CurLegNum].Y = 0;
-            g_RobotMoveCtrl.CurState.LegCurPos[CurLegNum].Z = 3 * g_RobotMoveCtrl.CurState.LegLiftHeight / (3 + g_RobotMoveCtrl.CurGait.HalfLiftHeight);
-            g_RobotMoveCtrl.CurState.LegCurPos[CurLegNum].A = g_RobotMoveCtrl.CurState.TravelLength.A / g_RobotMoveCtrl.CurGait.LiftDivFactor;
-            g_RobotMoveCtrl.CurState.GaitRot[CurLegNum] = -g_RobotMoveCtrl.CurState.TravelLength.Z / g_RobotMoveCtrl.CurGait.LiftDivFactor;
-        }
 
-        GaitPos = 3;
-    }
-    else if (((g_RobotMoveCtrl.CurGait.NrLiftedPos == 5
-            && (g_RobotMoveCtrl.CurState.GaitStep == g_RobotMoveCtrl.CurGait.GaitLegNr[CurLegNum] - 2)))
-            && g_RobotMoveCtrl.CurState.TravelRequest)
-    {    //Optional Half heigth Rear 5 LiftedPos (5 lifted positions)
-        g_RobotMoveCtrl.CurState.LegCurPos[CurLegNum].X = -g_RobotMoveCtrl.CurState.TravelLength.X / 2;
-        g_RobotMoveCtrl.CurState.LegCurPos[CurLegNum].Y = -g_RobotMoveCtrl.CurState.TravelLength.Y / 2;
-        g_RobotMoveCtrl.CurState.LegCurPos[CurLegNum].Z = g_RobotMoveCtrl.CurState.LegLiftHeight / 2;
-        g_RobotMoveCtrl.CurState.GaitRot[CurLegNum] = -g_RobotMoveCtrl.CurState.TravelLength.Z / 2;
-
-        GaitPos = 4;
-    }
-    else if ((g_RobotMoveCtrl.CurGait.NrLiftedPos == 5)
-            && (g_RobotMoveCtrl.CurState.GaitStep == g_RobotMoveCtrl.CurGait.GaitLegNr[CurLegNum] + 2
-            || g_RobotMoveCtrl.CurState.GaitStep == g_RobotMoveCtrl.CurGait.GaitLegNr[CurLegNum] - (g_RobotMoveCtrl.CurGait.StepsInGait-2))
-            && g_RobotMoveCtrl.CurState.TravelRequest)
-    {   //Optional Half heigth Front 5 LiftedPos(5 lifted positions)
-        g_RobotMoveCtrl.CurState.LegCurPos[CurLegNum].X = g_RobotMoveCtrl.CurState.TravelLength.X / 2;
-        g_RobotMoveCtrl.CurState.LegCurPos[CurLegNum].Y = g_RobotMoveCtrl.CurState.TravelLength.Y / 2;
-        g_RobotMoveCtrl.CurState.LegCurPos[CurLegNum].Z = g_RobotMoveCtrl.CurState.LegLiftHeight / 2;
-        g_RobotMoveCtrl.CurState.GaitRot[CurLegNum] = g_RobotMoveCtrl.CurState.TravelLength.Z / 2;
-
-        GaitPos = 5;
-    }
-    else if((g_RobotMoveCtrl.CurState.GaitStep == g_RobotMoveCtrl.CurGait.GaitLegNr[CurLegNum] + g_RobotMoveCtrl.CurGait.FrontDownPos
-            || g_RobotMoveCtrl.CurState.GaitStep == g_RobotMoveCtrl.CurGait.GaitLegNr[CurLegNum] - (g_RobotMoveCtrl.CurGait.StepsInGait - g_RobotMoveCtrl.CurGait.FrontDownPos))
-            && g_RobotMoveCtrl.CurState.LegCurPos[CurLegNum].Y < 0)
-    {   //Leg front down position
-        g_RobotMoveCtrl.CurState.LegCurPos[CurLegNum].X = g_RobotMoveCtrl.CurState.TravelLength.X / 2;
-        g_RobotMoveCtrl.CurState.LegCurPos[CurLegNum].Y = g_RobotMoveCtrl.CurState.TravelLength.Y / 2;
-        g_RobotMoveCtrl.CurState.LegCurPos[CurLegNum].Z = 0;
-        g_RobotMoveCtrl.CurState.GaitRot[CurLegNum] = g_RobotMoveCtrl.CurState.TravelLength.Z / 2;
-
-        GaitPos = 6;
+    if(NULL == pGait)
+    {
+        g_RobotGait[GaitType] = g_RobotGaitDefault[GaitType];
     }
     else
-    {   //Move body forward
-        if(ROC_ROBOT_MOVE_STATUS_CIRCLING != g_RobotMoveCtrl.CurState.MoveStatus)
-        {
-            g_RobotMoveCtrl.CurState.LegCurPos[CurLegNum].X = g_RobotMoveCtrl.CurState.LegCurPos[CurLegNum].X - (g_RobotMoveCtrl.CurState.TravelLength.X / g_RobotMoveCtrl.CurGait.SlidDivFactor);
-            g_RobotMoveCtrl.CurState.LegCurPos[CurLegNum].Y = g_RobotMoveCtrl.CurState.LegCurPos[CurLegNum].Y - (g_RobotMoveCtrl.CurState.TravelLength.Y / g_RobotMoveCtrl.CurGait.SlidDivFactor);
-            g_RobotMoveCtrl.CurState.LegCurPos[CurLegNum].Z = 0;
-            g_RobotMoveCtrl.CurState.GaitRot[CurLegNum] = g_RobotMoveCtrl.CurState.GaitRot[CurLegNum] - (g_RobotMoveCtrl.CurState.TravelLength.Y / g_RobotMoveCtrl.CurGait.SlidDivFactor);
-        }
-        else
-        {
-            g_RobotMoveCtrl.CurState.LegCurPos[CurLegNum].X = 0;
-            g_RobotMoveCtrl.CurState.LegCurPos[CurLegNum].Y = 0;
-            g_RobotMoveCtrl.CurState.LegCurPos[CurLegNum].Z = 0;
-            g_RobotMoveCtrl.CurState.LegCurPos[CurLegNum].A =  g_RobotMoveCtrl.CurState.LegCurPos[CurLegNum].A - (g_RobotMoveCtrl.CurState.TravelLength.A / g_RobotMoveCtrl.CurGait.SlidDivFactor);
-            g_RobotMoveCtrl.CurState.GaitRot[CurLegNum] = g_RobotMoveCtrl.CurState.GaitRot[CurLegNum] - (g_RobotMoveCtrl.CurState.TravelLength.Y / g_RobotMoveCtrl.CurGait.SlidDivFactor);
-        }
+    {
+        g_RobotGait[GaitType] = *pGait;
 
-        GaitPos = 7;
+#ifdef ROC_ROBOT_DISPLAY_GAIT_NAMES
+        g_RobotGait[GaitType].PszName = g_RobotGaitDefault[GaitType].PszName;
+#endif
     }
 
-    if((ROC_ROBOT_CNT_LEGS - 1) == CurLegNum)
+    if(GaitType == g_RobotMoveCtrl.CurState.GaitType)
     {
-        g_RobotMoveCtrl.CurState.GaitStep++;                                    //Advance to the next step
+        return RocRobotGaitTypeSet(GaitType);
+    }
 
-        if (g_RobotMoveCtrl.CurState.GaitStep > g_RobotMoveCtrl.CurGait.StepsInGait) //The last leg in this step
-        {
-            g_RobotMoveCtrl.CurState.GaitStep = 1;
-        }
+    return RET_OK;
+}
+
+/*********************************************************************************
+ *  Description:
+ *              Change the robot gait type, the walk mode follows the gait and the
+ *              gait sequence restarts from the first step, the feet are blended
+ *              to the new gait
+ *
+ *  Parameter:
+ *              GaitType: the expected gait type
+ *
+ *  Return:
+ *              The result of the gait select
+ *
+ *  Author:
+ *              ROC LiRen(2026.10.17)
+**********************************************************************************/
+ROC_RESULT RocRobotGaitTypeSet(ROC_ROBOT_GAIT_TYPE_e GaitType)
+{
+    ROC_RESULT  Ret = RET_OK;
+
+    if(ROC_ROBOT_GAIT_TYPE_NUM <= GaitType)
+    {
+        ROC_LOGE("Robot gait type(%d) is invalid!", GaitType);
+
+        return RET_ERROR;
     }
+
+    g_RobotMoveCtrl.CurState.GaitType = GaitType;
+    g_RobotMoveCtrl.CurState.GaitStep = 1;
+
+#ifdef ROC_ROBOT_GAIT_QUAD_MODE_ENABLE
+    if(ROC_ROBOT_GAIT_QUAD_MODE_RIPPLE_4 <= GaitType)
+    {
+        g_RobotMoveCtrl.CurState.WalkMode = ROC_ROBOT_WALK_MODE_QUADRUPED;
+    }
+    else
 #endif
+    {
+        g_RobotMoveCtrl.CurState.WalkMode = ROC_ROBOT_WALK_MODE_HEXAPOD;
+    }
 
-    //Gait in motion
-    if ((g_RobotMoveCtrl.CurState.TravelRequest
-        && (g_RobotMoveCtrl.CurGait.NrLiftedPos == 1) && (LegStep == 0))
-        || (!g_RobotMoveCtrl.CurState.TravelRequest && (LegStep == 0)
-        && ((fabs(g_RobotMoveCtrl.CurState.LegCurPos[CurLegNum].X) > 2)
-        || (fabs(g_RobotMoveCtrl.CurState.LegCurPos[CurLegNum].Y) > 2)
-        || (fabs(g_RobotMoveCtrl.CurState.GaitRot[CurLegNum]) > 2))))
-    {
-        g_RobotMoveCtrl.CurState.LegCurPos[CurLegNum].X = 0;
-        g_RobotMoveCtrl.CurState.LegCurPos[CurLegNum].Y = 0;
-        g_RobotMoveCtrl.CurState.LegCurPos[CurLegNum].Z = g_RobotMoveCtrl.CurState.LegLiftHeight;
-        g_RobotMoveCtrl.CurState.GaitRot[CurLegNum] = 0;
-
-        GaitPos = 1;
-    }
-    else if ((((g_RobotMoveCtrl.CurGait.NrLiftedPos == 2)&& (LegStep == 0))
-        || ((g_RobotMoveCtrl.CurGait.NrLiftedPos >= 3)
-        && ((LegStep == -1) || (LegStep == g_RobotMoveCtrl.CurGait.StepsInGait - 1))))
-        && g_RobotMoveCtrl.CurState.TravelRequest)
-    {    //Optional Half heigth Rear (2, 3, 5 lifted positions)
-        if(ROC_ROBOT_MOVE_STATUS_CIRCLING != g_RobotMoveCtrl.CurState.MoveStatus)
-        {
-            g_RobotMoveCtrl.CurState.LegCurPos[CurLegNum].X = -g_RobotMoveCtrl.CurState.TravelLength.X / g_RobotMoveCtrl.CurGait.LiftDivFactor;
-            g_RobotMoveCtrl.CurState.LegCurPos[CurLegNum].Y = -g_RobotMoveCtrl.CurState.TravelLength.Y / g_RobotMoveCtrl.CurGait.LiftDivFactor;
-            g_RobotMoveCtrl.CurState.LegCurPos[CurLegNum].Z = 3 * g_RobotMoveCtrl.CurState.LegLiftHeight / (3 + g_RobotMoveCtrl.CurGait.HalfLiftHeight);     //Easier to shift between div factor: /1 (3/3), /2 (3/6) and 3/4
-            g_RobotMoveCtrl.CurState.GaitRot[CurLegNum] = -g_RobotMoveCtrl.CurState.TravelLength.Z / g_RobotMoveCtrl.CurGait.LiftDivFactor;
-        }
-        else
-        {
-            g_RobotMoveCtrl.CurState.LegCurPos[CurLegNum].X = 0;
-            g_RobotMoveCtrl.CurState.LegCurPos[CurLegNum].Y = 0;
-            g_RobotMoveCtrl.CurState.LegCurPos[CurLegNum].Z = 3 * g_RobotMoveCtrl.CurState.LegLiftHeight / (3 + g_RobotMoveCtrl.CurGait.HalfLiftHeight);
-            g_RobotMoveCtrl.CurState.LegCurPos[CurLegNum].A = -g_RobotMoveCtrl.CurState.TravelLength.A / g_RobotMoveCtrl.CurGait.LiftDivFactor;
-            g_RobotMoveCtrl.CurState.GaitRot[CurLegNum] = -g_RobotMoveCtrl.CurState.TravelLength.Z / g_RobotMoveCtrl.CurGait.LiftDivFactor;
-        }
+    Ret = RocRobotGaitSelect();
+
+    /* The feet move from the old gait to the new one, the parked legs too */
+    RocRobotTransitionStart();
 
-        GaitPos = 2;
+    /* The stability monitor starts the new gait from the full step */
+    RocRobotStabilityInit();
+
+    return Ret;
+}
+
+/*********************************************************************************
+ *  Description:
+ *              Change the gait mode, the continuous gait restarts from the first
+ *              step of the gait
+ *
+ *  Parameter:
+ *              GaitMode: the expected gait mode
+ *
+ *  Return:
+ *              RET_ERROR if the gait mode is invalid
+ *
+ *  Author:
+ *              ROC LiRen(2026.10.17)
+**********************************************************************************/
+ROC_RESULT RocRobotGaitModeSet(ROC_ROBOT_GAIT_MODE_e GaitMode)
+{
+    if(ROC_ROBOT_GAIT_MODE_NUM <= GaitMode)
+    {
+        ROC_LOGE("Robot gait mode(%d) is invalid!", GaitMode);
+
+        return RET_ERROR;
     }
-    else if ((g_RobotMoveCtrl.CurGait.NrLiftedPos >= 2)
-        && ((LegStep == 1) || LegStep == - (g_RobotMoveCtrl.CurGait.StepsInGait-1))
-        && g_RobotMoveCtrl.CurState.TravelRequest)
-    {    // Optional Half heigth front (2, 3, 5 lifted positions)
-        if(ROC_ROBOT_MOVE_STATUS_CIRCLING != g_RobotMoveCtrl.CurState.MoveStatus)
-        {
-            g_RobotMoveCtrl.CurState.LegCurPos[CurLegNum].X = g_RobotMoveCtrl.CurState.TravelLength.X / g_RobotMoveCtrl.CurGait.LiftDivFactor;
-            g_RobotMoveCtrl.CurState.LegCurPos[CurLegNum].Y = g_RobotMoveCtrl.CurState.TravelLength.Y / g_RobotMoveCtrl.CurGait.LiftDivFactor;
-            g_RobotMoveCtrl.CurState.LegCurPos[CurLegNum].Z = 3 * g_RobotMoveCtrl.CurState.LegLiftHeight / (3 + g_RobotMoveCtrl.CurGait.HalfLiftHeight); // Easier to shift between div factor: /1 (3/3), /2 (3/6) and 3/4
-            g_RobotMoveCtrl.CurState.GaitRot[CurLegNum] = g_RobotMoveCtrl.CurState.TravelLength.Z / g_RobotMoveCtrl.CurGait.LiftDivFactor;
-        }
-        else
-        {
-            g_RobotMoveCtrl.CurState.LegCurPos[CurLegNum].X = 0;
-            g_RobotMoveCtrl.CurState.LegCurPos[CurLegNum].Y = 0;
-            g_RobotMoveCtrl.CurState.LegCurPos[CurLegNum].Z = 3 * g_RobotMoveCtrl.CurState.LegLiftHeight / (3 + g_RobotMoveCtrl.CurGait.HalfLiftHeight);
-            g_RobotMoveCtrl.CurState.LegCurPos[CurLegNum].A = g_RobotMoveCtrl.CurState.TravelLength.A / g_RobotMoveCtrl.CurGait.LiftDivFactor;
-            g_RobotMoveCtrl.CurState.GaitRot[CurLegNum] = -g_RobotMoveCtrl.CurState.TravelLength.Z / g_RobotMoveCtrl.CurGait.LiftDivFactor;
-        }
 
-        GaitPos = 3;
+    g_RobotMoveCtrl.CurState.GaitMode = GaitMode;
+
+    return RocRobotGaitTypeSet(g_RobotMoveCtrl.CurState.GaitType);
+}
+
+/*********************************************************************************
+ *  Description:
+ *              Find the gait phase of the leg at the leg step, it follows the
+ *              leg position order of the Phoenix gait. The gait is always in
+ *              motion when it is updated, so the phases are for the travel
+ *              request.
+ *
+ *  Parameter:
+ *              pGait: the pointer to the gait
+ *              LegStep: the gait step minus the init position of the leg
+ *              IsDown: ROC_TRUE for the leg behind the body (LegCurPos.Y < 0)
+ *
+ *  Return:
+ *              The gait phase of the leg
+ *
+ *  Author:
+ *              ROC LiRen(2026.10.17)
+**********************************************************************************/
+static ROC_ROBOT_GAIT_PHASE_e RocRobotGaitPhaseFind(const ROC_PHOENIX_GAIT_s *pGait, int16_t LegStep, uint8_t IsDown)
+{
+    int16_t StepsInGait = pGait->StepsInGait;
+
+    if((1 == pGait->NrLiftedPos) && (0 == LegStep))
+    {
+        return ROC_ROBOT_GAIT_PHASE_LIFT;
     }
-    else if (((g_RobotMoveCtrl.CurGait.NrLiftedPos == 5) && (LegStep == -2))
-        && g_RobotMoveCtrl.CurState.TravelRequest)
-    {    //Optional Half heigth Rear 5 LiftedPos (5 lifted positions)
-        g_RobotMoveCtrl.CurState.LegCurPos[CurLegNum].X = -g_RobotMoveCtrl.CurState.TravelLength.X / 2;
-        g_RobotMoveCtrl.CurState.LegCurPos[CurLegNum].Y = -g_RobotMoveCtrl.CurState.TravelLength.Y / 2;
-        g_RobotMoveCtrl.CurState.LegCurPos[CurLegNum].Z = g_RobotMoveCtrl.CurState.LegLiftHeight / 2;
-        g_RobotMoveCtrl.CurState.GaitRot[CurLegNum] = -g_RobotMoveCtrl.CurState.TravelLength.Z / 2;
 
-        GaitPos = 4;
+    if(((2 == pGait->NrLiftedPos) && (0 == LegStep))
+        || ((3 <= pGait->NrLiftedPos) && ((-1 == LegStep) || (StepsInGait - 1 == LegStep))))
+    {
+        return ROC_ROBOT_GAIT_PHASE_HALF_REAR;
     }
-    else if ((g_RobotMoveCtrl.CurGait.NrLiftedPos == 5)
-        && ((LegStep == 2) || (LegStep == -(g_RobotMoveCtrl.CurGait.StepsInGait - 2)))
-        && g_RobotMoveCtrl.CurState.TravelRequest)
-    {   //Optional Half heigth Front 5 LiftedPos(5 lifted positions)
-        g_RobotMoveCtrl.CurState.LegCurPos[CurLegNum].X = g_RobotMoveCtrl.CurState.TravelLength.X / 2;
-        g_RobotMoveCtrl.CurState.LegCurPos[CurLegNum].Y = g_RobotMoveCtrl.CurState.TravelLength.Y / 2;
-        g_RobotMoveCtrl.CurState.LegCurPos[CurLegNum].Z = g_RobotMoveCtrl.CurState.LegLiftHeight / 2;
-        g_RobotMoveCtrl.CurState.GaitRot[CurLegNum] = g_RobotMoveCtrl.CurState.TravelLength.Z / 2;
 
-        GaitPos = 5;
+    if((2 <= pGait->NrLiftedPos) && ((1 == LegStep) || (-(StepsInGait - 1) == LegStep)))
+    {
+        return ROC_ROBOT_GAIT_PHASE_HALF_FRONT;
     }
-    else if(((LegStep == g_RobotMoveCtrl.CurGait.FrontDownPos)
-        || (LegStep == -(g_RobotMoveCtrl.CurGait.StepsInGait - g_RobotMoveCtrl.CurGait.FrontDownPos)))
-        && g_RobotMoveCtrl.CurState.LegCurPos[CurLegNum].Y < 0)
-    {   //Leg front down position
-        g_RobotMoveCtrl.CurState.LegCurPos[CurLegNum].X = g_RobotMoveCtrl.CurState.TravelLength.X / 2;
-        g_RobotMoveCtrl.CurState.LegCurPos[CurLegNum].Y = g_RobotMoveCtrl.CurState.TravelLength.Y / 2;
-        g_RobotMoveCtrl.CurState.LegCurPos[CurLegNum].Z = 0;
-        g_RobotMoveCtrl.CurState.GaitRot[CurLegNum] = g_RobotMoveCtrl.CurState.TravelLength.Z / 2;
 
-        GaitPos = 6;
+    if((5 == pGait->NrLiftedPos) && (-2 == LegStep))
+    {
+        return ROC_ROBOT_GAIT_PHASE_HALF_REAR_5;
     }
-    else
-    {   //Move body forward
-        if(ROC_ROBOT_MOVE_STATUS_CIRCLING != g_RobotMoveCtrl.CurState.MoveStatus)
-        {
-            g_RobotMoveCtrl.CurState.LegCurPos[CurLegNum].X = g_RobotMoveCtrl.CurState.LegCurPos[CurLegNum].X - (g_RobotMoveCtrl.CurState.TravelLength.X / g_RobotMoveCtrl.CurGait.SlidDivFactor);
-            g_RobotMoveCtrl.CurState.LegCurPos[CurLegNum].Y = g_RobotMoveCtrl.CurState.LegCurPos[CurLegNum].Y - (g_RobotMoveCtrl.CurState.TravelLength.Y / g_RobotMoveCtrl.CurGait.SlidDivFactor);
-            g_RobotMoveCtrl.CurState.LegCurPos[CurLegNum].Z = 0;
-            g_RobotMoveCtrl.CurState.GaitRot[CurLegNum] = g_RobotMoveCtrl.CurState.GaitRot[CurLegNum] - (g_RobotMoveCtrl.CurState.TravelLength.Y / g_RobotMoveCtrl.CurGait.SlidDivFactor);
-        }
-        else
+
+    if((5 == pGait->NrLiftedPos) && ((2 == LegStep) || (-(StepsInGait - 2) == LegStep)))
+    {
+        return ROC_ROBOT_GAIT_PHASE_HALF_FRONT_5;
+    }
+
+    if((ROC_TRUE == IsDown)
+        && ((pGait->FrontDownPos == LegStep) || (-(StepsInGait - pGait->FrontDownPos) == LegStep)))
+    {
+        return ROC_ROBOT_GAIT_PHASE_FRONT_DOWN;
+    }
+
+    return ROC_ROBOT_GAIT_PHASE_SLIDE;
+}
+
+/*********************************************************************************
+ *  Description:
+ *              Compile the gait to the phase table, one phase of every leg in
+ *              every gait step. It is done once when the gait is selected, so
+ *              the gait update does not look at the gait parameters.
+ *
+ *  Parameter:
+ *              pGait: the pointer to the gait
+ *
+ *  Return:
+ *              RET_ERROR if the gait steps is out of the table
+ *
+ *  Author:
+ *              ROC LiRen(2026.10.17)
+**********************************************************************************/
+static ROC_RESULT RocRobotGaitPhaseCompile(const ROC_PHOENIX_GAIT_s *pGait)
+{
+    uint8_t i = 0;
+    uint8_t j = 0;
+    int16_t LegStep = 0;
+
+    if((0 == pGait->StepsInGait) || (ROC_ROBOT_GAIT_MAX_STEPS < pGait->StepsInGait))
+    {
+        ROC_LOGE("Robot gait steps(%d) is out of range!", pGait->StepsInGait);
+
+        return RET_ERROR;
+    }
+
+    for(i = 0; i < pGait->StepsInGait; i++)
+    {
+        for(j = 0; j < ROC_ROBOT_CNT_LEGS; j++)
         {
-            g_RobotMoveCtrl.CurState.LegCurPos[CurLegNum].X = 0;
-            g_RobotMoveCtrl.CurState.LegCurPos[CurLegNum].Y = 0;
-            g_RobotMoveCtrl.CurState.LegCurPos[CurLegNum].Z = 0;
-            g_RobotMoveCtrl.CurState.LegCurPos[CurLegNum].A =  g_RobotMoveCtrl.CurState.LegCurPos[CurLegNum].A - (g_RobotMoveCtrl.CurState.TravelLength.A / g_RobotMoveCtrl.CurGait.SlidDivFactor);
-            g_RobotMoveCtrl.CurState.GaitRot[CurLegNum] = g_RobotMoveCtrl.CurState.GaitRot[CurLegNum] - (g_RobotMoveCtrl.CurState.TravelLength.Y / g_RobotMoveCtrl.CurGait.SlidDivFactor);
-        }
+            LegStep = (int16_t)(i + 1) - pGait->GaitLegNr[j];
 
-        GaitPos = 7;
+            g_RobotGaitPhaseTable[i][j][ROC_FALSE] = (uint8_t)RocRobotGaitPhaseFind(pGait, LegStep, ROC_FALSE);
+            g_RobotGaitPhaseTable[i][j][ROC_TRUE] = (uint8_t)RocRobotGaitPhaseFind(pGait, LegStep, ROC_TRUE);
+        }
     }
 
-    GaitPos = GaitPos;
+    return RET_OK;
+}
+
+/*********************************************************************************
+ *  Description:
+ *              Update the robot leg position with the coefficients of its gait
+ *              phase, there is no branch on the gait parameters
+ *
+ *  Parameter:
+ *              CurLegNum: the selected leg to control
+ *              pPhase: the pointer to the gait phase of the leg
+ *              pTravelStep: the travel divided by the phase divisors
+ *              pLiftHeight: the leg lift heights of the phases
+ *
+ *  Return:
+ *              None
+ *
+ *  Author:
+ *              ROC LiRen(2019.03.30)
+**********************************************************************************/
+static void RocRobotGaitPosUpdate(uint8_t CurLegNum, const ROC_ROBOT_GAIT_PHASE_s *pPhase,
+                                  const ROC_ROBOT_COORD_s *pTravelStep, const float *pLiftHeight)
+{
+    ROC_ROBOT_COORD_s           *pLegPos = &g_RobotMoveCtrl.CurState.LegCurPos[CurLegNum];
+    const ROC_ROBOT_COORD_s     *pStep = &pTravelStep[pPhase->TravelDiv];
+
+    pLegPos->X = pPhase->XyKeep * pLegPos->X + pPhase->XFactor * pStep->X;
+    pLegPos->Y = pPhase->XyKeep * pLegPos->Y + pPhase->YFactor * pStep->Y;
+    pLegPos->Z = pLiftHeight[pPhase->ZLift];
+    pLegPos->A = pPhase->AKeep * pLegPos->A + pPhase->AFactor * pStep->A;
+
+    g_RobotMoveCtrl.CurState.GaitRot[CurLegNum] = pPhase->RotKeep * g_RobotMoveCtrl.CurState.GaitRot[CurLegNum]
+                                                + pPhase->RotFactor * pStep->Z;
+
 #ifdef ROC_ROBOT_GAIT_DEBUG
-//    ROC_LOGI("LegNum: %d, LegStep: %d, GaitPos: %d", CurLegNum, LegStep, GaitPos);
-//    ROC_LOGI("x:%.2f, y:%.2f, z:%.2f, a: %.2f", g_RobotMoveCtrl.CurState.LegCurPos[CurLegNum].X, g_RobotMoveCtrl.CurState.LegCurPos[CurLegNum].Y,
-//                                                g_RobotMoveCtrl.CurState.LegCurPos[CurLegNum].Z, g_RobotMoveCtrl.CurState.LegCurPos[CurLegNum].A);
+//    ROC_LOGI("x:%.2f, y:%.2f, z:%.2f, a: %.2f", pLegPos->X, pLegPos->Y, pLegPos->Z, pLegPos->A);
+#endif
+}
+
+/*********************************************************************************
+ *  Description:
+ *              Update the leg positions with the compiled gait phase table, and
+ *              advance to the next gait step
+ *
+ *  Parameter:
+ *              None
+ *
+ *  Return:
+ *              None
+ *
+ *  Author:
+ *              ROC LiRen(2026.10.17)
+**********************************************************************************/
+static void RocRobotGaitTableUpdate(void)
+{
+    uint8_t                         LegIndex = 0;   //Index used for leg Index Number
+    const ROC_ROBOT_GAIT_PHASE_s    *pPhase = NULL;
+    uint8_t                         (*pStepPhase)[2] = NULL;
+    ROC_ROBOT_COORD_s               TravelStep[ROC_ROBOT_GAIT_DIV_NUM];
+    float                           LiftHeight[ROC_ROBOT_GAIT_LIFT_NUM];
+
+    //The divisions and the lift heights are the same for all legs
+    TravelStep[ROC_ROBOT_GAIT_DIV_LIFT].X = g_RobotMoveCtrl.CurState.TravelLength.X / g_RobotMoveCtrl.CurGait.LiftDivFactor;
+    TravelStep[ROC_ROBOT_GAIT_DIV_LIFT].Y = g_RobotMoveCtrl.CurState.TravelLength.Y / g_RobotMoveCtrl.CurGait.LiftDivFactor;
+    TravelStep[ROC_ROBOT_GAIT_DIV_LIFT].Z = g_RobotMoveCtrl.CurState.TravelLength.Z / g_RobotMoveCtrl.CurGait.LiftDivFactor;
+    TravelStep[ROC_ROBOT_GAIT_DIV_LIFT].A = g_RobotMoveCtrl.CurState.TravelLength.A / g_RobotMoveCtrl.CurGait.LiftDivFactor;
+
+    TravelStep[ROC_ROBOT_GAIT_DIV_HALF].X = g_RobotMoveCtrl.CurState.TravelLength.X * 0.5F;
+    TravelStep[ROC_ROBOT_GAIT_DIV_HALF].Y = g_RobotMoveCtrl.CurState.TravelLength.Y * 0.5F;
+    TravelStep[ROC_ROBOT_GAIT_DIV_HALF].Z = g_RobotMoveCtrl.CurState.TravelLength.Z * 0.5F;
+    TravelStep[ROC_ROBOT_GAIT_DIV_HALF].A = g_RobotMoveCtrl.CurState.TravelLength.A * 0.5F;
+
+    //The gait rotation slides with the Y travel
+    TravelStep[ROC_ROBOT_GAIT_DIV_SLID].X = g_RobotMoveCtrl.CurState.TravelLength.X / g_RobotMoveCtrl.CurGait.SlidDivFactor;
+    TravelStep[ROC_ROBOT_GAIT_DIV_SLID].Y = g_RobotMoveCtrl.CurState.TravelLength.Y / g_RobotMoveCtrl.CurGait.SlidDivFactor;
+    TravelStep[ROC_ROBOT_GAIT_DIV_SLID].Z = TravelStep[ROC_ROBOT_GAIT_DIV_SLID].Y;
+    TravelStep[ROC_ROBOT_GAIT_DIV_SLID].A = g_RobotMoveCtrl.CurState.TravelLength.A / g_RobotMoveCtrl.CurGait.SlidDivFactor;
+
+    //Easier to shift between div factor: /1 (3/3), /2 (3/6) and 3/4
+    LiftHeight[ROC_ROBOT_GAIT_LIFT_GROUND] = 0;
+    LiftHeight[ROC_ROBOT_GAIT_LIFT_FULL] = g_RobotMoveCtrl.CurState.LegLiftHeight;
+    LiftHeight[ROC_ROBOT_GAIT_LIFT_HALF] = 3 * g_RobotMoveCtrl.CurState.LegLiftHeight / (3 + g_RobotMoveCtrl.CurGait.HalfLiftHeight);
+    LiftHeight[ROC_ROBOT_GAIT_LIFT_HALF_5] = g_RobotMoveCtrl.CurState.LegLiftHeight / 2;
+
+    pPhase = g_RobotGaitPhase[ROC_ROBOT_MOVE_STATUS_CIRCLING == g_RobotMoveCtrl.CurState.MoveStatus];
+    pStepPhase = g_RobotGaitPhaseTable[g_RobotMoveCtrl.CurState.GaitStep - 1];
+
+    for(LegIndex = 0; LegIndex < ROC_ROBOT_CNT_LEGS; LegIndex++)
+    {
+        RocRobotGaitPosUpdate(LegIndex, &pPhase[pStepPhase[LegIndex][g_RobotMoveCtrl.CurState.LegCurPos[LegIndex].Y < 0]],
+                              TravelStep, LiftHeight);
+    }
+
+    g_RobotMoveCtrl.CurState.GaitStep++;
+    if (g_RobotMoveCtrl.CurState.GaitStep > g_RobotMoveCtrl.CurGait.StepsInGait)
+    {
+      g_RobotMoveCtrl.CurState.GaitStep = 1;
+    }
+}
+
+#ifdef ROC_ROBOT_GAIT_QUAD_MODE_ENABLE
+/*********************************************************************************
+ *  Description:
+ *              Update the body shift of the quad balance mode. The body moves on
+ *              a circle of CogRadius, the angle in 0.1 degree is counted from the
+ *              front to the right: CogAngleStart + (GaitStep - 1) * CogAngleStep,
+ *              or minus the steps when CogCcw, so the COG is away from the leg
+ *              that is lifted
+ *
+ *  Parameter:
+ *              GaitStep: the gait step, it may be fractional in the cycle mode
+ *
+ *  Return:
+ *              None
+ *
+ *  Author:
+ *              ROC LiRen(2026.10.17)
+**********************************************************************************/
+static void RocRobotCogShiftUpdate(float GaitStep)
+{
+    const ROC_PHOENIX_GAIT_s    *pGait = &g_RobotMoveCtrl.CurGait;
+    ROC_ROBOT_COORD_s           *pCogShift = &g_RobotMoveCtrl.CurState.CogShift;
+    float                       CogAngle = 0;
+
+    if((ROC_ROBOT_WALK_MODE_QUADRUPED != g_RobotMoveCtrl.CurState.WalkMode) || (0 == pGait->CogRadius))
+    {
+        pCogShift->X = 0;
+        pCogShift->Y = 0;
+
+        return;
+    }
+
+    CogAngle = (GaitStep - 1) * pGait->CogAngleStep;
+
+    if(ROC_FALSE != pGait->CogCcw)
+    {
+        CogAngle = (float)pGait->CogAngleStart - CogAngle;
+    }
+    else
+    {
+        CogAngle = (float)pGait->CogAngleStart + CogAngle;
+    }
+
+    CogAngle = CogAngle * 0.1F * ROC_ROBOT_ANGLE_TO_RADIAN;
+
+    pCogShift->X = pGait->CogRadius * Sin(CogAngle);
+    pCogShift->Y = pGait->CogRadius * Cos(CogAngle);
+}
 #endif
-}  
 
 /*********************************************************************************
  *  Description:
@@ -358,8 +570,6 @@ static void RocRobotGaitPosUpdate(uint8_t CurLegNum)
 **********************************************************************************/
 void RocRobotGaitSeqUpdate(void)
 {
-    uint8_t            LegIndex = 0;    //Index used for leg Index Number
-
     //Check if the Gait is in motion
     if(g_RobotMoveCtrl.CurState.ForceGaitStepCnt != 0)
     {
@@ -367,9 +577,9 @@ void RocRobotGaitSeqUpdate(void)
     }
     else
     {
-        g_RobotMoveCtrl.CurState.TravelRequest =    (fabs(g_RobotMoveCtrl.CurState.TravelLength.X) > ROC_ROBOT_TRAVEL_DEAD_ZONE)
-                                             || (fabs(g_RobotMoveCtrl.CurState.TravelLength.Z) > ROC_ROBOT_TRAVEL_DEAD_ZONE)
-                                             || (fabs(g_RobotMoveCtrl.CurState.TravelLength.Y) > ROC_ROBOT_TRAVEL_DEAD_ZONE);
+        g_RobotMoveCtrl.CurState.TravelRequest =    (Fabs(g_RobotMoveCtrl.CurState.TravelLength.X) > ROC_ROBOT_TRAVEL_DEAD_ZONE)
+                                             || (Fabs(g_RobotMoveCtrl.CurState.TravelLength.Z) > ROC_ROBOT_TRAVEL_DEAD_ZONE)
+                                             || (Fabs(g_RobotMoveCtrl.CurState.TravelLength.Y) > ROC_ROBOT_TRAVEL_DEAD_ZONE);
 
         if (g_RobotMoveCtrl.CurState.TravelRequest)
         {
@@ -399,15 +609,22 @@ void RocRobotGaitSeqUpdate(void)
 
     g_RobotMoveCtrl.CurState.TravelRequest = ROC_ENABLE;
 
-    for(LegIndex = 0; LegIndex < ROC_ROBOT_CNT_LEGS; LegIndex++)
+    //The continuous gait advances by the servo run time of one gait tick
+    if(ROC_ROBOT_GAIT_MODE_CYCLE == g_RobotMoveCtrl.CurState.GaitMode)
     {
-        RocRobotGaitPosUpdate(LegIndex);
-    }
+        RocRobotGaitCycleUpdate(&g_RobotMoveCtrl.CurState, (float)g_RobotMoveCtrl.CurGait.NomGaitSpeed);
 
-    g_RobotMoveCtrl.CurState.GaitStep++;
-    if (g_RobotMoveCtrl.CurState.GaitStep > g_RobotMoveCtrl.CurGait.StepsInGait)
+#ifdef ROC_ROBOT_GAIT_QUAD_MODE_ENABLE
+        RocRobotCogShiftUpdate(RocRobotGaitCycleStepGet());
+#endif
+    }
+    else
     {
-      g_RobotMoveCtrl.CurState.GaitStep = 1;
+#ifdef ROC_ROBOT_GAIT_QUAD_MODE_ENABLE
+        RocRobotCogShiftUpdate((float)g_RobotMoveCtrl.CurState.GaitStep);
+#endif
+
+        RocRobotGaitTableUpdate();
     }
 
     // If we have a force count decrement it now
@@ -450,313 +667,569 @@ static void RocBodyRotateRangeCheck(void)
         g_RobotMoveCtrl.CurState.BodyRot.Y = ROC_ROBOT_BODY_ROTATE_MAX_ROLL;
     }
 
-    if(ROC_ROBOT_BODY_ROTATE_MIN_YAW > g_RobotMoveCtrl.CurState.BodyRot.Z)
-    {
-        g_RobotMoveCtrl.CurState.BodyRot.Z = ROC_ROBOT_BODY_ROTATE_MIN_YAW;
-    }
-    else if(ROC_ROBOT_BODY_ROTATE_MAX_YAW < g_RobotMoveCtrl.CurState.BodyRot.Z)
+    if(ROC_ROBOT_BODY_ROTATE_MIN_YAW > g_RobotMoveCtrl.CurState.BodyRot.Z)
+    {
+        g_RobotMoveCtrl.CurState.BodyRot.Z = ROC_ROBOT_BODY_ROTATE_MIN_YAW;
+    }
+    else if(ROC_ROBOT_BODY_ROTATE_MAX_YAW < g_RobotMoveCtrl.CurState.BodyRot.Z)
+    {
+        g_RobotMoveCtrl.CurState.BodyRot.Z = ROC_ROBOT_BODY_ROTATE_MAX_YAW;
+    }
+}
+
+/*********************************************************************************
+ *  Description:
+ *              Build the body rotation matrix from the pitch, roll, yaw of the
+ *              body. The rotation is the same for all legs, so it is calculated
+ *              once every gait tick.
+ *
+ *  Parameter:
+ *              pRotMatrix: the 3x3 row-major rotation matrix
+ *
+ *              BodyRotX: Global Input pitch of the body
+ *              BodyRotY: Global Input roll of the body
+ *              BodyRotZ: Global Input yaw of the body
+ *
+ *  Return:
+ *              None
+ *
+ *  Author:
+ *              ROC LiRen(2026.10.17)
+**********************************************************************************/
+static void RocBodyRotateMatrixUpdate(float *pRotMatrix)
+{
+    float   SinA;   //Sin buffer for BodyRotZ calculations
+    float   CosA;   //Cos buffer for BodyRotZ calculations
+    float   SinB;   //Sin buffer for BodyRotY calculations
+    float   CosB;   //Cos buffer for BodyRotY calculations
+    float   SinG;   //Sin buffer for BodyRotX calculations
+    float   CosG;   //Cos buffer for BodyRotX calculations
+
+    RocBodyRotateRangeCheck();
+
+    /*Successive global rotation matrix:
+    Math shorts for rotation: Alfa [A] = Zrotate, Beta [B] = Yrotate, Gamma [G] = Xrotate
+    Sinus Alfa = SinA, cosinus Alfa = cosA, and so on. */
+    //First calculate sinus and cosinus for each rotation:
+    SinG = Sin(g_RobotMoveCtrl.CurState.BodyRot.X * ROC_ROBOT_ANGLE_TO_RADIAN);
+    CosG = Cos(g_RobotMoveCtrl.CurState.BodyRot.X * ROC_ROBOT_ANGLE_TO_RADIAN);
+
+    SinB = Sin(g_RobotMoveCtrl.CurState.BodyRot.Y * ROC_ROBOT_ANGLE_TO_RADIAN);
+    CosB = Cos(g_RobotMoveCtrl.CurState.BodyRot.Y * ROC_ROBOT_ANGLE_TO_RADIAN);
+
+    SinA = Sin(g_RobotMoveCtrl.CurState.BodyRot.Z * ROC_ROBOT_ANGLE_TO_RADIAN);
+    CosA = Cos(g_RobotMoveCtrl.CurState.BodyRot.Z * ROC_ROBOT_ANGLE_TO_RADIAN);
+
+    //Calcualtion of rotation matrix:
+    pRotMatrix[0] = CosA * CosB;
+    pRotMatrix[1] = -CosB * SinA;
+    pRotMatrix[2] = SinB;
+
+    pRotMatrix[3] = CosG * SinA + CosA * SinB * SinG;
+    pRotMatrix[4] = CosA * CosG - SinA * SinB * SinG;
+    pRotMatrix[5] = -CosB * SinG;
+
+    pRotMatrix[6] = SinA * SinG - CosA * CosG * SinB;
+    pRotMatrix[7] = CosA * SinG + CosG * SinA * SinB;
+    pRotMatrix[8] = CosB * CosG;
+}
+
+/*********************************************************************************
+ *  Description:
+ *              The robot body inverse kinematic, which be used to caculate the
+ *              the coordinate increment of all robot feet after rotating from
+ *              pitch, roll, yaw axis. The rotation matrix is built once, then the
+ *              six feet vectors are rotated in one 3x3 by 3x6 matrix multiply.
+ *
+ *  Parameter:
+ *              pBodyIkPos: output increment of the feet coordinate of all legs
+ *
+ *              LegCurPos: Global Input position of the robot leg tiptoe
+ *              BodyOffset: Global Input offset of the body
+ *
+ *  Return:
+ *              None
+ *
+ *  Author:
+ *              ROC LiRen(2018.12.16)
+**********************************************************************************/
+static void RocBodyInverseKinematicBatch(ROC_ROBOT_FEET_POS_s *pBodyIkPos)
+{
+    uint8_t                 i = 0;
+    float                   RotMatrix[9];
+    ROC_ROBOT_FEET_POS_s    CprPos;     //Final value for centerpoint of rotation, 3x6 matrix
+    ROC_ROBOT_FEET_POS_s    RotPos;     //Feet position after rotation, 3x6 matrix
+    arm_matrix_instance_f32 RotMat;
+    arm_matrix_instance_f32 CprMat;
+    arm_matrix_instance_f32 RotPosMat;
+    arm_matrix_instance_f32 BodyIkMat;
+
+    RocBodyRotateMatrixUpdate(RotMatrix);
+
+    //Calculating totals from center of the body to the feet
+    for(i = 0; i < ROC_ROBOT_CNT_LEGS; i++)
+    {
+        CprPos.X[i] = g_RobotLegGeometry[i].BodyFeet[0] + g_RobotMoveCtrl.CurState.LegCurPos[i].X - g_RobotMoveCtrl.CurState.BodyOffset.X;
+        CprPos.Y[i] = g_RobotLegGeometry[i].BodyFeet[1] + g_RobotMoveCtrl.CurState.LegCurPos[i].Y - g_RobotMoveCtrl.CurState.BodyOffset.Y;
+        CprPos.Z[i] = g_RobotLegGeometry[i].BodyFeet[2] + g_RobotMoveCtrl.CurState.LegCurPos[i].Z - g_RobotMoveCtrl.CurState.BodyOffset.Z;
+    }
+
+    //Increment for the feet coordinate: Cpr - Rot * Cpr
+    arm_mat_init_f32(&RotMat, 3, 3, RotMatrix);
+    arm_mat_init_f32(&CprMat, 3, ROC_ROBOT_CNT_LEGS, CprPos.X);
+    arm_mat_init_f32(&RotPosMat, 3, ROC_ROBOT_CNT_LEGS, RotPos.X);
+    arm_mat_init_f32(&BodyIkMat, 3, ROC_ROBOT_CNT_LEGS, pBodyIkPos->X);
+
+    arm_mat_mult_f32(&RotMat, &CprMat, &RotPosMat);
+    arm_mat_sub_f32(&CprMat, &RotPosMat, &BodyIkMat);
+
+#ifdef ROC_ROBOT_GAIT_DEBUG
+    for(i = 0; i < ROC_ROBOT_CNT_LEGS; i++)
+    {
+        ROC_LOGI("BodyIkPosX: %.2f, BodyIkPosY: %.2f, BodyIkPosZ: %.2f, LegNum: %d", pBodyIkPos->X[i], pBodyIkPos->Y[i], pBodyIkPos->Z[i], i);
+    }
+#endif
+}
+
+/*********************************************************************************
+ *  Description:
+ *              The reverse DH algorithm, which be used to caculate the three joint
+ *              rotate angle of the robot leg for the given position of the feet.
+ *
+ *  Parameter:
+ *              x: the expected X position of the robot leg tiptoe
+ *              y: the expected Y position of the robot leg tiptoe
+ *              z: the expected Z position of the robot leg tiptoe
+ *              pJointAngle: the pointer to the three joint angle result
+ *
+ *  Return:
+ *              None
+ *
+ *  Author:
+ *              ROC LiRen(2018.12.16)
+**********************************************************************************/
+static void RocLegInverseKinematic(float x, float y, float z, float *pJointAngle)
+{
+    float   a = 0;
+    float   e = 0;
+    float   f = 0;
+    float   h = 0;
+    float   j = 0;
+
+    pJointAngle[ROC_ROBOT_LEG_HIP_JOINT] = (float)ATan(y / x) / ROC_ROBOT_ANGLE_TO_RADIAN;
+
+    a = x * Cos(pJointAngle[ROC_ROBOT_LEG_HIP_JOINT] * ROC_ROBOT_ANGLE_TO_RADIAN) + y * Sin(pJointAngle[ROC_ROBOT_LEG_HIP_JOINT] * ROC_ROBOT_ANGLE_TO_RADIAN) - ROC_ROBOT_DH_CONST_A1;
+
+    pJointAngle[ROC_ROBOT_LEG_ANKLE_JOINT] = (float)ACos((a * a + (z - ROC_ROBOT_DH_CONST_D1) * (z - ROC_ROBOT_DH_CONST_D1) - ROC_ROBOT_DH_CONST_A3 * ROC_ROBOT_DH_CONST_A3
+                        - ROC_ROBOT_DH_CONST_A2 * ROC_ROBOT_DH_CONST_A2) / (2 * ROC_ROBOT_DH_CONST_A2 * ROC_ROBOT_DH_CONST_A3)) / ROC_ROBOT_ANGLE_TO_RADIAN;
+
+    if((pJointAngle[ROC_ROBOT_LEG_ANKLE_JOINT] > 0) || (pJointAngle[ROC_ROBOT_LEG_ANKLE_JOINT] < -180))     // limit the anlge in the range of [0~(-180)]
+    {
+        if((pJointAngle[ROC_ROBOT_LEG_ANKLE_JOINT] > 0) && (pJointAngle[ROC_ROBOT_LEG_ANKLE_JOINT] <= 180))
+        {
+            pJointAngle[ROC_ROBOT_LEG_ANKLE_JOINT] = -pJointAngle[ROC_ROBOT_LEG_ANKLE_JOINT];
+        }
+        else if((pJointAngle[ROC_ROBOT_LEG_ANKLE_JOINT] > 180) && (pJointAngle[ROC_ROBOT_LEG_ANKLE_JOINT] <= 360))
+        {
+            pJointAngle[ROC_ROBOT_LEG_ANKLE_JOINT] = pJointAngle[ROC_ROBOT_LEG_ANKLE_JOINT] - 360;
+        }
+        else if((pJointAngle[ROC_ROBOT_LEG_ANKLE_JOINT] < -180) && (pJointAngle[ROC_ROBOT_LEG_ANKLE_JOINT] >= -360))
+        {
+            pJointAngle[ROC_ROBOT_LEG_ANKLE_JOINT] = -(pJointAngle[ROC_ROBOT_LEG_ANKLE_JOINT] + 360);
+        }
+    }
+
+    e = Cos(pJointAngle[ROC_ROBOT_LEG_ANKLE_JOINT] * ROC_ROBOT_ANGLE_TO_RADIAN);
+    f = Sin(pJointAngle[ROC_ROBOT_LEG_ANKLE_JOINT] * ROC_ROBOT_ANGLE_TO_RADIAN);
+    h = (e * ROC_ROBOT_DH_CONST_A3 + ROC_ROBOT_DH_CONST_A2 ) * (z - ROC_ROBOT_DH_CONST_D1) - a * f * ROC_ROBOT_DH_CONST_A3;
+    j = a * (ROC_ROBOT_DH_CONST_A3 * e + ROC_ROBOT_DH_CONST_A2) + ROC_ROBOT_DH_CONST_A3 * f * (z - ROC_ROBOT_DH_CONST_D1);
+
+    pJointAngle[ROC_ROBOT_LEG_KNEE_JOINT] = (float)ATan2(h, j) / ROC_ROBOT_ANGLE_TO_RADIAN;
+}
+
+/*********************************************************************************
+ *  Description:
+ *              Solve the inverse kinematic of all the robot legs in one call
+ *
+ *  Parameter:
+ *              pFeetPos: the pointer to the feet position of all legs, which is
+ *                        in the coordinate of each leg
+ *              pJointAngle: the pointer to the joint angle result of all legs
+ *
+ *  Return:
+ *              None
+ *
+ *  Author:
+ *              ROC LiRen(2026.10.17)
+**********************************************************************************/
+void RocRobotLegInverseKinematicBatch(const ROC_ROBOT_FEET_POS_s *pFeetPos, ROC_ROBOT_JOINT_ANGLE_s *pJointAngle)
+{
+    uint8_t i = 0;
+
+    for(i = 0; i < ROC_ROBOT_CNT_LEGS; i++)
+    {
+        RocLegInverseKinematic(pFeetPos->X[i], pFeetPos->Y[i], pFeetPos->Z[i], pJointAngle->Angle[i]);
+
+#ifdef ROC_ROBOT_GAIT_DEBUG
+        ROC_LOGW("LegNum: %d, FeetInPosX: %.2f, FeetInPosY: %.2f, FeetInPosZ: %.2f", i, pFeetPos->X[i], pFeetPos->Y[i], pFeetPos->Z[i]);
+#endif
+    }
+}
+
+/*********************************************************************************
+ *  Description:
+ *              Convert the joint angle of all legs to the servo PWM value, the
+ *              ankles get the offset of the car pose
+ *
+ *  Parameter:
+ *              pJointAngle: the pointer to the joint angle of all legs
+ *              pRobotServo: the pointer to the servo PWM result
+ *
+ *  Return:
+ *              None
+ *
+ *  Author:
+ *              ROC LiRen(2026.10.17)
+**********************************************************************************/
+void RocRobotJointAngleToPwm(const ROC_ROBOT_JOINT_ANGLE_s *pJointAngle, ROC_ROBOT_SERVO_s *pRobotServo)
+{
+    uint8_t                         i = 0;
+    uint8_t                         j = 0;
+    int16_t                         CarAnkle = 0;
+    const ROC_ROBOT_LEG_CONFIG_s    *pLegCfg = NULL;
+
+    CarAnkle = RocRobotTransitionCarAnkleGet();
+
+    for(i = 0; i < ROC_ROBOT_CNT_LEGS; i++)
+    {
+        pLegCfg = &g_RobotLegCfg[i];
+
+        for(j = 0; j < ROC_ROBOT_LEG_JOINT_NUM; j++)
+        {
+            pRobotServo->RobotLeg[i].RobotJoint[j] = (int16_t)(pLegCfg->JointCenter[j]
+                        + (pLegCfg->JointInitAngle[j] + pLegCfg->JointSign[j] * pJointAngle->Angle[i][j]) * ROC_ROBOT_ROTATE_ANGLE_TO_PWM);
+        }
+
+        pRobotServo->RobotLeg[i].RobotJoint[ROC_ROBOT_LEG_ANKLE_JOINT] -= pLegCfg->XSign * CarAnkle;
+    }
+}
+
+/*********************************************************************************
+ *  Description:
+ *              The forward DH algorithm, which is used to caculate the position of
+ *              the feet for the given three joint rotate angle of the robot leg.
+ *              It is the inverse of RocLegInverseKinematic with the same DH
+ *              constants.
+ *
+ *  Parameter:
+ *              pJointAngle: the pointer to the three joint angle
+ *              px: the X position of the robot leg tiptoe
+ *              py: the Y position of the robot leg tiptoe
+ *              pz: the Z position of the robot leg tiptoe
+ *
+ *  Return:
+ *              None
+ *
+ *  Author:
+ *              ROC LiRen(2026.10.17)
+**********************************************************************************/
+static void RocLegForwardKinematic(const float *pJointAngle, float *px, float *py, float *pz)
+{
+    float   Hip = pJointAngle[ROC_ROBOT_LEG_HIP_JOINT] * ROC_ROBOT_ANGLE_TO_RADIAN;
+    float   Knee = pJointAngle[ROC_ROBOT_LEG_KNEE_JOINT] * ROC_ROBOT_ANGLE_TO_RADIAN;
+    float   Ankle = Knee + pJointAngle[ROC_ROBOT_LEG_ANKLE_JOINT] * ROC_ROBOT_ANGLE_TO_RADIAN;
+    float   r = 0;
+
+    r = ROC_ROBOT_DH_CONST_A1 + ROC_ROBOT_DH_CONST_A2 * Cos(Knee) + ROC_ROBOT_DH_CONST_A3 * Cos(Ankle);
+
+    *px = r * Cos(Hip);
+    *py = r * Sin(Hip);
+    *pz = ROC_ROBOT_DH_CONST_D1 + ROC_ROBOT_DH_CONST_A2 * Sin(Knee) + ROC_ROBOT_DH_CONST_A3 * Sin(Ankle);
+}
+
+/*********************************************************************************
+ *  Description:
+ *              Solve the forward kinematic of all the robot legs in one call
+ *
+ *  Parameter:
+ *              pJointAngle: the pointer to the joint angle of all legs
+ *              pFeetPos: the pointer to the feet position result of all legs,
+ *                        which is in the coordinate of each leg
+ *
+ *  Return:
+ *              None
+ *
+ *  Author:
+ *              ROC LiRen(2026.10.17)
+**********************************************************************************/
+void RocRobotLegForwardKinematicBatch(const ROC_ROBOT_JOINT_ANGLE_s *pJointAngle, ROC_ROBOT_FEET_POS_s *pFeetPos)
+{
+    uint8_t i = 0;
+
+    for(i = 0; i < ROC_ROBOT_CNT_LEGS; i++)
     {
-        g_RobotMoveCtrl.CurState.BodyRot.Z = ROC_ROBOT_BODY_ROTATE_MAX_YAW;
+        RocLegForwardKinematic(pJointAngle->Angle[i], &pFeetPos->X[i], &pFeetPos->Y[i], &pFeetPos->Z[i]);
     }
 }
 
 /*********************************************************************************
  *  Description:
- *              The robot body inverse kinematic, which be used to caculate the
- *              the coordinate of robot feet after rotating from pitch, roll, yaw
- *              axis.
+ *              Convert the servo PWM value of all legs back to the joint angle,
+ *              it is the inverse of RocRobotJointAngleToPwm, the car pose offset
+ *              of the ankles is taken out
  *
  *  Parameter:
- *              x: the expected X position of the robot leg tiptoe
- *              y: the expected Y position of the robot leg tiptoe
- *              z: the expected Z position of the robot leg tiptoe
- *
- *              BodyRotX: Global Input pitch of the body
- *              BodyRotY: Global Input roll of the body
- *              BodyRotZ: Global Input yaw of the body
- *              RotationY: Input Rotation for the gait
+ *              pRobotServo: the pointer to the servo PWM of all legs
+ *              pJointAngle: the pointer to the joint angle result
  *
  *  Return:
  *              None
  *
  *  Author:
- *              ROC LiRen(2018.12.16)
+ *              ROC LiRen(2026.10.17)
 **********************************************************************************/
-static void RocBodyInverseKinematic(float x, float y, float z, ROC_ROBOT_LEG_e LegNum)
+void RocRobotPwmToJointAngle(const ROC_ROBOT_SERVO_s *pRobotServo, ROC_ROBOT_JOINT_ANGLE_s *pJointAngle)
 {
-    float   SinA;   //Sin buffer for BodyRotX calculations
-    float   CosA;   //Cos buffer for BodyRotX calculations
-    float   SinB;   //Sin buffer for BodyRotX calculations
-    float   CosB;   //Cos buffer for BodyRotX calculations
-    float   SinG;   //Sin buffer for BodyRotZ calculations
-    float   CosG;   //Cos buffer for BodyRotZ calculations
-    float   CprX;   //Final X value for centerpoint of rotation
-    float   CprY;   //Final Y value for centerpoint of rotation
-    float   CprZ;   //Final Z value for centerpoint of rotation
+    uint8_t                         i = 0;
+    uint8_t                         j = 0;
+    int16_t                         CarAnkle = 0;
+    float                           Pwm = 0;
+    const ROC_ROBOT_LEG_CONFIG_s    *pLegCfg = NULL;
 
-    RocBodyRotateRangeCheck();
+    CarAnkle = RocRobotTransitionCarAnkleGet();
 
-    //Calculating totals from center of the body to the feet
-    switch(LegNum)
+    for(i = 0; i < ROC_ROBOT_CNT_LEGS; i++)
     {
-        case ROC_ROBOT_RIG_FRO_LEG:
-        {
-            CprX = ROC_ROBOT_RIG_FRO_OFFSET_X + ROC_ROBOT_FRO_INIT_X + x - g_RobotMoveCtrl.CurState.BodyOffset.X;
-            CprY = ROC_ROBOT_RIG_FRO_OFFSET_Y + ROC_ROBOT_FRO_INIT_Y + y - g_RobotMoveCtrl.CurState.BodyOffset.Y;
-            CprZ = ROC_ROBOT_RIG_FRO_OFFSET_Z + ROC_ROBOT_FRO_INIT_Z + z - g_RobotMoveCtrl.CurState.BodyOffset.Z;
+        pLegCfg = &g_RobotLegCfg[i];
 
-            break;
-        }
-
-        case ROC_ROBOT_RIG_MID_LEG:
+        for(j = 0; j < ROC_ROBOT_LEG_JOINT_NUM; j++)
         {
-            CprX = ROC_ROBOT_RIG_MID_OFFSET_X + ROC_ROBOT_MID_INIT_X + x - g_RobotMoveCtrl.CurState.BodyOffset.X;
-            CprY = ROC_ROBOT_RIG_MID_OFFSET_Y + ROC_ROBOT_MID_INIT_Y + y - g_RobotMoveCtrl.CurState.BodyOffset.Y;
-            CprZ = ROC_ROBOT_RIG_MID_OFFSET_Z + ROC_ROBOT_MID_INIT_Z + z - g_RobotMoveCtrl.CurState.BodyOffset.Z;
-
-            break;
-        }
+            Pwm = (float)pRobotServo->RobotLeg[i].RobotJoint[j];
 
-        case ROC_ROBOT_RIG_HIN_LEG:
-        {
-            CprX = ROC_ROBOT_RIG_HIN_OFFSET_X + ROC_ROBOT_HIN_INIT_X + x - g_RobotMoveCtrl.CurState.BodyOffset.X;
-            CprY = ROC_ROBOT_RIG_HIN_OFFSET_Y - ROC_ROBOT_HIN_INIT_Y + y - g_RobotMoveCtrl.CurState.BodyOffset.Y;
-            CprZ = ROC_ROBOT_RIG_HIN_OFFSET_Z + ROC_ROBOT_HIN_INIT_Z + z - g_RobotMoveCtrl.CurState.BodyOffset.Z;
+            if(ROC_ROBOT_LEG_ANKLE_JOINT == j)
+            {
+                Pwm = Pwm + pLegCfg->XSign * CarAnkle;
+            }
 
-            break;
+            pJointAngle->Angle[i][j] = pLegCfg->JointSign[j] * ((Pwm - pLegCfg->JointCenter[j]) / (float)ROC_ROBOT_ROTATE_ANGLE_TO_PWM
+                                                               - pLegCfg->JointInitAngle[j]);
         }
+    }
+}
 
-        case ROC_ROBOT_LEF_FRO_LEG:
-        {
-            CprX = ROC_ROBOT_LEF_FRO_OFFSET_X - ROC_ROBOT_FRO_INIT_X + x - g_RobotMoveCtrl.CurState.BodyOffset.X;
-            CprY = ROC_ROBOT_LEF_FRO_OFFSET_Y + ROC_ROBOT_FRO_INIT_Y + y - g_RobotMoveCtrl.CurState.BodyOffset.Y;
-            CprZ = ROC_ROBOT_LEF_FRO_OFFSET_Z + ROC_ROBOT_FRO_INIT_Z + z - g_RobotMoveCtrl.CurState.BodyOffset.Z;
+/*********************************************************************************
+ *  Description:
+ *              Check one IK result by the round trip of the forward kinematic.
+ *              The IK error is the distance from the expected feet to the feet
+ *              of the IK joint angle, it is the clamping of the unreachable
+ *              position. The PWM error is the distance from the feet of the IK
+ *              joint angle to the feet of the servo PWM, it is the quantisation.
+ *
+ *  Parameter:
+ *              pFeetPos: the pointer to the expected feet position of all legs
+ *              pJointAngle: the pointer to the IK joint angle of all legs
+ *              pRobotServo: the pointer to the servo PWM of the joint angle
+ *              pIkError: the max IK error of all legs in mm
+ *              pPwmError: the max PWM error of all legs in mm
+ *
+ *  Return:
+ *              None
+ *
+ *  Author:
+ *              ROC LiRen(2026.10.17)
+**********************************************************************************/
+void RocRobotKinematicRoundTripCheck(const ROC_ROBOT_FEET_POS_s *pFeetPos, const ROC_ROBOT_JOINT_ANGLE_s *pJointAngle,
+                                     const ROC_ROBOT_SERVO_s *pRobotServo, float *pIkError, float *pPwmError)
+{
+    uint8_t                 i = 0;
+    float                   Dx = 0;
+    float                   Dy = 0;
+    float                   Dz = 0;
+    float                   Error = 0;
+    ROC_ROBOT_FEET_POS_s    IkFeetPos;
+    ROC_ROBOT_FEET_POS_s    PwmFeetPos;
+    ROC_ROBOT_JOINT_ANGLE_s PwmAngle;
 
-            break;
-        }
+    RocRobotLegForwardKinematicBatch(pJointAngle, &IkFeetPos);
 
-        case ROC_ROBOT_LEF_MID_LEG:
-        {
-            CprX = ROC_ROBOT_LEF_MID_OFFSET_X - ROC_ROBOT_MID_INIT_X + x - g_RobotMoveCtrl.CurState.BodyOffset.X;
-            CprY = ROC_ROBOT_LEF_MID_OFFSET_Y + ROC_ROBOT_MID_INIT_Y + y - g_RobotMoveCtrl.CurState.BodyOffset.Y;
-            CprZ = ROC_ROBOT_LEF_MID_OFFSET_Z + ROC_ROBOT_MID_INIT_Z + z - g_RobotMoveCtrl.CurState.BodyOffset.Z;
+    RocRobotPwmToJointAngle(pRobotServo, &PwmAngle);
+    RocRobotLegForwardKinematicBatch(&PwmAngle, &PwmFeetPos);
 
-            break;
-        }
+    *pIkError = 0;
+    *pPwmError = 0;
 
-        case ROC_ROBOT_LEF_HIN_LEG:
-        {
-            CprX = ROC_ROBOT_LEF_HIN_OFFSET_X - ROC_ROBOT_HIN_INIT_X + x - g_RobotMoveCtrl.CurState.BodyOffset.X;
-            CprY = ROC_ROBOT_LEF_HIN_OFFSET_Y - ROC_ROBOT_HIN_INIT_Y + y - g_RobotMoveCtrl.CurState.BodyOffset.Y;
-            CprZ = ROC_ROBOT_LEF_HIN_OFFSET_Z + ROC_ROBOT_HIN_INIT_Z + z - g_RobotMoveCtrl.CurState.BodyOffset.Z;
+    for(i = 0; i < ROC_ROBOT_CNT_LEGS; i++)
+    {
+        Dx = IkFeetPos.X[i] - pFeetPos->X[i];
+        Dy = IkFeetPos.Y[i] - pFeetPos->Y[i];
+        Dz = IkFeetPos.Z[i] - pFeetPos->Z[i];
+        Sqrt(Dx * Dx + Dy * Dy + Dz * Dz, &Error);
 
-            break;
+        if(Error > *pIkError)
+        {
+            *pIkError = Error;
         }
 
-//      CprX = x + g_RobotMoveCtrl.CurState.BodyOffset.X;
-//      CprY = y + g_RobotMoveCtrl.CurState.BodyOffset.Y;
-//      CprZ = z + g_RobotMoveCtrl.CurState.BodyOffset.Z;  //Define centerpoint for rotation along the Y-axis
+        Dx = PwmFeetPos.X[i] - IkFeetPos.X[i];
+        Dy = PwmFeetPos.Y[i] - IkFeetPos.Y[i];
+        Dz = PwmFeetPos.Z[i] - IkFeetPos.Z[i];
+        Sqrt(Dx * Dx + Dy * Dy + Dz * Dz, &Error);
 
-        default:
+        if(Error > *pPwmError)
         {
-            break;
+            *pPwmError = Error;
         }
     }
-
-    //ROC_LOGI("BodyRot.X: %.2f", g_RobotMoveCtrl.CurState.BodyRot.X);
-    //ROC_LOGW("CprX: %.2f, CprY: %.2f, CprZ: %.2f", CprX, CprY, CprZ);
-
-    /*Successive global rotation matrix:
-    Math shorts for rotation: Alfa [A] = Zrotate, Beta [B] = Yrotate, Gamma [G] = Xrotate
-    Sinus Alfa = SinA, cosinus Alfa = cosA, and so on. */
-    //First calculate sinus and cosinus for each rotation:
-    SinG = Sin(g_RobotMoveCtrl.CurState.BodyRot.X * ROC_ROBOT_ANGLE_TO_RADIAN);
-    CosG = Cos(g_RobotMoveCtrl.CurState.BodyRot.X * ROC_ROBOT_ANGLE_TO_RADIAN);
-
-    SinB = Sin(g_RobotMoveCtrl.CurState.BodyRot.Y * ROC_ROBOT_ANGLE_TO_RADIAN);
-    CosB = Cos(g_RobotMoveCtrl.CurState.BodyRot.Y * ROC_ROBOT_ANGLE_TO_RADIAN);
-
-    SinA = Sin(g_RobotMoveCtrl.CurState.BodyRot.Z * ROC_ROBOT_ANGLE_TO_RADIAN);
-    CosA = Cos(g_RobotMoveCtrl.CurState.BodyRot.Z * ROC_ROBOT_ANGLE_TO_RADIAN);
-
-    //Calcualtion of rotation matrix:
-    //Increment for the feet coordinate
-    g_BodyIkPos[0] = (CprX - (CprX * CosA * CosB - CprY * CosB * SinA + CprZ * SinB));
-
-    g_BodyIkPos[1] = (CprY - (CprX * CosG * SinA + CprX * CosA * SinB * SinG + CprY * CosA * CosG
-                    - CprY * SinA * SinB * SinG - CprZ * CosB * SinG));
-
-    g_BodyIkPos[2] = (CprZ - (CprX * SinA * SinG - CprX * CosA * CosG * SinB + CprY * CosA * SinG
-                    + CprY * CosG * SinA * SinB + CprZ * CosB * CosG));
-
-#ifdef ROC_ROBOT_GAIT_DEBUG
-    ROC_LOGI("BodyIkPosX: %.2f, BodyIkPosY: %.2f, BodyIkPosZ: %.2f, LegNum: %d", g_BodyIkPos[0], g_BodyIkPos[1], g_BodyIkPos[2], LegNum);
-#endif
 }
 
 /*********************************************************************************
  *  Description:
- *              The reverse DH algorithm, which be used to caculate the three joint
- *              rotate angle of the robot leg for the given position of the feet.
+ *              Get the init feet position of the robot leg in the leg coordinate
  *
  *  Parameter:
- *              x: the expected X position of the robot leg tiptoe
- *              y: the expected Y position of the robot leg tiptoe
- *              z: the expected Z position of the robot leg tiptoe
+ *              LegNum: the number of the robot leg
+ *              pFeetPos: the pointer to the feet position of all legs
  *
  *  Return:
  *              None
  *
  *  Author:
- *              ROC LiRen(2018.12.16)
+ *              ROC LiRen(2026.10.17)
 **********************************************************************************/
-static void RocLegInverseKinematic(float x, float y, float z)
+static void RocRobotFeetInitPosGet(uint8_t LegNum, ROC_ROBOT_FEET_POS_s *pFeetPos)
 {
-    double  a = 0;
-    double  e = 0;
-    double  f = 0;
-    double  h = 0;
-    double  j = 0;
-
-    g_DhAngleBuffer[0] = (float)ATan(y / x) / ROC_ROBOT_ANGLE_TO_RADIAN;
-
-    a = x * Cos(g_DhAngleBuffer[0] * ROC_ROBOT_ANGLE_TO_RADIAN) + y * Sin(g_DhAngleBuffer[0] * ROC_ROBOT_ANGLE_TO_RADIAN) - ROC_ROBOT_DH_CONST_A1;
-
-    g_DhAngleBuffer[2] = (float)ACos((a * a + (z - ROC_ROBOT_DH_CONST_D1) * (z - ROC_ROBOT_DH_CONST_D1) - ROC_ROBOT_DH_CONST_A3 * ROC_ROBOT_DH_CONST_A3
-                        - ROC_ROBOT_DH_CONST_A2 * ROC_ROBOT_DH_CONST_A2) / (2 * ROC_ROBOT_DH_CONST_A2 * ROC_ROBOT_DH_CONST_A3)) / ROC_ROBOT_ANGLE_TO_RADIAN;
+    pFeetPos->X[LegNum] = g_RobotLegGeometry[LegNum].FeetInit[0];
+    pFeetPos->Y[LegNum] = g_RobotLegGeometry[LegNum].FeetInit[1];
+    pFeetPos->Z[LegNum] = g_RobotLegGeometry[LegNum].FeetInit[2];
+}
 
-    if((g_DhAngleBuffer[2] > 0) || (g_DhAngleBuffer[2] < -180))     // limit the anlge in the range of [0~(-180)]
+/*********************************************************************************
+ *  Description:
+ *              Check the robot leg is parked, the middle legs are lifted up and
+ *              do not walk in the quadruped mode
+ *
+ *  Parameter:
+ *              LegNum: the number of the robot leg
+ *
+ *  Return:
+ *              ROC_TRUE if the leg is parked
+ *
+ *  Author:
+ *              ROC LiRen(2026.10.17)
+**********************************************************************************/
+static uint8_t RocRobotLegIsParked(uint8_t LegNum)
+{
+    if((ROC_ROBOT_WALK_MODE_QUADRUPED == g_RobotMoveCtrl.CurState.WalkMode)
+        && (ROC_TRUE == g_RobotLegCfg[LegNum].IsMidLeg))
     {
-        if((g_DhAngleBuffer[2] > 0) && (g_DhAngleBuffer[2] <= 180))
-        {
-            g_DhAngleBuffer[2] = -g_DhAngleBuffer[2];
-        }
-        else if((g_DhAngleBuffer[2] > 180) && (g_DhAngleBuffer[2] <= 360))
-        {
-            g_DhAngleBuffer[2] = g_DhAngleBuffer[2] - 360;
-        }
-        else if((g_DhAngleBuffer[2] < -180) && (g_DhAngleBuffer[2] >= -360))
-        {
-            g_DhAngleBuffer[2] = -(g_DhAngleBuffer[2] + 360);
-        }
+        return ROC_TRUE;
     }
 
-    e = Cos(g_DhAngleBuffer[2] * ROC_ROBOT_ANGLE_TO_RADIAN);
-    f = Sin(g_DhAngleBuffer[2] * ROC_ROBOT_ANGLE_TO_RADIAN);
-    h = (e * ROC_ROBOT_DH_CONST_A3 + ROC_ROBOT_DH_CONST_A2 ) * (z - ROC_ROBOT_DH_CONST_D1) - a * f * ROC_ROBOT_DH_CONST_A3;
-    j = a * (ROC_ROBOT_DH_CONST_A3 * e + ROC_ROBOT_DH_CONST_A2) + ROC_ROBOT_DH_CONST_A3 * f * (z - ROC_ROBOT_DH_CONST_D1);
-
-    g_DhAngleBuffer[1] = (float)ATan2(h, j) / ROC_ROBOT_ANGLE_TO_RADIAN;
+    return ROC_FALSE;
 }
 
 /*********************************************************************************
  *  Description:
- *              Caculate the servo PWM value when robot straight walking
+ *              Update the static stability margin of the feet sent to the IK,
+ *              and feed it to the stability monitor. The feet move back to the
+ *              body coordinate, so the gait, the body shift, the body rotation
+ *              and the transition are all in. The feet on the floor are the
+ *              ones that the gait does not lift.
  *
  *  Parameter:
- *              Step: the move step when robot straight walking
- *              Lift: the lift height of the legs when robot move
- *              pRobotCtrlPwmVal: the point of the result array data
+ *              pFeetPos: the feet position in the leg coordinate
  *
  *  Return:
  *              None
  *
  *  Author:
- *              ROC LiRen(2018.12.16)
+ *              ROC LiRen(2026.10.17)
 **********************************************************************************/
-void RocRobotOpenLoopWalkCalculate(ROC_ROBOT_SERVO_s *pRobotServo)
+static void RocRobotStabilityMarginUpdate(const ROC_ROBOT_FEET_POS_s *pFeetPos)
 {
-    float   x = 0;
-    float   y = 0;
-    float   z = 0;
-
-    /***********the coordinate datas of the first group legs ****************/
-    x = ROC_ROBOT_FRO_INIT_X + g_RobotMoveCtrl.CurState.LegCurPos[ROC_ROBOT_RIG_FRO_LEG].X;
-    y = ROC_ROBOT_FRO_INIT_Y + g_RobotMoveCtrl.CurState.LegCurPos[ROC_ROBOT_RIG_FRO_LEG].Y;
-    z = ROC_ROBOT_FRO_INIT_Z + g_RobotMoveCtrl.CurState.LegCurPos[ROC_ROBOT_RIG_FRO_LEG].Z;
+    uint8_t                     i = 0;
+    uint8_t                     Num = 0;
+    float                       GaitStep = 0;
+    float                       X[ROC_ROBOT_CNT_LEGS];
+    float                       Y[ROC_ROBOT_CNT_LEGS];
+    ROC_PHOENIX_STATE_s         *pState = &g_RobotMoveCtrl.CurState;
 
-#ifdef ROC_ROBOT_GAIT_DEBUG
-    ROC_LOGW("x:%.2f, y:%.2f, z:%.2f", x, y, z);
-#endif
-    RocLegInverseKinematic(x, y, z);
+    for(i = 0; i < ROC_ROBOT_CNT_LEGS; i++)
+    {
+        if((ROC_TRUE == RocRobotLegIsParked(i)) || (ROC_ROBOT_STABILITY_STANCE_Z <= pState->LegCurPos[i].Z))
+        {
+            continue;
+        }
 
-    pRobotServo->RobotLeg[ROC_ROBOT_RIG_FRO_LEG].RobotJoint[ROC_ROBOT_LEG_HIP_JOINT] = (int16_t)(ROC_ROBOT_RIG_FRO_HIP_CENTER + (ROC_ROBOT_FRO_HIP_INIT_ANGLE - g_DhAngleBuffer[0]) * ROC_ROBOT_ROTATE_ANGLE_TO_PWM);
-    pRobotServo->RobotLeg[ROC_ROBOT_RIG_FRO_LEG].RobotJoint[ROC_ROBOT_LEG_KNEE_JOINT] = (int16_t)(ROC_ROBOT_RIG_FRO_LEG_CENTER + (ROC_ROBOT_FRO_LEG_INIT_ANGLE - g_DhAngleBuffer[1]) * ROC_ROBOT_ROTATE_ANGLE_TO_PWM);
-    pRobotServo->RobotLeg[ROC_ROBOT_RIG_FRO_LEG].RobotJoint[ROC_ROBOT_LEG_ANKLE_JOINT] = (int16_t)(ROC_ROBOT_RIG_FRO_FET_CENTER + (ROC_ROBOT_FRO_FET_INIT_ANGLE + g_DhAngleBuffer[2]) * ROC_ROBOT_ROTATE_ANGLE_TO_PWM);
+        X[Num] = g_RobotLegGeometry[i].BodyFeet[0] + g_RobotLegCfg[i].XSign * (pFeetPos->X[i] - g_RobotLegGeometry[i].FeetInit[0]);
+        Y[Num] = g_RobotLegGeometry[i].BodyFeet[1] + g_RobotLegCfg[i].YSign * (pFeetPos->Y[i] - g_RobotLegGeometry[i].FeetInit[1]);
+        Num++;
+    }
 
+    pState->StabilityMargin = RocRobotStabilityMarginCalc(X, Y, Num);
 
-    if(ROC_ROBOT_WALK_MODE_QUADRUPED == g_RobotMoveCtrl.CurState.WalkMode)
+    if(ROC_ROBOT_GAIT_MODE_CYCLE == pState->GaitMode)
     {
-        x = ROC_ROBOT_MID_INIT_X;
-        y = ROC_ROBOT_MID_INIT_Y;
-        z = ROC_ROBOT_MID_INIT_Z + ROC_ROBOT_QUAD_MODE_FEET_LIFT;
+        GaitStep = RocRobotGaitCycleStepGet();
     }
-    else if(ROC_ROBOT_WALK_MODE_HEXAPOD == g_RobotMoveCtrl.CurState.WalkMode)
+    else
     {
-        x = ROC_ROBOT_MID_INIT_X - g_RobotMoveCtrl.CurState.LegCurPos[ROC_ROBOT_LEF_MID_LEG].X;
-        y = ROC_ROBOT_MID_INIT_Y + g_RobotMoveCtrl.CurState.LegCurPos[ROC_ROBOT_LEF_MID_LEG].Y;
-        z = ROC_ROBOT_MID_INIT_Z + g_RobotMoveCtrl.CurState.LegCurPos[ROC_ROBOT_LEF_MID_LEG].Z;
+        GaitStep = (float)pState->GaitStep;
     }
 
-    RocLegInverseKinematic(x, y, z);
-
-    pRobotServo->RobotLeg[ROC_ROBOT_LEF_MID_LEG].RobotJoint[ROC_ROBOT_LEG_HIP_JOINT] = (int16_t)(ROC_ROBOT_LEF_MID_HIP_CENTER + (g_DhAngleBuffer[0] - ROC_ROBOT_MID_HIP_INIT_ANGLE) * ROC_ROBOT_ROTATE_ANGLE_TO_PWM);
-    pRobotServo->RobotLeg[ROC_ROBOT_LEF_MID_LEG].RobotJoint[ROC_ROBOT_LEG_KNEE_JOINT] = (int16_t)(ROC_ROBOT_LEF_MID_LEG_CENTER + (ROC_ROBOT_MID_LEG_INIT_ANGLE + g_DhAngleBuffer[1]) * ROC_ROBOT_ROTATE_ANGLE_TO_PWM);
-    pRobotServo->RobotLeg[ROC_ROBOT_LEF_MID_LEG].RobotJoint[ROC_ROBOT_LEG_ANKLE_JOINT] = (int16_t)(ROC_ROBOT_LEF_MID_FET_CENTER + (-ROC_ROBOT_MID_FET_INIT_ANGLE - g_DhAngleBuffer[2]) * ROC_ROBOT_ROTATE_ANGLE_TO_PWM);
-
-
-    x = ROC_ROBOT_HIN_INIT_X + g_RobotMoveCtrl.CurState.LegCurPos[ROC_ROBOT_RIG_HIN_LEG].X;
-    y = ROC_ROBOT_HIN_INIT_Y - g_RobotMoveCtrl.CurState.LegCurPos[ROC_ROBOT_RIG_HIN_LEG].Y;
-    z = ROC_ROBOT_HIN_INIT_Z + g_RobotMoveCtrl.CurState.LegCurPos[ROC_ROBOT_RIG_HIN_LEG].Z;
-
-    RocLegInverseKinematic(x, y, z);
-
-    pRobotServo->RobotLeg[ROC_ROBOT_RIG_HIN_LEG].RobotJoint[ROC_ROBOT_LEG_HIP_JOINT] = (int16_t)(ROC_ROBOT_RIG_HIN_HIP_CENTER + (g_DhAngleBuffer[0] - ROC_ROBOT_HIN_HIP_INIT_ANGLE) * ROC_ROBOT_ROTATE_ANGLE_TO_PWM);
-    pRobotServo->RobotLeg[ROC_ROBOT_RIG_HIN_LEG].RobotJoint[ROC_ROBOT_LEG_KNEE_JOINT] = (int16_t)(ROC_ROBOT_RIG_HIN_LEG_CENTER + (ROC_ROBOT_HIN_LEG_INIT_ANGLE - g_DhAngleBuffer[1]) * ROC_ROBOT_ROTATE_ANGLE_TO_PWM);
-    pRobotServo->RobotLeg[ROC_ROBOT_RIG_HIN_LEG].RobotJoint[ROC_ROBOT_LEG_ANKLE_JOINT] = (int16_t)(ROC_ROBOT_RIG_HIN_FET_CENTER + (ROC_ROBOT_HIN_FET_INIT_ANGLE + g_DhAngleBuffer[2]) * ROC_ROBOT_ROTATE_ANGLE_TO_PWM);
-
-
-    /***********the coordinate datas of the second group legs ***************/
-    x = ROC_ROBOT_FRO_INIT_X - g_RobotMoveCtrl.CurState.LegCurPos[ROC_ROBOT_LEF_FRO_LEG].X;
-    y = ROC_ROBOT_FRO_INIT_Y + g_RobotMoveCtrl.CurState.LegCurPos[ROC_ROBOT_LEF_FRO_LEG].Y;
-    z = ROC_ROBOT_FRO_INIT_Z + g_RobotMoveCtrl.CurState.LegCurPos[ROC_ROBOT_LEF_FRO_LEG].Z;
+    RocRobotStabilityMonitorUpdate(pState->StabilityMargin, Num, GaitStep);
+}
 
-    RocLegInverseKinematic(x, y, z);
+/*********************************************************************************
+ *  Description:
+ *              Caculate the servo PWM value when robot straight walking
+ *
+ *  Parameter:
+ *              pRobotServo: the point of the result servo PWM data
+ *
+ *  Return:
+ *              None
+ *
+ *  Author:
+ *              ROC LiRen(2018.12.16)
+**********************************************************************************/
+void RocRobotOpenLoopWalkCalculate(ROC_ROBOT_SERVO_s *pRobotServo)
+{
+    uint8_t                         i = 0;
+    const ROC_ROBOT_LEG_CONFIG_s    *pLegCfg = NULL;
+    ROC_ROBOT_FEET_POS_s            FeetPos;
+    ROC_ROBOT_JOINT_ANGLE_s         JointAngle;
 
-    pRobotServo->RobotLeg[ROC_ROBOT_LEF_FRO_LEG].RobotJoint[ROC_ROBOT_LEG_HIP_JOINT] = (int16_t)(ROC_ROBOT_LEF_FRO_HIP_CENTER + (g_DhAngleBuffer[0] - ROC_ROBOT_FRO_HIP_INIT_ANGLE) * ROC_ROBOT_ROTATE_ANGLE_TO_PWM);
-    pRobotServo->RobotLeg[ROC_ROBOT_LEF_FRO_LEG].RobotJoint[ROC_ROBOT_LEG_KNEE_JOINT] = (int16_t)(ROC_ROBOT_LEF_FRO_LEG_CENTER + (g_DhAngleBuffer[1] - ROC_ROBOT_FRO_LEG_INIT_ANGLE) * ROC_ROBOT_ROTATE_ANGLE_TO_PWM);
-    pRobotServo->RobotLeg[ROC_ROBOT_LEF_FRO_LEG].RobotJoint[ROC_ROBOT_LEG_ANKLE_JOINT] = (int16_t)(ROC_ROBOT_LEF_FRO_FET_CENTER + (-ROC_ROBOT_FRO_FET_INIT_ANGLE - g_DhAngleBuffer[2]) * ROC_ROBOT_ROTATE_ANGLE_TO_PWM);
+    for(i = 0; i < ROC_ROBOT_CNT_LEGS; i++)
+    {
+        pLegCfg = &g_RobotLegCfg[i];
 
+        RocRobotFeetInitPosGet(i, &FeetPos);
 
-    if(ROC_ROBOT_WALK_MODE_QUADRUPED == g_RobotMoveCtrl.CurState.WalkMode)
-    {
-        x = ROC_ROBOT_MID_INIT_X;
-        y = ROC_ROBOT_MID_INIT_Y;
-        z = ROC_ROBOT_MID_INIT_Z + ROC_ROBOT_QUAD_MODE_FEET_LIFT;
-    }
-    else if(ROC_ROBOT_WALK_MODE_HEXAPOD == g_RobotMoveCtrl.CurState.WalkMode)
-    {
-        x = ROC_ROBOT_MID_INIT_X + g_RobotMoveCtrl.CurState.LegCurPos[ROC_ROBOT_RIG_MID_LEG].X;
-        y = ROC_ROBOT_MID_INIT_Y + g_RobotMoveCtrl.CurState.LegCurPos[ROC_ROBOT_RIG_MID_LEG].Y;
-        z = ROC_ROBOT_MID_INIT_Z + g_RobotMoveCtrl.CurState.LegCurPos[ROC_ROBOT_RIG_MID_LEG].Z;
+        if(ROC_TRUE == RocRobotLegIsParked(i))
+        {
+            FeetPos.Z[i] = FeetPos.Z[i] + ROC_ROBOT_QUAD_MODE_FEET_LIFT;
+        }
+        else
+        {
+            FeetPos.X[i] = FeetPos.X[i] + pLegCfg->XSign * (g_RobotMoveCtrl.CurState.LegCurPos[i].X - g_RobotMoveCtrl.CurState.CogShift.X);
+            FeetPos.Y[i] = FeetPos.Y[i] + pLegCfg->YSign * (g_RobotMoveCtrl.CurState.LegCurPos[i].Y - g_RobotMoveCtrl.CurState.CogShift.Y);
+            FeetPos.Z[i] = FeetPos.Z[i] + g_RobotMoveCtrl.CurState.LegCurPos[i].Z;
+        }
     }
 
-    RocLegInverseKinematic(x, y, z);
+    RocRobotTransitionFeetBlend(&FeetPos);
 
-    pRobotServo->RobotLeg[ROC_ROBOT_RIG_MID_LEG].RobotJoint[ROC_ROBOT_LEG_HIP_JOINT] = (int16_t)(ROC_ROBOT_RIG_MID_HIP_CENTER + (ROC_ROBOT_MID_HIP_INIT_ANGLE - g_DhAngleBuffer[0]) * ROC_ROBOT_ROTATE_ANGLE_TO_PWM);
-    pRobotServo->RobotLeg[ROC_ROBOT_RIG_MID_LEG].RobotJoint[ROC_ROBOT_LEG_KNEE_JOINT] = (int16_t)(ROC_ROBOT_RIG_MID_LEG_CENTER + (-ROC_ROBOT_MID_LEG_INIT_ANGLE - g_DhAngleBuffer[1]) * ROC_ROBOT_ROTATE_ANGLE_TO_PWM);
-    pRobotServo->RobotLeg[ROC_ROBOT_RIG_MID_LEG].RobotJoint[ROC_ROBOT_LEG_ANKLE_JOINT] = (int16_t)(ROC_ROBOT_RIG_MID_FET_CENTER + (ROC_ROBOT_MID_FET_INIT_ANGLE + g_DhAngleBuffer[2]) * ROC_ROBOT_ROTATE_ANGLE_TO_PWM);
+    RocRobotStabilityMarginUpdate(&FeetPos);
 
+    RocRobotLegInverseKinematicBatch(&FeetPos, &JointAngle);
 
-    x = ROC_ROBOT_HIN_INIT_X - g_RobotMoveCtrl.CurState.LegCurPos[ROC_ROBOT_LEF_HIN_LEG].X;
-    y = ROC_ROBOT_HIN_INIT_Y - g_RobotMoveCtrl.CurState.LegCurPos[ROC_ROBOT_LEF_HIN_LEG].Y;
-    z = ROC_ROBOT_HIN_INIT_Z + g_RobotMoveCtrl.CurState.LegCurPos[ROC_ROBOT_LEF_HIN_LEG].Z;
+    RocRobotJointAngleToPwm(&JointAngle, pRobotServo);
 
-    RocLegInverseKinematic(x, y, z);
-
-    pRobotServo->RobotLeg[ROC_ROBOT_LEF_HIN_LEG].RobotJoint[ROC_ROBOT_LEG_HIP_JOINT] = (int16_t)(ROC_ROBOT_LEF_HIN_HIP_CENTER + (ROC_ROBOT_HIN_HIP_INIT_ANGLE - g_DhAngleBuffer[0]) * ROC_ROBOT_ROTATE_ANGLE_TO_PWM);
-    pRobotServo->RobotLeg[ROC_ROBOT_LEF_HIN_LEG].RobotJoint[ROC_ROBOT_LEG_KNEE_JOINT] = (int16_t)(ROC_ROBOT_LEF_HIN_LEG_CENTER + (g_DhAngleBuffer[1] - ROC_ROBOT_HIN_LEG_INIT_ANGLE) * ROC_ROBOT_ROTATE_ANGLE_TO_PWM);
-    pRobotServo->RobotLeg[ROC_ROBOT_LEF_HIN_LEG].RobotJoint[ROC_ROBOT_LEG_ANKLE_JOINT] = (int16_t)(ROC_ROBOT_LEF_HIN_FET_CENTER + (-ROC_ROBOT_HIN_FET_INIT_ANGLE - g_DhAngleBuffer[2]) * ROC_ROBOT_ROTATE_ANGLE_TO_PWM);
+#ifdef ROC_ROBOT_KINEMATIC_CHECK
+    RocRobotKinematicRoundTripCheck(&FeetPos, &JointAngle, pRobotServo,
+                                    &g_RobotMoveCtrl.CurState.IkError, &g_RobotMoveCtrl.CurState.PwmError);
+#endif
 }
 
 /*********************************************************************************
@@ -764,9 +1237,7 @@ void RocRobotOpenLoopWalkCalculate(ROC_ROBOT_SERVO_s *pRobotServo)
  *              Caculate the servo PWM value when robot circle walking
  *
  *  Parameter:
- *              DeltaAngle: the circle increment angle when robot circle move
- *              Lift: the lift height of the legs when robot move
- *              pRobotCtrlPwmVal: the point of the result array data
+ *              pRobotServo: the point of the result servo PWM data
  *
  *  Return:
  *              None
@@ -776,82 +1247,72 @@ void RocRobotOpenLoopWalkCalculate(ROC_ROBOT_SERVO_s *pRobotServo)
 **********************************************************************************/
 void RocRobotOpenLoopCircleCalculate(ROC_ROBOT_SERVO_s *pRobotServo)
 {
-    float   x = 0;
-    float   y = 0;
-    float   z = 0;
-
-    /***********the coordinate datas of the first group legs ****************/
-    x = ROC_ROBOT_WIDTH * Cos((ROC_ROBOT_FRO_HIP_INIT_ANGLE + g_RobotMoveCtrl.CurState.LegCurPos[ROC_ROBOT_RIG_FRO_LEG].A) * ROC_ROBOT_ANGLE_TO_RADIAN);
-    y = ROC_ROBOT_WIDTH * Sin((ROC_ROBOT_FRO_HIP_INIT_ANGLE + g_RobotMoveCtrl.CurState.LegCurPos[ROC_ROBOT_RIG_FRO_LEG].A) * ROC_ROBOT_ANGLE_TO_RADIAN);
-    z = ROC_ROBOT_FRO_INIT_Z + g_RobotMoveCtrl.CurState.LegCurPos[ROC_ROBOT_LEF_MID_LEG].Z;
-
-#ifdef ROC_ROBOT_GAIT_DEBUG
-    ROC_LOGW("x:%.2f, y:%.2f, z:%.2f", x, y, z);
-#endif
-    RocLegInverseKinematic(x, y, z);
-
-    pRobotServo->RobotLeg[ROC_ROBOT_RIG_FRO_LEG].RobotJoint[ROC_ROBOT_LEG_HIP_JOINT] = (int16_t)(ROC_ROBOT_RIG_FRO_HIP_CENTER + (ROC_ROBOT_FRO_HIP_INIT_ANGLE - g_DhAngleBuffer[0]) * ROC_ROBOT_ROTATE_ANGLE_TO_PWM);
-    pRobotServo->RobotLeg[ROC_ROBOT_RIG_FRO_LEG].RobotJoint[ROC_ROBOT_LEG_KNEE_JOINT] = (int16_t)(ROC_ROBOT_RIG_FRO_LEG_CENTER + (ROC_ROBOT_FRO_LEG_INIT_ANGLE - g_DhAngleBuffer[1]) * ROC_ROBOT_ROTATE_ANGLE_TO_PWM);
-    pRobotServo->RobotLeg[ROC_ROBOT_RIG_FRO_LEG].RobotJoint[ROC_ROBOT_LEG_ANKLE_JOINT] = (int16_t)(ROC_ROBOT_RIG_FRO_FET_CENTER + (ROC_ROBOT_FRO_FET_INIT_ANGLE + g_DhAngleBuffer[2]) * ROC_ROBOT_ROTATE_ANGLE_TO_PWM);
-
-
-    x = ROC_ROBOT_WIDTH * Cos( (ROC_ROBOT_MID_HIP_INIT_ANGLE - g_RobotMoveCtrl.CurState.LegCurPos[ROC_ROBOT_LEF_MID_LEG].A) * ROC_ROBOT_ANGLE_TO_RADIAN);
-    y = ROC_ROBOT_WIDTH * Sin( (ROC_ROBOT_MID_HIP_INIT_ANGLE - g_RobotMoveCtrl.CurState.LegCurPos[ROC_ROBOT_LEF_MID_LEG].A) * ROC_ROBOT_ANGLE_TO_RADIAN);
-    z = ROC_ROBOT_MID_INIT_Z + g_RobotMoveCtrl.CurState.LegCurPos[ROC_ROBOT_LEF_MID_LEG].Z;
-
-    RocLegInverseKinematic(x, y, z);
-
-    pRobotServo->RobotLeg[ROC_ROBOT_LEF_MID_LEG].RobotJoint[ROC_ROBOT_LEG_HIP_JOINT] = (int16_t)(ROC_ROBOT_LEF_MID_HIP_CENTER + (g_DhAngleBuffer[0] - ROC_ROBOT_MID_HIP_INIT_ANGLE) * ROC_ROBOT_ROTATE_ANGLE_TO_PWM);
-    pRobotServo->RobotLeg[ROC_ROBOT_LEF_MID_LEG].RobotJoint[ROC_ROBOT_LEG_KNEE_JOINT] = (int16_t)(ROC_ROBOT_LEF_MID_LEG_CENTER + (ROC_ROBOT_MID_LEG_INIT_ANGLE + g_DhAngleBuffer[1]) * ROC_ROBOT_ROTATE_ANGLE_TO_PWM);
-    pRobotServo->RobotLeg[ROC_ROBOT_LEF_MID_LEG].RobotJoint[ROC_ROBOT_LEG_ANKLE_JOINT] = (int16_t)(ROC_ROBOT_LEF_MID_FET_CENTER + (-ROC_ROBOT_MID_FET_INIT_ANGLE - g_DhAngleBuffer[2]) * ROC_ROBOT_ROTATE_ANGLE_TO_PWM);
-
-
-    x = ROC_ROBOT_WIDTH * Cos( (ROC_ROBOT_HIN_HIP_INIT_ANGLE - g_RobotMoveCtrl.CurState.LegCurPos[ROC_ROBOT_RIG_HIN_LEG].A) * ROC_ROBOT_ANGLE_TO_RADIAN);
-    y = ROC_ROBOT_WIDTH * Sin( (ROC_ROBOT_HIN_HIP_INIT_ANGLE - g_RobotMoveCtrl.CurState.LegCurPos[ROC_ROBOT_RIG_HIN_LEG].A) * ROC_ROBOT_ANGLE_TO_RADIAN);
-    z = ROC_ROBOT_HIN_INIT_Z + g_RobotMoveCtrl.CurState.LegCurPos[ROC_ROBOT_RIG_HIN_LEG].Z;
-
-    RocLegInverseKinematic(x, y, z);
-
-    pRobotServo->RobotLeg[ROC_ROBOT_RIG_HIN_LEG].RobotJoint[ROC_ROBOT_LEG_HIP_JOINT] = (int16_t)(ROC_ROBOT_RIG_HIN_HIP_CENTER + (g_DhAngleBuffer[0] - ROC_ROBOT_HIN_HIP_INIT_ANGLE) * ROC_ROBOT_ROTATE_ANGLE_TO_PWM);
-    pRobotServo->RobotLeg[ROC_ROBOT_RIG_HIN_LEG].RobotJoint[ROC_ROBOT_LEG_KNEE_JOINT] = (int16_t)(ROC_ROBOT_RIG_HIN_LEG_CENTER + (ROC_ROBOT_HIN_LEG_INIT_ANGLE - g_DhAngleBuffer[1]) * ROC_ROBOT_ROTATE_ANGLE_TO_PWM);
-    pRobotServo->RobotLeg[ROC_ROBOT_RIG_HIN_LEG].RobotJoint[ROC_ROBOT_LEG_ANKLE_JOINT] = (int16_t)(ROC_ROBOT_RIG_HIN_FET_CENTER + (ROC_ROBOT_HIN_FET_INIT_ANGLE + g_DhAngleBuffer[2]) * ROC_ROBOT_ROTATE_ANGLE_TO_PWM);
-
-
-    /***********the coordinate datas of the second group legs ***************/
-    x = ROC_ROBOT_WIDTH * Cos( (ROC_ROBOT_FRO_HIP_INIT_ANGLE - g_RobotMoveCtrl.CurState.LegCurPos[ROC_ROBOT_LEF_FRO_LEG].A) * ROC_ROBOT_ANGLE_TO_RADIAN);
-    y = ROC_ROBOT_WIDTH * Sin( (ROC_ROBOT_FRO_HIP_INIT_ANGLE - g_RobotMoveCtrl.CurState.LegCurPos[ROC_ROBOT_LEF_FRO_LEG].A) * ROC_ROBOT_ANGLE_TO_RADIAN);
-    z = ROC_ROBOT_FRO_INIT_Z + g_RobotMoveCtrl.CurState.LegCurPos[ROC_ROBOT_LEF_FRO_LEG].Z;
-
-    RocLegInverseKinematic(x, y, z);
-
-    pRobotServo->RobotLeg[ROC_ROBOT_LEF_FRO_LEG].RobotJoint[ROC_ROBOT_LEG_HIP_JOINT] = (int16_t)(ROC_ROBOT_LEF_FRO_HIP_CENTER + (g_DhAngleBuffer[0] - ROC_ROBOT_FRO_HIP_INIT_ANGLE) * ROC_ROBOT_ROTATE_ANGLE_TO_PWM);
-    pRobotServo->RobotLeg[ROC_ROBOT_LEF_FRO_LEG].RobotJoint[ROC_ROBOT_LEG_KNEE_JOINT] = (int16_t)(ROC_ROBOT_LEF_FRO_LEG_CENTER + (g_DhAngleBuffer[1] - ROC_ROBOT_FRO_LEG_INIT_ANGLE) * ROC_ROBOT_ROTATE_ANGLE_TO_PWM);
-    pRobotServo->RobotLeg[ROC_ROBOT_LEF_FRO_LEG].RobotJoint[ROC_ROBOT_LEG_ANKLE_JOINT] = (int16_t)(ROC_ROBOT_LEF_FRO_FET_CENTER + (-ROC_ROBOT_FRO_FET_INIT_ANGLE - g_DhAngleBuffer[2]) * ROC_ROBOT_ROTATE_ANGLE_TO_PWM);
+    uint8_t                         i = 0;
+    float                           HipAngle = 0;
+    const ROC_ROBOT_LEG_CONFIG_s    *pLegCfg = NULL;
+    ROC_ROBOT_FEET_POS_s            FeetPos;
+    ROC_ROBOT_JOINT_ANGLE_s         JointAngle;
 
+    for(i = 0; i < ROC_ROBOT_CNT_LEGS; i++)
+    {
+        pLegCfg = &g_RobotLegCfg[i];
 
-    x = ROC_ROBOT_WIDTH * Cos( (ROC_ROBOT_MID_HIP_INIT_ANGLE + g_RobotMoveCtrl.CurState.LegCurPos[ROC_ROBOT_RIG_MID_LEG].A) * ROC_ROBOT_ANGLE_TO_RADIAN);
-    y = ROC_ROBOT_WIDTH * Sin( (ROC_ROBOT_MID_HIP_INIT_ANGLE + g_RobotMoveCtrl.CurState.LegCurPos[ROC_ROBOT_RIG_MID_LEG].A) * ROC_ROBOT_ANGLE_TO_RADIAN);
-    z = ROC_ROBOT_MID_INIT_Z + g_RobotMoveCtrl.CurState.LegCurPos[ROC_ROBOT_RIG_MID_LEG].Z;
+        /* The circle angle turns the same direction for the legs on the diagonal */
+        HipAngle = pLegCfg->HipInitAngle + pLegCfg->XSign * pLegCfg->YSign * g_RobotMoveCtrl.CurState.LegCurPos[i].A;
 
-    RocLegInverseKinematic(x, y, z);
+        FeetPos.X[i] = ROC_ROBOT_WIDTH * Cos(HipAngle * ROC_ROBOT_ANGLE_TO_RADIAN);
+        FeetPos.Y[i] = ROC_ROBOT_WIDTH * Sin(HipAngle * ROC_ROBOT_ANGLE_TO_RADIAN);
+        FeetPos.Z[i] = -ROC_ROBOT_HEIGHT + g_RobotMoveCtrl.CurState.LegCurPos[i].Z;
+    }
 
-    pRobotServo->RobotLeg[ROC_ROBOT_RIG_MID_LEG].RobotJoint[ROC_ROBOT_LEG_HIP_JOINT] = (int16_t)(ROC_ROBOT_RIG_MID_HIP_CENTER + (ROC_ROBOT_MID_HIP_INIT_ANGLE - g_DhAngleBuffer[0]) * ROC_ROBOT_ROTATE_ANGLE_TO_PWM);
-    pRobotServo->RobotLeg[ROC_ROBOT_RIG_MID_LEG].RobotJoint[ROC_ROBOT_LEG_KNEE_JOINT] = (int16_t)(ROC_ROBOT_RIG_MID_LEG_CENTER + (-ROC_ROBOT_MID_LEG_INIT_ANGLE - g_DhAngleBuffer[1]) * ROC_ROBOT_ROTATE_ANGLE_TO_PWM);
-    pRobotServo->RobotLeg[ROC_ROBOT_RIG_MID_LEG].RobotJoint[ROC_ROBOT_LEG_ANKLE_JOINT] = (int16_t)(ROC_ROBOT_RIG_MID_FET_CENTER + (ROC_ROBOT_MID_FET_INIT_ANGLE + g_DhAngleBuffer[2]) * ROC_ROBOT_ROTATE_ANGLE_TO_PWM);
+    RocRobotTransitionFeetBlend(&FeetPos);
 
+    RocRobotStabilityMarginUpdate(&FeetPos);
 
-    x = ROC_ROBOT_WIDTH * Cos( (ROC_ROBOT_HIN_HIP_INIT_ANGLE + g_RobotMoveCtrl.CurState.LegCurPos[ROC_ROBOT_LEF_HIN_LEG].A) * ROC_ROBOT_ANGLE_TO_RADIAN);
-    y = ROC_ROBOT_WIDTH * Sin( (ROC_ROBOT_HIN_HIP_INIT_ANGLE + g_RobotMoveCtrl.CurState.LegCurPos[ROC_ROBOT_LEF_HIN_LEG].A) * ROC_ROBOT_ANGLE_TO_RADIAN);
-    z = ROC_ROBOT_HIN_INIT_Z + g_RobotMoveCtrl.CurState.LegCurPos[ROC_ROBOT_LEF_HIN_LEG].Z;
+    RocRobotLegInverseKinematicBatch(&FeetPos, &JointAngle);
 
-    RocLegInverseKinematic(x, y, z);
+    RocRobotJointAngleToPwm(&JointAngle, pRobotServo);
 
-    pRobotServo->RobotLeg[ROC_ROBOT_LEF_HIN_LEG].RobotJoint[ROC_ROBOT_LEG_HIP_JOINT] = (int16_t)(ROC_ROBOT_LEF_HIN_HIP_CENTER + (ROC_ROBOT_HIN_HIP_INIT_ANGLE - g_DhAngleBuffer[0]) * ROC_ROBOT_ROTATE_ANGLE_TO_PWM);
-    pRobotServo->RobotLeg[ROC_ROBOT_LEF_HIN_LEG].RobotJoint[ROC_ROBOT_LEG_KNEE_JOINT] = (int16_t)(ROC_ROBOT_LEF_HIN_LEG_CENTER + (g_DhAngleBuffer[1] - ROC_ROBOT_HIN_LEG_INIT_ANGLE) * ROC_ROBOT_ROTATE_ANGLE_TO_PWM);
-    pRobotServo->RobotLeg[ROC_ROBOT_LEF_HIN_LEG].RobotJoint[ROC_ROBOT_LEG_ANKLE_JOINT] = (int16_t)(ROC_ROBOT_LEF_HIN_FET_CENTER + (-ROC_ROBOT_HIN_FET_INIT_ANGLE - g_DhAngleBuffer[2]) * ROC_ROBOT_ROTATE_ANGLE_TO_PWM);
+#ifdef ROC_ROBOT_KINEMATIC_CHECK
+    RocRobotKinematicRoundTripCheck(&FeetPos, &JointAngle, pRobotServo,
+                                    &g_RobotMoveCtrl.CurState.IkError, &g_RobotMoveCtrl.CurState.PwmError);
+#endif
 }
 
 #ifdef ROC_ROBOT_CLOSED_LOOP_CONTROL
+/*********************************************************************************
+ *  Description:
+ *              Calculate the yaw of the current IMU attitude from the reference
+ *              one. It is the yaw of the relative quaternion Cur * conj(Ref), so
+ *              it wraps at +-180 degree without the jump of the euler difference.
+ *
+ *  Parameter:
+ *              *pCur: the pointer to the current IMU data
+ *              *pRef: the pointer to the reference IMU data
+ *
+ *  Return:
+ *              The yaw difference in degree, -180 ~ 180
+ *
+ *  Author:
+ *              ROC LiRen(2026.10.17)
+**********************************************************************************/
+static float RocRobotImuYawDiffCalc(const ROC_ROBOT_IMU_DATA_s *pCur, const ROC_ROBOT_IMU_DATA_s *pRef)
+{
+    const float *c = pCur->Quat;
+    const float *r = pRef->Quat;
+    float       w = 0;
+    float       x = 0;
+    float       y = 0;
+    float       z = 0;
+
+    w =  c[0] * r[0] + c[1] * r[1] + c[2] * r[2] + c[3] * r[3];
+    x = -c[0] * r[1] + c[1] * r[0] - c[2] * r[3] + c[3] * r[2];
+    y = -c[0] * r[2] + c[1] * r[3] + c[2] * r[0] - c[3] * r[1];
+    z = -c[0] * r[3] - c[1] * r[2] + c[2] * r[1] + c[3] * r[0];
+
+    return ATan2(2 * (x * y + w * z), w * w + x * x - y * y - z * z) / ROC_ROBOT_ANGLE_TO_RADIAN;
+}
+
 /*********************************************************************************
  *  Description:
  *              Check the step error value
@@ -896,7 +1357,7 @@ static void RocRobotStepErrorCheck(float *x)
  *  Author:
  *              ROC LiRen(2018.12.16)
 **********************************************************************************/
-static void RocCorrectionPositionCaculate(uint8_t LegNum, double DeltaAlpha, double *x, double *y, double *z)
+static void RocCorrectionPositionCaculate(uint8_t LegNum, float DeltaAlpha, float *x, float *y, float *z)
 {
     float   L = 0, R = 0;
     float   C1 = 0, Alfa1 = 0;
@@ -971,8 +1432,7 @@ static void RocCorrectionPositionCaculate(uint8_t LegNum, double DeltaAlpha, dou
  *              Adjust the robot walk step when using closed loop control.
  *
  *  Parameter:
- *              ExpectedAngle: the expected anlge value when robot straight walking
- *              Direction: the direction of robot move
+ *              pRobotServo: the point of the result servo PWM data
  *
  *  Return:
  *              None
@@ -982,168 +1442,69 @@ static void RocCorrectionPositionCaculate(uint8_t LegNum, double DeltaAlpha, dou
 **********************************************************************************/
 void RocRobotClosedLoopWalkCalculate(ROC_ROBOT_SERVO_s *pRobotServo)
 {
-    float   x = 0;
-    float   y = 0;
-    float   z = 0;
-    float   XStepError = 0;
-    static  float MaxError = 0;
+    uint8_t                         i = 0;
+    float                           XStepError = 0;
+    static  float                   MaxError = 0;
+    const ROC_ROBOT_LEG_CONFIG_s    *pLegCfg = NULL;
+    ROC_ROBOT_FEET_POS_s            FeetPos;
+    ROC_ROBOT_FEET_POS_s            BodyIkPos;
+    ROC_ROBOT_JOINT_ANGLE_s         JointAngle;
 
-    XStepError = (g_RobotMoveCtrl.CurState.CurImuAngle.Yaw - g_RobotMoveCtrl.CurState.RefImuAngle.Yaw) * ROC_ROBOT_PID_CONST_P;
+    XStepError = RocRobotImuYawDiffCalc(&g_RobotMoveCtrl.CurState.CurImuAngle, &g_RobotMoveCtrl.CurState.RefImuAngle) * ROC_ROBOT_PID_CONST_P;
 
     if(ROC_ROBOT_MOVE_STATUS_BAKWALKING == g_RobotMoveCtrl.CurState.MoveStatus)
     {
         XStepError = -XStepError;
     }
 
-    if(fabs(MaxError) < fabs(XStepError))
+    if(Fabs(MaxError) < Fabs(XStepError))
     {
         MaxError = XStepError;
     }
 
     XStepError = 0;
 
-    //RocTftLcdDrawGbk24Num(120, 200, ROC_TFT_LCD_COLOR_DEFAULT_FOR, ROC_TFT_LCD_COLOR_DEFAULT_BAK, fabs(MaxError));
+    //RocTftLcdDrawGbk24Num(120, 200, ROC_TFT_LCD_COLOR_DEFAULT_FOR, ROC_TFT_LCD_COLOR_DEFAULT_BAK, Fabs(MaxError));
 
     RocRobotStepErrorCheck(&XStepError);
 
-    RocBodyInverseKinematic(g_RobotMoveCtrl.CurState.LegCurPos[ROC_ROBOT_RIG_FRO_LEG].X,
-                            g_RobotMoveCtrl.CurState.LegCurPos[ROC_ROBOT_RIG_FRO_LEG].Y,
-                            g_RobotMoveCtrl.CurState.LegCurPos[ROC_ROBOT_RIG_FRO_LEG].Z,
-                            ROC_ROBOT_RIG_FRO_LEG);
-
-    /***********the coordinate datas of the first group legs ****************/
-    x = ROC_ROBOT_FRO_INIT_X + g_RobotMoveCtrl.CurState.LegCurPos[ROC_ROBOT_RIG_FRO_LEG].X - g_BodyIkPos[0] + XStepError;
-    y = ROC_ROBOT_FRO_INIT_Y + g_RobotMoveCtrl.CurState.LegCurPos[ROC_ROBOT_RIG_FRO_LEG].Y - g_BodyIkPos[1];
-    z = ROC_ROBOT_FRO_INIT_Z + g_RobotMoveCtrl.CurState.LegCurPos[ROC_ROBOT_RIG_FRO_LEG].Z - g_BodyIkPos[2];
-
-    RocLegInverseKinematic(x, y, z);
-
-#ifdef ROC_ROBOT_GAIT_DEBUG
-    ROC_LOGW("FeetInPosX: %.2f, FeetInPosY: %.2f, FeetInPosZ: %.2f", x, y, z);
-#endif
-
-    pRobotServo->RobotLeg[ROC_ROBOT_RIG_FRO_LEG].RobotJoint[ROC_ROBOT_LEG_HIP_JOINT] = (int16_t)(ROC_ROBOT_RIG_FRO_HIP_CENTER + (ROC_ROBOT_FRO_HIP_INIT_ANGLE - g_DhAngleBuffer[0]) * ROC_ROBOT_ROTATE_ANGLE_TO_PWM);
-    pRobotServo->RobotLeg[ROC_ROBOT_RIG_FRO_LEG].RobotJoint[ROC_ROBOT_LEG_KNEE_JOINT] = (int16_t)(ROC_ROBOT_RIG_FRO_LEG_CENTER + (ROC_ROBOT_FRO_LEG_INIT_ANGLE - g_DhAngleBuffer[1]) * ROC_ROBOT_ROTATE_ANGLE_TO_PWM);
-    pRobotServo->RobotLeg[ROC_ROBOT_RIG_FRO_LEG].RobotJoint[ROC_ROBOT_LEG_ANKLE_JOINT] = (int16_t)(ROC_ROBOT_RIG_FRO_FET_CENTER + (ROC_ROBOT_FRO_FET_INIT_ANGLE + g_DhAngleBuffer[2]) * ROC_ROBOT_ROTATE_ANGLE_TO_PWM);
-
+    RocBodyInverseKinematicBatch(&BodyIkPos);
 
-    RocBodyInverseKinematic(g_RobotMoveCtrl.CurState.LegCurPos[ROC_ROBOT_LEF_MID_LEG].X,
-                            g_RobotMoveCtrl.CurState.LegCurPos[ROC_ROBOT_LEF_MID_LEG].Y,
-                            g_RobotMoveCtrl.CurState.LegCurPos[ROC_ROBOT_LEF_MID_LEG].Z,
-                            ROC_ROBOT_LEF_MID_LEG);
-
-    if(ROC_ROBOT_WALK_MODE_QUADRUPED == g_RobotMoveCtrl.CurState.WalkMode)
-    {
-        x = ROC_ROBOT_MID_INIT_X;
-        y = ROC_ROBOT_MID_INIT_Y;
-        z = ROC_ROBOT_MID_INIT_Z + ROC_ROBOT_QUAD_MODE_FEET_LIFT;
-    }
-    else if(ROC_ROBOT_WALK_MODE_HEXAPOD == g_RobotMoveCtrl.CurState.WalkMode)
+    for(i = 0; i < ROC_ROBOT_CNT_LEGS; i++)
     {
-        x = ROC_ROBOT_MID_INIT_X - g_RobotMoveCtrl.CurState.LegCurPos[ROC_ROBOT_LEF_MID_LEG].X + g_BodyIkPos[0];
-        y = ROC_ROBOT_MID_INIT_Y + g_RobotMoveCtrl.CurState.LegCurPos[ROC_ROBOT_LEF_MID_LEG].Y - g_BodyIkPos[1];
-        z = ROC_ROBOT_MID_INIT_Z + g_RobotMoveCtrl.CurState.LegCurPos[ROC_ROBOT_LEF_MID_LEG].Z - g_BodyIkPos[2];
-    }
-
-    RocLegInverseKinematic(x, y, z);
-
-#ifdef ROC_ROBOT_GAIT_DEBUG
-    ROC_LOGW("FeetInPosX: %.2f, FeetInPosY: %.2f, FeetInPosZ: %.2f", x, y, z);
-#endif
-
-    pRobotServo->RobotLeg[ROC_ROBOT_LEF_MID_LEG].RobotJoint[ROC_ROBOT_LEG_HIP_JOINT] = (int16_t)(ROC_ROBOT_LEF_MID_HIP_CENTER + (g_DhAngleBuffer[0] - ROC_ROBOT_MID_HIP_INIT_ANGLE) * ROC_ROBOT_ROTATE_ANGLE_TO_PWM);
-    pRobotServo->RobotLeg[ROC_ROBOT_LEF_MID_LEG].RobotJoint[ROC_ROBOT_LEG_KNEE_JOINT] = (int16_t)(ROC_ROBOT_LEF_MID_LEG_CENTER + (ROC_ROBOT_MID_LEG_INIT_ANGLE + g_DhAngleBuffer[1]) * ROC_ROBOT_ROTATE_ANGLE_TO_PWM);
-    pRobotServo->RobotLeg[ROC_ROBOT_LEF_MID_LEG].RobotJoint[ROC_ROBOT_LEG_ANKLE_JOINT] = (int16_t)(ROC_ROBOT_LEF_MID_FET_CENTER + (-ROC_ROBOT_MID_FET_INIT_ANGLE - g_DhAngleBuffer[2]) * ROC_ROBOT_ROTATE_ANGLE_TO_PWM);
-
-
-    RocBodyInverseKinematic(g_RobotMoveCtrl.CurState.LegCurPos[ROC_ROBOT_RIG_HIN_LEG].X,
-                            g_RobotMoveCtrl.CurState.LegCurPos[ROC_ROBOT_RIG_HIN_LEG].Y,
-                            g_RobotMoveCtrl.CurState.LegCurPos[ROC_ROBOT_RIG_HIN_LEG].Z,
-                            ROC_ROBOT_RIG_HIN_LEG);
-
-    x = ROC_ROBOT_HIN_INIT_X + g_RobotMoveCtrl.CurState.LegCurPos[ROC_ROBOT_RIG_HIN_LEG].X - g_BodyIkPos[0] + XStepError;
-    y = ROC_ROBOT_HIN_INIT_Y - g_RobotMoveCtrl.CurState.LegCurPos[ROC_ROBOT_RIG_HIN_LEG].Y + g_BodyIkPos[1];
-    z = ROC_ROBOT_HIN_INIT_Z + g_RobotMoveCtrl.CurState.LegCurPos[ROC_ROBOT_RIG_HIN_LEG].Z - g_BodyIkPos[2];
-
-    RocLegInverseKinematic(x, y, z);
-
-#ifdef ROC_ROBOT_GAIT_DEBUG
-    ROC_LOGW("FeetInPosX: %.2f, FeetInPosY: %.2f, FeetInPosZ: %.2f", x, y, z);
-#endif
-
-    pRobotServo->RobotLeg[ROC_ROBOT_RIG_HIN_LEG].RobotJoint[ROC_ROBOT_LEG_HIP_JOINT] = (int16_t)(ROC_ROBOT_RIG_HIN_HIP_CENTER + (g_DhAngleBuffer[0] - ROC_ROBOT_HIN_HIP_INIT_ANGLE) * ROC_ROBOT_ROTATE_ANGLE_TO_PWM);
-    pRobotServo->RobotLeg[ROC_ROBOT_RIG_HIN_LEG].RobotJoint[ROC_ROBOT_LEG_KNEE_JOINT] = (int16_t)(ROC_ROBOT_RIG_HIN_LEG_CENTER + (ROC_ROBOT_HIN_LEG_INIT_ANGLE - g_DhAngleBuffer[1]) * ROC_ROBOT_ROTATE_ANGLE_TO_PWM);
-    pRobotServo->RobotLeg[ROC_ROBOT_RIG_HIN_LEG].RobotJoint[ROC_ROBOT_LEG_ANKLE_JOINT] = (int16_t)(ROC_ROBOT_RIG_HIN_FET_CENTER + (ROC_ROBOT_HIN_FET_INIT_ANGLE + g_DhAngleBuffer[2]) * ROC_ROBOT_ROTATE_ANGLE_TO_PWM);
-
-
-    /***********the coordinate datas of the second group legs ***************/
-    RocBodyInverseKinematic(g_RobotMoveCtrl.CurState.LegCurPos[ROC_ROBOT_LEF_FRO_LEG].X,
-                            g_RobotMoveCtrl.CurState.LegCurPos[ROC_ROBOT_LEF_FRO_LEG].Y,
-                            g_RobotMoveCtrl.CurState.LegCurPos[ROC_ROBOT_LEF_FRO_LEG].Z,
-                            ROC_ROBOT_LEF_FRO_LEG);
-
-    x = ROC_ROBOT_FRO_INIT_X - g_RobotMoveCtrl.CurState.LegCurPos[ROC_ROBOT_LEF_FRO_LEG].X + g_BodyIkPos[0] - XStepError;
-    y = ROC_ROBOT_FRO_INIT_Y + g_RobotMoveCtrl.CurState.LegCurPos[ROC_ROBOT_LEF_FRO_LEG].Y - g_BodyIkPos[1];
-    z = ROC_ROBOT_FRO_INIT_Z + g_RobotMoveCtrl.CurState.LegCurPos[ROC_ROBOT_LEF_FRO_LEG].Z - g_BodyIkPos[2];
-
-    RocLegInverseKinematic(x, y, z);
-
-#ifdef ROC_ROBOT_GAIT_DEBUG
-    ROC_LOGW("FeetInPosX: %.2f, FeetInPosY: %.2f, FeetInPosZ: %.2f", x, y, z);
-#endif
-
-    pRobotServo->RobotLeg[ROC_ROBOT_LEF_FRO_LEG].RobotJoint[ROC_ROBOT_LEG_HIP_JOINT] = (int16_t)(ROC_ROBOT_LEF_FRO_HIP_CENTER + (g_DhAngleBuffer[0] - ROC_ROBOT_FRO_HIP_INIT_ANGLE) * ROC_ROBOT_ROTATE_ANGLE_TO_PWM);
-    pRobotServo->RobotLeg[ROC_ROBOT_LEF_FRO_LEG].RobotJoint[ROC_ROBOT_LEG_KNEE_JOINT] = (int16_t)(ROC_ROBOT_LEF_FRO_LEG_CENTER + (g_DhAngleBuffer[1] - ROC_ROBOT_FRO_LEG_INIT_ANGLE) * ROC_ROBOT_ROTATE_ANGLE_TO_PWM);
-    pRobotServo->RobotLeg[ROC_ROBOT_LEF_FRO_LEG].RobotJoint[ROC_ROBOT_LEG_ANKLE_JOINT] = (int16_t)(ROC_ROBOT_LEF_FRO_FET_CENTER + (-ROC_ROBOT_FRO_FET_INIT_ANGLE - g_DhAngleBuffer[2]) * ROC_ROBOT_ROTATE_ANGLE_TO_PWM);
+        pLegCfg = &g_RobotLegCfg[i];
 
+        RocRobotFeetInitPosGet(i, &FeetPos);
 
-    RocBodyInverseKinematic(g_RobotMoveCtrl.CurState.LegCurPos[ROC_ROBOT_RIG_MID_LEG].X,
-                            g_RobotMoveCtrl.CurState.LegCurPos[ROC_ROBOT_RIG_MID_LEG].Y,
-                            g_RobotMoveCtrl.CurState.LegCurPos[ROC_ROBOT_RIG_MID_LEG].Z,
-                            ROC_ROBOT_RIG_MID_LEG);
+        if(ROC_TRUE == RocRobotLegIsParked(i))
+        {
+            FeetPos.Z[i] = FeetPos.Z[i] + ROC_ROBOT_QUAD_MODE_FEET_LIFT;
+        }
+        else
+        {
+            FeetPos.X[i] = FeetPos.X[i] + pLegCfg->XSign * (g_RobotMoveCtrl.CurState.LegCurPos[i].X - g_RobotMoveCtrl.CurState.CogShift.X) - pLegCfg->XSign * BodyIkPos.X[i];
+            FeetPos.Y[i] = FeetPos.Y[i] + pLegCfg->YSign * (g_RobotMoveCtrl.CurState.LegCurPos[i].Y - g_RobotMoveCtrl.CurState.CogShift.Y) - pLegCfg->YSign * BodyIkPos.Y[i];
+            FeetPos.Z[i] = FeetPos.Z[i] + g_RobotMoveCtrl.CurState.LegCurPos[i].Z - BodyIkPos.Z[i];
 
-    if(ROC_ROBOT_WALK_MODE_QUADRUPED == g_RobotMoveCtrl.CurState.WalkMode)
-    {
-        x = ROC_ROBOT_MID_INIT_X;
-        y = ROC_ROBOT_MID_INIT_Y;
-        z = ROC_ROBOT_MID_INIT_Z + ROC_ROBOT_QUAD_MODE_FEET_LIFT;
-    }
-    else if(ROC_ROBOT_WALK_MODE_HEXAPOD == g_RobotMoveCtrl.CurState.WalkMode)
-    {
-        x = ROC_ROBOT_MID_INIT_X + g_RobotMoveCtrl.CurState.LegCurPos[ROC_ROBOT_RIG_MID_LEG].X - g_BodyIkPos[0];
-        y = ROC_ROBOT_MID_INIT_Y + g_RobotMoveCtrl.CurState.LegCurPos[ROC_ROBOT_RIG_MID_LEG].Y - g_BodyIkPos[1];
-        z = ROC_ROBOT_MID_INIT_Z + g_RobotMoveCtrl.CurState.LegCurPos[ROC_ROBOT_RIG_MID_LEG].Z - g_BodyIkPos[2];
+            if(ROC_FALSE == pLegCfg->IsMidLeg)
+            {
+                FeetPos.X[i] = FeetPos.X[i] + pLegCfg->XSign * XStepError;
+            }
+        }
     }
 
-    RocLegInverseKinematic(x, y, z);
-
-#ifdef ROC_ROBOT_GAIT_DEBUG
-    ROC_LOGW("FeetInPosX: %.2f, FeetInPosY: %.2f, FeetInPosZ: %.2f", x, y, z);
-#endif
-
-    pRobotServo->RobotLeg[ROC_ROBOT_RIG_MID_LEG].RobotJoint[ROC_ROBOT_LEG_HIP_JOINT] = (int16_t)(ROC_ROBOT_RIG_MID_HIP_CENTER + (ROC_ROBOT_MID_HIP_INIT_ANGLE - g_DhAngleBuffer[0]) * ROC_ROBOT_ROTATE_ANGLE_TO_PWM);
-    pRobotServo->RobotLeg[ROC_ROBOT_RIG_MID_LEG].RobotJoint[ROC_ROBOT_LEG_KNEE_JOINT] = (int16_t)(ROC_ROBOT_RIG_MID_LEG_CENTER + (-ROC_ROBOT_MID_LEG_INIT_ANGLE - g_DhAngleBuffer[1]) * ROC_ROBOT_ROTATE_ANGLE_TO_PWM);
-    pRobotServo->RobotLeg[ROC_ROBOT_RIG_MID_LEG].RobotJoint[ROC_ROBOT_LEG_ANKLE_JOINT] = (int16_t)(ROC_ROBOT_RIG_MID_FET_CENTER + (ROC_ROBOT_MID_FET_INIT_ANGLE + g_DhAngleBuffer[2]) * ROC_ROBOT_ROTATE_ANGLE_TO_PWM);
+    RocRobotTransitionFeetBlend(&FeetPos);
 
+    RocRobotStabilityMarginUpdate(&FeetPos);
 
-    RocBodyInverseKinematic(g_RobotMoveCtrl.CurState.LegCurPos[ROC_ROBOT_LEF_HIN_LEG].X,
-                            g_RobotMoveCtrl.CurState.LegCurPos[ROC_ROBOT_LEF_HIN_LEG].Y,
-                            g_RobotMoveCtrl.CurState.LegCurPos[ROC_ROBOT_LEF_HIN_LEG].Z,
-                            ROC_ROBOT_LEF_HIN_LEG);
+    RocRobotLegInverseKinematicBatch(&FeetPos, &JointAngle);
 
-    x = ROC_ROBOT_HIN_INIT_X - g_RobotMoveCtrl.CurState.LegCurPos[ROC_ROBOT_LEF_HIN_LEG].X + g_BodyIkPos[0] - XStepError;
-    y = ROC_ROBOT_HIN_INIT_Y - g_RobotMoveCtrl.CurState.LegCurPos[ROC_ROBOT_LEF_HIN_LEG].Y + g_BodyIkPos[1];
-    z = ROC_ROBOT_HIN_INIT_Z + g_RobotMoveCtrl.CurState.LegCurPos[ROC_ROBOT_LEF_HIN_LEG].Z - g_BodyIkPos[2];
+    RocRobotJointAngleToPwm(&JointAngle, pRobotServo);
 
-    RocLegInverseKinematic(x, y, z);
-
-#ifdef ROC_ROBOT_GAIT_DEBUG
-    ROC_LOGW("FeetInPosX: %.2f, FeetInPosY: %.2f, FeetInPosZ: %.2f", x, y, z);
+#ifdef ROC_ROBOT_KINEMATIC_CHECK
+    RocRobotKinematicRoundTripCheck(&FeetPos, &JointAngle, pRobotServo,
+                                    &g_RobotMoveCtrl.CurState.IkError, &g_RobotMoveCtrl.CurState.PwmError);
 #endif
-
-    pRobotServo->RobotLeg[ROC_ROBOT_LEF_HIN_LEG].RobotJoint[ROC_ROBOT_LEG_HIP_JOINT] = (int16_t)(ROC_ROBOT_LEF_HIN_HIP_CENTER + (ROC_ROBOT_HIN_HIP_INIT_ANGLE - g_DhAngleBuffer[0]) * ROC_ROBOT_ROTATE_ANGLE_TO_PWM);
-    pRobotServo->RobotLeg[ROC_ROBOT_LEF_HIN_LEG].RobotJoint[ROC_ROBOT_LEG_KNEE_JOINT] = (int16_t)(ROC_ROBOT_LEF_HIN_LEG_CENTER + (g_DhAngleBuffer[1] - ROC_ROBOT_HIN_LEG_INIT_ANGLE) * ROC_ROBOT_ROTATE_ANGLE_TO_PWM);
-    pRobotServo->RobotLeg[ROC_ROBOT_LEF_HIN_LEG].RobotJoint[ROC_ROBOT_LEG_ANKLE_JOINT] = (int16_t)(ROC_ROBOT_LEF_HIN_FET_CENTER + (-ROC_ROBOT_HIN_FET_INIT_ANGLE - g_DhAngleBuffer[2]) * ROC_ROBOT_ROTATE_ANGLE_TO_PWM);
 }
 #endif
 
@@ -1218,12 +1579,32 @@ ROC_ROBOT_MOVE_STATUS_e RocRobotMoveStatus_Get(void)
  *  Author:
  *              ROC LiRen(2019.03.30)
 **********************************************************************************/
-void RocRobotCtrlDeltaMoveCoorInput(double x, double y, double z, double a, double h)
+void RocRobotCtrlDeltaMoveCoorInput(float x, float y, float z, float a, float h)
 {
-    g_RobotMoveCtrl.CurState.TravelLength.X = x;
-    g_RobotMoveCtrl.CurState.TravelLength.Y = y;
+    float   Scale = 1.0F;
+
+    //The step length of the walking gait is capped by the stability monitor, the Z is the body pose
+    switch(g_RobotMoveCtrl.CurState.MoveStatus)
+    {
+        case ROC_ROBOT_MOVE_STATUS_FORWALKING:
+        case ROC_ROBOT_MOVE_STATUS_BAKWALKING:
+        case ROC_ROBOT_MOVE_STATUS_CIRCLING:
+        {
+            Scale = RocRobotStabilityScaleGet();
+
+            break;
+        }
+
+        default:
+        {
+            break;
+        }
+    }
+
+    g_RobotMoveCtrl.CurState.TravelLength.X = x * Scale;
+    g_RobotMoveCtrl.CurState.TravelLength.Y = y * Scale;
     g_RobotMoveCtrl.CurState.TravelLength.Z = z;
-    g_RobotMoveCtrl.CurState.TravelLength.A = a;
+    g_RobotMoveCtrl.CurState.TravelLength.A = a * Scale;
     g_RobotMoveCtrl.CurState.LegLiftHeight  = h;
 }
 
@@ -1316,6 +1697,10 @@ void RocRobotSingleLegCtrl(ROC_ROBOT_SERVO_s *pRobotServo)
 #endif
     }
 
+    //The body is back to the center when standing
+    g_RobotMoveCtrl.CurState.CogShift.X = 0;
+    g_RobotMoveCtrl.CurState.CogShift.Y = 0;
+
     RocRobotOpenLoopWalkCalculate(pRobotServo);
 
     g_RobotMoveCtrl.CurState.SelectLegIsAllDown = ROC_TRUE;
@@ -1347,6 +1732,14 @@ ROC_RESULT RocRobotAlgoCtrlInit(void)
     uint8_t     i = 0;
     ROC_RESULT  Ret = RET_OK;
 
+#ifdef ROC_ROBOT_MATH_USE_TRIG_LUT
+    RocRobotTrigLutInit();
+#endif
+
+    RocRobotTransitionInit();
+
+    RocRobotStabilityInit();
+
     for(i = 0; i < ROC_ROBOT_CNT_LEGS; i++)
     {
         g_RobotMoveCtrl.CurState.LegCurPos[i].X = 0;
@@ -1355,9 +1748,12 @@ ROC_RESULT RocRobotAlgoCtrlInit(void)
         g_RobotMoveCtrl.CurState.LegCurPos[i].A = 0;
     }
 
+    memcpy(g_RobotGait, g_RobotGaitDefault, sizeof(g_RobotGait));
+
     g_RobotMoveCtrl.CurState.GaitStep = 1;
     g_RobotMoveCtrl.CurState.GaitType = ROC_ROBOT_GAIT_HEXP_MODE_TRIPOD_6;
     g_RobotMoveCtrl.CurState.WalkMode = ROC_ROBOT_WALK_MODE_HEXAPOD;
+    g_RobotMoveCtrl.CurState.GaitMode = ROC_ROBOT_GAIT_MODE_TABLE;
     //g_RobotMoveCtrl.CurState.GaitType = ROC_ROBOT_GAIT_QUAD_MODE_AMBLE_4;
     //g_RobotMoveCtrl.CurState.WalkMode = ROC_ROBOT_WALK_MODE_QUADRUPED;
 
@@ -10,47 +10,26 @@
 
 #include <stdint.h>
 
+#ifndef ROC_ROBOT_HOST_BUILD
 #include "stm32f4xx_hal.h"
+#endif
 #include "arm_math.h"
 
 #include "RocServo.h"
 #include "RocRobotMath.h"
+#include "RocRobotGeometryDesc.h"
+#include "RocRobotGeometry.h"
 
 
 //#define ROC_ROBOT_GAIT_DEBUG
 #define ROC_ROBOT_GAIT_QUAD_MODE_ENABLE
 #define ROC_ROBOT_CLOSED_LOOP_CONTROL
+//#define ROC_ROBOT_KINEMATIC_CHECK                 // Check the IK and the PWM with the forward kinematic every tick, on in the host build
 #define ROC_ROBOT_DISPLAY_GAIT_NAMES
 //#define ROC_ROBOT_GAIT_QUADMODE       // Building for quad support
 
 
-#define ROC_ROBOT_MATH_CONST_PI                     3.1415926
-
-
-#define ROC_ROBOT_LEG_HEIGHT                        120
-#define ROC_ROBOT_FEET_WIDTH                        21
-
-#define ROC_ROBOT_DH_CONST_D1                       0
-#define ROC_ROBOT_DH_CONST_A1                       43
-#define ROC_ROBOT_DH_CONST_A2                       64
-#define ROC_ROBOT_DH_CONST_A3                       121.82F /* (ROC_ROBOT_FEET_WIDTH^2 + ROC_ROBOT_FEET_WIDTH^2)^0.5 */
-
-#define ROC_ROBOT_LEG_WIDTH                         (ROC_ROBOT_DH_CONST_A1 + ROC_ROBOT_DH_CONST_A2 + ROC_ROBOT_FEET_WIDTH)
-
-
-#define ROC_ROBOT_BODY_LENGTH_OFFSET                48
-#define ROC_ROBOT_BODY_HEIGHT_OFFSET                0
-
-
-#define ROC_ROBOT_FRO_HIP_INIT_ANGLE                60
-#define ROC_ROBOT_FRO_LEG_INIT_ANGLE                0
-#define ROC_ROBOT_FRO_FET_INIT_ANGLE                78.19F
-#define ROC_ROBOT_MID_HIP_INIT_ANGLE                0
-#define ROC_ROBOT_MID_LEG_INIT_ANGLE                0
-#define ROC_ROBOT_MID_FET_INIT_ANGLE                78.19F
-#define ROC_ROBOT_HIN_HIP_INIT_ANGLE                60
-#define ROC_ROBOT_HIN_LEG_INIT_ANGLE                0
-#define ROC_ROBOT_HIN_FET_INIT_ANGLE                78.19F
+#define ROC_ROBOT_MATH_CONST_PI                     3.1415926F
 
 
 #define ROC_ROBOT_INIT_ANGLE_THET_1                 60
@@ -74,49 +53,10 @@
 #define ROC_ROBOT_STEP_ERROR_HIGH_LIMIT             15
 
 
-#define ROC_ROBOT_INIT_DOWN_ANGLE                   0
 #define ROC_ROBOT_ANGLE_TO_RADIAN                   (ROC_ROBOT_MATH_CONST_PI / 180)
 #define ROC_ROBOT_ROTATE_ANGLE_TO_PWM               ((ROC_SERVO_MAX_PWM_VAL - ROC_SERVO_MIN_PWM_VAL) / ROC_SERVO_MAX_ROTATE_ANGLE)
 
 
-#define ROC_ROBOT_WIDTH                             (ROC_ROBOT_DH_CONST_A1 + ROC_ROBOT_DH_CONST_A2 * Cos(ROC_ROBOT_INIT_DOWN_ANGLE \
-                                                    * ROC_ROBOT_ANGLE_TO_RADIAN) + ROC_ROBOT_FEET_WIDTH)
-#define ROC_ROBOT_HEIGHT                            (ROC_ROBOT_DH_CONST_A2 * Sin(ROC_ROBOT_INIT_DOWN_ANGLE * ROC_ROBOT_ANGLE_TO_RADIAN) \
-                                                    + ROC_ROBOT_LEG_HEIGHT)
-
-
-#define ROC_ROBOT_RIG_FRO_OFFSET_X                  (ROC_ROBOT_BODY_LENGTH_OFFSET * Cos(ROC_ROBOT_FRO_HIP_INIT_ANGLE * ROC_ROBOT_ANGLE_TO_RADIAN))
-#define ROC_ROBOT_RIG_FRO_OFFSET_Y                  (ROC_ROBOT_BODY_LENGTH_OFFSET * Sin(ROC_ROBOT_FRO_HIP_INIT_ANGLE * ROC_ROBOT_ANGLE_TO_RADIAN))
-#define ROC_ROBOT_RIG_FRO_OFFSET_Z                  (ROC_ROBOT_BODY_HEIGHT_OFFSET)
-#define ROC_ROBOT_RIG_MID_OFFSET_X                  (ROC_ROBOT_BODY_LENGTH_OFFSET * Cos(ROC_ROBOT_MID_HIP_INIT_ANGLE * ROC_ROBOT_ANGLE_TO_RADIAN))
-#define ROC_ROBOT_RIG_MID_OFFSET_Y                  (ROC_ROBOT_BODY_LENGTH_OFFSET * Sin(ROC_ROBOT_MID_HIP_INIT_ANGLE * ROC_ROBOT_ANGLE_TO_RADIAN))
-#define ROC_ROBOT_RIG_MID_OFFSET_Z                  (ROC_ROBOT_BODY_HEIGHT_OFFSET)
-#define ROC_ROBOT_RIG_HIN_OFFSET_X                  (ROC_ROBOT_BODY_LENGTH_OFFSET * Cos(ROC_ROBOT_HIN_HIP_INIT_ANGLE * ROC_ROBOT_ANGLE_TO_RADIAN))
-#define ROC_ROBOT_RIG_HIN_OFFSET_Y                  (-ROC_ROBOT_BODY_LENGTH_OFFSET * Sin(ROC_ROBOT_HIN_HIP_INIT_ANGLE * ROC_ROBOT_ANGLE_TO_RADIAN))
-#define ROC_ROBOT_RIG_HIN_OFFSET_Z                  (ROC_ROBOT_BODY_HEIGHT_OFFSET)
-
-#define ROC_ROBOT_LEF_FRO_OFFSET_X                  (-ROC_ROBOT_BODY_LENGTH_OFFSET * Cos(ROC_ROBOT_FRO_HIP_INIT_ANGLE * ROC_ROBOT_ANGLE_TO_RADIAN))
-#define ROC_ROBOT_LEF_FRO_OFFSET_Y                  (ROC_ROBOT_BODY_LENGTH_OFFSET * Sin(ROC_ROBOT_FRO_HIP_INIT_ANGLE * ROC_ROBOT_ANGLE_TO_RADIAN))
-#define ROC_ROBOT_LEF_FRO_OFFSET_Z                  (ROC_ROBOT_BODY_HEIGHT_OFFSET)
-#define ROC_ROBOT_LEF_MID_OFFSET_X                  (-ROC_ROBOT_BODY_LENGTH_OFFSET * Cos(ROC_ROBOT_MID_HIP_INIT_ANGLE * ROC_ROBOT_ANGLE_TO_RADIAN))
-#define ROC_ROBOT_LEF_MID_OFFSET_Y                  (ROC_ROBOT_BODY_LENGTH_OFFSET * Sin(ROC_ROBOT_MID_HIP_INIT_ANGLE * ROC_ROBOT_ANGLE_TO_RADIAN))
-#define ROC_ROBOT_LEF_MID_OFFSET_Z                  (ROC_ROBOT_BODY_HEIGHT_OFFSET)
-#define ROC_ROBOT_LEF_HIN_OFFSET_X                  (-ROC_ROBOT_BODY_LENGTH_OFFSET * Cos(ROC_ROBOT_HIN_HIP_INIT_ANGLE * ROC_ROBOT_ANGLE_TO_RADIAN))
-#define ROC_ROBOT_LEF_HIN_OFFSET_Y                  (-ROC_ROBOT_BODY_LENGTH_OFFSET * Sin(ROC_ROBOT_HIN_HIP_INIT_ANGLE * ROC_ROBOT_ANGLE_TO_RADIAN))
-#define ROC_ROBOT_LEF_HIN_OFFSET_Z                  (ROC_ROBOT_BODY_HEIGHT_OFFSET)
-
-
-#define ROC_ROBOT_FRO_INIT_X                        (ROC_ROBOT_WIDTH * Cos(ROC_ROBOT_FRO_HIP_INIT_ANGLE * ROC_ROBOT_ANGLE_TO_RADIAN))
-#define ROC_ROBOT_FRO_INIT_Y                        (ROC_ROBOT_WIDTH * Sin(ROC_ROBOT_FRO_HIP_INIT_ANGLE * ROC_ROBOT_ANGLE_TO_RADIAN))
-#define ROC_ROBOT_FRO_INIT_Z                        (-ROC_ROBOT_HEIGHT)
-#define ROC_ROBOT_MID_INIT_X                        (ROC_ROBOT_WIDTH * Cos(ROC_ROBOT_MID_HIP_INIT_ANGLE * ROC_ROBOT_ANGLE_TO_RADIAN))
-#define ROC_ROBOT_MID_INIT_Y                        (ROC_ROBOT_WIDTH * Sin(ROC_ROBOT_MID_HIP_INIT_ANGLE * ROC_ROBOT_ANGLE_TO_RADIAN))
-#define ROC_ROBOT_MID_INIT_Z                        (-ROC_ROBOT_HEIGHT)
-#define ROC_ROBOT_HIN_INIT_X                        (ROC_ROBOT_WIDTH * Cos(ROC_ROBOT_HIN_HIP_INIT_ANGLE * ROC_ROBOT_ANGLE_TO_RADIAN))
-#define ROC_ROBOT_HIN_INIT_Y                        (ROC_ROBOT_WIDTH * Sin(ROC_ROBOT_HIN_HIP_INIT_ANGLE * ROC_ROBOT_ANGLE_TO_RADIAN))
-#define ROC_ROBOT_HIN_INIT_Z                        (-ROC_ROBOT_HEIGHT)
-
-
 #define ROC_ROBOT_RIG_FRO_HIP_CENTER                (302)
 #define ROC_ROBOT_RIG_FRO_LEG_CENTER                (172 + 180)
 #define ROC_ROBOT_RIG_FRO_FET_CENTER                (320)
@@ -142,6 +82,7 @@
 #define ROC_ROBOT_DEFAULT_TURN_ANGLE                20
 #define ROC_ROBOT_DEFAULT_FEET_LIFT                 45
 #define ROC_ROBOT_QUAD_MODE_FEET_LIFT               40
+#define ROC_ROBOT_QUAD_MODE_COG_RADIUS              30      // Body shift of the ripple gaits, mm
 
 
 #define ROC_ROBOT_BODY_ROTATE_MIN_PITCH             (-16)
@@ -152,10 +93,15 @@
 #define ROC_ROBOT_BODY_ROTATE_MAX_YAW               20
 
 
+#define ROC_ROBOT_GAIT_MAX_STEPS                    32  //The gait phase table size
+
+
 #define ROC_ROBOT_TRAVEL_DEAD_ZONE                  1   //The deadzone for the analog input from the remote
 
 #define ROC_ROBOT_RUN_SPEED_POWER_ON                (ROC_SERVO_PWM_CYCLE * ROC_SERVO_SPEED_DIV_STP * ROC_SERVO_SPEED_DOWN_MAG * 4)
 #define ROC_ROBOT_RUN_SPEED_DEFAULT                 (ROC_SERVO_PWM_CYCLE * ROC_SERVO_SPEED_DIV_STP * ROC_SERVO_SPEED_DOWN_MAG)
+#define ROC_ROBOT_RUN_SPEED_SLOW                    (ROC_ROBOT_RUN_SPEED_DEFAULT * 2)                   // The joystick in the center
+#define ROC_ROBOT_RUN_SPEED_FAST                    (ROC_SERVO_PWM_CYCLE * ROC_SERVO_SPEED_DIV_STP)     // One PWM cycle for one step
 
 
 typedef enum _ROC_ROBOT_WALK_MODE_e
@@ -165,6 +111,14 @@ typedef enum _ROC_ROBOT_WALK_MODE_e
 
 }ROC_ROBOT_WALK_MODE_e;
 
+typedef enum _ROC_ROBOT_GAIT_MODE_e
+{
+    ROC_ROBOT_GAIT_MODE_TABLE = 0,          /* The gait steps of the gait table */
+    ROC_ROBOT_GAIT_MODE_CYCLE,              /* The continuous phase of RocRobotGaitCycle.c */
+
+    ROC_ROBOT_GAIT_MODE_NUM,
+}ROC_ROBOT_GAIT_MODE_e;
+
 typedef enum _ROC_ROBOT_LEG_JOINT_e
 {
     ROC_ROBOT_LEG_HIP_JOINT = 0,
@@ -220,6 +174,39 @@ typedef enum _ROC_ROBOT_MOVE_STATUS_e
 }ROC_ROBOT_MOVE_STATUS_e;
 
 
+typedef enum _ROC_ROBOT_GAIT_PHASE_e
+{
+    ROC_ROBOT_GAIT_PHASE_LIFT = 0,          /* Leg lifted up to the top */
+    ROC_ROBOT_GAIT_PHASE_HALF_REAR,         /* Half height rear (2, 3, 5 lifted positions) */
+    ROC_ROBOT_GAIT_PHASE_HALF_FRONT,        /* Half height front (2, 3, 5 lifted positions) */
+    ROC_ROBOT_GAIT_PHASE_HALF_REAR_5,       /* Half height rear (5 lifted positions) */
+    ROC_ROBOT_GAIT_PHASE_HALF_FRONT_5,      /* Half height front (5 lifted positions) */
+    ROC_ROBOT_GAIT_PHASE_FRONT_DOWN,        /* Leg front down position */
+    ROC_ROBOT_GAIT_PHASE_SLIDE,             /* Leg on the floor, move body forward */
+
+    ROC_ROBOT_GAIT_PHASE_NUM,
+}ROC_ROBOT_GAIT_PHASE_e;
+
+typedef enum _ROC_ROBOT_GAIT_DIV_e
+{
+    ROC_ROBOT_GAIT_DIV_LIFT = 0,            /* Travel / LiftDivFactor */
+    ROC_ROBOT_GAIT_DIV_HALF,                /* Travel / 2 */
+    ROC_ROBOT_GAIT_DIV_SLID,                /* Travel / SlidDivFactor */
+
+    ROC_ROBOT_GAIT_DIV_NUM,
+}ROC_ROBOT_GAIT_DIV_e;
+
+typedef enum _ROC_ROBOT_GAIT_LIFT_e
+{
+    ROC_ROBOT_GAIT_LIFT_GROUND = 0,         /* 0 */
+    ROC_ROBOT_GAIT_LIFT_FULL,               /* LegLiftHeight */
+    ROC_ROBOT_GAIT_LIFT_HALF,               /* 3 * LegLiftHeight / (3 + HalfLiftHeight) */
+    ROC_ROBOT_GAIT_LIFT_HALF_5,             /* LegLiftHeight / 2 */
+
+    ROC_ROBOT_GAIT_LIFT_NUM,
+}ROC_ROBOT_GAIT_LIFT_e;
+
+
 typedef struct _ROC_ROBOT_COORD_s
 {
     float   X;
@@ -229,8 +216,11 @@ typedef struct _ROC_ROBOT_COORD_s
 
 }ROC_ROBOT_COORD_s;
 
+/* The IMU attitude is the quaternion of every sample, the euler angle is only
+   converted for the display and the report */
 typedef struct _ROC_ROBOT_IMU_DATA_s
 {
+    float   Quat[4];        // Unit quaternion W, X, Y, Z
     float   Pitch;
     float   Roll;
     float   Yaw;
@@ -280,12 +270,15 @@ typedef struct _ROC_PHOENIX_STATE_s
 
     //[gait]
     ROC_ROBOT_GAIT_TYPE_e       GaitType;               // Gait type
+    ROC_ROBOT_GAIT_MODE_e       GaitMode;               // Gait table steps or continuous phase
     uint8_t                     GaitStep;               // Actual current step in gait
     uint8_t                     TravelRequest;          //Temp to check if the gait is in motion
-    double                      GaitRot[ROC_ROBOT_CNT_LEGS];//Array containing Relative Z rotation corresponding to the Gait
+    float                       GaitRot[ROC_ROBOT_CNT_LEGS];//Array containing Relative Z rotation corresponding to the Gait
     uint16_t                    LegLiftHeight;          // Current Travel height
     ROC_ROBOT_COORD_s           TravelLength;           // X-Y or Length, Z is rotation
     uint16_t                    TurnLength;             // turn angle for clockwise move
+    ROC_ROBOT_COORD_s           CogShift;               // Body shift of the quad balance mode in the body coordinate
+    float                       StabilityMargin;        // Static stability margin of the feet on the floor in mm
 
 #ifdef TurretRotPin
     // Turret information
@@ -308,6 +301,12 @@ typedef struct _ROC_PHOENIX_STATE_s
 
     ROC_ROBOT_WALK_MODE_e       WalkMode;               // Robot current walk mode
 
+#ifdef ROC_ROBOT_KINEMATIC_CHECK
+    //[Kinematic check]
+    float                       IkError;                // Max feet error of the IK angle clamping of the last tick, mm
+    float                       PwmError;               // Max feet error of the servo PWM quantisation of the last tick, mm
+#endif
+
     //[TIMING]
     uint8_t                     InputTimeDelay;         // Delay that depends on the input to get the "sneaking" effect
     uint32_t                    SpeedControl;           // Adjustible Delay
@@ -334,6 +333,58 @@ typedef struct _ROC_ROBOT_SERVO_s
 }ROC_ROBOT_SERVO_s;
 
 
+typedef struct _ROC_ROBOT_FEET_POS_s
+{
+    float                       X[ROC_ROBOT_CNT_LEGS];  // Feet position of all legs, in the coordinate of each leg
+    float                       Y[ROC_ROBOT_CNT_LEGS];
+    float                       Z[ROC_ROBOT_CNT_LEGS];
+
+}ROC_ROBOT_FEET_POS_s;
+
+
+typedef struct _ROC_ROBOT_JOINT_ANGLE_s
+{
+    float                       Angle[ROC_ROBOT_CNT_LEGS][ROC_ROBOT_LEG_JOINT_NUM];
+
+}ROC_ROBOT_JOINT_ANGLE_s;
+
+
+typedef struct _ROC_ROBOT_LEG_GEOMETRY_s
+{
+    float                       FeetInit[3];            // Stand feet position in the leg coordinate
+    float                       BodyFeet[3];            // Stand feet position in the body coordinate
+
+}ROC_ROBOT_LEG_GEOMETRY_s;
+
+
+typedef struct _ROC_ROBOT_LEG_CONFIG_s
+{
+    int8_t                      XSign;                  // Mirror of the X travel, right legs: 1, left legs: -1
+    int8_t                      YSign;                  // Mirror of the Y travel, hind legs: -1, others: 1
+    uint8_t                     IsMidLeg;               // True if the leg is parked in quadruped mode
+    float                       HipInitAngle;           // Init hip angle of the feet position
+    int16_t                     JointCenter[ROC_ROBOT_LEG_JOINT_NUM];   // Servo PWM center of the joints
+    float                       JointInitAngle[ROC_ROBOT_LEG_JOINT_NUM];// Signed init angle of the joints
+    int8_t                      JointSign[ROC_ROBOT_LEG_JOINT_NUM];     // Servo rotate direction of the joints
+
+}ROC_ROBOT_LEG_CONFIG_s;
+
+
+typedef struct _ROC_ROBOT_GAIT_PHASE_s
+{
+    float                       XyKeep;                 // 1: the X, Y slide from the last position, 0: set
+    float                       RotKeep;                // 1: the gait rotation slides from the last one, 0: set
+    float                       AKeep;                  // 1: the circle angle slides from the last one, 0: set
+    float                       XFactor;                // Factor of the X travel step
+    float                       YFactor;                // Factor of the Y travel step
+    float                       RotFactor;              // Factor of the rotation travel step
+    float                       AFactor;                // Factor of the circle angle travel step
+    uint8_t                     TravelDiv;              // ROC_ROBOT_GAIT_DIV_e of the travel step
+    uint8_t                     ZLift;                  // ROC_ROBOT_GAIT_LIFT_e of the leg height
+
+}ROC_ROBOT_GAIT_PHASE_s;
+
+
 typedef struct _ROC_ROBOT_MOVE_CTRL_s
 {
     ROC_PHOENIX_GAIT_s  CurGait;                        // Definition of the current gait
@@ -346,6 +397,10 @@ typedef struct _ROC_ROBOT_MOVE_CTRL_s
 
 void RocRobotGaitSeqUpdate(void);
 ROC_RESULT RocRobotAlgoCtrlInit(void);
+ROC_RESULT RocRobotGaitTypeSet(ROC_ROBOT_GAIT_TYPE_e GaitType);
+ROC_RESULT RocRobotGaitModeSet(ROC_ROBOT_GAIT_MODE_e GaitMode);
+ROC_RESULT RocRobotGaitTableGet(ROC_ROBOT_GAIT_TYPE_e GaitType, ROC_PHOENIX_GAIT_s *pGait);
+ROC_RESULT RocRobotGaitTableSet(ROC_ROBOT_GAIT_TYPE_e GaitType, const ROC_PHOENIX_GAIT_s *pGait);
 ROC_ROBOT_MOVE_CTRL_s *RocRobotCtrlInfoGet(void);
 ROC_ROBOT_MOVE_STATUS_e RocRobotMoveStatus_Get(void);
 void RocRobotMoveStatus_Set(ROC_ROBOT_MOVE_STATUS_e MoveStatus);
@@ -354,7 +409,13 @@ void RocRobotSingleLegCtrl(ROC_ROBOT_SERVO_s *pRobotServo);
 void RocRobotOpenLoopWalkCalculate(ROC_ROBOT_SERVO_s *pRobotServo);
 void RocRobotOpenLoopCircleCalculate(ROC_ROBOT_SERVO_s *pRobotServo);
 void RocRobotClosedLoopWalkCalculate(ROC_ROBOT_SERVO_s *pRobotServo);
-void RocRobotCtrlDeltaMoveCoorInput(double x, double y, double z, double a, double h);
+void RocRobotCtrlDeltaMoveCoorInput(float x, float y, float z, float a, float h);
+void RocRobotLegInverseKinematicBatch(const ROC_ROBOT_FEET_POS_s *pFeetPos, ROC_ROBOT_JOINT_ANGLE_s *pJointAngle);
+void RocRobotJointAngleToPwm(const ROC_ROBOT_JOINT_ANGLE_s *pJointAngle, ROC_ROBOT_SERVO_s *pRobotServo);
+void RocRobotLegForwardKinematicBatch(const ROC_ROBOT_JOINT_ANGLE_s *pJointAngle, ROC_ROBOT_FEET_POS_s *pFeetPos);
+void RocRobotPwmToJointAngle(const ROC_ROBOT_SERVO_s *pRobotServo, ROC_ROBOT_JOINT_ANGLE_s *pJointAngle);
+void RocRobotKinematicRoundTripCheck(const ROC_ROBOT_FEET_POS_s *pFeetPos, const ROC_ROBOT_JOINT_ANGLE_s *pJointAngle,
+                                     const ROC_ROBOT_SERVO_s *pRobotServo, float *pIkError, float *pPwmError);
 
 
 #endif
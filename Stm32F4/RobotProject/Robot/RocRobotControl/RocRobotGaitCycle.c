@@ -0,0 +1,272 @@
+/********************************************************************************
+ * This code is used for robot control
+*********************************************************************************
+ * Author        Data            Version
+ * Liren         2026/10/17      1.0
+********************************************************************************/
+#include <stdint.h>
+
+#include "RocLog.h"
+#include "RocRobotMath.h"
+#include "RocRobotGaitCycle.h"
+
+
+#define ROC_ROBOT_GAIT_CYCLE_CONST_2PI              (2 * ROC_ROBOT_MATH_CONST_PI)
+
+
+typedef struct _ROC_ROBOT_GAIT_CYCLE_s
+{
+    float                       LegPhase[ROC_ROBOT_CNT_LEGS];   // Phase accumulator of every leg, [0, 1)
+    float                       SwingRatio;             // Part of the cycle that the leg is lifted
+    float                       PeriodMs;               // Time of one gait cycle
+    float                       CyclePhase;             // Phase of the gait cycle, 0 is the top swing of the leg with GaitLegNr 1
+    uint8_t                     StepsInGait;            // Gait table steps of one gait cycle
+    ROC_ROBOT_GAIT_SWING_e      Swing;                  // Swing trajectory
+
+}ROC_ROBOT_GAIT_CYCLE_s;
+
+
+static ROC_ROBOT_GAIT_CYCLE_s   g_RobotGaitCycle =
+{
+    .SwingRatio  = 0.5F,
+    .PeriodMs    = 1000.0F,
+    .StepsInGait = 1,
+    .Swing       = ROC_ROBOT_GAIT_SWING_CYCLOID,
+};
+
+
+/*********************************************************************************
+ *  Description:
+ *              Init the continuous gait from the gait of the gait table, the
+ *              legs start from the gait step 1, and the cycle time is the same
+ *              as the table gait at its nominal speed
+ *
+ *  Parameter:
+ *              pGait: the pointer to the gait
+ *
+ *  Return:
+ *              RET_ERROR if the gait has no swing or no stance
+ *
+ *  Author:
+ *              ROC LiRen(2026.10.17)
+**********************************************************************************/
+ROC_RESULT RocRobotGaitCycleInit(const ROC_PHOENIX_GAIT_s *pGait)
+{
+    uint8_t i = 0;
+    float   Phase = 0;
+
+    if((0 == pGait->SlidDivFactor) || (pGait->StepsInGait <= pGait->SlidDivFactor))
+    {
+        ROC_LOGE("Robot gait cycle(%d, %d) has no swing!", pGait->StepsInGait, pGait->SlidDivFactor);
+
+        return RET_ERROR;
+    }
+
+    g_RobotGaitCycle.SwingRatio = 1.0F - (float)pGait->SlidDivFactor / pGait->StepsInGait;
+    g_RobotGaitCycle.CyclePhase = 0;
+    g_RobotGaitCycle.StepsInGait = pGait->StepsInGait;
+
+    for(i = 0; i < ROC_ROBOT_CNT_LEGS; i++)
+    {
+        Phase = 0.5F * g_RobotGaitCycle.SwingRatio - (float)(pGait->GaitLegNr[i] - 1) / pGait->StepsInGait;
+
+        g_RobotGaitCycle.LegPhase[i] = Phase - floorf(Phase);
+    }
+
+    return RocRobotGaitCyclePeriodSet((uint32_t)pGait->StepsInGait * pGait->NomGaitSpeed);
+}
+
+/*********************************************************************************
+ *  Description:
+ *              Set the time of one gait cycle, the walk speed is the stride
+ *              length divided by the cycle time
+ *
+ *  Parameter:
+ *              PeriodMs: the cycle time in ms
+ *
+ *  Return:
+ *              RET_ERROR if the cycle time is out of range
+ *
+ *  Author:
+ *              ROC LiRen(2026.10.17)
+**********************************************************************************/
+ROC_RESULT RocRobotGaitCyclePeriodSet(uint32_t PeriodMs)
+{
+    if((ROC_ROBOT_GAIT_CYCLE_MIN_PERIOD > PeriodMs) || (ROC_ROBOT_GAIT_CYCLE_MAX_PERIOD < PeriodMs))
+    {
+        ROC_LOGE("Robot gait cycle period(%u ms) is out of range!", PeriodMs);
+
+        return RET_ERROR;
+    }
+
+    g_RobotGaitCycle.PeriodMs = (float)PeriodMs;
+
+    return RET_OK;
+}
+
+/*********************************************************************************
+ *  Description:
+ *              Get the time of one gait cycle
+ *
+ *  Parameter:
+ *              None
+ *
+ *  Return:
+ *              The cycle time in ms
+ *
+ *  Author:
+ *              ROC LiRen(2026.10.17)
+**********************************************************************************/
+uint32_t RocRobotGaitCyclePeriodGet(void)
+{
+    return (uint32_t)g_RobotGaitCycle.PeriodMs;
+}
+
+/*********************************************************************************
+ *  Description:
+ *              Select the swing trajectory of the lifted leg
+ *
+ *  Parameter:
+ *              Swing: the swing trajectory
+ *
+ *  Return:
+ *              RET_ERROR if the swing trajectory is invalid
+ *
+ *  Author:
+ *              ROC LiRen(2026.10.17)
+**********************************************************************************/
+ROC_RESULT RocRobotGaitCycleSwingSet(ROC_ROBOT_GAIT_SWING_e Swing)
+{
+    if(ROC_ROBOT_GAIT_SWING_NUM <= Swing)
+    {
+        ROC_LOGE("Robot gait swing(%d) is invalid!", Swing);
+
+        return RET_ERROR;
+    }
+
+    g_RobotGaitCycle.Swing = Swing;
+
+    return RET_OK;
+}
+
+/*********************************************************************************
+ *  Description:
+ *              Calculate the swing trajectory, both the stride and the lift
+ *              start and end with zero speed
+ *
+ *  Parameter:
+ *              s: the progress of the swing, [0, 1)
+ *              pStride: the stride progress, from 0 to 1
+ *              pLift: the part of the lift height, 0 at both ends and 1 at the top
+ *
+ *  Return:
+ *              None
+ *
+ *  Author:
+ *              ROC LiRen(2026.10.17)
+**********************************************************************************/
+static void RocRobotGaitCycleSwingCalc(float s, float *pStride, float *pLift)
+{
+    float   Angle = 0;
+
+    if(ROC_ROBOT_GAIT_SWING_BEZIER == g_RobotGaitCycle.Swing)
+    {
+        /* Control points: stride (0, 0, 1, 1), lift (0, 4/3, 4/3, 0) */
+        *pStride = s * s * (3.0F - 2.0F * s);
+        *pLift = 4.0F * s * (1.0F - s);
+    }
+    else
+    {
+        Angle = ROC_ROBOT_GAIT_CYCLE_CONST_2PI * s;
+
+        *pStride = s - Sin(Angle) / ROC_ROBOT_GAIT_CYCLE_CONST_2PI;
+        *pLift = 0.5F * (1.0F - Cos(Angle));
+    }
+}
+
+/*********************************************************************************
+ *  Description:
+ *              Advance the continuous gait and update the leg positions. The
+ *              leg is at the front of the stride (+travel / 2) when it is put
+ *              down, and slides to the rear (-travel / 2) with the constant
+ *              speed on the floor.
+ *
+ *  Parameter:
+ *              pState: the pointer to the robot state, the travel is the input,
+ *                      LegCurPos and GaitRot are the output
+ *              DtMs: the time since the last update
+ *
+ *  Return:
+ *              None
+ *
+ *  Author:
+ *              ROC LiRen(2026.10.17)
+**********************************************************************************/
+void RocRobotGaitCycleUpdate(ROC_PHOENIX_STATE_s *pState, float DtMs)
+{
+    uint8_t i = 0;
+    float   PhaseStep = 0;
+    float   Phase = 0;
+    float   Stride = 0;
+    float   Lift = 0;
+
+    PhaseStep = DtMs / g_RobotGaitCycle.PeriodMs;
+
+    Phase = g_RobotGaitCycle.CyclePhase + PhaseStep;
+    g_RobotGaitCycle.CyclePhase = Phase - floorf(Phase);
+
+    for(i = 0; i < ROC_ROBOT_CNT_LEGS; i++)
+    {
+        Phase = g_RobotGaitCycle.LegPhase[i] + PhaseStep;
+        Phase = Phase - floorf(Phase);
+
+        g_RobotGaitCycle.LegPhase[i] = Phase;
+
+        if(Phase < g_RobotGaitCycle.SwingRatio)
+        {
+            RocRobotGaitCycleSwingCalc(Phase / g_RobotGaitCycle.SwingRatio, &Stride, &Lift);
+
+            Stride = Stride - 0.5F;
+        }
+        else
+        {
+            Stride = 0.5F - (Phase - g_RobotGaitCycle.SwingRatio) / (1.0F - g_RobotGaitCycle.SwingRatio);
+            Lift = 0;
+        }
+
+        if(ROC_ROBOT_MOVE_STATUS_CIRCLING != pState->MoveStatus)
+        {
+            pState->LegCurPos[i].X = Stride * pState->TravelLength.X;
+            pState->LegCurPos[i].Y = Stride * pState->TravelLength.Y;
+        }
+        else
+        {
+            pState->LegCurPos[i].X = 0;
+            pState->LegCurPos[i].Y = 0;
+            pState->LegCurPos[i].A = Stride * pState->TravelLength.A;
+        }
+
+        pState->LegCurPos[i].Z = Lift * pState->LegLiftHeight;
+        pState->GaitRot[i] = Stride * pState->TravelLength.Z;
+    }
+}
+
+/*********************************************************************************
+ *  Description:
+ *              Get the position of the gait cycle in the gait table steps, the
+ *              leg with GaitLegNr N is at the top of its swing at step N
+ *
+ *  Parameter:
+ *              None
+ *
+ *  Return:
+ *              The gait step in [1, StepsInGait + 1)
+ *
+ *  Author:
+ *              ROC LiRen(2026.10.17)
+**********************************************************************************/
+float RocRobotGaitCycleStepGet(void)
+{
+    return 1.0F + g_RobotGaitCycle.CyclePhase * g_RobotGaitCycle.StepsInGait;
+}
+
@@ -0,0 +1,45 @@
+/********************************************************************************
+ * This code is used for robot control
+*********************************************************************************
+ * Author        Data            Version
+ * Liren         2026/10/17      1.0
+********************************************************************************/
+#ifndef __ROC_ROBOT_GAIT_CYCLE_H
+#define __ROC_ROBOT_GAIT_CYCLE_H
+
+
+#include <stdint.h>
+
+#include "RocError.h"
+#include "RocRobotDhAlgorithm.h"
+
+
+/* The continuous gait: every leg has a phase in [0, 1) of the gait cycle, the
+   leg swings in [0, SwingRatio) and is on the floor in [SwingRatio, 1). The
+   phase advances with the time, so the gait can be evaluated at any control
+   rate. The leg order and the duty of a gait table gait are kept:
+   SwingRatio = 1 - SlidDivFactor / StepsInGait, and the leg with GaitLegNr N is
+   at the top of its swing at (N - 1) / StepsInGait of the cycle. */
+#define ROC_ROBOT_GAIT_CYCLE_MIN_PERIOD             100U    // ms
+#define ROC_ROBOT_GAIT_CYCLE_MAX_PERIOD             10000U  // ms
+
+
+typedef enum _ROC_ROBOT_GAIT_SWING_e
+{
+    ROC_ROBOT_GAIT_SWING_CYCLOID = 0,           // Stride s - sin(2PIs) / 2PI, lift (1 - cos(2PIs)) / 2
+    ROC_ROBOT_GAIT_SWING_BEZIER,                // Cubic Bezier, stride 3s^2 - 2s^3, lift 4s(1 - s)
+
+    ROC_ROBOT_GAIT_SWING_NUM,
+}ROC_ROBOT_GAIT_SWING_e;
+
+
+ROC_RESULT RocRobotGaitCycleInit(const ROC_PHOENIX_GAIT_s *pGait);
+ROC_RESULT RocRobotGaitCyclePeriodSet(uint32_t PeriodMs);
+uint32_t RocRobotGaitCyclePeriodGet(void);
+ROC_RESULT RocRobotGaitCycleSwingSet(ROC_ROBOT_GAIT_SWING_e Swing);
+void RocRobotGaitCycleUpdate(ROC_PHOENIX_STATE_s *pState, float DtMs);
+float RocRobotGaitCycleStepGet(void);
+
+
+#endif
+
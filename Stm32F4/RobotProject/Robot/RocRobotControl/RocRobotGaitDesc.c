@@ -0,0 +1,447 @@
+/********************************************************************************
+ * This code is used for robot control
+*********************************************************************************
+ * Author        Data            Version
+ * Liren         2026/10/17      1.0
+********************************************************************************/
+#include <string.h>
+
+#include "RocLog.h"
+#include "RocAt24c02.h"
+#include "RocRobotGaitDesc.h"
+
+
+#define ROC_ROBOT_GAIT_DESC_SLOT_FREE           0xFFU
+
+
+/* The gait type stored in every slot, ROC_ROBOT_GAIT_DESC_SLOT_FREE is free */
+static uint8_t g_RobotGaitDescSlot[ROC_ROBOT_GAIT_DESC_SLOT_NUM];
+
+
+/*********************************************************************************
+ *  Description:
+ *              Check the gait can be run by the gait sequence
+ *
+ *  Parameter:
+ *              pGait: the pointer to the gait
+ *
+ *  Return:
+ *              RET_ERROR if any parameter is out of range
+ *
+ *  Author:
+ *              ROC LiRen(2026.10.17)
+**********************************************************************************/
+static ROC_RESULT RocRobotGaitDescCheck(const ROC_PHOENIX_GAIT_s *pGait)
+{
+    uint8_t i = 0;
+
+    if((2U > pGait->StepsInGait) || (ROC_ROBOT_GAIT_DESC_MAX_STEP < pGait->StepsInGait))
+    {
+        ROC_LOGE("Gait steps(%d) is out of range!", pGait->StepsInGait);
+
+        return RET_ERROR;
+    }
+
+    /* The lifted leg positions are written for 1, 2, 3 and 5 positions */
+    if((0U == pGait->NrLiftedPos) || (5U < pGait->NrLiftedPos) || (4U == pGait->NrLiftedPos))
+    {
+        ROC_LOGE("Gait lifted positions(%d) is not supported!", pGait->NrLiftedPos);
+
+        return RET_ERROR;
+    }
+
+    if((0U == pGait->LiftDivFactor) || (0U == pGait->SlidDivFactor)
+        || (pGait->StepsInGait < pGait->NrLiftedPos + pGait->SlidDivFactor))
+    {
+        ROC_LOGE("Gait div factor(%d, %d) is out of range!", pGait->LiftDivFactor, pGait->SlidDivFactor);
+
+        return RET_ERROR;
+    }
+
+    if((0U == pGait->FrontDownPos) || (pGait->StepsInGait <= pGait->FrontDownPos))
+    {
+        ROC_LOGE("Gait front down position(%d) is out of range!", pGait->FrontDownPos);
+
+        return RET_ERROR;
+    }
+
+    for(i = 0; i < ROC_ROBOT_CNT_LEGS; i++)
+    {
+        if(pGait->StepsInGait < pGait->GaitLegNr[i])
+        {
+            ROC_LOGE("Gait leg(%d) number(%d) is out of range!", i, pGait->GaitLegNr[i]);
+
+            return RET_ERROR;
+        }
+    }
+
+    if(ROC_ROBOT_GAIT_DESC_MAX_HALF_LIFT < pGait->HalfLiftHeight)
+    {
+        ROC_LOGE("Gait half lift height(%d) is out of range!", pGait->HalfLiftHeight);
+
+        return RET_ERROR;
+    }
+
+    if(((uint16_t)ROC_ROBOT_RUN_SPEED_FAST > pGait->NomGaitSpeed)
+        || ((uint16_t)ROC_ROBOT_RUN_SPEED_POWER_ON < pGait->NomGaitSpeed))
+    {
+        ROC_LOGE("Gait speed(%d) is out of range!", pGait->NomGaitSpeed);
+
+        return RET_ERROR;
+    }
+
+    return RET_OK;
+}
+
+/*********************************************************************************
+ *  Description:
+ *              Check the robot is walking, the AT24C02 write blocks the main
+ *              loop for some page write cycles and the servo tick is missed
+ *
+ *  Parameter:
+ *              None
+ *
+ *  Return:
+ *              ROC_TRUE if the robot is walking or circling
+ *
+ *  Author:
+ *              ROC LiRen(2026.10.17)
+**********************************************************************************/
+static uint8_t RocRobotGaitDescIsWalking(void)
+{
+    switch(RocRobotMoveStatus_Get())
+    {
+        case ROC_ROBOT_MOVE_STATUS_FORWALKING:
+        case ROC_ROBOT_MOVE_STATUS_BAKWALKING:
+        case ROC_ROBOT_MOVE_STATUS_CIRCLING:
+        {
+            ROC_LOGW("Robot is walking, stop it before writing the gait descriptors!");
+
+            return ROC_TRUE;
+        }
+
+        default:
+        {
+            return ROC_FALSE;
+        }
+    }
+}
+
+/*********************************************************************************
+ *  Description:
+ *              Serialise the gait to the descriptor of the present version
+ *
+ *  Parameter:
+ *              GaitType: the gait type
+ *              pGait:    the pointer to the gait
+ *              pDesc:    the pointer to the descriptor, ROC_ROBOT_GAIT_DESC_LEN bytes
+ *
+ *  Return:
+ *              RET_ERROR if the gait type is invalid
+ *
+ *  Author:
+ *              ROC LiRen(2026.10.17)
+**********************************************************************************/
+ROC_RESULT RocRobotGaitDescEncode(ROC_ROBOT_GAIT_TYPE_e GaitType, const ROC_PHOENIX_GAIT_s *pGait, uint8_t *pDesc)
+{
+    uint8_t     i = 0;
+    uint16_t    Crc = 0;
+
+    if(ROC_ROBOT_GAIT_TYPE_NUM <= GaitType)
+    {
+        return RET_ERROR;
+    }
+
+    memset(pDesc, 0, ROC_ROBOT_GAIT_DESC_LEN);
+
+    pDesc[ROC_ROBOT_GAIT_DESC_VERSION_BYTE] = ROC_ROBOT_GAIT_DESC_VERSION;
+    pDesc[ROC_ROBOT_GAIT_DESC_TYPE_BYTE] = (uint8_t)GaitType;
+    pDesc[ROC_ROBOT_GAIT_DESC_SPEED_BYTE] = (uint8_t)pGait->NomGaitSpeed;
+    pDesc[ROC_ROBOT_GAIT_DESC_SPEED_BYTE + 1] = (uint8_t)(pGait->NomGaitSpeed >> 8);
+    pDesc[ROC_ROBOT_GAIT_DESC_STEPS_BYTE] = pGait->StepsInGait;
+    pDesc[ROC_ROBOT_GAIT_DESC_LIFTED_POS_BYTE] = pGait->NrLiftedPos;
+    pDesc[ROC_ROBOT_GAIT_DESC_FRONT_DOWN_BYTE] = pGait->FrontDownPos;
+    pDesc[ROC_ROBOT_GAIT_DESC_LIFT_DIV_BYTE] = pGait->LiftDivFactor;
+    pDesc[ROC_ROBOT_GAIT_DESC_SLID_DIV_BYTE] = pGait->SlidDivFactor;
+    pDesc[ROC_ROBOT_GAIT_DESC_HALF_LIFT_BYTE] = pGait->HalfLiftHeight;
+
+    for(i = 0; i < ROC_ROBOT_CNT_LEGS; i++)
+    {
+        pDesc[ROC_ROBOT_GAIT_DESC_LEG_NR_BYTE + i] = pGait->GaitLegNr[i];
+    }
+
+#ifdef ROC_ROBOT_GAIT_QUAD_MODE_ENABLE
+    pDesc[ROC_ROBOT_GAIT_DESC_COG_START_BYTE] = (uint8_t)pGait->CogAngleStart;
+    pDesc[ROC_ROBOT_GAIT_DESC_COG_START_BYTE + 1] = (uint8_t)(pGait->CogAngleStart >> 8);
+    pDesc[ROC_ROBOT_GAIT_DESC_COG_STEP_BYTE] = (uint8_t)pGait->CogAngleStep;
+    pDesc[ROC_ROBOT_GAIT_DESC_COG_STEP_BYTE + 1] = (uint8_t)(pGait->CogAngleStep >> 8);
+    pDesc[ROC_ROBOT_GAIT_DESC_COG_RADIUS_BYTE] = pGait->CogRadius;
+    pDesc[ROC_ROBOT_GAIT_DESC_COG_CCW_BYTE] = pGait->CogCcw;
+#endif
+
+    Crc = RocAt24c02Crc16(pDesc, ROC_ROBOT_GAIT_DESC_CRC_BYTE);
+
+    pDesc[ROC_ROBOT_GAIT_DESC_CRC_BYTE] = (uint8_t)Crc;
+    pDesc[ROC_ROBOT_GAIT_DESC_CRC_BYTE + 1] = (uint8_t)(Crc >> 8);
+
+    return RET_OK;
+}
+
+/*********************************************************************************
+ *  Description:
+ *              Parse and validate the descriptor
+ *
+ *  Parameter:
+ *              pDesc:     the pointer to the descriptor, ROC_ROBOT_GAIT_DESC_LEN bytes
+ *              pGaitType: the pointer to the gait type
+ *              pGait:     the pointer to the gait
+ *
+ *  Return:
+ *              RET_ERROR if the version, the CRC or any parameter is invalid
+ *
+ *  Author:
+ *              ROC LiRen(2026.10.17)
+**********************************************************************************/
+ROC_RESULT RocRobotGaitDescDecode(const uint8_t *pDesc, ROC_ROBOT_GAIT_TYPE_e *pGaitType, ROC_PHOENIX_GAIT_s *pGait)
+{
+    uint8_t     i = 0;
+    uint16_t    Crc = 0;
+
+    if(ROC_ROBOT_GAIT_DESC_VERSION != pDesc[ROC_ROBOT_GAIT_DESC_VERSION_BYTE])
+    {
+        ROC_LOGE("Gait descriptor version(%d) is not supported!", pDesc[ROC_ROBOT_GAIT_DESC_VERSION_BYTE]);
+
+        return RET_ERROR;
+    }
+
+    Crc = (uint16_t)(pDesc[ROC_ROBOT_GAIT_DESC_CRC_BYTE] | (pDesc[ROC_ROBOT_GAIT_DESC_CRC_BYTE + 1] << 8));
+
+    if(Crc != RocAt24c02Crc16(pDesc, ROC_ROBOT_GAIT_DESC_CRC_BYTE))
+    {
+        ROC_LOGE("Gait descriptor CRC(0x%04X) is in error!", Crc);
+
+        return RET_ERROR;
+    }
+
+    if(ROC_ROBOT_GAIT_TYPE_NUM <= pDesc[ROC_ROBOT_GAIT_DESC_TYPE_BYTE])
+    {
+        ROC_LOGE("Gait descriptor type(%d) is invalid!", pDesc[ROC_ROBOT_GAIT_DESC_TYPE_BYTE]);
+
+        return RET_ERROR;
+    }
+
+    *pGaitType = (ROC_ROBOT_GAIT_TYPE_e)pDesc[ROC_ROBOT_GAIT_DESC_TYPE_BYTE];
+
+    memset(pGait, 0, sizeof(ROC_PHOENIX_GAIT_s));
+
+    pGait->NomGaitSpeed = (uint16_t)(pDesc[ROC_ROBOT_GAIT_DESC_SPEED_BYTE] | (pDesc[ROC_ROBOT_GAIT_DESC_SPEED_BYTE + 1] << 8));
+    pGait->StepsInGait = pDesc[ROC_ROBOT_GAIT_DESC_STEPS_BYTE];
+    pGait->NrLiftedPos = pDesc[ROC_ROBOT_GAIT_DESC_LIFTED_POS_BYTE];
+    pGait->FrontDownPos = pDesc[ROC_ROBOT_GAIT_DESC_FRONT_DOWN_BYTE];
+    pGait->LiftDivFactor = pDesc[ROC_ROBOT_GAIT_DESC_LIFT_DIV_BYTE];
+    pGait->SlidDivFactor = pDesc[ROC_ROBOT_GAIT_DESC_SLID_DIV_BYTE];
+    pGait->HalfLiftHeight = pDesc[ROC_ROBOT_GAIT_DESC_HALF_LIFT_BYTE];
+
+    for(i = 0; i < ROC_ROBOT_CNT_LEGS; i++)
+    {
+        pGait->GaitLegNr[i] = pDesc[ROC_ROBOT_GAIT_DESC_LEG_NR_BYTE + i];
+    }
+
+#ifdef ROC_ROBOT_GAIT_QUAD_MODE_ENABLE
+    pGait->CogAngleStart = (uint32_t)(pDesc[ROC_ROBOT_GAIT_DESC_COG_START_BYTE] | (pDesc[ROC_ROBOT_GAIT_DESC_COG_START_BYTE + 1] << 8));
+    pGait->CogAngleStep = (uint32_t)(pDesc[ROC_ROBOT_GAIT_DESC_COG_STEP_BYTE] | (pDesc[ROC_ROBOT_GAIT_DESC_COG_STEP_BYTE + 1] << 8));
+    pGait->CogRadius = pDesc[ROC_ROBOT_GAIT_DESC_COG_RADIUS_BYTE];
+    pGait->CogCcw = pDesc[ROC_ROBOT_GAIT_DESC_COG_CCW_BYTE];
+
+    if(1U < pGait->CogCcw)
+    {
+        ROC_LOGE("Gait COG direction(%d) is invalid!", pGait->CogCcw);
+
+        return RET_ERROR;
+    }
+#endif
+
+    return RocRobotGaitDescCheck(pGait);
+}
+
+/*********************************************************************************
+ *  Description:
+ *              Load the descriptors of the AT24C02 to the gait table, the free
+ *              slots are skipped, the invalid slots and the slots of a gait
+ *              loaded already are reported and reused
+ *
+ *  Parameter:
+ *              None
+ *
+ *  Return:
+ *              RET_ERROR if the AT24C02 can not be read, the default gaits
+ *              are kept
+ *
+ *  Author:
+ *              ROC LiRen(2026.10.17)
+**********************************************************************************/
+ROC_RESULT RocRobotGaitDescLoad(void)
+{
+    uint8_t                     i = 0;
+    uint8_t                     LoadNum = 0;
+    uint8_t                     Desc[ROC_ROBOT_GAIT_DESC_LEN];
+    ROC_ROBOT_GAIT_TYPE_e       GaitType = ROC_ROBOT_GAIT_HEXP_MODE_RIPPLE_12;
+    ROC_PHOENIX_GAIT_s          Gait;
+
+    memset(g_RobotGaitDescSlot, ROC_ROBOT_GAIT_DESC_SLOT_FREE, sizeof(g_RobotGaitDescSlot));
+
+    for(i = 0; i < ROC_ROBOT_GAIT_DESC_SLOT_NUM; i++)
+    {
+        if(RET_OK != RocAt24c02Read(ROC_ROBOT_GAIT_DESC_EEPROM_ADDR + i * ROC_ROBOT_GAIT_DESC_LEN, Desc, ROC_ROBOT_GAIT_DESC_LEN))
+        {
+            return RET_ERROR;
+        }
+
+        /* The erased EEPROM is 0xFF */
+        if(ROC_ROBOT_GAIT_DESC_VERSION != Desc[ROC_ROBOT_GAIT_DESC_VERSION_BYTE])
+        {
+            continue;
+        }
+
+        if(RET_OK != RocRobotGaitDescDecode(Desc, &GaitType, &Gait))
+        {
+            ROC_LOGW("Gait descriptor slot(%d) is invalid, the default gait is used!", i);
+
+            continue;
+        }
+
+        /* The save updates the first slot of the gait, a later one is stale */
+        if(NULL != memchr(g_RobotGaitDescSlot, (uint8_t)GaitType, i))
+        {
+            ROC_LOGW("Gait descriptor slot(%d) has the gait(%d) of a previous slot, it is skipped!", i, GaitType);
+
+            continue;
+        }
+
+        g_RobotGaitDescSlot[i] = (uint8_t)GaitType;
+
+        RocRobotGaitTableSet(GaitType, &Gait);
+
+        LoadNum++;
+    }
+
+    ROC_LOGI("%d gait descriptors are loaded.", LoadNum);
+
+    return RET_OK;
+}
+
+/*********************************************************************************
+ *  Description:
+ *              Validate the descriptor, put it to the gait table and store it
+ *              to the slot of the same gait or a free slot
+ *
+ *  Parameter:
+ *              pDesc: the pointer to the descriptor, ROC_ROBOT_GAIT_DESC_LEN bytes
+ *
+ *  Return:
+ *              RET_ERROR if the robot is walking, the descriptor is invalid,
+ *              all the slots are used or the AT24C02 write is in error
+ *
+ *  Author:
+ *              ROC LiRen(2026.10.17)
+**********************************************************************************/
+ROC_RESULT RocRobotGaitDescSave(const uint8_t *pDesc)
+{
+    uint8_t                     i = 0;
+    uint8_t                     Slot = ROC_ROBOT_GAIT_DESC_SLOT_NUM;
+    ROC_ROBOT_GAIT_TYPE_e       GaitType = ROC_ROBOT_GAIT_HEXP_MODE_RIPPLE_12;
+    ROC_PHOENIX_GAIT_s          Gait;
+
+    if(ROC_TRUE == RocRobotGaitDescIsWalking())
+    {
+        return RET_ERROR;
+    }
+
+    if(RET_OK != RocRobotGaitDescDecode(pDesc, &GaitType, &Gait))
+    {
+        return RET_ERROR;
+    }
+
+    for(i = 0; i < ROC_ROBOT_GAIT_DESC_SLOT_NUM; i++)
+    {
+        if((uint8_t)GaitType == g_RobotGaitDescSlot[i])
+        {
+            Slot = i;
+
+            break;
+        }
+
+        if((ROC_ROBOT_GAIT_DESC_SLOT_NUM == Slot) && (ROC_ROBOT_GAIT_DESC_SLOT_FREE == g_RobotGaitDescSlot[i]))
+        {
+            Slot = i;
+        }
+    }
+
+    if(ROC_ROBOT_GAIT_DESC_SLOT_NUM == Slot)
+    {
+        ROC_LOGE("No free gait descriptor slot!");
+
+        return RET_ERROR;
+    }
+
+    RocRobotGaitTableSet(GaitType, &Gait);
+
+    if(RET_OK != RocAt24c02Write(ROC_ROBOT_GAIT_DESC_EEPROM_ADDR + Slot * ROC_ROBOT_GAIT_DESC_LEN, pDesc, ROC_ROBOT_GAIT_DESC_LEN))
+    {
+        return RET_ERROR;
+    }
+
+    g_RobotGaitDescSlot[Slot] = (uint8_t)GaitType;
+
+    return RET_OK;
+}
+
+/*********************************************************************************
+ *  Description:
+ *              Free the descriptor slot of the gait and restore the default gait
+ *
+ *  Parameter:
+ *              GaitType: the gait type, ROC_ROBOT_GAIT_DESC_ALL_GAIT for all the gaits
+ *
+ *  Return:
+ *              RET_ERROR if the robot is walking or the AT24C02 write is in error
+ *
+ *  Author:
+ *              ROC LiRen(2026.10.17)
+**********************************************************************************/
+ROC_RESULT RocRobotGaitDescErase(uint8_t GaitType)
+{
+    uint8_t                     i = 0;
+    uint8_t                     Free = ROC_ROBOT_GAIT_DESC_SLOT_FREE;
+
+    if(ROC_TRUE == RocRobotGaitDescIsWalking())
+    {
+        return RET_ERROR;
+    }
+
+    for(i = 0; i < ROC_ROBOT_GAIT_DESC_SLOT_NUM; i++)
+    {
+        if(ROC_ROBOT_GAIT_DESC_SLOT_FREE == g_RobotGaitDescSlot[i])
+        {
+            continue;
+        }
+
+        if((ROC_ROBOT_GAIT_DESC_ALL_GAIT != GaitType) && (GaitType != g_RobotGaitDescSlot[i]))
+        {
+            continue;
+        }
+
+        if(RET_OK != RocAt24c02Write(ROC_ROBOT_GAIT_DESC_EEPROM_ADDR + i * ROC_ROBOT_GAIT_DESC_LEN
+                                        + ROC_ROBOT_GAIT_DESC_VERSION_BYTE, &Free, 1))
+        {
+            return RET_ERROR;
+        }
+
+        RocRobotGaitTableSet((ROC_ROBOT_GAIT_TYPE_e)g_RobotGaitDescSlot[i], NULL);
+
+        g_RobotGaitDescSlot[i] = ROC_ROBOT_GAIT_DESC_SLOT_FREE;
+    }
+
+    return RET_OK;
+}
+
@@ -0,0 +1,63 @@
+/********************************************************************************
+ * This code is used for robot control
+*********************************************************************************
+ * Author        Data            Version
+ * Liren         2026/10/17      1.0
+********************************************************************************/
+#ifndef __ROC_ROBOT_GAIT_DESC_H
+#define __ROC_ROBOT_GAIT_DESC_H
+
+
+#include <stdint.h>
+
+#include "RocError.h"
+#include "RocRobotDhAlgorithm.h"
+
+
+/* One gait descriptor replaces one gait of the gait table, the multi-byte
+   values are little endian:
+   0  version            1  gait type          2  nominal speed(2)
+   4  steps in gait      5  lifted positions   6  front down position
+   7  lift div factor    8  slid div factor    9  half lift height
+   10 gait leg number(6)
+   16 COG angle start(2) 18 COG angle step(2)  20 COG radius   21 COG CCW
+   22 CRC16 of the bytes 0 to 21(2)
+   The descriptor slots are in the AT24C02 from ROC_ROBOT_GAIT_DESC_EEPROM_ADDR,
+   a slot with an unknown version is free. The AT24C02 write blocks the main
+   loop, which runs the servo and the gait ticks, so the descriptors are not
+   saved or erased while the robot is walking. */
+#define ROC_ROBOT_GAIT_DESC_VERSION             1U
+#define ROC_ROBOT_GAIT_DESC_LEN                 24U
+#define ROC_ROBOT_GAIT_DESC_SLOT_NUM            8U
+#define ROC_ROBOT_GAIT_DESC_EEPROM_ADDR         0x00U   /* 0x00 to 0xBF */
+#define ROC_ROBOT_GAIT_DESC_MAX_STEP            ((uint8_t)ROC_ROBOT_GAIT_MAX_STEPS)
+#define ROC_ROBOT_GAIT_DESC_MAX_HALF_LIFT       3U      /* The half lift is 3 / (3 + HalfLiftHeight), not under half of the lift */
+
+#define ROC_ROBOT_GAIT_DESC_ALL_GAIT            0xFFU   /* Erase all the descriptors */
+
+#define ROC_ROBOT_GAIT_DESC_VERSION_BYTE        0
+#define ROC_ROBOT_GAIT_DESC_TYPE_BYTE           1
+#define ROC_ROBOT_GAIT_DESC_SPEED_BYTE          2
+#define ROC_ROBOT_GAIT_DESC_STEPS_BYTE          4
+#define ROC_ROBOT_GAIT_DESC_LIFTED_POS_BYTE     5
+#define ROC_ROBOT_GAIT_DESC_FRONT_DOWN_BYTE     6
+#define ROC_ROBOT_GAIT_DESC_LIFT_DIV_BYTE       7
+#define ROC_ROBOT_GAIT_DESC_SLID_DIV_BYTE       8
+#define ROC_ROBOT_GAIT_DESC_HALF_LIFT_BYTE      9
+#define ROC_ROBOT_GAIT_DESC_LEG_NR_BYTE         10
+#define ROC_ROBOT_GAIT_DESC_COG_START_BYTE      16
+#define ROC_ROBOT_GAIT_DESC_COG_STEP_BYTE       18
+#define ROC_ROBOT_GAIT_DESC_COG_RADIUS_BYTE     20
+#define ROC_ROBOT_GAIT_DESC_COG_CCW_BYTE        21
+#define ROC_ROBOT_GAIT_DESC_CRC_BYTE            22
+
+
+ROC_RESULT RocRobotGaitDescEncode(ROC_ROBOT_GAIT_TYPE_e GaitType, const ROC_PHOENIX_GAIT_s *pGait, uint8_t *pDesc);
+ROC_RESULT RocRobotGaitDescDecode(const uint8_t *pDesc, ROC_ROBOT_GAIT_TYPE_e *pGaitType, ROC_PHOENIX_GAIT_s *pGait);
+ROC_RESULT RocRobotGaitDescLoad(void);
+ROC_RESULT RocRobotGaitDescSave(const uint8_t *pDesc);
+ROC_RESULT RocRobotGaitDescErase(uint8_t GaitType);
+
+
+#endif
+
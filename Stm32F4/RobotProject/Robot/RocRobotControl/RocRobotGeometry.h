@@ -0,0 +1,100 @@
+/********************************************************************************
+ * This code is used for robot control
+*********************************************************************************
+ * Generated by RocRobotGeometryGen from RocRobotGeometryDesc.h, do not edit.
+********************************************************************************/
+#ifndef __ROC_ROBOT_GEOMETRY_H
+#define __ROC_ROBOT_GEOMETRY_H
+
+
+#define ROC_ROBOT_WIDTH                             (128.000000F)
+#define ROC_ROBOT_HEIGHT                            (120.000000F)
+
+
+#define ROC_ROBOT_RIG_FRO_INIT_X                    (64.000000F)
+#define ROC_ROBOT_RIG_FRO_INIT_Y                    (110.851252F)
+#define ROC_ROBOT_RIG_FRO_INIT_Z                    (-120.000000F)
+#define ROC_ROBOT_RIG_FRO_OFFSET_X                  (24.000000F)
+#define ROC_ROBOT_RIG_FRO_OFFSET_Y                  (41.569219F)
+#define ROC_ROBOT_RIG_FRO_OFFSET_Z                  (0.000000F)
+
+#define ROC_ROBOT_RIG_MID_INIT_X                    (128.000000F)
+#define ROC_ROBOT_RIG_MID_INIT_Y                    (0.000000F)
+#define ROC_ROBOT_RIG_MID_INIT_Z                    (-120.000000F)
+#define ROC_ROBOT_RIG_MID_OFFSET_X                  (48.000000F)
+#define ROC_ROBOT_RIG_MID_OFFSET_Y                  (0.000000F)
+#define ROC_ROBOT_RIG_MID_OFFSET_Z                  (0.000000F)
+
+#define ROC_ROBOT_RIG_HIN_INIT_X                    (64.000000F)
+#define ROC_ROBOT_RIG_HIN_INIT_Y                    (110.851252F)
+#define ROC_ROBOT_RIG_HIN_INIT_Z                    (-120.000000F)
+#define ROC_ROBOT_RIG_HIN_OFFSET_X                  (24.000000F)
+#define ROC_ROBOT_RIG_HIN_OFFSET_Y                  (-41.569219F)
+#define ROC_ROBOT_RIG_HIN_OFFSET_Z                  (0.000000F)
+
+#define ROC_ROBOT_LEF_FRO_INIT_X                    (64.000000F)
+#define ROC_ROBOT_LEF_FRO_INIT_Y                    (110.851252F)
+#define ROC_ROBOT_LEF_FRO_INIT_Z                    (-120.000000F)
+#define ROC_ROBOT_LEF_FRO_OFFSET_X                  (-24.000000F)
+#define ROC_ROBOT_LEF_FRO_OFFSET_Y                  (41.569219F)
+#define ROC_ROBOT_LEF_FRO_OFFSET_Z                  (0.000000F)
+
+#define ROC_ROBOT_LEF_MID_INIT_X                    (128.000000F)
+#define ROC_ROBOT_LEF_MID_INIT_Y                    (0.000000F)
+#define ROC_ROBOT_LEF_MID_INIT_Z                    (-120.000000F)
+#define ROC_ROBOT_LEF_MID_OFFSET_X                  (-48.000000F)
+#define ROC_ROBOT_LEF_MID_OFFSET_Y                  (0.000000F)
+#define ROC_ROBOT_LEF_MID_OFFSET_Z                  (0.000000F)
+
+#define ROC_ROBOT_LEF_HIN_INIT_X                    (64.000000F)
+#define ROC_ROBOT_LEF_HIN_INIT_Y                    (110.851252F)
+#define ROC_ROBOT_LEF_HIN_INIT_Z                    (-120.000000F)
+#define ROC_ROBOT_LEF_HIN_OFFSET_X                  (-24.000000F)
+#define ROC_ROBOT_LEF_HIN_OFFSET_Y                  (-41.569219F)
+#define ROC_ROBOT_LEF_HIN_OFFSET_Z                  (0.000000F)
+
+
+/* ROC_ROBOT_LEG_GEOMETRY_s of all legs in the order of ROC_ROBOT_LEG_e */
+#define ROC_ROBOT_GEOMETRY_LEG_TABLE                                        \
+{                                                                           \
+    {   /* ROC_ROBOT_RIG_FRO_LEG */                                          \
+        {ROC_ROBOT_RIG_FRO_INIT_X, ROC_ROBOT_RIG_FRO_INIT_Y, ROC_ROBOT_RIG_FRO_INIT_Z},   \
+        {ROC_ROBOT_RIG_FRO_OFFSET_X + ROC_ROBOT_RIG_FRO_INIT_X,                     \
+         ROC_ROBOT_RIG_FRO_OFFSET_Y + ROC_ROBOT_RIG_FRO_INIT_Y,                     \
+         ROC_ROBOT_RIG_FRO_OFFSET_Z + ROC_ROBOT_RIG_FRO_INIT_Z},                     \
+    },                                                                      \
+    {   /* ROC_ROBOT_RIG_MID_LEG */                                          \
+        {ROC_ROBOT_RIG_MID_INIT_X, ROC_ROBOT_RIG_MID_INIT_Y, ROC_ROBOT_RIG_MID_INIT_Z},   \
+        {ROC_ROBOT_RIG_MID_OFFSET_X + ROC_ROBOT_RIG_MID_INIT_X,                     \
+         ROC_ROBOT_RIG_MID_OFFSET_Y + ROC_ROBOT_RIG_MID_INIT_Y,                     \
+         ROC_ROBOT_RIG_MID_OFFSET_Z + ROC_ROBOT_RIG_MID_INIT_Z},                     \
+    },                                                                      \
+    {   /* ROC_ROBOT_RIG_HIN_LEG */                                          \
+        {ROC_ROBOT_RIG_HIN_INIT_X, ROC_ROBOT_RIG_HIN_INIT_Y, ROC_ROBOT_RIG_HIN_INIT_Z},   \
+        {ROC_ROBOT_RIG_HIN_OFFSET_X + ROC_ROBOT_RIG_HIN_INIT_X,                     \
+         ROC_ROBOT_RIG_HIN_OFFSET_Y - ROC_ROBOT_RIG_HIN_INIT_Y,                     \
+         ROC_ROBOT_RIG_HIN_OFFSET_Z + ROC_ROBOT_RIG_HIN_INIT_Z},                     \
+    },                                                                      \
+    {   /* ROC_ROBOT_LEF_FRO_LEG */                                          \
+        {ROC_ROBOT_LEF_FRO_INIT_X, ROC_ROBOT_LEF_FRO_INIT_Y, ROC_ROBOT_LEF_FRO_INIT_Z},   \
+        {ROC_ROBOT_LEF_FRO_OFFSET_X - ROC_ROBOT_LEF_FRO_INIT_X,                     \
+         ROC_ROBOT_LEF_FRO_OFFSET_Y + ROC_ROBOT_LEF_FRO_INIT_Y,                     \
+         ROC_ROBOT_LEF_FRO_OFFSET_Z + ROC_ROBOT_LEF_FRO_INIT_Z},                     \
+    },                                                                      \
+    {   /* ROC_ROBOT_LEF_MID_LEG */                                          \
+        {ROC_ROBOT_LEF_MID_INIT_X, ROC_ROBOT_LEF_MID_INIT_Y, ROC_ROBOT_LEF_MID_INIT_Z},   \
+        {ROC_ROBOT_LEF_MID_OFFSET_X - ROC_ROBOT_LEF_MID_INIT_X,                     \
+         ROC_ROBOT_LEF_MID_OFFSET_Y + ROC_ROBOT_LEF_MID_INIT_Y,                     \
+         ROC_ROBOT_LEF_MID_OFFSET_Z + ROC_ROBOT_LEF_MID_INIT_Z},                     \
+    },                                                                      \
+    {   /* ROC_ROBOT_LEF_HIN_LEG */                                          \
+        {ROC_ROBOT_LEF_HIN_INIT_X, ROC_ROBOT_LEF_HIN_INIT_Y, ROC_ROBOT_LEF_HIN_INIT_Z},   \
+        {ROC_ROBOT_LEF_HIN_OFFSET_X - ROC_ROBOT_LEF_HIN_INIT_X,                     \
+         ROC_ROBOT_LEF_HIN_OFFSET_Y - ROC_ROBOT_LEF_HIN_INIT_Y,                     \
+         ROC_ROBOT_LEF_HIN_OFFSET_Z + ROC_ROBOT_LEF_HIN_INIT_Z},                     \
+    },                                                                      \
+}
+
+
+#endif
+
@@ -0,0 +1,57 @@
+/********************************************************************************
+ * This code is used for robot control
+*********************************************************************************
+ * Author        Data            Version
+ * Liren         2026/10/17      1.0
+********************************************************************************/
+#ifndef __ROC_ROBOT_GEOMETRY_DESC_H
+#define __ROC_ROBOT_GEOMETRY_DESC_H
+
+
+/* The geometry description of the robot chassis. RocRobotGeometry.h is generated
+   from this file by the host tool RocRobotGeometryGen, run the host build target
+   RocRobotGeometryUpdate after any change here. */
+
+
+#define ROC_ROBOT_LEG_HEIGHT                        120
+#define ROC_ROBOT_FEET_WIDTH                        21
+
+#define ROC_ROBOT_DH_CONST_D1                       0
+#define ROC_ROBOT_DH_CONST_A1                       43
+#define ROC_ROBOT_DH_CONST_A2                       64
+#define ROC_ROBOT_DH_CONST_A3                       121.82F /* (ROC_ROBOT_FEET_WIDTH^2 + ROC_ROBOT_FEET_WIDTH^2)^0.5 */
+
+#define ROC_ROBOT_LEG_WIDTH                         (ROC_ROBOT_DH_CONST_A1 + ROC_ROBOT_DH_CONST_A2 + ROC_ROBOT_FEET_WIDTH)
+
+
+#define ROC_ROBOT_BODY_LENGTH_OFFSET                48
+#define ROC_ROBOT_BODY_HEIGHT_OFFSET                0
+
+
+#define ROC_ROBOT_FRO_HIP_INIT_ANGLE                60
+#define ROC_ROBOT_FRO_LEG_INIT_ANGLE                0
+#define ROC_ROBOT_FRO_FET_INIT_ANGLE                78.19F
+#define ROC_ROBOT_MID_HIP_INIT_ANGLE                0
+#define ROC_ROBOT_MID_LEG_INIT_ANGLE                0
+#define ROC_ROBOT_MID_FET_INIT_ANGLE                78.19F
+#define ROC_ROBOT_HIN_HIP_INIT_ANGLE                60
+#define ROC_ROBOT_HIN_LEG_INIT_ANGLE                0
+#define ROC_ROBOT_HIN_FET_INIT_ANGLE                78.19F
+
+#define ROC_ROBOT_INIT_DOWN_ANGLE                   0
+
+
+/* The legs of the chassis in the order of ROC_ROBOT_LEG_e:
+   LEG(Name, HipInitAngle, XSign, YSign), the sign is the mirror of the leg
+   coordinate to the body coordinate, right legs: X 1, hind legs: Y -1 */
+#define ROC_ROBOT_GEOMETRY_LEG_LIST(LEG)                                    \
+    LEG(RIG_FRO,    ROC_ROBOT_FRO_HIP_INIT_ANGLE,    1,  1)                 \
+    LEG(RIG_MID,    ROC_ROBOT_MID_HIP_INIT_ANGLE,    1,  1)                 \
+    LEG(RIG_HIN,    ROC_ROBOT_HIN_HIP_INIT_ANGLE,    1, -1)                 \
+    LEG(LEF_FRO,    ROC_ROBOT_FRO_HIP_INIT_ANGLE,   -1,  1)                 \
+    LEG(LEF_MID,    ROC_ROBOT_MID_HIP_INIT_ANGLE,   -1,  1)                 \
+    LEG(LEF_HIN,    ROC_ROBOT_HIN_HIP_INIT_ANGLE,   -1, -1)
+
+
+#endif
+
@@ -10,29 +10,52 @@
 
 #include <math.h>
 
+#ifndef ROC_ROBOT_HOST_BUILD
 #include "stm32f4xx_hal.h"
 #include "arm_math.h"
+#endif
+
 
+/* Use the lookup tables of RocRobotTrigLut.c for the trigonometry of the gait
+   hot path, the max error is documented in RocRobotTrigLut.h */
+#define ROC_ROBOT_MATH_USE_TRIG_LUT
 
-#if (__FPU_USED == 1U)
+
+/* All the kinematics math is single precision, so the Cortex-M4F runs it on the
+   FPU instead of the software double routines. Keep the arguments float as well,
+   a double argument still promotes the whole expression. */
+#if defined(ROC_ROBOT_MATH_USE_TRIG_LUT)
+#include "RocRobotTrigLut.h"
+#define Sin(x)              RocRobotTrigLutSin(x)
+#define Cos(x)              RocRobotTrigLutCos(x)
+#define ASin(x)             RocRobotTrigLutAsin(x)
+#define ACos(x)             RocRobotTrigLutAcos(x)
+#define ATan(x)             RocRobotTrigLutAtan(x)
+#define ATan2(x, y)         RocRobotTrigLutAtan2(x, y)
+#elif !defined(ROC_ROBOT_HOST_BUILD) && (__FPU_USED == 1U)
 #define Sin(x)              arm_sin_f32(x)
 #define Cos(x)              arm_cos_f32(x)
-#define ASin(x)             asin(x)
-#define ACos(x)             acos(x)
-#define ATan(x)             atan(x)
-#define ATan2(x, y)         atan2(x, y)
-#define Pow(x, y)           pow(x, y)
+#define ASin(x)             asinf(x)
+#define ACos(x)             acosf(x)
+#define ATan(x)             atanf(x)
+#define ATan2(x, y)         atan2f(x, y)
+#else
+#define Sin(x)              sinf(x)
+#define Cos(x)              cosf(x)
+#define ASin(x)             asinf(x)
+#define ACos(x)             acosf(x)
+#define ATan(x)             atanf(x)
+#define ATan2(x, y)         atan2f(x, y)
+#endif
+
+#if !defined(ROC_ROBOT_HOST_BUILD) && (__FPU_USED == 1U)
 #define Sqrt(in, out)       arm_sqrt_f32(in, out)
 #else
-#define Sin(x)              sin(x)
-#define Cos(x)              cos(x)
-#define ASin(x)             asin(x)
-#define ACos(x)             acos(x)
-#define ATan(x)             atan(x)
-#define ATan2(x, y)         atan2(x, y)
-#define Pow(x, y)           pow(x, y)
-#define Sqrt(x)             sqrt(x)
+#define Sqrt(in, out)       (*(out) = sqrtf(in))
 #endif
 
+#define Pow(x, y)           powf(x, y)
+#define Fabs(x)             fabsf(x)
+
 
 #endif
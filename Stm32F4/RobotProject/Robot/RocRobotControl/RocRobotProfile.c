@@ -0,0 +1,307 @@
+/********************************************************************************
+ * This code is used for robot control
+*********************************************************************************
+ * Author        Data            Version
+ * Liren         2026/10/17      1.0
+********************************************************************************/
+#include <string.h>
+
+#ifdef ROC_ROBOT_HOST_BUILD
+#include <time.h>
+#else
+#include "stm32f4xx_hal.h"
+#endif
+
+#include "RocLog.h"
+#include "RocRobotProfile.h"
+
+
+typedef struct _ROC_ROBOT_PROFILE_SCOPE_s
+{
+    uint32_t                    StartCount;             // Counter value when the scope begins
+    uint32_t                    Count;
+    uint32_t                    MinCount;
+    uint32_t                    MaxCount;
+    uint64_t                    SumCount;
+    uint32_t                    Hist[ROC_ROBOT_PROFILE_HIST_BIN_NUM];
+
+}ROC_ROBOT_PROFILE_SCOPE_s;
+
+
+static const char *g_RobotProfileScopeName[ROC_ROBOT_PROFILE_SCOPE_NUM] =
+{
+    "CtrlTick",
+    "RemoteCtrl",
+    "MoveCtrl",
+    "ServoCtrl",
+    "ImuRead",
+    "LcdShow",
+};
+
+static ROC_ROBOT_PROFILE_SCOPE_s g_RobotProfileScope[ROC_ROBOT_PROFILE_SCOPE_NUM];
+
+
+/*********************************************************************************
+ *  Description:
+ *              Get the free running profile counter
+ *
+ *  Parameter:
+ *              None
+ *
+ *  Return:
+ *              The DWT cycle counter on the target, the monotonic time in ns
+ *              on the host build
+ *
+ *  Author:
+ *              ROC LiRen(2026.10.17)
+**********************************************************************************/
+uint32_t RocRobotProfileCountGet(void)
+{
+#ifdef ROC_ROBOT_HOST_BUILD
+    struct timespec Now;
+
+    clock_gettime(CLOCK_MONOTONIC, &Now);
+
+    return (uint32_t)((uint64_t)Now.tv_sec * 1000000000ULL + (uint64_t)Now.tv_nsec);
+#else
+    return DWT->CYCCNT;
+#endif
+}
+
+/*********************************************************************************
+ *  Description:
+ *              Convert the profile counter to ns
+ *
+ *  Parameter:
+ *              Count: the profile counter
+ *
+ *  Return:
+ *              The time in ns
+ *
+ *  Author:
+ *              ROC LiRen(2026.10.17)
+**********************************************************************************/
+uint32_t RocRobotProfileCountToNs(uint64_t Count)
+{
+    return (uint32_t)(Count * 1000U / ROC_ROBOT_PROFILE_COUNT_PER_US);
+}
+
+/*********************************************************************************
+ *  Description:
+ *              Reset the statistics of all the scopes
+ *
+ *  Parameter:
+ *              None
+ *
+ *  Return:
+ *              None
+ *
+ *  Author:
+ *              ROC LiRen(2026.10.17)
+**********************************************************************************/
+void RocRobotProfileReset(void)
+{
+    uint8_t i = 0;
+
+    memset(g_RobotProfileScope, 0, sizeof(g_RobotProfileScope));
+
+    for(i = 0; i < ROC_ROBOT_PROFILE_SCOPE_NUM; i++)
+    {
+        g_RobotProfileScope[i].MinCount = 0xFFFFFFFFU;
+    }
+}
+
+/*********************************************************************************
+ *  Description:
+ *              Start the profile counter and reset the statistics
+ *
+ *  Parameter:
+ *              None
+ *
+ *  Return:
+ *              The init status
+ *
+ *  Author:
+ *              ROC LiRen(2026.10.17)
+**********************************************************************************/
+ROC_RESULT RocRobotProfileInit(void)
+{
+#ifndef ROC_ROBOT_HOST_BUILD
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CYCCNT = 0;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+
+    if(0 == (DWT->CTRL & DWT_CTRL_CYCCNTENA_Msk))
+    {
+        ROC_LOGE("DWT cycle counter is not available!");
+
+        return RET_ERROR;
+    }
+#endif
+
+    RocRobotProfileReset();
+
+    return RET_OK;
+}
+
+/*********************************************************************************
+ *  Description:
+ *              Begin to measure the scope, the scopes can be nested but one
+ *              scope can not begin again before it ends
+ *
+ *  Parameter:
+ *              Scope: the measured scope
+ *
+ *  Return:
+ *              None
+ *
+ *  Author:
+ *              ROC LiRen(2026.10.17)
+**********************************************************************************/
+void RocRobotProfileScopeBegin(ROC_ROBOT_PROFILE_SCOPE_e Scope)
+{
+    g_RobotProfileScope[Scope].StartCount = RocRobotProfileCountGet();
+}
+
+/*********************************************************************************
+ *  Description:
+ *              End to measure the scope, and add the time to the statistics
+ *
+ *  Parameter:
+ *              Scope: the measured scope
+ *
+ *  Return:
+ *              None
+ *
+ *  Author:
+ *              ROC LiRen(2026.10.17)
+**********************************************************************************/
+void RocRobotProfileScopeEnd(ROC_ROBOT_PROFILE_SCOPE_e Scope)
+{
+    uint32_t                    Delta = 0;
+    uint32_t                    Us = 0;
+    uint8_t                     Bin = 0;
+    ROC_ROBOT_PROFILE_SCOPE_s   *pScope = &g_RobotProfileScope[Scope];
+
+    /* The unsigned difference is right across the counter wrap */
+    Delta = RocRobotProfileCountGet() - pScope->StartCount;
+
+    pScope->Count++;
+    pScope->SumCount += Delta;
+
+    if(Delta < pScope->MinCount)
+    {
+        pScope->MinCount = Delta;
+    }
+
+    if(Delta > pScope->MaxCount)
+    {
+        pScope->MaxCount = Delta;
+    }
+
+    Us = Delta / ROC_ROBOT_PROFILE_COUNT_PER_US;
+
+    while((0 != Us) && (Bin < (ROC_ROBOT_PROFILE_HIST_BIN_NUM - 1)))
+    {
+        Us >>= 1;
+        Bin++;
+    }
+
+    pScope->Hist[Bin]++;
+}
+
+/*********************************************************************************
+ *  Description:
+ *              Get the name of the scope
+ *
+ *  Parameter:
+ *              Scope: the scope
+ *
+ *  Return:
+ *              The scope name
+ *
+ *  Author:
+ *              ROC LiRen(2026.10.17)
+**********************************************************************************/
+const char *RocRobotProfileScopeNameGet(ROC_ROBOT_PROFILE_SCOPE_e Scope)
+{
+    if(ROC_ROBOT_PROFILE_SCOPE_NUM <= Scope)
+    {
+        return "Unknown";
+    }
+
+    return g_RobotProfileScopeName[Scope];
+}
+
+/*********************************************************************************
+ *  Description:
+ *              Get the statistics of the scope in ns
+ *
+ *  Parameter:
+ *              Scope: the scope
+ *              pStat: the pointer to the statistics
+ *
+ *  Return:
+ *              RET_ERROR if the scope is invalid
+ *
+ *  Author:
+ *              ROC LiRen(2026.10.17)
+**********************************************************************************/
+ROC_RESULT RocRobotProfileStatGet(ROC_ROBOT_PROFILE_SCOPE_e Scope, ROC_ROBOT_PROFILE_STAT_s *pStat)
+{
+    ROC_ROBOT_PROFILE_SCOPE_s   *pScope = NULL;
+
+    if(ROC_ROBOT_PROFILE_SCOPE_NUM <= Scope)
+    {
+        return RET_ERROR;
+    }
+
+    pScope = &g_RobotProfileScope[Scope];
+
+    memset(pStat, 0, sizeof(ROC_ROBOT_PROFILE_STAT_s));
+
+    pStat->Count = pScope->Count;
+    memcpy(pStat->Hist, pScope->Hist, sizeof(pStat->Hist));
+
+    if(0 != pScope->Count)
+    {
+        pStat->MinNs = RocRobotProfileCountToNs(pScope->MinCount);
+        pStat->MaxNs = RocRobotProfileCountToNs(pScope->MaxCount);
+        pStat->MeanNs = RocRobotProfileCountToNs(pScope->SumCount / pScope->Count);
+    }
+
+    return RET_OK;
+}
+
+/*********************************************************************************
+ *  Description:
+ *              Print the statistics of all the measured scopes to the log
+ *
+ *  Parameter:
+ *              None
+ *
+ *  Return:
+ *              None
+ *
+ *  Author:
+ *              ROC LiRen(2026.10.17)
+**********************************************************************************/
+void RocRobotProfileReport(void)
+{
+    uint8_t                     i = 0;
+    ROC_ROBOT_PROFILE_STAT_s    Stat;
+
+    for(i = 0; i < ROC_ROBOT_PROFILE_SCOPE_NUM; i++)
+    {
+        RocRobotProfileStatGet((ROC_ROBOT_PROFILE_SCOPE_e)i, &Stat);
+
+        if(0 == Stat.Count)
+        {
+            continue;
+        }
+
+        ROC_LOGI("%-10s count: %u, min: %u ns, mean: %u ns, max: %u ns",
+                 g_RobotProfileScopeName[i], Stat.Count, Stat.MinNs, Stat.MeanNs, Stat.MaxNs);
+    }
+}
+
@@ -0,0 +1,77 @@
+/********************************************************************************
+ * This code is used for robot control
+*********************************************************************************
+ * Author        Data            Version
+ * Liren         2026/10/17      1.0
+********************************************************************************/
+#ifndef __ROC_ROBOT_PROFILE_H
+#define __ROC_ROBOT_PROFILE_H
+
+
+#include <stdint.h>
+
+#include "RocError.h"
+
+
+#define ROC_ROBOT_PROFILE_ENABLE
+
+
+/* The scope time is counted by the DWT cycle counter on the target, and by the
+   monotonic clock in ns on the host build */
+#ifdef ROC_ROBOT_HOST_BUILD
+#define ROC_ROBOT_PROFILE_COUNT_PER_US              1000U
+#else
+#define ROC_ROBOT_PROFILE_COUNT_PER_US              (SystemCoreClock / 1000000U)
+#endif
+
+/* Histogram bin 0 holds the time below 1 us, bin N holds [2^(N-1), 2^N) us,
+   the last bin holds all the longer time */
+#define ROC_ROBOT_PROFILE_HIST_BIN_NUM              16
+
+
+typedef enum _ROC_ROBOT_PROFILE_SCOPE_e
+{
+    ROC_ROBOT_PROFILE_SCOPE_CTRL_TICK = 0,          // The whole robot control tick
+    ROC_ROBOT_PROFILE_SCOPE_REMOTE_CTRL,            // RocRobotRemoteControl
+    ROC_ROBOT_PROFILE_SCOPE_MOVE_CTRL,              // RocRobotMoveCtrlCore
+    ROC_ROBOT_PROFILE_SCOPE_SERVO_CTRL,             // RocServoControl
+    ROC_ROBOT_PROFILE_SCOPE_IMU_READ,               // IMU euler angle read
+    ROC_ROBOT_PROFILE_SCOPE_LCD_SHOW,               // LCD information task
+
+    ROC_ROBOT_PROFILE_SCOPE_NUM,
+}ROC_ROBOT_PROFILE_SCOPE_e;
+
+
+typedef struct _ROC_ROBOT_PROFILE_STAT_s
+{
+    uint32_t                    Count;                  // Number of the measured scope runs
+    uint32_t                    MinNs;
+    uint32_t                    MaxNs;
+    uint32_t                    MeanNs;
+    uint32_t                    Hist[ROC_ROBOT_PROFILE_HIST_BIN_NUM];
+
+}ROC_ROBOT_PROFILE_STAT_s;
+
+
+#ifdef ROC_ROBOT_PROFILE_ENABLE
+#define ROC_ROBOT_PROFILE_BEGIN(Scope)              RocRobotProfileScopeBegin(Scope)
+#define ROC_ROBOT_PROFILE_END(Scope)                RocRobotProfileScopeEnd(Scope)
+#else
+#define ROC_ROBOT_PROFILE_BEGIN(Scope)
+#define ROC_ROBOT_PROFILE_END(Scope)
+#endif
+
+
+ROC_RESULT RocRobotProfileInit(void);
+uint32_t RocRobotProfileCountGet(void);
+uint32_t RocRobotProfileCountToNs(uint64_t Count);
+void RocRobotProfileReset(void);
+void RocRobotProfileScopeBegin(ROC_ROBOT_PROFILE_SCOPE_e Scope);
+void RocRobotProfileScopeEnd(ROC_ROBOT_PROFILE_SCOPE_e Scope);
+const char *RocRobotProfileScopeNameGet(ROC_ROBOT_PROFILE_SCOPE_e Scope);
+ROC_RESULT RocRobotProfileStatGet(ROC_ROBOT_PROFILE_SCOPE_e Scope, ROC_ROBOT_PROFILE_STAT_s *pStat);
+void RocRobotProfileReport(void);
+
+
+#endif
+
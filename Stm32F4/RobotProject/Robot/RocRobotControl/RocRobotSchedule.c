@@ -0,0 +1,404 @@
+/********************************************************************************
+ * This code is used for robot control
+*********************************************************************************
+ * Author        Data            Version
+ * Liren         2026/10/17      1.0
+********************************************************************************/
+#include <string.h>
+
+#include "RocLog.h"
+#include "RocRobotProfile.h"
+#include "RocRobotSchedule.h"
+
+
+typedef struct _ROC_ROBOT_SCHEDULE_TASK_s
+{
+    uint32_t                    Deadline;           // The tick which must not be released before the task ends
+    uint8_t                     IsLate;             // The miss is counted when the task starts
+    uint32_t                    RunNum;
+    uint32_t                    MissNum;
+    uint32_t                    LatencyNum;
+    uint32_t                    LatencyMin;
+    uint32_t                    LatencyMax;
+    uint64_t                    LatencySum;
+
+}ROC_ROBOT_SCHEDULE_TASK_s;
+
+typedef struct _ROC_ROBOT_SCHEDULE_s
+{
+    uint8_t                     StepNum;
+    uint8_t                     GaitPhase;
+    volatile uint32_t           TickNum;            // Written by the timer interrupt only
+    volatile uint32_t           TickCount;          // Profile counter of the last tick
+    volatile uint32_t           GaitReleaseNum;
+    volatile uint32_t           GaitReleaseCount;
+    volatile uint32_t           GaitReleaseTick;
+    volatile uint32_t           GaitDeadline;
+    uint32_t                    ServoRunNum;        // The ticks taken by the servo task
+    uint32_t                    GaitRunNum;         // The gait releases taken by the gait task
+    ROC_ROBOT_SCHEDULE_TASK_s   Task[ROC_ROBOT_SCHEDULE_TASK_NUM];
+
+}ROC_ROBOT_SCHEDULE_s;
+
+
+static const char *g_RobotScheduleTaskName[ROC_ROBOT_SCHEDULE_TASK_NUM] =
+{
+    "Servo",
+    "Gait",
+};
+
+static ROC_ROBOT_SCHEDULE_s g_RobotSchedule;
+
+
+/*********************************************************************************
+ *  Description:
+ *              Add the release to start latency of the task to the statistics
+ *
+ *  Parameter:
+ *              pTask:        the pointer to the task
+ *              ReleaseCount: the profile counter of the release tick
+ *
+ *  Return:
+ *              None
+ *
+ *  Author:
+ *              ROC LiRen(2026.10.17)
+**********************************************************************************/
+static void RocRobotScheduleLatencyAdd(ROC_ROBOT_SCHEDULE_TASK_s *pTask, uint32_t ReleaseCount)
+{
+    uint32_t                    Latency = 0;
+
+    Latency = RocRobotProfileCountGet() - ReleaseCount;
+
+    pTask->LatencyNum++;
+    pTask->LatencySum += Latency;
+
+    if(Latency < pTask->LatencyMin)
+    {
+        pTask->LatencyMin = Latency;
+    }
+
+    if(Latency > pTask->LatencyMax)
+    {
+        pTask->LatencyMax = Latency;
+    }
+}
+
+/*********************************************************************************
+ *  Description:
+ *              Reset the statistics of all the tasks
+ *
+ *  Parameter:
+ *              None
+ *
+ *  Return:
+ *              None
+ *
+ *  Author:
+ *              ROC LiRen(2026.10.17)
+**********************************************************************************/
+void RocRobotScheduleReset(void)
+{
+    uint8_t i = 0;
+
+    for(i = 0; i < ROC_ROBOT_SCHEDULE_TASK_NUM; i++)
+    {
+        g_RobotSchedule.Task[i].RunNum = 0;
+        g_RobotSchedule.Task[i].MissNum = 0;
+        g_RobotSchedule.Task[i].LatencyNum = 0;
+        g_RobotSchedule.Task[i].LatencyMin = 0xFFFFFFFFU;
+        g_RobotSchedule.Task[i].LatencyMax = 0;
+        g_RobotSchedule.Task[i].LatencySum = 0;
+    }
+}
+
+/*********************************************************************************
+ *  Description:
+ *              Init the scheduler, call it with the servo timer stopped, the
+ *              servo steps are not changed while the timer runs
+ *
+ *  Parameter:
+ *              StepNum:   the servo ticks of one gait period
+ *              GaitPhase: the tick releasing the gait task, from 1 to StepNum - 1
+ *
+ *  Return:
+ *              RET_ERROR if the phase is out of range
+ *
+ *  Author:
+ *              ROC LiRen(2026.10.17)
+**********************************************************************************/
+ROC_RESULT RocRobotScheduleInit(uint8_t StepNum, uint8_t GaitPhase)
+{
+    if((0 == GaitPhase) || (StepNum <= GaitPhase))
+    {
+        ROC_LOGE("Schedule gait phase(%d) is out of the gait period(%d)!", GaitPhase, StepNum);
+
+        return RET_ERROR;
+    }
+
+    memset(&g_RobotSchedule, 0, sizeof(g_RobotSchedule));
+
+    g_RobotSchedule.StepNum = StepNum;
+    g_RobotSchedule.GaitPhase = GaitPhase;
+
+    RocRobotScheduleReset();
+
+    return RET_OK;
+}
+
+/*********************************************************************************
+ *  Description:
+ *              Release the tasks of the servo timer tick, called by the servo
+ *              timer interrupt
+ *
+ *  Parameter:
+ *              None
+ *
+ *  Return:
+ *              None
+ *
+ *  Author:
+ *              ROC LiRen(2026.10.17)
+**********************************************************************************/
+void RocRobotScheduleTick(void)
+{
+    uint32_t                    Count = 0;
+    uint32_t                    TickNum = 0;
+
+    Count = RocRobotProfileCountGet();
+    TickNum = g_RobotSchedule.TickNum + 1;
+
+    g_RobotSchedule.TickCount = Count;
+    g_RobotSchedule.TickNum = TickNum;
+
+    if(g_RobotSchedule.GaitPhase == (TickNum - 1) % g_RobotSchedule.StepNum + 1)
+    {
+        g_RobotSchedule.GaitReleaseCount = Count;
+        g_RobotSchedule.GaitReleaseTick = TickNum;
+        g_RobotSchedule.GaitDeadline = TickNum + g_RobotSchedule.StepNum - g_RobotSchedule.GaitPhase;
+        g_RobotSchedule.GaitReleaseNum++;
+    }
+}
+
+/*********************************************************************************
+ *  Description:
+ *              Take one released tick for the servo task, the ticks missed by
+ *              a long task are taken one by one, so the servo does not lose
+ *              its place in the gait period
+ *
+ *  Parameter:
+ *              pStep: the pointer to the tick in the gait period, from 1 to StepNum
+ *
+ *  Return:
+ *              ROC_TRUE if the servo task should run
+ *
+ *  Author:
+ *              ROC LiRen(2026.10.17)
+**********************************************************************************/
+uint8_t RocRobotScheduleServoIsReady(uint8_t *pStep)
+{
+    uint32_t                    TickNum = 0;
+    uint32_t                    TickCount = 0;
+    ROC_ROBOT_SCHEDULE_TASK_s   *pTask = &g_RobotSchedule.Task[ROC_ROBOT_SCHEDULE_TASK_SERVO];
+
+    /* Read the tick and its counter without the timer interrupt between them */
+    do
+    {
+        TickNum = g_RobotSchedule.TickNum;
+        TickCount = g_RobotSchedule.TickCount;
+    }while(TickNum != g_RobotSchedule.TickNum);
+
+    if(TickNum == g_RobotSchedule.ServoRunNum)
+    {
+        return ROC_FALSE;
+    }
+
+    g_RobotSchedule.ServoRunNum++;
+
+    *pStep = (uint8_t)((g_RobotSchedule.ServoRunNum - 1) % g_RobotSchedule.StepNum + 1);
+
+    pTask->Deadline = g_RobotSchedule.ServoRunNum + 1;
+    pTask->IsLate = ROC_FALSE;
+
+    if(TickNum == g_RobotSchedule.ServoRunNum)
+    {
+        RocRobotScheduleLatencyAdd(pTask, TickCount);
+    }
+    else
+    {
+        pTask->IsLate = ROC_TRUE;
+        pTask->MissNum++;
+    }
+
+    return ROC_TRUE;
+}
+
+/*********************************************************************************
+ *  Description:
+ *              Check if the gait task is released and not taken yet
+ *
+ *  Parameter:
+ *              None
+ *
+ *  Return:
+ *              ROC_TRUE if the gait task is released
+ *
+ *  Author:
+ *              ROC LiRen(2026.10.17)
+**********************************************************************************/
+uint8_t RocRobotScheduleGaitIsReleased(void)
+{
+    return (g_RobotSchedule.GaitReleaseNum != g_RobotSchedule.GaitRunNum) ? ROC_TRUE : ROC_FALSE;
+}
+
+/*********************************************************************************
+ *  Description:
+ *              Take the gait task release after the servo task has run the
+ *              release tick, the older releases which are not taken in time are
+ *              counted as the misses
+ *
+ *  Parameter:
+ *              None
+ *
+ *  Return:
+ *              ROC_TRUE if the gait task should run
+ *
+ *  Author:
+ *              ROC LiRen(2026.10.17)
+**********************************************************************************/
+uint8_t RocRobotScheduleGaitIsReady(void)
+{
+    uint32_t                    ReleaseNum = 0;
+    uint32_t                    ReleaseCount = 0;
+    uint32_t                    ReleaseTick = 0;
+    uint32_t                    Deadline = 0;
+    ROC_ROBOT_SCHEDULE_TASK_s   *pTask = &g_RobotSchedule.Task[ROC_ROBOT_SCHEDULE_TASK_GAIT];
+
+    do
+    {
+        ReleaseNum = g_RobotSchedule.GaitReleaseNum;
+        ReleaseCount = g_RobotSchedule.GaitReleaseCount;
+        ReleaseTick = g_RobotSchedule.GaitReleaseTick;
+        Deadline = g_RobotSchedule.GaitDeadline;
+    }while(ReleaseNum != g_RobotSchedule.GaitReleaseNum);
+
+    /* The servo catching up the missed ticks has not loaded the last move yet */
+    if((ReleaseNum == g_RobotSchedule.GaitRunNum) || ((int32_t)(g_RobotSchedule.ServoRunNum - ReleaseTick) < 0))
+    {
+        return ROC_FALSE;
+    }
+
+    pTask->MissNum += ReleaseNum - g_RobotSchedule.GaitRunNum - 1;
+    g_RobotSchedule.GaitRunNum = ReleaseNum;
+
+    pTask->Deadline = Deadline;
+    pTask->IsLate = ROC_FALSE;
+
+    if((int32_t)(g_RobotSchedule.TickNum - Deadline) >= 0)
+    {
+        pTask->IsLate = ROC_TRUE;
+        pTask->MissNum++;
+    }
+    else
+    {
+        RocRobotScheduleLatencyAdd(pTask, ReleaseCount);
+    }
+
+    return ROC_TRUE;
+}
+
+/*********************************************************************************
+ *  Description:
+ *              End the task run, the run is missed if the deadline tick is
+ *              released before it ends
+ *
+ *  Parameter:
+ *              Task: the task
+ *
+ *  Return:
+ *              None
+ *
+ *  Author:
+ *              ROC LiRen(2026.10.17)
+**********************************************************************************/
+void RocRobotScheduleTaskEnd(ROC_ROBOT_SCHEDULE_TASK_e Task)
+{
+    ROC_ROBOT_SCHEDULE_TASK_s   *pTask = &g_RobotSchedule.Task[Task];
+
+    pTask->RunNum++;
+
+    if((ROC_FALSE == pTask->IsLate) && ((int32_t)(g_RobotSchedule.TickNum - pTask->Deadline) >= 0))
+    {
+        pTask->MissNum++;
+    }
+}
+
+/*********************************************************************************
+ *  Description:
+ *              Get the statistics of the task in ns
+ *
+ *  Parameter:
+ *              Task:  the task
+ *              pStat: the pointer to the statistics
+ *
+ *  Return:
+ *              RET_ERROR if the task is invalid
+ *
+ *  Author:
+ *              ROC LiRen(2026.10.17)
+**********************************************************************************/
+ROC_RESULT RocRobotScheduleStatGet(ROC_ROBOT_SCHEDULE_TASK_e Task, ROC_ROBOT_SCHEDULE_STAT_s *pStat)
+{
+    ROC_ROBOT_SCHEDULE_TASK_s   *pTask = NULL;
+
+    if(ROC_ROBOT_SCHEDULE_TASK_NUM <= Task)
+    {
+        return RET_ERROR;
+    }
+
+    pTask = &g_RobotSchedule.Task[Task];
+
+    memset(pStat, 0, sizeof(ROC_ROBOT_SCHEDULE_STAT_s));
+
+    pStat->RunNum = pTask->RunNum;
+    pStat->MissNum = pTask->MissNum;
+
+    if(0 != pTask->LatencyNum)
+    {
+        pStat->LatencyMinNs = RocRobotProfileCountToNs(pTask->LatencyMin);
+        pStat->LatencyMaxNs = RocRobotProfileCountToNs(pTask->LatencyMax);
+        pStat->LatencyMeanNs = RocRobotProfileCountToNs(pTask->LatencySum / pTask->LatencyNum);
+        pStat->JitterNs = pStat->LatencyMaxNs - pStat->LatencyMinNs;
+    }
+
+    return RET_OK;
+}
+
+/*********************************************************************************
+ *  Description:
+ *              Print the statistics of all the tasks to the log
+ *
+ *  Parameter:
+ *              None
+ *
+ *  Return:
+ *              None
+ *
+ *  Author:
+ *              ROC LiRen(2026.10.17)
+**********************************************************************************/
+void RocRobotScheduleReport(void)
+{
+    uint8_t                     i = 0;
+    ROC_ROBOT_SCHEDULE_STAT_s   Stat;
+
+    for(i = 0; i < ROC_ROBOT_SCHEDULE_TASK_NUM; i++)
+    {
+        RocRobotScheduleStatGet((ROC_ROBOT_SCHEDULE_TASK_e)i, &Stat);
+
+        ROC_LOGI("%-5s run: %u, miss: %u, latency min: %u ns, mean: %u ns, max: %u ns, jitter: %u ns",
+                 g_RobotScheduleTaskName[i], Stat.RunNum, Stat.MissNum, Stat.LatencyMinNs,
+                 Stat.LatencyMeanNs, Stat.LatencyMaxNs, Stat.JitterNs);
+    }
+}
+
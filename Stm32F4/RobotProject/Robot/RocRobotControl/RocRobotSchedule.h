@@ -0,0 +1,57 @@
+/********************************************************************************
+ * This code is used for robot control
+*********************************************************************************
+ * Author        Data            Version
+ * Liren         2026/10/17      1.0
+********************************************************************************/
+#ifndef __ROC_ROBOT_SCHEDULE_H
+#define __ROC_ROBOT_SCHEDULE_H
+
+
+#include <stdint.h>
+
+#include "RocError.h"
+
+
+/* The servo task runs on every servo timer tick, one gait period is StepNum
+   ticks, numbered from 1 to StepNum, the servo loads the new target on the
+   tick StepNum. The gait task is released on the tick GaitPhase, so the IK of
+   the next move runs while the present move is interpolated, and its deadline
+   is the tick StepNum. */
+#define ROC_ROBOT_SCHEDULE_GAIT_PHASE               1U
+
+
+typedef enum _ROC_ROBOT_SCHEDULE_TASK_e
+{
+    ROC_ROBOT_SCHEDULE_TASK_SERVO = 0,              // Servo interpolation, every tick
+    ROC_ROBOT_SCHEDULE_TASK_GAIT,                   // Gait and IK, once per gait period
+
+    ROC_ROBOT_SCHEDULE_TASK_NUM,
+}ROC_ROBOT_SCHEDULE_TASK_e;
+
+
+typedef struct _ROC_ROBOT_SCHEDULE_STAT_s
+{
+    uint32_t                    RunNum;
+    uint32_t                    MissNum;            // Runs started or ended after the deadline, or skipped
+    uint32_t                    LatencyMinNs;       // From the release tick to the task start
+    uint32_t                    LatencyMaxNs;
+    uint32_t                    LatencyMeanNs;
+    uint32_t                    JitterNs;           // LatencyMaxNs - LatencyMinNs
+
+}ROC_ROBOT_SCHEDULE_STAT_s;
+
+
+ROC_RESULT RocRobotScheduleInit(uint8_t StepNum, uint8_t GaitPhase);
+void RocRobotScheduleReset(void);
+void RocRobotScheduleTick(void);
+uint8_t RocRobotScheduleServoIsReady(uint8_t *pStep);
+uint8_t RocRobotScheduleGaitIsReady(void);
+uint8_t RocRobotScheduleGaitIsReleased(void);
+void RocRobotScheduleTaskEnd(ROC_ROBOT_SCHEDULE_TASK_e Task);
+ROC_RESULT RocRobotScheduleStatGet(ROC_ROBOT_SCHEDULE_TASK_e Task, ROC_ROBOT_SCHEDULE_STAT_s *pStat);
+void RocRobotScheduleReport(void);
+
+
+#endif
+
@@ -0,0 +1,322 @@
+/********************************************************************************
+ * This code is used for robot control
+*********************************************************************************
+ * Author        Data            Version
+ * Liren         2026/10/17      1.0
+********************************************************************************/
+#include <stdint.h>
+#include <string.h>
+
+#include "RocRobotMath.h"
+#include "RocRobotStability.h"
+
+
+#define ROC_ROBOT_STABILITY_MARGIN_NONE             (-1000.0F)  // No feet on the floor
+
+
+typedef struct _ROC_ROBOT_STABILITY_s
+{
+    float                       Scale;                  // Travel scale of the step length and the speed
+    float                       CycleMin;               // Minimum margin of the running gait cycle
+    uint8_t                     CycleMinIsValid;        // A tick with the support polygon is in the cycle
+    float                       LastStep;               // Gait step of the last tick, a smaller one starts a cycle
+
+}ROC_ROBOT_STABILITY_s;
+
+
+static ROC_ROBOT_STABILITY_s    g_RobotStability =
+{
+    .Scale = 1.0F,
+};
+
+
+/*********************************************************************************
+ *  Description:
+ *              Init the stability monitor, the travel is not scaled
+ *
+ *  Parameter:
+ *              None
+ *
+ *  Return:
+ *              RET_OK
+ *
+ *  Author:
+ *              ROC LiRen(2026.10.17)
+**********************************************************************************/
+ROC_RESULT RocRobotStabilityInit(void)
+{
+    memset(&g_RobotStability, 0, sizeof(g_RobotStability));
+
+    g_RobotStability.Scale = 1.0F;
+
+    return RET_OK;
+}
+
+/*********************************************************************************
+ *  Description:
+ *              The cross product of OA and OB, it is positive when OAB turns
+ *              counter clockwise
+ *
+ *  Parameter:
+ *              pX, pY: the points
+ *              o, a, b: the index of the points O, A, B
+ *
+ *  Return:
+ *              The cross product
+ *
+ *  Author:
+ *              ROC LiRen(2026.10.17)
+**********************************************************************************/
+static float RocRobotStabilityCross(const float *pX, const float *pY, uint8_t o, uint8_t a, uint8_t b)
+{
+    return (pX[a] - pX[o]) * (pY[b] - pY[o]) - (pY[a] - pY[o]) * (pX[b] - pX[o]);
+}
+
+/*********************************************************************************
+ *  Description:
+ *              The distance from the origin to the segment AB
+ *
+ *  Parameter:
+ *              Ax, Ay: the point A
+ *              Bx, By: the point B
+ *
+ *  Return:
+ *              The distance
+ *
+ *  Author:
+ *              ROC LiRen(2026.10.17)
+**********************************************************************************/
+static float RocRobotStabilitySegmentDist(float Ax, float Ay, float Bx, float By)
+{
+    float   Dx = Bx - Ax;
+    float   Dy = By - Ay;
+    float   Len2 = Dx * Dx + Dy * Dy;
+    float   t = 0;
+    float   Dist = 0;
+
+    if(0 < Len2)
+    {
+        t = -(Ax * Dx + Ay * Dy) / Len2;
+
+        if(0 > t)
+        {
+            t = 0;
+        }
+        else if(1 < t)
+        {
+            t = 1;
+        }
+    }
+
+    Dx = Ax + t * Dx;
+    Dy = Ay + t * Dy;
+
+    Sqrt(Dx * Dx + Dy * Dy, &Dist);
+
+    return Dist;
+}
+
+/*********************************************************************************
+ *  Description:
+ *              Calculate the static stability margin of the body center in the
+ *              support polygon. The polygon is the convex hull of the feet on
+ *              the floor, built by the monotone chain.
+ *
+ *  Parameter:
+ *              pX, pY: the feet position on the floor in the body coordinate,
+ *                      the COG is at the origin
+ *              Num: the number of the feet, up to ROC_ROBOT_CNT_LEGS
+ *
+ *  Return:
+ *              The stability margin in mm
+ *
+ *  Author:
+ *              ROC LiRen(2026.10.17)
+**********************************************************************************/
+float RocRobotStabilityMarginCalc(const float *pX, const float *pY, uint8_t Num)
+{
+    uint8_t i = 0;
+    uint8_t j = 0;
+    uint8_t k = 0;
+    uint8_t t = 0;
+    uint8_t Order[ROC_ROBOT_CNT_LEGS];
+    uint8_t Hull[2 * ROC_ROBOT_CNT_LEGS];
+    float   Len = 0;
+    float   Dist = 0;
+    float   Margin = 0;
+
+    if(0 == Num)
+    {
+        return ROC_ROBOT_STABILITY_MARGIN_NONE;
+    }
+
+    if(ROC_ROBOT_CNT_LEGS < Num)
+    {
+        Num = ROC_ROBOT_CNT_LEGS;
+    }
+
+    /* Sort the feet by X, then by Y */
+    for(i = 0; i < Num; i++)
+    {
+        for(j = i; (0 < j) && ((pX[i] < pX[Order[j - 1]])
+            || ((pX[i] == pX[Order[j - 1]]) && (pY[i] < pY[Order[j - 1]]))); j--)
+        {
+            Order[j] = Order[j - 1];
+        }
+
+        Order[j] = i;
+    }
+
+    /* The lower hull, then the upper hull, both counter clockwise */
+    for(i = 0; i < Num; i++)
+    {
+        while((2 <= k) && (0 >= RocRobotStabilityCross(pX, pY, Hull[k - 2], Hull[k - 1], Order[i])))
+        {
+            k--;
+        }
+
+        Hull[k++] = Order[i];
+    }
+
+    for(i = Num - 1, t = k + 1; 0 < i; i--)
+    {
+        while((t <= k) && (0 >= RocRobotStabilityCross(pX, pY, Hull[k - 2], Hull[k - 1], Order[i - 1])))
+        {
+            k--;
+        }
+
+        Hull[k++] = Order[i - 1];
+    }
+
+    /* The last point closes the hull */
+    if(1 < k)
+    {
+        k--;
+    }
+
+    if(3 > k)
+    {
+        /* A support line or point, the COG is never inside */
+        j = Hull[(1 < k) ? 1 : 0];
+
+        return -RocRobotStabilitySegmentDist(pX[Hull[0]], pY[Hull[0]], pX[j], pY[j]);
+    }
+
+    for(i = 0; i < k; i++)
+    {
+        j = (i + 1 < k) ? (i + 1) : 0;
+
+        Sqrt((pX[Hull[j]] - pX[Hull[i]]) * (pX[Hull[j]] - pX[Hull[i]])
+            + (pY[Hull[j]] - pY[Hull[i]]) * (pY[Hull[j]] - pY[Hull[i]]), &Len);
+
+        /* The signed distance of the origin to the edge, positive on the inner side */
+        Dist = (pX[Hull[i]] * pY[Hull[j]] - pY[Hull[i]] * pX[Hull[j]]) / Len;
+
+        if((0 == i) || (Dist < Margin))
+        {
+            Margin = Dist;
+        }
+    }
+
+    return Margin;
+}
+
+/*********************************************************************************
+ *  Description:
+ *              Update the stability monitor with the margin of one gait tick,
+ *              the travel scale is updated at the end of every gait cycle
+ *
+ *  Parameter:
+ *              Margin: the static stability margin of the tick in mm
+ *              FeetNum: the number of the feet on the floor
+ *              GaitStep: the gait step of the tick, it may be fractional
+ *
+ *  Return:
+ *              None
+ *
+ *  Author:
+ *              ROC LiRen(2026.10.17)
+**********************************************************************************/
+void RocRobotStabilityMonitorUpdate(float Margin, uint8_t FeetNum, float GaitStep)
+{
+    ROC_ROBOT_STABILITY_s   *pMonitor = &g_RobotStability;
+
+    if((GaitStep < pMonitor->LastStep) && (ROC_TRUE == pMonitor->CycleMinIsValid))
+    {
+        if(ROC_ROBOT_STABILITY_MARGIN_LOW > pMonitor->CycleMin)
+        {
+            pMonitor->Scale -= ROC_ROBOT_STABILITY_SCALE_DOWN;
+
+            if(ROC_ROBOT_STABILITY_SCALE_MIN > pMonitor->Scale)
+            {
+                pMonitor->Scale = ROC_ROBOT_STABILITY_SCALE_MIN;
+            }
+        }
+        else if(ROC_ROBOT_STABILITY_MARGIN_HIGH < pMonitor->CycleMin)
+        {
+            pMonitor->Scale += ROC_ROBOT_STABILITY_SCALE_UP;
+
+            if(1.0F < pMonitor->Scale)
+            {
+                pMonitor->Scale = 1.0F;
+            }
+        }
+
+        pMonitor->CycleMinIsValid = ROC_FALSE;
+    }
+
+    pMonitor->LastStep = GaitStep;
+
+    /* Less than three feet on the floor has no support polygon, it is the
+       2-foot support of the amble gaits, which are balanced by the motion and
+       not statically, so its margin is left out of the cycle minimum */
+    if(3 > FeetNum)
+    {
+        return;
+    }
+
+    if((ROC_FALSE == pMonitor->CycleMinIsValid) || (Margin < pMonitor->CycleMin))
+    {
+        pMonitor->CycleMin = Margin;
+        pMonitor->CycleMinIsValid = ROC_TRUE;
+    }
+}
+
+/*********************************************************************************
+ *  Description:
+ *              Get the travel scale of the stability monitor, the step length
+ *              is multiplied by it
+ *
+ *  Parameter:
+ *              None
+ *
+ *  Return:
+ *              The travel scale in [ROC_ROBOT_STABILITY_SCALE_MIN, 1]
+ *
+ *  Author:
+ *              ROC LiRen(2026.10.17)
+**********************************************************************************/
+float RocRobotStabilityScaleGet(void)
+{
+    return g_RobotStability.Scale;
+}
+
+/*********************************************************************************
+ *  Description:
+ *              Get the servo time of one gait tick capped by the stability
+ *              monitor, the nominal time is stretched by the travel scale
+ *
+ *  Parameter:
+ *              NomGaitSpeed: the nominal servo time of one gait tick in ms
+ *
+ *  Return:
+ *              The servo time of one gait tick in ms
+ *
+ *  Author:
+ *              ROC LiRen(2026.10.17)
+**********************************************************************************/
+uint16_t RocRobotStabilityGaitSpeedGet(uint16_t NomGaitSpeed)
+{
+    return (uint16_t)(NomGaitSpeed / g_RobotStability.Scale);
+}
+
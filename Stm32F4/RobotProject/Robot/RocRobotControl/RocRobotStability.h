@@ -0,0 +1,44 @@
+/********************************************************************************
+ * This code is used for robot control
+*********************************************************************************
+ * Author        Data            Version
+ * Liren         2026/10/17      1.0
+********************************************************************************/
+#ifndef __ROC_ROBOT_STABILITY_H
+#define __ROC_ROBOT_STABILITY_H
+
+
+#include <stdint.h>
+
+#include "RocError.h"
+#include "RocRobotDhAlgorithm.h"
+
+
+/* The static stability margin is the distance in mm from the body center, where
+   the COG is, to the nearest edge of the support polygon of the feet on the
+   floor. It is negative when the COG is out of the polygon, or the distance to
+   the support line or point when less than three feet are on the floor. */
+#define ROC_ROBOT_STABILITY_STANCE_Z                0.5F    // The feet lower than it are on the floor
+
+/* The monitor keeps the minimum margin of every gait cycle, the ticks with less
+   than three feet on the floor are the dynamic phases of the amble gaits and
+   are left out. A cycle under the low margin cuts the travel scale, a cycle
+   over the high margin raises it back. The scale caps the step length and the
+   turn angle of the walking gaits, not the body height, and the servo time of
+   one gait tick is stretched by it. */
+#define ROC_ROBOT_STABILITY_MARGIN_LOW              10.0F   // mm
+#define ROC_ROBOT_STABILITY_MARGIN_HIGH             12.0F   // mm
+#define ROC_ROBOT_STABILITY_SCALE_MIN               0.5F
+#define ROC_ROBOT_STABILITY_SCALE_DOWN              0.1F    // Scale cut of a cycle under the low margin
+#define ROC_ROBOT_STABILITY_SCALE_UP                0.05F   // Scale raise of a cycle over the high margin
+
+
+ROC_RESULT RocRobotStabilityInit(void);
+float RocRobotStabilityMarginCalc(const float *pX, const float *pY, uint8_t Num);
+void RocRobotStabilityMonitorUpdate(float Margin, uint8_t FeetNum, float GaitStep);
+float RocRobotStabilityScaleGet(void);
+uint16_t RocRobotStabilityGaitSpeedGet(uint16_t NomGaitSpeed);
+
+
+#endif
+
@@ -0,0 +1,261 @@
+/********************************************************************************
+ * This code is used for robot control
+*********************************************************************************
+ * Author        Data            Version
+ * Liren         2026/10/17      1.0
+********************************************************************************/
+#include <stdint.h>
+#include <string.h>
+
+#include "RocLog.h"
+#include "RocRobotTransition.h"
+
+
+typedef struct _ROC_ROBOT_TRANSITION_s
+{
+    ROC_ROBOT_FEET_POS_s        FromPos;                // Feet position when the transition starts
+    ROC_ROBOT_FEET_POS_s        LastPos;                // Feet position sent to the IK at the last gait tick
+    uint8_t                     LastPosIsValid;         // No blend before the first feet position
+    float                       FromCar;                // The car part of the pose when the transition starts
+    float                       ToCar;                  // The car part of the target pose, 0 legged and 1 car
+    float                       CurCar;
+    uint16_t                    Tick;                   // Gait ticks since the transition starts
+    uint16_t                    TickNum;                // Gait ticks of the transition, 0 is not running
+    uint16_t                    TickNumDefault;         // Gait ticks of a gait or command change
+
+}ROC_ROBOT_TRANSITION_s;
+
+
+static ROC_ROBOT_TRANSITION_s   g_RobotTransition = {0};
+
+
+/*********************************************************************************
+ *  Description:
+ *              Init the transition, no transition is running and the robot is
+ *              in the legged pose
+ *
+ *  Parameter:
+ *              None
+ *
+ *  Return:
+ *              RET_OK
+ *
+ *  Author:
+ *              ROC LiRen(2026.10.17)
+**********************************************************************************/
+ROC_RESULT RocRobotTransitionInit(void)
+{
+    memset(&g_RobotTransition, 0, sizeof(g_RobotTransition));
+
+    g_RobotTransition.TickNumDefault = ROC_ROBOT_TRANSITION_TICK_DEFAULT;
+
+    return RET_OK;
+}
+
+/*********************************************************************************
+ *  Description:
+ *              Set the gait ticks of the transition started by a gait or command
+ *              change, 0 switches at once
+ *
+ *  Parameter:
+ *              TickNum: the gait ticks of the transition
+ *
+ *  Return:
+ *              RET_ERROR if the gait ticks are out of range
+ *
+ *  Author:
+ *              ROC LiRen(2026.10.17)
+**********************************************************************************/
+ROC_RESULT RocRobotTransitionTickNumSet(uint16_t TickNum)
+{
+    if(ROC_ROBOT_TRANSITION_TICK_MAX < TickNum)
+    {
+        ROC_LOGE("Robot transition ticks(%u) is out of range!", TickNum);
+
+        return RET_ERROR;
+    }
+
+    g_RobotTransition.TickNumDefault = TickNum;
+
+    return RET_OK;
+}
+
+/*********************************************************************************
+ *  Description:
+ *              Get the gait ticks of the transition started by a gait or command
+ *              change
+ *
+ *  Parameter:
+ *              None
+ *
+ *  Return:
+ *              The gait ticks of the transition
+ *
+ *  Author:
+ *              ROC LiRen(2026.10.17)
+**********************************************************************************/
+uint16_t RocRobotTransitionTickNumGet(void)
+{
+    return g_RobotTransition.TickNumDefault;
+}
+
+/*********************************************************************************
+ *  Description:
+ *              Start the transition from the feet position of the last gait tick,
+ *              a running transition restarts from where it is
+ *
+ *  Parameter:
+ *              TickNum: the gait ticks of the transition
+ *
+ *  Return:
+ *              None
+ *
+ *  Author:
+ *              ROC LiRen(2026.10.17)
+**********************************************************************************/
+static void RocRobotTransitionRun(uint16_t TickNum)
+{
+    if(ROC_FALSE == g_RobotTransition.LastPosIsValid)
+    {
+        TickNum = 0;
+    }
+
+    g_RobotTransition.FromPos = g_RobotTransition.LastPos;
+    g_RobotTransition.FromCar = g_RobotTransition.CurCar;
+    g_RobotTransition.Tick = 0;
+    g_RobotTransition.TickNum = TickNum;
+
+    if(0 == TickNum)
+    {
+        g_RobotTransition.CurCar = g_RobotTransition.ToCar;
+    }
+}
+
+/*********************************************************************************
+ *  Description:
+ *              Start the transition of a gait or command change, the car part
+ *              of the pose is kept
+ *
+ *  Parameter:
+ *              None
+ *
+ *  Return:
+ *              None
+ *
+ *  Author:
+ *              ROC LiRen(2026.10.17)
+**********************************************************************************/
+void RocRobotTransitionStart(void)
+{
+    RocRobotTransitionRun(g_RobotTransition.TickNumDefault);
+}
+
+/*********************************************************************************
+ *  Description:
+ *              Start the transition between the legged and the car pose, the
+ *              ankles turn the wheels down or up while the feet move
+ *
+ *  Parameter:
+ *              IsCar: ROC_TRUE to the car pose, ROC_FALSE to the legged pose
+ *              TickNum: the gait ticks of the transition
+ *
+ *  Return:
+ *              None
+ *
+ *  Author:
+ *              ROC LiRen(2026.10.17)
+**********************************************************************************/
+void RocRobotTransitionCarStart(uint8_t IsCar, uint16_t TickNum)
+{
+    g_RobotTransition.ToCar = (ROC_TRUE == IsCar) ? 1.0F : 0.0F;
+
+    RocRobotTransitionRun(TickNum);
+}
+
+/*********************************************************************************
+ *  Description:
+ *              Check the transition is running
+ *
+ *  Parameter:
+ *              None
+ *
+ *  Return:
+ *              ROC_TRUE if the transition has not reached the target pose
+ *
+ *  Author:
+ *              ROC LiRen(2026.10.17)
+**********************************************************************************/
+uint8_t RocRobotTransitionIsBusy(void)
+{
+    return (g_RobotTransition.Tick < g_RobotTransition.TickNum) ? ROC_TRUE : ROC_FALSE;
+}
+
+/*********************************************************************************
+ *  Description:
+ *              Advance the transition by one gait tick and blend the feet
+ *              position of the new gait or pose, it is called once per gait
+ *              tick just before the IK
+ *
+ *  Parameter:
+ *              pFeetPos: the pointer to the live feet position, it is blended
+ *
+ *  Return:
+ *              None
+ *
+ *  Author:
+ *              ROC LiRen(2026.10.17)
+**********************************************************************************/
+void RocRobotTransitionFeetBlend(ROC_ROBOT_FEET_POS_s *pFeetPos)
+{
+    uint8_t                     i = 0;
+    float                       s = 0;
+    float                       w = 0;
+    const ROC_ROBOT_FEET_POS_s  *pFrom = &g_RobotTransition.FromPos;
+
+    if(g_RobotTransition.Tick < g_RobotTransition.TickNum)
+    {
+        g_RobotTransition.Tick++;
+
+        if(g_RobotTransition.Tick < g_RobotTransition.TickNum)
+        {
+            s = (float)g_RobotTransition.Tick / g_RobotTransition.TickNum;
+            w = s * s * (3.0F - 2.0F * s);
+
+            for(i = 0; i < ROC_ROBOT_CNT_LEGS; i++)
+            {
+                pFeetPos->X[i] = pFrom->X[i] + w * (pFeetPos->X[i] - pFrom->X[i]);
+                pFeetPos->Y[i] = pFrom->Y[i] + w * (pFeetPos->Y[i] - pFrom->Y[i]);
+                pFeetPos->Z[i] = pFrom->Z[i] + w * (pFeetPos->Z[i] - pFrom->Z[i]);
+            }
+
+            g_RobotTransition.CurCar = g_RobotTransition.FromCar + w * (g_RobotTransition.ToCar - g_RobotTransition.FromCar);
+        }
+        else
+        {
+            g_RobotTransition.CurCar = g_RobotTransition.ToCar;
+        }
+    }
+
+    g_RobotTransition.LastPos = *pFeetPos;
+    g_RobotTransition.LastPosIsValid = ROC_TRUE;
+}
+
+/*********************************************************************************
+ *  Description:
+ *              Get the ankle PWM offset of the car part of the pose, the right
+ *              ankles turn by minus the offset and the left ones by plus
+ *
+ *  Parameter:
+ *              None
+ *
+ *  Return:
+ *              The ankle PWM offset
+ *
+ *  Author:
+ *              ROC LiRen(2026.10.17)
+**********************************************************************************/
+int16_t RocRobotTransitionCarAnkleGet(void)
+{
+    return (int16_t)(g_RobotTransition.CurCar * ROC_ROBOT_TRANSITION_CAR_ANKLE_PWM);
+}
+
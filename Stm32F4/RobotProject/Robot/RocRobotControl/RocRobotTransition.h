@@ -0,0 +1,39 @@
+/********************************************************************************
+ * This code is used for robot control
+*********************************************************************************
+ * Author        Data            Version
+ * Liren         2026/10/17      1.0
+********************************************************************************/
+#ifndef __ROC_ROBOT_TRANSITION_H
+#define __ROC_ROBOT_TRANSITION_H
+
+
+#include <stdint.h>
+
+#include "RocError.h"
+#include "RocRobotDhAlgorithm.h"
+
+
+/* The transition blends the feet position sent to the IK from the position
+   when it starts to the live position of the new gait or pose, so any gait,
+   walk mode or car mode change goes on without stopping. One step is one gait
+   tick, the blend is w = 3s^2 - 2s^3 of s = step / steps, and the last step is
+   the live position. */
+#define ROC_ROBOT_TRANSITION_TICK_DEFAULT           4U      // Gait ticks of a gait or command change
+#define ROC_ROBOT_TRANSITION_TICK_MAX               64U
+
+#define ROC_ROBOT_TRANSITION_CAR_ANKLE_PWM          20      // The ankle PWM offset putting the wheels down in the car mode
+
+
+ROC_RESULT RocRobotTransitionInit(void);
+ROC_RESULT RocRobotTransitionTickNumSet(uint16_t TickNum);
+uint16_t RocRobotTransitionTickNumGet(void);
+void RocRobotTransitionStart(void);
+void RocRobotTransitionCarStart(uint8_t IsCar, uint16_t TickNum);
+uint8_t RocRobotTransitionIsBusy(void);
+void RocRobotTransitionFeetBlend(ROC_ROBOT_FEET_POS_s *pFeetPos);
+int16_t RocRobotTransitionCarAnkleGet(void);
+
+
+#endif
+
@@ -0,0 +1,285 @@
+/********************************************************************************
+ * This code is used for robot control
+*********************************************************************************
+ * Author        Data            Version
+ * Liren         2026/10/17      1.0
+********************************************************************************/
+#include <math.h>
+
+#include "RocRobotTrigLut.h"
+
+
+static float g_TrigLutSin[ROC_ROBOT_TRIG_LUT_SIN_SIZE];
+static float g_TrigLutAtan[ROC_ROBOT_TRIG_LUT_ATAN_SIZE + 1];
+
+
+/*********************************************************************************
+ *  Description:
+ *              Fill the trigonometry tables, it must be called before any other
+ *              function of the module
+ *
+ *  Parameter:
+ *              None
+ *
+ *  Return:
+ *              None
+ *
+ *  Author:
+ *              ROC LiRen(2026.10.17)
+**********************************************************************************/
+void RocRobotTrigLutInit(void)
+{
+    uint32_t    i = 0;
+
+    for(i = 0; i < ROC_ROBOT_TRIG_LUT_SIN_SIZE; i++)
+    {
+        g_TrigLutSin[i] = (float)sin(2 * 3.14159265358979 * i / ROC_ROBOT_TRIG_LUT_SIN_SIZE);
+    }
+
+    for(i = 0; i <= ROC_ROBOT_TRIG_LUT_ATAN_SIZE; i++)
+    {
+        g_TrigLutAtan[i] = (float)atan((double)i / ROC_ROBOT_TRIG_LUT_ATAN_SIZE);
+    }
+}
+
+/*********************************************************************************
+ *  Description:
+ *              Look up the sine table by the table index, one table step is
+ *              2 * PI / ROC_ROBOT_TRIG_LUT_SIN_SIZE. The value between two table
+ *              points is interpolated by the second order Taylor expansion:
+ *              sin(x0 + d) = sin(x0) + d * (cos(x0) - d * sin(x0) / 2), the cos(x0)
+ *              is the table point a quarter turn later
+ *
+ *  Parameter:
+ *              Index: the table index, it can be any value
+ *
+ *  Return:
+ *              The interpolated sine value
+ *
+ *  Author:
+ *              ROC LiRen(2026.10.17)
+**********************************************************************************/
+static float RocRobotTrigLutSinIndex(float Index)
+{
+    int32_t i = 0;
+    float   Delta = 0;
+    float   SinX0 = 0;
+    float   CosX0 = 0;
+
+    i = (int32_t)Index;
+    if((float)i > Index)            // round to the negative infinity
+    {
+        i--;
+    }
+
+    Delta = (Index - (float)i) * (2 * ROC_ROBOT_TRIG_LUT_CONST_PI / ROC_ROBOT_TRIG_LUT_SIN_SIZE);
+    SinX0 = g_TrigLutSin[i & (ROC_ROBOT_TRIG_LUT_SIN_SIZE - 1)];
+    CosX0 = g_TrigLutSin[(i + ROC_ROBOT_TRIG_LUT_SIN_SIZE / 4) & (ROC_ROBOT_TRIG_LUT_SIN_SIZE - 1)];
+
+    return SinX0 + Delta * (CosX0 - 0.5F * Delta * SinX0);
+}
+
+/*********************************************************************************
+ *  Description:
+ *              Look up the arc tangent table in the range of [0, 1]
+ *
+ *  Parameter:
+ *              x: the input value in [0, 1]
+ *
+ *  Return:
+ *              The interpolated arc tangent in radian
+ *
+ *  Author:
+ *              ROC LiRen(2026.10.17)
+**********************************************************************************/
+static float RocRobotTrigLutAtanUnit(float x)
+{
+    int32_t i = 0;
+    float   Index = 0;
+    float   Frac = 0;
+
+    Index = x * ROC_ROBOT_TRIG_LUT_ATAN_SIZE;
+    i = (int32_t)Index;
+
+    if(i >= ROC_ROBOT_TRIG_LUT_ATAN_SIZE)
+    {
+        i = ROC_ROBOT_TRIG_LUT_ATAN_SIZE - 1;
+    }
+
+    Frac = Index - (float)i;
+
+    return g_TrigLutAtan[i] + Frac * (g_TrigLutAtan[i + 1] - g_TrigLutAtan[i]);
+}
+
+/*********************************************************************************
+ *  Description:
+ *              The sine of the angle
+ *
+ *  Parameter:
+ *              x: the angle in radian
+ *
+ *  Return:
+ *              The sine value
+ *
+ *  Author:
+ *              ROC LiRen(2026.10.17)
+**********************************************************************************/
+float RocRobotTrigLutSin(float x)
+{
+    return RocRobotTrigLutSinIndex(x * (ROC_ROBOT_TRIG_LUT_SIN_SIZE / (2 * ROC_ROBOT_TRIG_LUT_CONST_PI)));
+}
+
+/*********************************************************************************
+ *  Description:
+ *              The cosine of the angle, which is the sine moved by a quarter turn
+ *
+ *  Parameter:
+ *              x: the angle in radian
+ *
+ *  Return:
+ *              The cosine value
+ *
+ *  Author:
+ *              ROC LiRen(2026.10.17)
+**********************************************************************************/
+float RocRobotTrigLutCos(float x)
+{
+    return RocRobotTrigLutSinIndex(x * (ROC_ROBOT_TRIG_LUT_SIN_SIZE / (2 * ROC_ROBOT_TRIG_LUT_CONST_PI))
+                                    + (ROC_ROBOT_TRIG_LUT_SIN_SIZE / 4));
+}
+
+/*********************************************************************************
+ *  Description:
+ *              The arc tangent of the value
+ *
+ *  Parameter:
+ *              x: the input value
+ *
+ *  Return:
+ *              The arc tangent in radian, in the range of [-PI/2, PI/2]
+ *
+ *  Author:
+ *              ROC LiRen(2026.10.17)
+**********************************************************************************/
+float RocRobotTrigLutAtan(float x)
+{
+    float   Abs = 0;
+    float   Angle = 0;
+
+    Abs = (x < 0) ? -x : x;
+
+    if(Abs <= 1)
+    {
+        Angle = RocRobotTrigLutAtanUnit(Abs);
+    }
+    else
+    {
+        Angle = ROC_ROBOT_TRIG_LUT_CONST_HALF_PI - RocRobotTrigLutAtanUnit(1 / Abs);
+    }
+
+    return (x < 0) ? -Angle : Angle;
+}
+
+/*********************************************************************************
+ *  Description:
+ *              The arc tangent of y / x, which uses the signs of both arguments
+ *              to find the quadrant
+ *
+ *  Parameter:
+ *              y: the y coordinate
+ *              x: the x coordinate
+ *
+ *  Return:
+ *              The angle in radian, in the range of [-PI, PI]
+ *
+ *  Author:
+ *              ROC LiRen(2026.10.17)
+**********************************************************************************/
+float RocRobotTrigLutAtan2(float y, float x)
+{
+    float   AbsX = 0;
+    float   AbsY = 0;
+    float   Angle = 0;
+
+    AbsX = (x < 0) ? -x : x;
+    AbsY = (y < 0) ? -y : y;
+
+    if((0 == AbsX) && (0 == AbsY))
+    {
+        return 0;
+    }
+
+    if(AbsY <= AbsX)
+    {
+        Angle = RocRobotTrigLutAtanUnit(AbsY / AbsX);
+    }
+    else
+    {
+        Angle = ROC_ROBOT_TRIG_LUT_CONST_HALF_PI - RocRobotTrigLutAtanUnit(AbsX / AbsY);
+    }
+
+    if(x < 0)
+    {
+        Angle = ROC_ROBOT_TRIG_LUT_CONST_PI - Angle;
+    }
+
+    return (y < 0) ? -Angle : Angle;
+}
+
+/*********************************************************************************
+ *  Description:
+ *              The arc cosine of the value, it is solved by the arc tangent of
+ *              (1 - x^2)^0.5 / x. The input out of [-1, 1] is limited, so an
+ *              unreachable leg position gives the nearest joint angle
+ *
+ *  Parameter:
+ *              x: the input value
+ *
+ *  Return:
+ *              The arc cosine in radian, in the range of [0, PI]
+ *
+ *  Author:
+ *              ROC LiRen(2026.10.17)
+**********************************************************************************/
+float RocRobotTrigLutAcos(float x)
+{
+    if(x > 1)
+    {
+        x = 1;
+    }
+    else if(x < -1)
+    {
+        x = -1;
+    }
+
+    /* (1 - x) * (1 + x) keeps the precision when x is close to 1 */
+    return RocRobotTrigLutAtan2(sqrtf((1 - x) * (1 + x)), x);
+}
+
+/*********************************************************************************
+ *  Description:
+ *              The arc sine of the value, the input out of [-1, 1] is limited
+ *
+ *  Parameter:
+ *              x: the input value
+ *
+ *  Return:
+ *              The arc sine in radian, in the range of [-PI/2, PI/2]
+ *
+ *  Author:
+ *              ROC LiRen(2026.10.17)
+**********************************************************************************/
+float RocRobotTrigLutAsin(float x)
+{
+    if(x > 1)
+    {
+        x = 1;
+    }
+    else if(x < -1)
+    {
+        x = -1;
+    }
+
+    return RocRobotTrigLutAtan2(x, sqrtf((1 - x) * (1 + x)));
+}
+
@@ -0,0 +1,44 @@
+/********************************************************************************
+ * This code is used for robot control
+*********************************************************************************
+ * Author        Data            Version
+ * Liren         2026/10/17      1.0
+********************************************************************************/
+#ifndef __ROC_ROBOT_TRIG_LUT_H
+#define __ROC_ROBOT_TRIG_LUT_H
+
+
+#include <stdint.h>
+
+
+/* Table size of the sine wave for one turn, must be the power of 2. The value
+   between the table points uses the second order Taylor expansion, the error is
+   (2 * PI / SIZE)^3 / 6. For 512 points: the max error of Sin/Cos is 3.1e-7,
+   1.6e-6 measured for the angle in [-4 * PI, 4 * PI] with the float rounding. */
+#define ROC_ROBOT_TRIG_LUT_SIN_SIZE                 512
+
+/* Table size of the arc tangent in [0, 1], the value between the table points
+   is linear interpolated, the error is 0.65 * (1 / SIZE)^2 / 8. For 256 points:
+   the max angular error of ATan, ATan2, ACos and ASin is 1.3e-6 rad, and 1.5e-6
+   rad (8.7e-5 deg) measured with the float rounding. */
+#define ROC_ROBOT_TRIG_LUT_ATAN_SIZE                256
+
+/* In the robot workspace, the max joint angle error against the double solver
+   is 0.01 deg and no servo PWM moves more than one count, which is checked by
+   the host tool RocRobotIkAccuracyCheck. */
+
+#define ROC_ROBOT_TRIG_LUT_CONST_PI                 3.14159265F
+#define ROC_ROBOT_TRIG_LUT_CONST_HALF_PI            1.57079633F
+
+
+void RocRobotTrigLutInit(void);
+float RocRobotTrigLutSin(float x);
+float RocRobotTrigLutCos(float x);
+float RocRobotTrigLutAtan(float x);
+float RocRobotTrigLutAtan2(float y, float x);
+float RocRobotTrigLutAcos(float x);
+float RocRobotTrigLutAsin(float x);
+
+
+#endif
+
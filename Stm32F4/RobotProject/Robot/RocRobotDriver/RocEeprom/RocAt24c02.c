@@ -4,11 +4,11 @@
  * Author        Data            Version
  * Liren         2019/01/18      1.0
 ********************************************************************************/
-#include <string.h>
 
 #include "i2c.h"
 
 #include "RocLog.h"
+#include "RocPca9685.h"
 #include "RocAt24c02.h"
 
 
@@ -16,15 +16,11 @@
 #define ADDR_AT24C02_Read   0xA1
 
 
-uint8_t I2cBufferWrite[256];
-uint8_t I2cBufferRead[256];
-
-
 static HAL_StatusTypeDef RocAt24c02WriteReg(uint16_t SlaveAddr, uint16_t Reg, uint8_t *BufferAddr, uint16_t DatNum)
 {
     HAL_StatusTypeDef   WriteStatus;
 
-    WriteStatus = HAL_I2C_Mem_Write(&hi2c1, SlaveAddr, Reg, I2C_MEMADD_SIZE_8BIT, BufferAddr, DatNum, 1000);
+    WriteStatus = HAL_I2C_Mem_Write(&hi2c1, SlaveAddr, Reg, I2C_MEMADD_SIZE_8BIT, BufferAddr, DatNum, ROC_AT24C02_BUS_TIMEOUT);
 
     return WriteStatus;
 }
@@ -33,55 +29,175 @@ static HAL_StatusTypeDef RocAt24c02ReadReg(uint16_t SlaveAddr, uint16_t Reg, uin
 {
     HAL_StatusTypeDef   ReadStatus;
 
-    ReadStatus = HAL_I2C_Mem_Read(&hi2c1, SlaveAddr, Reg, I2C_MEMADD_SIZE_8BIT, BufferAddr, DatNum, 1000);
+    ReadStatus = HAL_I2C_Mem_Read(&hi2c1, SlaveAddr, Reg, I2C_MEMADD_SIZE_8BIT, BufferAddr, DatNum, ROC_AT24C02_BUS_TIMEOUT);
 
     return ReadStatus;
 }
 
-void RocAt24c02Init(void)
+/*********************************************************************************
+ *  Description:
+ *              Check the AT24C02 answers on the IIC bus, the AT24C02 shares the
+ *              bus with the PCA9685 frame DMA
+ *
+ *  Parameter:
+ *              None
+ *
+ *  Return:
+ *              RET_ERROR if the AT24C02 does not answer
+ *
+ *  Author:
+ *              ROC LiRen(2019.01.18)
+**********************************************************************************/
+ROC_RESULT RocAt24c02Init(void)
 {
-    uint16_t i = 0;
+    RocPca9685FrameWaitIdle(ROC_PCA9685_FRAME_WAIT_TIMEOUT);
+
+    if(HAL_OK != HAL_I2C_IsDeviceReady(&hi2c1, ADDR_AT24C02_Write, 3, ROC_AT24C02_WRITE_TIMEOUT))
+    {
+        ROC_LOGE("AT24C02 is not ready!");
+
+        return RET_ERROR;
+    }
 
-    printf("\r\n \r\n*********STM32CubeMX I2C AT24C02 Example*********\r\n");
-    printf("\r\n I2C Write Buffer:\r\n");
+    return RET_OK;
+}
 
-    for(i = 0; i < 256; i++)
+/*********************************************************************************
+ *  Description:
+ *              Read the AT24C02
+ *
+ *  Parameter:
+ *              Addr: the memory address
+ *              pBuf: the pointer to the read buffer
+ *              Len:  the read length
+ *
+ *  Return:
+ *              RET_ERROR if the range is invalid or the bus is in error
+ *
+ *  Author:
+ *              ROC LiRen(2026.10.17)
+**********************************************************************************/
+ROC_RESULT RocAt24c02Read(uint16_t Addr, uint8_t *pBuf, uint16_t Len)
+{
+    if((0 == Len) || (ROC_AT24C02_SIZE < Addr + Len))
     {
-        I2cBufferWrite[i] = i;  /* WriteBuffer Initialization */
-        printf("%02X ", I2cBufferWrite[i]);
+        ROC_LOGE("AT24C02 read range(%d, %d) is invalid!", Addr, Len);
+
+        return RET_ERROR;
     }
 
-    /* write data to AT24C02 */
-    for(i = 0; i < 256; i = i + 8)
+    RocPca9685FrameWaitIdle(ROC_PCA9685_FRAME_WAIT_TIMEOUT);
+
+    if(HAL_OK != RocAt24c02ReadReg(ADDR_AT24C02_Read, Addr, pBuf, Len))
     {
-        if (RocAt24c02WriteReg(ADDR_AT24C02_Write, i, &(I2cBufferWrite[i]), 8) == HAL_OK)
-        {
-            printf("\r\n Byte %02d to Byte %02d Write OK", i, i + 8);
-            HAL_Delay(5);
-        }
-        else
-        {
-            printf("\r\n Byte %02d to Byte %02d Write Failed", i, i + 8);
-        }
+        ROC_LOGE("AT24C02 read(%d, %d) is in error!", Addr, Len);
+
+        return RET_ERROR;
     }
 
-    /* read data from EEPROM */
-    printf("\r\n Reading from AT24C02:\r\n");
+    return RET_OK;
+}
 
-    RocAt24c02ReadReg(ADDR_AT24C02_Read, 0, I2cBufferRead, 256);
+/*********************************************************************************
+ *  Description:
+ *              Write the AT24C02, the write is split at the page boundary and
+ *              every page waits for the write cycle by the acknowledge polling
+ *
+ *  Parameter:
+ *              Addr: the memory address
+ *              pBuf: the pointer to the write data
+ *              Len:  the write length
+ *
+ *  Return:
+ *              RET_ERROR if the range is invalid or the bus is in error
+ *
+ *  Author:
+ *              ROC LiRen(2026.10.17)
+**********************************************************************************/
+ROC_RESULT RocAt24c02Write(uint16_t Addr, const uint8_t *pBuf, uint16_t Len)
+{
+    uint16_t            PageLen = 0;
 
-    for(i = 0; i < 256; i++)
+    if((0 == Len) || (ROC_AT24C02_SIZE < Addr + Len))
     {
-        printf("0x%02X  ", I2cBufferRead[i]);
+        ROC_LOGE("AT24C02 write range(%d, %d) is invalid!", Addr, Len);
+
+        return RET_ERROR;
     }
 
-    if(memcmp(I2cBufferRead, I2cBufferWrite, 256) == 0) /* check data */
+    while(0 != Len)
     {
-        printf("\r\n AT24C02 Read Test OK\r\n");
+        PageLen = ROC_AT24C02_PAGE_SIZE - Addr % ROC_AT24C02_PAGE_SIZE;
+        if(PageLen > Len)
+        {
+            PageLen = Len;
+        }
+
+        RocPca9685FrameWaitIdle(ROC_PCA9685_FRAME_WAIT_TIMEOUT);
+
+        if(HAL_OK != RocAt24c02WriteReg(ADDR_AT24C02_Write, Addr, (uint8_t *)pBuf, PageLen))
+        {
+            ROC_LOGE("AT24C02 write(%d, %d) is in error!", Addr, PageLen);
+
+            return RET_ERROR;
+        }
+
+        /* The AT24C02 does not acknowledge until the write cycle ends */
+        if(HAL_OK != HAL_I2C_IsDeviceReady(&hi2c1, ADDR_AT24C02_Write, ROC_AT24C02_WRITE_TIMEOUT, ROC_AT24C02_WRITE_TIMEOUT))
+        {
+            ROC_LOGE("AT24C02 write cycle(%d) is timeout!", Addr);
+
+            return RET_ERROR;
+        }
+
+        Addr += PageLen;
+        pBuf += PageLen;
+        Len -= PageLen;
     }
-    else
+
+    return RET_OK;
+}
+
+/*********************************************************************************
+ *  Description:
+ *              Calculate the CRC16-CCITT of the stored data, the polynomial is
+ *              0x1021 and the initial value is 0xFFFF
+ *
+ *  Parameter:
+ *              pBuf: the pointer to the data
+ *              Len:  the data length
+ *
+ *  Return:
+ *              The CRC value
+ *
+ *  Author:
+ *              ROC LiRen(2026.10.17)
+**********************************************************************************/
+uint16_t RocAt24c02Crc16(const uint8_t *pBuf, uint16_t Len)
+{
+    uint8_t             i = 0;
+    uint16_t            Crc = 0xFFFFU;
+
+    while(0 != Len)
     {
-        printf("\r\n AT24C02 Read Test Failed\r\n");
+        Crc ^= (uint16_t)(*pBuf << 8);
+
+        for(i = 0; i < 8; i++)
+        {
+            if(Crc & 0x8000U)
+            {
+                Crc = (uint16_t)((Crc << 1) ^ 0x1021U);
+            }
+            else
+            {
+                Crc = (uint16_t)(Crc << 1);
+            }
+        }
+
+        pBuf++;
+        Len--;
     }
+
+    return Crc;
 }
 
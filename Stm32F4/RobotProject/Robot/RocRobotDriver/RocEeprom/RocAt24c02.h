@@ -7,7 +7,22 @@
 #ifndef _ROC_AT24C02_H
 #define _ROC_AT24C02_H
 
-void RocAt24c02Init(void);
+
+#include <stdint.h>
+
+#include "RocError.h"
+
+
+#define ROC_AT24C02_SIZE                256U
+#define ROC_AT24C02_PAGE_SIZE           8U      /* One write must not cross the page */
+#define ROC_AT24C02_WRITE_TIMEOUT       10U     /* ms, the write cycle is 5 ms at most */
+#define ROC_AT24C02_BUS_TIMEOUT         100U    /* ms */
+
+
+ROC_RESULT RocAt24c02Init(void);
+ROC_RESULT RocAt24c02Read(uint16_t Addr, uint8_t *pBuf, uint16_t Len);
+ROC_RESULT RocAt24c02Write(uint16_t Addr, const uint8_t *pBuf, uint16_t Len);
+uint16_t RocAt24c02Crc16(const uint8_t *pBuf, uint16_t Len);
 
 #endif
 
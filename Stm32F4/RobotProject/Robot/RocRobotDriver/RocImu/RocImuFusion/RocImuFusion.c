@@ -0,0 +1,285 @@
+/********************************************************************************
+ * This code is used for robot control
+*********************************************************************************
+ * Author        Data            Version
+ * Liren         2026/10/17      1.0
+********************************************************************************/
+#include <stdint.h>
+#include <string.h>
+#include <math.h>
+
+#include "RocImuFusion.h"
+
+
+/*********************************************************************************
+ *  Description:
+ *              Normalize the quaternion of the fusion
+ *
+ *  Parameter:
+ *              pQuat: the pointer to the quaternion W, X, Y, Z
+ *
+ *  Return:
+ *              None
+ *
+ *  Author:
+ *              ROC LiRen(2026.10.17)
+**********************************************************************************/
+static void RocImuFusionQuatNormalize(float *pQuat)
+{
+    float   Norm = 0;
+
+    Norm = sqrtf(pQuat[0] * pQuat[0] + pQuat[1] * pQuat[1] + pQuat[2] * pQuat[2] + pQuat[3] * pQuat[3]);
+    if(0 == Norm)
+    {
+        pQuat[0] = 1.0F;
+        pQuat[1] = 0;
+        pQuat[2] = 0;
+        pQuat[3] = 0;
+
+        return;
+    }
+
+    Norm = 1.0F / Norm;
+
+    pQuat[0] *= Norm;
+    pQuat[1] *= Norm;
+    pQuat[2] *= Norm;
+    pQuat[3] *= Norm;
+}
+
+/*********************************************************************************
+ *  Description:
+ *              Align the quaternion to the gravity of the accel, it is the
+ *              shortest rotation of the accel to the earth Z axis, the yaw is 0
+ *
+ *  Parameter:
+ *              pFusion: the pointer to the fusion
+ *              a: the normalized accel
+ *
+ *  Return:
+ *              None
+ *
+ *  Author:
+ *              ROC LiRen(2026.10.17)
+**********************************************************************************/
+static void RocImuFusionGravityAlign(ROC_IMU_FUSION_s *pFusion, const float *a)
+{
+    if(-0.999F > a[2])
+    {
+        /* Upside down, the rotation axis of the shortest rotation is not defined */
+        pFusion->Quat[0] = 0;
+        pFusion->Quat[1] = 1.0F;
+        pFusion->Quat[2] = 0;
+        pFusion->Quat[3] = 0;
+    }
+    else
+    {
+        pFusion->Quat[0] = 1.0F + a[2];
+        pFusion->Quat[1] = a[1];
+        pFusion->Quat[2] = -a[0];
+        pFusion->Quat[3] = 0;
+
+        RocImuFusionQuatNormalize(pFusion->Quat);
+    }
+
+    pFusion->IsAligned = ROC_TRUE;
+}
+
+/*********************************************************************************
+ *  Description:
+ *              Get the gyro rate corrected by the accel with the Mahony filter,
+ *              the error is the cross product of the measured gravity and the
+ *              estimated one, its integral is clamped as the gyro bias range
+ *
+ *  Parameter:
+ *              pFusion: the pointer to the fusion
+ *              g: the gyro rate in rad/s, corrected in place
+ *              a: the normalized accel
+ *              Dt: the sample time in s
+ *
+ *  Return:
+ *              None
+ *
+ *  Author:
+ *              ROC LiRen(2026.10.17)
+**********************************************************************************/
+static void RocImuFusionMahonyCorrect(ROC_IMU_FUSION_s *pFusion, float *g, const float *a, float Dt)
+{
+    uint8_t     i = 0;
+    const float *q = pFusion->Quat;
+    float       v[3];
+    float       e[3];
+
+    /* Half of the gravity direction of the estimated attitude */
+    v[0] = q[1] * q[3] - q[0] * q[2];
+    v[1] = q[0] * q[1] + q[2] * q[3];
+    v[2] = q[0] * q[0] - 0.5F + q[3] * q[3];
+
+    e[0] = a[1] * v[2] - a[2] * v[1];
+    e[1] = a[2] * v[0] - a[0] * v[2];
+    e[2] = a[0] * v[1] - a[1] * v[0];
+
+    for(i = 0; i < 3; i++)
+    {
+        if(0 < pFusion->Ki)
+        {
+            pFusion->IntError[i] += pFusion->Ki * e[i] * Dt;
+
+            if(ROC_IMU_FUSION_MAHONY_INT_MAX < pFusion->IntError[i])
+            {
+                pFusion->IntError[i] = ROC_IMU_FUSION_MAHONY_INT_MAX;
+            }
+            else if(-ROC_IMU_FUSION_MAHONY_INT_MAX > pFusion->IntError[i])
+            {
+                pFusion->IntError[i] = -ROC_IMU_FUSION_MAHONY_INT_MAX;
+            }
+
+            g[i] += pFusion->IntError[i];
+        }
+
+        g[i] += pFusion->Kp * e[i];
+    }
+}
+
+/*********************************************************************************
+ *  Description:
+ *              Get the quaternion rate corrected by the accel with the Madgwick
+ *              filter, one gradient descent step of the gravity error
+ *
+ *  Parameter:
+ *              pFusion: the pointer to the fusion
+ *              pRate: the quaternion rate, corrected in place
+ *              a: the normalized accel
+ *
+ *  Return:
+ *              None
+ *
+ *  Author:
+ *              ROC LiRen(2026.10.17)
+**********************************************************************************/
+static void RocImuFusionMadgwickCorrect(ROC_IMU_FUSION_s *pFusion, float *pRate, const float *a)
+{
+    const float *q = pFusion->Quat;
+    float       Norm = 0;
+    float       f[3];
+    float       s[4];
+
+    /* The gravity error of the estimated attitude */
+    f[0] = 2.0F * (q[1] * q[3] - q[0] * q[2]) - a[0];
+    f[1] = 2.0F * (q[0] * q[1] + q[2] * q[3]) - a[1];
+    f[2] = 2.0F * (0.5F - q[1] * q[1] - q[2] * q[2]) - a[2];
+
+    /* The gradient is the transposed Jacobian multiplied by the error */
+    s[0] = -2.0F * q[2] * f[0] + 2.0F * q[1] * f[1];
+    s[1] =  2.0F * q[3] * f[0] + 2.0F * q[0] * f[1] - 4.0F * q[1] * f[2];
+    s[2] = -2.0F * q[0] * f[0] + 2.0F * q[3] * f[1] - 4.0F * q[2] * f[2];
+    s[3] =  2.0F * q[1] * f[0] + 2.0F * q[2] * f[1];
+
+    Norm = sqrtf(s[0] * s[0] + s[1] * s[1] + s[2] * s[2] + s[3] * s[3]);
+    if(0 == Norm)
+    {
+        return;
+    }
+
+    Norm = pFusion->Beta / Norm;
+
+    pRate[0] -= Norm * s[0];
+    pRate[1] -= Norm * s[1];
+    pRate[2] -= Norm * s[2];
+    pRate[3] -= Norm * s[3];
+}
+
+/*********************************************************************************
+ *  Description:
+ *              Init the fusion with the default gains, the quaternion is aligned
+ *              by the first sample
+ *
+ *  Parameter:
+ *              pFusion: the pointer to the fusion
+ *              Mode: the filter of the fusion
+ *
+ *  Return:
+ *              None
+ *
+ *  Author:
+ *              ROC LiRen(2026.10.17)
+**********************************************************************************/
+void RocImuFusionInit(ROC_IMU_FUSION_s *pFusion, ROC_IMU_FUSION_MODE_e Mode)
+{
+    memset(pFusion, 0, sizeof(*pFusion));
+
+    pFusion->Mode = Mode;
+    pFusion->Kp = ROC_IMU_FUSION_MAHONY_KP;
+    pFusion->Ki = ROC_IMU_FUSION_MAHONY_KI;
+    pFusion->Beta = ROC_IMU_FUSION_MADGWICK_BETA;
+    pFusion->Quat[0] = 1.0F;
+}
+
+/*********************************************************************************
+ *  Description:
+ *              Update the attitude with one sample of the gyro and the accel
+ *
+ *  Parameter:
+ *              pFusion: the pointer to the fusion
+ *              pGyro: the gyro rate X, Y, Z in rad/s
+ *              pAccel: the accel X, Y, Z in any unit, it is normalized, the
+ *                      zero accel is no correction
+ *              Dt: the sample time in s
+ *
+ *  Return:
+ *              None
+ *
+ *  Author:
+ *              ROC LiRen(2026.10.17)
+**********************************************************************************/
+void RocImuFusionUpdate(ROC_IMU_FUSION_s *pFusion, const float *pGyro, const float *pAccel, float Dt)
+{
+    float   *q = pFusion->Quat;
+    float   Norm = 0;
+    float   a[3];
+    float   g[3];
+    float   Rate[4];
+
+    Norm = sqrtf(pAccel[0] * pAccel[0] + pAccel[1] * pAccel[1] + pAccel[2] * pAccel[2]);
+    if(0 < Norm)
+    {
+        a[0] = pAccel[0] / Norm;
+        a[1] = pAccel[1] / Norm;
+        a[2] = pAccel[2] / Norm;
+
+        if(ROC_TRUE != pFusion->IsAligned)
+        {
+            RocImuFusionGravityAlign(pFusion, a);
+
+            return;
+        }
+    }
+
+    g[0] = pGyro[0];
+    g[1] = pGyro[1];
+    g[2] = pGyro[2];
+
+    if((ROC_IMU_FUSION_MODE_MAHONY == pFusion->Mode) && (0 < Norm))
+    {
+        RocImuFusionMahonyCorrect(pFusion, g, a, Dt);
+    }
+
+    /* The quaternion rate is half of the quaternion multiplied by the gyro rate */
+    Rate[0] = 0.5F * (-q[1] * g[0] - q[2] * g[1] - q[3] * g[2]);
+    Rate[1] = 0.5F * ( q[0] * g[0] + q[2] * g[2] - q[3] * g[1]);
+    Rate[2] = 0.5F * ( q[0] * g[1] - q[1] * g[2] + q[3] * g[0]);
+    Rate[3] = 0.5F * ( q[0] * g[2] + q[1] * g[1] - q[2] * g[0]);
+
+    if((ROC_IMU_FUSION_MODE_MADGWICK == pFusion->Mode) && (0 < Norm))
+    {
+        RocImuFusionMadgwickCorrect(pFusion, Rate, a);
+    }
+
+    q[0] += Rate[0] * Dt;
+    q[1] += Rate[1] * Dt;
+    q[2] += Rate[2] * Dt;
+    q[3] += Rate[3] * Dt;
+
+    RocImuFusionQuatNormalize(q);
+}
+
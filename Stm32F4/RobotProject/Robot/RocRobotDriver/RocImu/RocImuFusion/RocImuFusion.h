@@ -0,0 +1,65 @@
+/********************************************************************************
+ * This code is used for robot control
+*********************************************************************************
+ * Author        Data            Version
+ * Liren         2026/10/17      1.0
+********************************************************************************/
+#ifndef __ROC_IMU_FUSION_H
+#define __ROC_IMU_FUSION_H
+
+
+#include <stdint.h>
+
+#include "RocError.h"
+
+
+/* The sensor fusion of the raw gyro and accel, it is the alternative of the DMP
+   firmware. The attitude is the unit quaternion W, X, Y, Z of the body in the
+   earth frame, Z up, the same as the DMP one. The first sample aligns the
+   quaternion to the gravity at once, then the gyro is integrated and corrected
+   by the accel with the gain of the filter. All the math is single precision
+   without trigonometry.
+   The yaw has no reference in both filters and drifts with the Z gyro bias, the
+   accel doesn't see it: on the synthetic log of RocImuFusionReplay, 0.5 dps of
+   bias without the calibration, the yaw is 10.5 degree off after 20 s with the
+   Madgwick filter, and the same with the Mahony one. The gyro bias calibration
+   of RocMpu6050BiasCalibrate is the only cure of it.
+   The Mahony gains are tuned on that log: with Kp 1 and no integral term the
+   tilt error of the uncalibrated bias stays at 1 degree and never settles, Kp 2
+   and Ki 0.05 keep it under 0.7 degree from the start. The integral term
+   learns the X and Y bias, it is clamped to the bias range of the gyro, so a
+   long tilted start doesn't wind it up. */
+#define ROC_IMU_FUSION_MAHONY_KP                2.0F    // Proportional gain of the accel error, 2 * Kp of the paper
+#define ROC_IMU_FUSION_MAHONY_KI                0.05F   // Integral gain of the accel error, learns the gyro bias
+#define ROC_IMU_FUSION_MAHONY_INT_MAX           0.035F  // Clamp of the integral feedback, 2 dps in rad/s
+#define ROC_IMU_FUSION_MADGWICK_BETA            0.1F    // Gradient descent step, rad/s
+
+
+typedef enum _ROC_IMU_FUSION_MODE_e
+{
+    ROC_IMU_FUSION_MODE_MAHONY = 0,
+    ROC_IMU_FUSION_MODE_MADGWICK,
+
+    ROC_IMU_FUSION_MODE_NUM,
+
+}ROC_IMU_FUSION_MODE_e;
+
+typedef struct _ROC_IMU_FUSION_s
+{
+    ROC_IMU_FUSION_MODE_e       Mode;
+    float                       Kp;                     // Mahony proportional gain
+    float                       Ki;                     // Mahony integral gain
+    float                       Beta;                   // Madgwick gain
+    float                       Quat[4];                // Unit quaternion W, X, Y, Z
+    float                       IntError[3];            // Mahony integral feedback, rad/s
+    uint8_t                     IsAligned;              // The quaternion is aligned to the gravity
+
+}ROC_IMU_FUSION_s;
+
+
+void RocImuFusionInit(ROC_IMU_FUSION_s *pFusion, ROC_IMU_FUSION_MODE_e Mode);
+void RocImuFusionUpdate(ROC_IMU_FUSION_s *pFusion, const float *pGyro, const float *pAccel, float Dt);
+
+
+#endif
+
@@ -5,12 +5,66 @@
  * Liren         2019/04/15      1.0
 ********************************************************************************/
 
+#include <string.h>
+#include <math.h>
+
 #include "i2c.h"
+#include "gpio.h"
 
 #include "RocLog.h"
+#include "RocAt24c02.h"
 #include "RocMpu6050.h"
 
 
+typedef struct _ROC_MPU6050_STREAM_s
+{
+    uint8_t                     Packet[ROC_MPU6050_PACKET_MAX_LEN * ROC_MPU6050_BURST_MAX_NUM];   // DMA buffer
+    uint16_t                    PacketLen;              // DMP packet length of the enabled features, or the raw one
+    volatile uint8_t            IsStreaming;
+    volatile uint8_t            IsBusy;                 // A DMA read is running
+    volatile uint8_t            IsResync;               // The FIFO is reset by the task before the next read
+    volatile uint8_t            DeferNum;               // Packets of the INT pulses while the DMA was busy
+    uint8_t                     ReadNum;                // Packets of the DMA read in run
+    uint32_t                    ReadTime;               // INT time of the last packet of the DMA read
+    uint32_t                    DeferTime;              // INT time of the last deferred packet
+    uint32_t                    PeriodMs;               // DMP packet period
+    uint32_t                    StartTime;              // Time of the stream start
+    uint32_t                    YawWinTime;             // Start time of the yaw stable window
+    float                       YawWinAngle;            // Yaw at the window start
+    uint8_t                     IsYawWin;               // The yaw stable window is started
+    uint8_t                     IsYawReported;          // The stable yaw time is logged
+#ifdef ROC_MPU6050_RAW_FUSION
+    ROC_IMU_FUSION_s            Fusion;
+    uint32_t                    FuseTime;               // Time of the last fused sample without the stream
+#endif
+    ROC_MPU6050_SAMPLE_s        Sample[ROC_MPU6050_SAMPLE_BUF_NUM];
+    volatile uint32_t           WriteNum;               // Samples written, the newest one is at WriteNum - 1
+    uint32_t                    GetNum;                 // WriteNum of the last sample got by the task
+    ROC_MPU6050_STREAM_STAT_s   Stat;
+
+}ROC_MPU6050_STREAM_s;
+
+
+typedef struct _ROC_MPU6050_BIAS_s
+{
+    long                        Gyro[3];                // q16 hardware units
+    long                        Accel[3];               // q16 hardware units, without the gravity
+    uint16_t                    Temperature;            // 0.01 C at the calibration
+
+}ROC_MPU6050_BIAS_s;
+
+
+static ROC_MPU6050_STREAM_s     g_Mpu6050Stream = {0};
+static ROC_MPU6050_BIAS_s       g_Mpu6050Bias = {0};
+
+
+#ifdef ROC_MPU6050_RAW_FUSION
+#define ROC_MPU6050_STREAM_REG          ROC_MPU6050_ACCEL_XOUTH_REG
+#else
+#define ROC_MPU6050_STREAM_REG          ROC_MPU6050_FIFO_RW_REG
+#endif
+
+
 /*********************************************************************************
  *  Description:
  *              Write serval data to MPU6050 register
@@ -31,6 +85,13 @@ uint8_t RocMpu6050WriteLen(uint8_t Addr, uint8_t Reg, uint8_t Len, uint8_t *Buf)
 {
     HAL_StatusTypeDef   WriteStatus = HAL_OK;
 
+    if(ROC_TRUE == g_Mpu6050Stream.IsStreaming)
+    {
+        ROC_LOGE("MPU6050 is streaming, the register write is refused!");
+
+        return HAL_BUSY;
+    }
+
     while(HAL_I2C_GetState(&hi2c2) == HAL_I2C_STATE_BUSY_TX);
 
     WriteStatus = HAL_I2C_Mem_Write(&hi2c2, Addr << 1, Reg, I2C_MEMADD_SIZE_8BIT, Buf, Len, 10);
@@ -69,6 +130,13 @@ uint8_t RocMpu6050ReadLen(uint8_t Addr, uint8_t Reg, uint8_t Len, uint8_t *Buf)
 {
     HAL_StatusTypeDef   ReadStatus = HAL_OK;
 
+    if(ROC_TRUE == g_Mpu6050Stream.IsStreaming)
+    {
+        ROC_LOGE("MPU6050 is streaming, the register read is refused!");
+
+        return HAL_BUSY;
+    }
+
     ReadStatus = HAL_I2C_Mem_Read(&hi2c2, Addr << 1, Reg, I2C_MEMADD_SIZE_8BIT, Buf, Len, 10);
     if(HAL_OK != ReadStatus)
     {
@@ -78,6 +146,44 @@ uint8_t RocMpu6050ReadLen(uint8_t Addr, uint8_t Reg, uint8_t Len, uint8_t *Buf)
     return (uint8_t)ReadStatus;
 }
 
+/*********************************************************************************
+ *  Description:
+ *              Read a burst of data from MPU6050 register, it is longer than
+ *              255 bytes for the whole FIFO, the timeout is of the length
+ *
+ *  Parameter:
+ *              Addr: the MPU6050 address
+ *              Reg:  the register of MPU6050
+ *              Len:  the data length
+ *              *Buf: the point to the storage buffer
+ *
+ *  Return:
+ *              The read status
+ *
+ *  Author:
+ *              ROC LiRen(2026.10.17)
+**********************************************************************************/
+uint8_t RocMpu6050ReadBurst(uint8_t Addr, uint8_t Reg, uint16_t Len, uint8_t *Buf)
+{
+    HAL_StatusTypeDef   ReadStatus = HAL_OK;
+
+    if(ROC_TRUE == g_Mpu6050Stream.IsStreaming)
+    {
+        ROC_LOGE("MPU6050 is streaming, the register read is refused!");
+
+        return HAL_BUSY;
+    }
+
+    ReadStatus = HAL_I2C_Mem_Read(&hi2c2, Addr << 1, Reg, I2C_MEMADD_SIZE_8BIT, Buf, Len,
+                                  10 + Len / ROC_MPU6050_BURST_BYTES_PER_MS);
+    if(HAL_OK != ReadStatus)
+    {
+        ROC_LOGE("IIC2 burst read reg is in error(%d)!", ReadStatus);
+    }
+
+    return (uint8_t)ReadStatus;
+}
+
 /*********************************************************************************
  *  Description:
  *              Read MPU6050 register
@@ -96,6 +202,13 @@ uint8_t RocMpu6050WriteByte(uint8_t Reg, uint8_t Dat)
 {
     HAL_StatusTypeDef   WriteStatus = HAL_OK;
 
+    if(ROC_TRUE == g_Mpu6050Stream.IsStreaming)
+    {
+        ROC_LOGE("MPU6050 is streaming, the register write is refused!");
+
+        return HAL_BUSY;
+    }
+
     WriteStatus = HAL_I2C_Mem_Write(&hi2c2, ROC_MPU6050_ADDRESS << 1, Reg, I2C_MEMADD_SIZE_8BIT, &Dat, 1, 10);
     while(HAL_OK != WriteStatus)
     {
@@ -127,9 +240,16 @@ uint8_t RocMpu6050WriteByte(uint8_t Reg, uint8_t Dat)
 **********************************************************************************/
 uint8_t RocMpu6050ReadByte(uint8_t Reg)
 {
-    uint8_t Dat;
+    uint8_t Dat = 0;
     HAL_StatusTypeDef   ReadStatus = HAL_OK;
 
+    if(ROC_TRUE == g_Mpu6050Stream.IsStreaming)
+    {
+        ROC_LOGE("MPU6050 is streaming, the register read is refused!");
+
+        return Dat;
+    }
+
     ReadStatus = HAL_I2C_Mem_Read(&hi2c2, ROC_MPU6050_ADDRESS << 1, Reg, I2C_MEMADD_SIZE_8BIT, &Dat, 1, 10);
     if(HAL_OK != ReadStatus)
     {
@@ -286,12 +406,13 @@ uint8_t RocMpu6050SetRate(uint16_t Rate)
 uint16_t RocMpu6050GetTemperature(void)
 {
     uint8_t     Buf[2];
-    uint16_t    Raw;
+    int16_t     Raw;
     float       Temp;
 
     RocMpu6050ReadLen(ROC_MPU6050_ADDRESS, ROC_MPU6050_TEMP_OUTH_REG, 2, Buf);
 
-    Raw = ((uint16_t)Buf[0] << 8) | Buf[1];
+    /* The raw temperature is signed, it is negative under 36.53 C */
+    Raw = (int16_t)(((uint16_t)Buf[0] << 8) | Buf[1]);
     Temp = 36.53 + ((double)Raw) / 340;
 
     return Temp * 100;
@@ -299,28 +420,52 @@ uint16_t RocMpu6050GetTemperature(void)
 
 /*********************************************************************************
  *  Description:
- *              Get MPU6050 temperature
+ *              Decode the three signed axes of the MPU6050 data registers
  *
  *  Parameter:
+ *              pBuf: the register data, the high byte first
+ *              pAxis: the X, Y, Z axes
+ *
+ *  Return:
  *              None
  *
+ *  Author:
+ *              ROC LiRen(2026.10.17)
+**********************************************************************************/
+static void RocMpu6050AxisDecode(const uint8_t *pBuf, int16_t *pAxis)
+{
+    pAxis[0] = (int16_t)(((uint16_t)pBuf[0] << 8) | pBuf[1]);
+    pAxis[1] = (int16_t)(((uint16_t)pBuf[2] << 8) | pBuf[3]);
+    pAxis[2] = (int16_t)(((uint16_t)pBuf[4] << 8) | pBuf[5]);
+}
+
+/*********************************************************************************
+ *  Description:
+ *              Get MPU6050 gyroscope raw data
+ *
+ *  Parameter:
+ *              *Gx, *Gy, *Gz: the pointer to the signed gyro of the axes
+ *
  *  Return:
- *              The temperature
+ *              The read status
  *
  *  Author:
  *              ROC LiRen(2019.04.15)
 **********************************************************************************/
-uint8_t RocMpu6050GetGyroscope(uint16_t *Gx, uint16_t *Gy, uint16_t *Gz)
+uint8_t RocMpu6050GetGyroscope(int16_t *Gx, int16_t *Gy, int16_t *Gz)
 {
     uint8_t Buf[6];
     uint8_t Res;
+    int16_t Axis[3];
 
     Res=RocMpu6050ReadLen(ROC_MPU6050_ADDRESS, ROC_MPU6050_GYRO_XOUTH_REG, 6, Buf);
     if(Res == 0)
     {
-        *Gx = ((uint16_t)Buf[0] << 8) | Buf[1];
-        *Gy = ((uint16_t)Buf[2] << 8) | Buf[3];
-        *Gz = ((uint16_t)Buf[4] << 8) | Buf[5];
+        RocMpu6050AxisDecode(Buf, Axis);
+
+        *Gx = Axis[0];
+        *Gy = Axis[1];
+        *Gz = Axis[2];
     }
 
     return Res;
@@ -328,60 +473,78 @@ uint8_t RocMpu6050GetGyroscope(uint16_t *Gx, uint16_t *Gy, uint16_t *Gz)
 
 /*********************************************************************************
  *  Description:
- *              Get MPU6050 temperature
+ *              Get MPU6050 accelerometer raw data
  *
  *  Parameter:
- *              None
+ *              *Ax, *Ay, *Az: the pointer to the signed accel of the axes
  *
  *  Return:
- *              The temperature
+ *              The read status
  *
  *  Author:
  *              ROC LiRen(2019.04.15)
 **********************************************************************************/
-uint8_t RocMpu6050GetAccelerometer(uint16_t *Ax, uint16_t *Ay, uint16_t *Az)
+uint8_t RocMpu6050GetAccelerometer(int16_t *Ax, int16_t *Ay, int16_t *Az)
 {
     uint8_t Buf[6];
     uint8_t Res;
+    int16_t Axis[3];
 
     Res = RocMpu6050ReadLen(ROC_MPU6050_ADDRESS, ROC_MPU6050_ACCEL_XOUTH_REG, 6, Buf);
     if(Res == 0)
     {
-        *Ax = ((uint16_t)Buf[0] << 8) | Buf[1];
-        *Ay = ((uint16_t)Buf[2] << 8) | Buf[3];
-        *Az = ((uint16_t)Buf[4] << 8) | Buf[5];
+        RocMpu6050AxisDecode(Buf, Axis);
+
+        *Ax = Axis[0];
+        *Ay = Axis[1];
+        *Az = Axis[2];
     }
 
     return Res;
 }
 
+#ifdef ROC_MPU6050_RAW_FUSION
 /*********************************************************************************
  *  Description:
- *              Get current MPU6050 euler angle
+ *              Fuse one raw sample to the attitude, the quaternion is in q30 as
+ *              the DMP one
  *
  *  Parameter:
- *              *Pitch: the pointer to the pitch axis angle data
- *              *Roll:  the pointer to the roll axis angle data
- *              *Yaw:   the pointer to the Yaw axis angle data
+ *              pGyro: the raw gyro
+ *              pAccel: the raw accel
+ *              Dt: the sample time in s
+ *              pQuat: the q30 quaternion result
  *
  *  Return:
- *              The PCA9685 driver init status
+ *              None
  *
  *  Author:
- *              ROC LiRen(2019.04.15)
+ *              ROC LiRen(2026.10.17)
 **********************************************************************************/
-ROC_RESULT RocMpu6050EulerAngleGet(float *Pitch, float *Roll, float *Yaw)
+static void RocMpu6050RawFuse(const int16_t *pGyro, const int16_t *pAccel, float Dt, long *pQuat)
 {
-    ROC_RESULT Ret = RET_OK;
+    uint8_t     i = 0;
+    float       Gyro[3];
+    float       Accel[3];
+
+    for(i = 0; i < 3; i++)
+    {
+        Gyro[i] = ((float)pGyro[i] - (float)g_Mpu6050Bias.Gyro[i] * ROC_MPU6050_Q16_TO_FLOAT) * ROC_MPU6050_GYRO_TO_RADIAN;
+        Accel[i] = (float)pAccel[i] - (float)g_Mpu6050Bias.Accel[i] * ROC_MPU6050_Q16_TO_FLOAT;
+    }
 
-    Ret = (ROC_RESULT)mpu_dmp_get_data(Pitch, Roll, Yaw);
+    RocImuFusionUpdate(&g_Mpu6050Stream.Fusion, Gyro, Accel, Dt);
 
-    return Ret;
+    for(i = 0; i < 4; i++)
+    {
+        pQuat[i] = (long)(g_Mpu6050Stream.Fusion.Quat[i] * 1073741824.0F);
+    }
 }
+#endif
 
 /*********************************************************************************
  *  Description:
- *              MPU6050 sensor and DMP init
+ *              Block the interrupts which drive the packet stream
  *
  *  Parameter:
  *              None
@@ -390,35 +553,1216 @@ ROC_RESULT RocMpu6050EulerAngleGet(float *Pitch, float *Roll, float *Yaw)
  *              None
  *
  *  Author:
- *              ROC LiRen(2019.04.15)
+ *              ROC LiRen(2026.10.17)
 **********************************************************************************/
-ROC_RESULT RocMpu6050Init(void)
+static void RocMpu6050StreamLock(void)
+{
+    HAL_NVIC_DisableIRQ(ROC_MPU6050_INT_IRQN);
+    HAL_NVIC_DisableIRQ(I2C2_EV_IRQn);
+    HAL_NVIC_DisableIRQ(I2C2_ER_IRQn);
+    HAL_NVIC_DisableIRQ(DMA1_Stream2_IRQn);
+}
+
+/*********************************************************************************
+ *  Description:
+ *              Unblock the interrupts which drive the packet stream
+ *
+ *  Parameter:
+ *              None
+ *
+ *  Return:
+ *              None
+ *
+ *  Author:
+ *              ROC LiRen(2026.10.17)
+**********************************************************************************/
+static void RocMpu6050StreamUnlock(void)
 {
-    ROC_RESULT Ret = RET_OK;
+    HAL_NVIC_EnableIRQ(DMA1_Stream2_IRQn);
+    HAL_NVIC_EnableIRQ(I2C2_ER_IRQn);
+    HAL_NVIC_EnableIRQ(I2C2_EV_IRQn);
+    HAL_NVIC_EnableIRQ(ROC_MPU6050_INT_IRQN);
+}
 
-    Ret = (ROC_RESULT)RocMpu6050RegInit();
-    if(RET_OK !=Ret)
+/*********************************************************************************
+ *  Description:
+ *              Start the DMA read of the DMP packets from the FIFO, the
+ *              deferred packets are read in one burst. The raw fusion reads
+ *              the newest sample of the data registers.
+ *
+ *  Parameter:
+ *              PacketNum: the number of the packets
+ *              IntTime: the INT time of the last packet in ms
+ *
+ *  Return:
+ *              None
+ *
+ *  Author:
+ *              ROC LiRen(2026.10.17)
+**********************************************************************************/
+static void RocMpu6050PacketRead(uint8_t PacketNum, uint32_t IntTime)
+{
+    uint16_t            Len = 0;
+    HAL_StatusTypeDef   ReadStatus = HAL_OK;
+
+    g_Mpu6050Stream.IsBusy = ROC_TRUE;
+    g_Mpu6050Stream.ReadNum = PacketNum;
+    g_Mpu6050Stream.ReadTime = IntTime;
+
+#ifdef ROC_MPU6050_RAW_FUSION
+    /* One raw sample covers the periods of all the packets */
+    Len = g_Mpu6050Stream.PacketLen;
+#else
+    Len = g_Mpu6050Stream.PacketLen * PacketNum;
+#endif
+
+    ReadStatus = HAL_I2C_Mem_Read_DMA(&hi2c2, ROC_MPU6050_ADDRESS << 1, ROC_MPU6050_STREAM_REG, I2C_MEMADD_SIZE_8BIT,
+                                      g_Mpu6050Stream.Packet, Len);
+    if(HAL_OK != ReadStatus)
     {
-        ROC_LOGE("MPU6050 register init is in error!");
-        return ROC_MPU6050_INIT_ERROR;
+        RocMpu6050StreamErrorHandle(HAL_I2C_GetError(&hi2c2));
     }
-    else
+}
+
+/*********************************************************************************
+ *  Description:
+ *              Start to stream the DMP packets, the FIFO is reset and the INT
+ *              pulse of every packet starts the DMA read of it
+ *
+ *  Parameter:
+ *              None
+ *
+ *  Return:
+ *              The stream start status
+ *
+ *  Author:
+ *              ROC LiRen(2026.10.17)
+**********************************************************************************/
+ROC_RESULT RocMpu6050StreamStart(void)
+{
+    uint16_t    PacketLen = 0;
+    uint16_t    Rate = 0;
+
+#ifdef ROC_MPU6050_RAW_FUSION
+    PacketLen = ROC_MPU6050_RAW_PACKET_LEN;
+    Rate = ROC_MPU6050_FUSION_RATE;
+
+    if(HAL_OK != RocMpu6050WriteByte(ROC_MPU6050_INT_EN_REG, ROC_MPU6050_INT_DATA_READY))
     {
-        ROC_LOGI("MPU6050 register init is in success");
+        ROC_LOGE("MPU6050 data ready interrupt setting is in error!");
+
+        return RET_ERROR;
     }
+#else
+    PacketLen = dmp_get_packet_length();
+    if((0 == PacketLen) || (ROC_MPU6050_PACKET_MAX_LEN < PacketLen))
+    {
+        ROC_LOGE("MPU6050 DMP packet length(%u) is out of range!", PacketLen);
 
-    Ret = (ROC_RESULT)mpu_dmp_init();
-    if(RET_OK !=Ret)
+        return RET_ERROR;
+    }
+
+    if((0 != dmp_get_fifo_rate(&Rate)) || (0 == Rate))
     {
-        ROC_LOGE("MPU6050 DMP init is in error!");
-        return ROC_MPU6050_DMP_INIT_ERROR;
+        ROC_LOGE("MPU6050 DMP rate is not set!");
+
+        return RET_ERROR;
     }
-    else
+
+    if((0 != dmp_set_interrupt_mode(DMP_INT_CONTINUOUS)) || (0 != mpu_reset_fifo()))
     {
-        ROC_LOGI("MPU6050 DMP init is in success");
+        ROC_LOGE("MPU6050 DMP interrupt setting is in error!");
+
+        return RET_ERROR;
+    }
+#endif
+
+    RocMpu6050StreamLock();
+
+    memset(&g_Mpu6050Stream, 0, sizeof(g_Mpu6050Stream));
+
+#ifdef ROC_MPU6050_RAW_FUSION
+    RocImuFusionInit(&g_Mpu6050Stream.Fusion, ROC_MPU6050_FUSION_MODE);
+#endif
+
+    g_Mpu6050Stream.PacketLen = PacketLen;
+    g_Mpu6050Stream.PeriodMs = 1000U / Rate;
+    g_Mpu6050Stream.StartTime = HAL_GetTick();
+    g_Mpu6050Stream.Stat.YawStableTime = ROC_MPU6050_YAW_UNSTABLE;
+    g_Mpu6050Stream.IsStreaming = ROC_TRUE;
+
+    __HAL_GPIO_EXTI_CLEAR_IT(ROC_MPU6050_INT_PIN);
+
+    RocMpu6050StreamUnlock();
+
+    ROC_LOGI("MPU6050 stream is started, packet length: %u", PacketLen);
+
+    return RET_OK;
+}
+
+/*********************************************************************************
+ *  Description:
+ *              Stop to stream the DMP packets, the running DMA read is waited,
+ *              then the blocking register access is allowed again
+ *
+ *  Parameter:
+ *              None
+ *
+ *  Return:
+ *              RET_ERROR if the DMA read does not end in time, the stream is
+ *              not stopped
+ *
+ *  Author:
+ *              ROC LiRen(2026.10.17)
+**********************************************************************************/
+ROC_RESULT RocMpu6050StreamStop(void)
+{
+    uint32_t    TickStart = 0;
+
+    HAL_NVIC_DisableIRQ(ROC_MPU6050_INT_IRQN);
+
+    TickStart = HAL_GetTick();
+
+    while(ROC_TRUE == g_Mpu6050Stream.IsBusy)
+    {
+        if(ROC_MPU6050_STREAM_STOP_TIMEOUT < HAL_GetTick() - TickStart)
+        {
+            HAL_NVIC_EnableIRQ(ROC_MPU6050_INT_IRQN);
+
+            ROC_LOGE("MPU6050 DMA read does not end, the stream is not stopped!");
+
+            return RET_ERROR;
+        }
+    }
+
+    g_Mpu6050Stream.IsStreaming = ROC_FALSE;
+    g_Mpu6050Stream.DeferNum = 0;
+
+    HAL_NVIC_EnableIRQ(ROC_MPU6050_INT_IRQN);
+
+    return RET_OK;
+}
+
+/*********************************************************************************
+ *  Description:
+ *              Reset the FIFO after a corrupted packet or an IIC error, the
+ *              packets are aligned to the FIFO again
+ *
+ *  Parameter:
+ *              None
+ *
+ *  Return:
+ *              None
+ *
+ *  Author:
+ *              ROC LiRen(2026.10.17)
+**********************************************************************************/
+static void RocMpu6050StreamResync(void)
+{
+    /* The resync is tried again by the next sample get */
+    if(RET_OK != RocMpu6050StreamStop())
+    {
+        return;
+    }
+
+    g_Mpu6050Stream.IsResync = ROC_FALSE;
+
+#ifndef ROC_MPU6050_RAW_FUSION
+    if(0 != mpu_reset_fifo())
+    {
+        ROC_LOGE("MPU6050 FIFO reset is in error!");
+    }
+#endif
+
+    __HAL_GPIO_EXTI_CLEAR_IT(ROC_MPU6050_INT_PIN);
+
+    g_Mpu6050Stream.IsStreaming = ROC_TRUE;
+}
+
+/*********************************************************************************
+ *  Description:
+ *              Get the newest sample of the stream, it never waits on the IIC
+ *
+ *  Parameter:
+ *              pSample: the pointer to the sample result
+ *
+ *  Return:
+ *              RET_OK if a new sample is got since the last call, else the
+ *              sample is not changed
+ *
+ *  Author:
+ *              ROC LiRen(2026.10.17)
+**********************************************************************************/
+ROC_RESULT RocMpu6050SampleLatestGet(ROC_MPU6050_SAMPLE_s *pSample)
+{
+    ROC_RESULT  Ret = RET_ERROR;
+
+    if(ROC_TRUE == g_Mpu6050Stream.IsResync)
+    {
+        RocMpu6050StreamResync();
+    }
+
+    RocMpu6050StreamLock();
+
+    if(g_Mpu6050Stream.GetNum != g_Mpu6050Stream.WriteNum)
+    {
+        if(1U < g_Mpu6050Stream.WriteNum - g_Mpu6050Stream.GetNum)
+        {
+            g_Mpu6050Stream.Stat.LostNum += g_Mpu6050Stream.WriteNum - g_Mpu6050Stream.GetNum - 1U;
+        }
+
+        *pSample = g_Mpu6050Stream.Sample[(g_Mpu6050Stream.WriteNum - 1U) & (ROC_MPU6050_SAMPLE_BUF_NUM - 1U)];
+        g_Mpu6050Stream.GetNum = g_Mpu6050Stream.WriteNum;
+
+        Ret = RET_OK;
+    }
+
+    RocMpu6050StreamUnlock();
+
+    return Ret;
+}
+
+/*********************************************************************************
+ *  Description:
+ *              Get all the samples since the last call, the oldest first. The
+ *              samples of the ring buffer are got while streaming, else all the
+ *              packets of the FIFO are drained in one IIC burst.
+ *
+ *  Parameter:
+ *              pSample: the pointer to the sample array
+ *              MaxNum: the max number of the samples
+ *              pNum: the number of the samples got
+ *
+ *  Return:
+ *              The sample get status
+ *
+ *  Author:
+ *              ROC LiRen(2026.10.17)
+**********************************************************************************/
+ROC_RESULT RocMpu6050SampleBatchGet(ROC_MPU6050_SAMPLE_s *pSample, uint16_t MaxNum, uint16_t *pNum)
+{
+    uint16_t                i = 0;
+    uint16_t                More = 0;
+    uint32_t                Num = 0;
+    ROC_RESULT              Ret = RET_OK;
+    static struct dmp_sample_s  DmpSample[ROC_MPU6050_BATCH_MAX_NUM];
+
+    *pNum = 0;
+
+    if(ROC_TRUE != g_Mpu6050Stream.IsStreaming)
+    {
+        if(ROC_MPU6050_BATCH_MAX_NUM < MaxNum)
+        {
+            MaxNum = ROC_MPU6050_BATCH_MAX_NUM;
+        }
+
+        Ret = (0 == dmp_read_fifo_batch(DmpSample, MaxNum, pNum, &More)) ? RET_OK : RET_ERROR;
+
+        for(i = 0; i < *pNum; i++)
+        {
+            memcpy(pSample[i].Quat, DmpSample[i].quat, sizeof(pSample[i].Quat));
+            memcpy(pSample[i].Gyro, DmpSample[i].gyro, sizeof(pSample[i].Gyro));
+            memcpy(pSample[i].Accel, DmpSample[i].accel, sizeof(pSample[i].Accel));
+            pSample[i].TimeStamp = (uint32_t)DmpSample[i].timestamp;
+        }
+
+        return Ret;
+    }
+
+    if(ROC_TRUE == g_Mpu6050Stream.IsResync)
+    {
+        RocMpu6050StreamResync();
+    }
+
+    RocMpu6050StreamLock();
+
+    Num = g_Mpu6050Stream.WriteNum - g_Mpu6050Stream.GetNum;
+
+    if(ROC_MPU6050_SAMPLE_BUF_NUM < Num)
+    {
+        g_Mpu6050Stream.Stat.LostNum += Num - ROC_MPU6050_SAMPLE_BUF_NUM;
+        g_Mpu6050Stream.GetNum = g_Mpu6050Stream.WriteNum - ROC_MPU6050_SAMPLE_BUF_NUM;
+        Num = ROC_MPU6050_SAMPLE_BUF_NUM;
+    }
+
+    if(MaxNum < Num)
+    {
+        Num = MaxNum;
+    }
+
+    for(i = 0; i < Num; i++)
+    {
+        pSample[i] = g_Mpu6050Stream.Sample[g_Mpu6050Stream.GetNum & (ROC_MPU6050_SAMPLE_BUF_NUM - 1U)];
+        g_Mpu6050Stream.GetNum++;
+    }
+
+    RocMpu6050StreamUnlock();
+
+    *pNum = (uint16_t)Num;
+
+    return RET_OK;
+}
+
+/*********************************************************************************
+ *  Description:
+ *              Get the statistics of the packet stream
+ *
+ *  Parameter:
+ *              pStat: the pointer to the statistics result
+ *
+ *  Return:
+ *              None
+ *
+ *  Author:
+ *              ROC LiRen(2026.10.17)
+**********************************************************************************/
+void RocMpu6050StreamStatGet(ROC_MPU6050_STREAM_STAT_s *pStat)
+{
+    RocMpu6050StreamLock();
+
+    memcpy(pStat, &g_Mpu6050Stream.Stat, sizeof(ROC_MPU6050_STREAM_STAT_s));
+
+    RocMpu6050StreamUnlock();
+}
+
+/*********************************************************************************
+ *  Description:
+ *              The DMA read is in error, the FIFO is reset by the task
+ *
+ *  Parameter:
+ *              ErrorCode: the HAL IIC error code
+ *
+ *  Return:
+ *              None
+ *
+ *  Author:
+ *              ROC LiRen(2026.10.17)
+**********************************************************************************/
+void RocMpu6050StreamErrorHandle(uint32_t ErrorCode)
+{
+    g_Mpu6050Stream.Stat.ErrorNum++;
+    g_Mpu6050Stream.Stat.ErrorCode = ErrorCode;
+
+    g_Mpu6050Stream.IsResync = ROC_TRUE;
+    g_Mpu6050Stream.DeferNum = 0;
+    g_Mpu6050Stream.IsBusy = ROC_FALSE;
+}
+
+/*********************************************************************************
+ *  Description:
+ *              The INT pulse of a DMP packet, start the DMA read of it, or read
+ *              it just after the running one
+ *
+ *  Parameter:
+ *              GPIO_Pin: the EXTI pin
+ *
+ *  Return:
+ *              None
+ *
+ *  Author:
+ *              ROC LiRen(2026.10.17)
+**********************************************************************************/
+void HAL_GPIO_EXTI_Callback(uint16_t GPIO_Pin)
+{
+    uint32_t    IntTime = 0;
+
+    if((ROC_MPU6050_INT_PIN != GPIO_Pin) || (ROC_TRUE != g_Mpu6050Stream.IsStreaming)
+        || (ROC_TRUE == g_Mpu6050Stream.IsResync))
+    {
+        return;
+    }
+
+    IntTime = HAL_GetTick();
+
+    g_Mpu6050Stream.Stat.IntNum++;
+
+    if(ROC_TRUE == g_Mpu6050Stream.IsBusy)
+    {
+        g_Mpu6050Stream.Stat.DeferNum++;
+        g_Mpu6050Stream.DeferNum++;
+        g_Mpu6050Stream.DeferTime = IntTime;
+
+        return;
+    }
+
+    RocMpu6050PacketRead(1, IntTime);
+}
+
+/*********************************************************************************
+ *  Description:
+ *              Check the yaw of the new sample is stable, the yaw must move less
+ *              than ROC_MPU6050_YAW_STABLE_DRIFT over the window. The check stops
+ *              after the first stable window, the robot is still at the boot.
+ *
+ *  Parameter:
+ *              pSample: the pointer to the new sample
+ *
+ *  Return:
+ *              None
+ *
+ *  Author:
+ *              ROC LiRen(2026.10.17)
+**********************************************************************************/
+static void RocMpu6050YawStableCheck(const ROC_MPU6050_SAMPLE_s *pSample)
+{
+    uint8_t     i = 0;
+    float       Pitch = 0;
+    float       Roll = 0;
+    float       Yaw = 0;
+    float       Drift = 0;
+    float       Quat[4];
+
+    if(ROC_MPU6050_YAW_UNSTABLE != g_Mpu6050Stream.Stat.YawStableTime)
+    {
+        return;
+    }
+
+    for(i = 0; i < 4; i++)
+    {
+        Quat[i] = (float)pSample->Quat[i] * ROC_MPU6050_Q30_TO_FLOAT;
+    }
+
+    RocMpu6050QuatToEuler(Quat, &Pitch, &Roll, &Yaw);
+
+    Drift = Yaw - g_Mpu6050Stream.YawWinAngle;
+    if(180.0F < Drift)
+    {
+        Drift -= 360.0F;
+    }
+    else if(-180.0F > Drift)
+    {
+        Drift += 360.0F;
+    }
+
+    if((ROC_TRUE != g_Mpu6050Stream.IsYawWin) || (ROC_MPU6050_YAW_STABLE_DRIFT < fabsf(Drift)))
+    {
+        /* The window restarts at this sample */
+        g_Mpu6050Stream.IsYawWin = ROC_TRUE;
+        g_Mpu6050Stream.YawWinAngle = Yaw;
+        g_Mpu6050Stream.YawWinTime = pSample->TimeStamp;
+
+        return;
+    }
+
+    if(ROC_MPU6050_YAW_STABLE_WINDOW <= pSample->TimeStamp - g_Mpu6050Stream.YawWinTime)
+    {
+        g_Mpu6050Stream.Stat.YawStableTime = g_Mpu6050Stream.YawWinTime - g_Mpu6050Stream.StartTime;
+    }
+}
+
+/*********************************************************************************
+ *  Description:
+ *              Log the time to the stable yaw once, it is in the task
+ *
+ *  Parameter:
+ *              None
+ *
+ *  Return:
+ *              None
+ *
+ *  Author:
+ *              ROC LiRen(2026.10.17)
+**********************************************************************************/
+static void RocMpu6050YawStableReport(void)
+{
+    uint32_t    StableTime = 0;
+
+    StableTime = g_Mpu6050Stream.Stat.YawStableTime;
+
+    if((ROC_TRUE == g_Mpu6050Stream.IsYawReported) || (ROC_MPU6050_YAW_UNSTABLE == StableTime))
+    {
+        return;
+    }
+
+    g_Mpu6050Stream.IsYawReported = ROC_TRUE;
+
+    ROC_LOGI("MPU6050 yaw is stable %u ms after the stream start, %u ms after the boot",
+             StableTime, g_Mpu6050Stream.StartTime + StableTime);
+}
+
+#ifdef ROC_MPU6050_RAW_FUSION
+/*********************************************************************************
+ *  Description:
+ *              Decode the raw sample of the DMA read and fuse it to the ring
+ *              buffer
+ *
+ *  Parameter:
+ *              None
+ *
+ *  Return:
+ *              RET_OK, the raw sample has no check
+ *
+ *  Author:
+ *              ROC LiRen(2026.10.17)
+**********************************************************************************/
+static ROC_RESULT RocMpu6050PacketDecode(void)
+{
+    ROC_MPU6050_SAMPLE_s    *pSample = NULL;
+
+    pSample = &g_Mpu6050Stream.Sample[g_Mpu6050Stream.WriteNum & (ROC_MPU6050_SAMPLE_BUF_NUM - 1U)];
+
+    RocMpu6050AxisDecode(g_Mpu6050Stream.Packet, pSample->Accel);
+    RocMpu6050AxisDecode(g_Mpu6050Stream.Packet + ROC_MPU6050_RAW_GYRO_OFFSET, pSample->Gyro);
+
+    RocMpu6050RawFuse(pSample->Gyro, pSample->Accel,
+                      (float)g_Mpu6050Stream.ReadNum / (float)ROC_MPU6050_FUSION_RATE, pSample->Quat);
+
+    pSample->TimeStamp = g_Mpu6050Stream.ReadTime;
+
+    RocMpu6050YawStableCheck(pSample);
+
+    g_Mpu6050Stream.WriteNum++;
+    g_Mpu6050Stream.Stat.SampleNum++;
+
+    return RET_OK;
+}
+#else
+/*********************************************************************************
+ *  Description:
+ *              Decode the DMP packets of the DMA read to the ring buffer
+ *
+ *  Parameter:
+ *              None
+ *
+ *  Return:
+ *              RET_ERROR if a packet is corrupted, the packets before it are
+ *              kept
+ *
+ *  Author:
+ *              ROC LiRen(2026.10.17)
+**********************************************************************************/
+static ROC_RESULT RocMpu6050PacketDecode(void)
+{
+    uint8_t                 i = 0;
+    short                   Sensors = 0;
+    ROC_MPU6050_SAMPLE_s    *pSample = NULL;
+
+    for(i = 0; i < g_Mpu6050Stream.ReadNum; i++)
+    {
+        pSample = &g_Mpu6050Stream.Sample[g_Mpu6050Stream.WriteNum & (ROC_MPU6050_SAMPLE_BUF_NUM - 1U)];
+
+        if(0 != dmp_decode_fifo_packet(g_Mpu6050Stream.Packet + i * g_Mpu6050Stream.PacketLen,
+                                       pSample->Gyro, pSample->Accel, pSample->Quat, &Sensors))
+        {
+            return RET_ERROR;
+        }
+
+        /* The packets of a burst are one DMP period apart */
+        pSample->TimeStamp = g_Mpu6050Stream.ReadTime - (g_Mpu6050Stream.ReadNum - 1U - i) * g_Mpu6050Stream.PeriodMs;
+
+        RocMpu6050YawStableCheck(pSample);
+
+        g_Mpu6050Stream.WriteNum++;
+        g_Mpu6050Stream.Stat.SampleNum++;
+    }
+
+    return RET_OK;
+}
+#endif
+
+/*********************************************************************************
+ *  Description:
+ *              The DMA read of the DMP packets is finished, decode them to the
+ *              ring buffer and read the deferred packets in one burst, called
+ *              by the IIC2 read complete callback
+ *
+ *  Parameter:
+ *              None
+ *
+ *  Return:
+ *              None
+ *
+ *  Author:
+ *              ROC LiRen(2026.10.17)
+**********************************************************************************/
+void RocMpu6050StreamReadCplt(void)
+{
+    uint8_t                 PacketNum = 0;
+
+    if(RET_OK != RocMpu6050PacketDecode())
+    {
+        g_Mpu6050Stream.Stat.CorruptNum++;
+        g_Mpu6050Stream.IsResync = ROC_TRUE;
+        g_Mpu6050Stream.DeferNum = 0;
+        g_Mpu6050Stream.IsBusy = ROC_FALSE;
+
+        return;
+    }
+
+    if(0 != g_Mpu6050Stream.DeferNum)
+    {
+        PacketNum = g_Mpu6050Stream.DeferNum;
+
+        if(ROC_MPU6050_BURST_MAX_NUM < PacketNum)
+        {
+            PacketNum = ROC_MPU6050_BURST_MAX_NUM;
+        }
+
+        g_Mpu6050Stream.DeferNum -= PacketNum;
+
+        RocMpu6050PacketRead(PacketNum, g_Mpu6050Stream.DeferTime - g_Mpu6050Stream.DeferNum * g_Mpu6050Stream.PeriodMs);
+
+        return;
+    }
+
+    g_Mpu6050Stream.IsBusy = ROC_FALSE;
+}
+
+#ifdef ROC_MPU6050_SAMPLE_LOG
+/*********************************************************************************
+ *  Description:
+ *              Log all the samples of the stream since the last call
+ *
+ *  Parameter:
+ *              pSample: the pointer to the newest sample
+ *
+ *  Return:
+ *              RET_OK if a new sample is got
+ *
+ *  Author:
+ *              ROC LiRen(2026.10.17)
+**********************************************************************************/
+static ROC_RESULT RocMpu6050SampleLog(ROC_MPU6050_SAMPLE_s *pSample)
+{
+    uint16_t                i = 0;
+    uint16_t                Num = 0;
+    ROC_MPU6050_SAMPLE_s    Sample[ROC_MPU6050_SAMPLE_BUF_NUM];
+
+    RocMpu6050SampleBatchGet(Sample, ROC_MPU6050_SAMPLE_BUF_NUM, &Num);
+
+    for(i = 0; i < Num; i++)
+    {
+        ROC_LOGN("IMU: %u %d %d %d %d %d %d %ld %ld %ld %ld", Sample[i].TimeStamp,
+                 Sample[i].Gyro[0], Sample[i].Gyro[1], Sample[i].Gyro[2],
+                 Sample[i].Accel[0], Sample[i].Accel[1], Sample[i].Accel[2],
+                 Sample[i].Quat[0], Sample[i].Quat[1], Sample[i].Quat[2], Sample[i].Quat[3]);
+    }
+
+    if(0 == Num)
+    {
+        return RET_ERROR;
+    }
+
+    *pSample = Sample[Num - 1];
+
+    return RET_OK;
+}
+#endif
+
+/*********************************************************************************
+ *  Description:
+ *              Get current MPU6050 attitude quaternion, it is the newest sample
+ *              of the stream, or the blocking FIFO read before the stream starts.
+ *              There is no trigonometry on the sample path.
+ *
+ *  Parameter:
+ *              *pQuat: the pointer to the unit quaternion W, X, Y, Z
+ *
+ *  Return:
+ *              RET_OK if a new sample is got
+ *
+ *  Author:
+ *              ROC LiRen(2026.10.17)
+**********************************************************************************/
+ROC_RESULT RocMpu6050QuatGet(float *pQuat)
+{
+    uint8_t                 i = 0;
+#ifndef ROC_MPU6050_RAW_FUSION
+    unsigned char           More = 0;
+    short                   Sensors = 0;
+#endif
+    unsigned long           TimeStamp = 0;
+    ROC_RESULT              Ret = RET_OK;
+    ROC_MPU6050_SAMPLE_s    Sample;
+
+    if(ROC_TRUE == g_Mpu6050Stream.IsStreaming)
+    {
+#ifdef ROC_MPU6050_SAMPLE_LOG
+        Ret = RocMpu6050SampleLog(&Sample);
+#else
+        Ret = RocMpu6050SampleLatestGet(&Sample);
+#endif
+
+        RocMpu6050YawStableReport();
+    }
+#ifdef ROC_MPU6050_RAW_FUSION
+    else if((0 != RocMpu6050GetGyroscope(&Sample.Gyro[0], &Sample.Gyro[1], &Sample.Gyro[2]))
+            || (0 != RocMpu6050GetAccelerometer(&Sample.Accel[0], &Sample.Accel[1], &Sample.Accel[2])))
+    {
+        Ret = RET_ERROR;
+    }
+    else
+    {
+        /* The blocking read is polled, the sample time is of the ticks */
+        TimeStamp = HAL_GetTick();
+        RocMpu6050RawFuse(Sample.Gyro, Sample.Accel, (float)(TimeStamp - g_Mpu6050Stream.FuseTime) * 0.001F, Sample.Quat);
+        g_Mpu6050Stream.FuseTime = TimeStamp;
+    }
+#else
+    else if((0 != dmp_read_fifo(Sample.Gyro, Sample.Accel, Sample.Quat, &TimeStamp, &Sensors, &More))
+            || (0 == (Sensors & INV_WXYZ_QUAT)))
+    {
+        Ret = RET_ERROR;
+    }
+#endif
+
+    if(RET_OK == Ret)
+    {
+        for(i = 0; i < 4; i++)
+        {
+            pQuat[i] = (float)Sample.Quat[i] * ROC_MPU6050_Q30_TO_FLOAT;
+        }
+    }
+
+    return Ret;
+}
+
+/*********************************************************************************
+ *  Description:
+ *              Convert the attitude quaternion to euler angle, it is only for
+ *              the display and the report, the control uses the quaternion
+ *
+ *  Parameter:
+ *              *pQuat: the pointer to the unit quaternion W, X, Y, Z
+ *              *Pitch: the pointer to the pitch axis angle data
+ *              *Roll:  the pointer to the roll axis angle data
+ *              *Yaw:   the pointer to the Yaw axis angle data
+ *
+ *  Return:
+ *              None
+ *
+ *  Author:
+ *              ROC LiRen(2026.10.17)
+**********************************************************************************/
+void RocMpu6050QuatToEuler(const float *pQuat, float *Pitch, float *Roll, float *Yaw)
+{
+    float   Sp = 0;
+
+    Sp = 2.0F * (pQuat[0] * pQuat[2] - pQuat[1] * pQuat[3]);
+
+    /* The quaternion is not exactly unit after the q30 rounding */
+    if(1.0F < Sp)
+    {
+        Sp = 1.0F;
+    }
+    else if(-1.0F > Sp)
+    {
+        Sp = -1.0F;
+    }
+
+    *Pitch = asinf(Sp) * ROC_MPU6050_RADIAN_TO_ANGLE;
+    *Roll = atan2f(2.0F * (pQuat[2] * pQuat[3] + pQuat[0] * pQuat[1]),
+                   1.0F - 2.0F * (pQuat[1] * pQuat[1] + pQuat[2] * pQuat[2])) * ROC_MPU6050_RADIAN_TO_ANGLE;
+    *Yaw = atan2f(2.0F * (pQuat[1] * pQuat[2] + pQuat[0] * pQuat[3]),
+                  1.0F - 2.0F * (pQuat[2] * pQuat[2] + pQuat[3] * pQuat[3])) * ROC_MPU6050_RADIAN_TO_ANGLE;
+}
+
+/*********************************************************************************
+ *  Description:
+ *              Get current MPU6050 euler angle, it is the newest sample of
+ *              the stream, or the blocking FIFO read before the stream starts
+ *
+ *  Parameter:
+ *              *Pitch: the pointer to the pitch axis angle data
+ *              *Roll:  the pointer to the roll axis angle data
+ *              *Yaw:   the pointer to the Yaw axis angle data
+ *
+ *  Return:
+ *              RET_OK if a new sample is got
+ *
+ *  Author:
+ *              ROC LiRen(2019.04.15)
+**********************************************************************************/
+ROC_RESULT RocMpu6050EulerAngleGet(float *Pitch, float *Roll, float *Yaw)
+{
+    ROC_RESULT  Ret = RET_OK;
+    float       Quat[4];
+
+    Ret = RocMpu6050QuatGet(Quat);
+    if(RET_OK == Ret)
+    {
+        RocMpu6050QuatToEuler(Quat, Pitch, Roll, Yaw);
+    }
+
+    return Ret;
+}
+
+/*********************************************************************************
+ *  Description:
+ *              Measure the gyro and accel biases by the average of the raw
+ *              samples, the robot stands still and level, the Z axis is up or
+ *              down. The biases are kept only if the gyro is still.
+ *
+ *  Parameter:
+ *              pBias: the pointer to the bias result
+ *
+ *  Return:
+ *              RET_ERROR if the read is in error or the robot moves
+ *
+ *  Author:
+ *              ROC LiRen(2026.10.17)
+**********************************************************************************/
+static ROC_RESULT RocMpu6050BiasMeasure(ROC_MPU6050_BIAS_s *pBias)
+{
+    uint16_t    i = 0;
+    uint8_t     j = 0;
+    int16_t     Gyro[3];
+    int16_t     Accel[3];
+    int16_t     GyroMin[3] = {0};
+    int16_t     GyroMax[3] = {0};
+    int32_t     GyroSum[3] = {0};
+    int32_t     AccelSum[3] = {0};
+
+    for(i = 0; i < ROC_MPU6050_BIAS_SAMPLE_NUM; i++)
+    {
+        HAL_Delay(ROC_MPU6050_BIAS_SAMPLE_MS);
+
+        if((0 != RocMpu6050GetGyroscope(&Gyro[0], &Gyro[1], &Gyro[2]))
+            || (0 != RocMpu6050GetAccelerometer(&Accel[0], &Accel[1], &Accel[2])))
+        {
+            ROC_LOGE("MPU6050 bias sample read is in error!");
+
+            return RET_ERROR;
+        }
+
+        for(j = 0; j < 3; j++)
+        {
+            GyroSum[j] += Gyro[j];
+            AccelSum[j] += Accel[j];
+
+            if((0 == i) || (GyroMin[j] > Gyro[j]))
+            {
+                GyroMin[j] = Gyro[j];
+            }
+
+            if((0 == i) || (GyroMax[j] < Gyro[j]))
+            {
+                GyroMax[j] = Gyro[j];
+            }
+        }
+    }
+
+    for(j = 0; j < 3; j++)
+    {
+        if(ROC_MPU6050_BIAS_STILL_RANGE < GyroMax[j] - GyroMin[j])
+        {
+            ROC_LOGW("MPU6050 gyro(%d) swings %d, the robot is not still!", j, GyroMax[j] - GyroMin[j]);
+
+            return RET_ERROR;
+        }
+    }
+
+    /* The gravity is not the bias, as the self test of eMPL */
+    if(0 < AccelSum[2])
+    {
+        AccelSum[2] -= (int32_t)ROC_MPU6050_ACCEL_1G * ROC_MPU6050_BIAS_SAMPLE_NUM;
+    }
+    else
+    {
+        AccelSum[2] += (int32_t)ROC_MPU6050_ACCEL_1G * ROC_MPU6050_BIAS_SAMPLE_NUM;
+    }
+
+    /* The offset over the sensor spec is the tilt, it is not removed */
+    for(j = 0; j < 3; j++)
+    {
+        if(((int32_t)ROC_MPU6050_BIAS_ACCEL_MAX * (int32_t)ROC_MPU6050_BIAS_SAMPLE_NUM < AccelSum[j])
+            || (-(int32_t)ROC_MPU6050_BIAS_ACCEL_MAX * (int32_t)ROC_MPU6050_BIAS_SAMPLE_NUM > AccelSum[j]))
+        {
+            ROC_LOGW("MPU6050 accel(%d) offset %ld is out of range, the robot is not level!",
+                     j, (long)(AccelSum[j] / (int32_t)ROC_MPU6050_BIAS_SAMPLE_NUM));
+
+            memset(AccelSum, 0, sizeof(AccelSum));
+
+            break;
+        }
+    }
+
+    for(j = 0; j < 3; j++)
+    {
+        pBias->Gyro[j] = (long)((int64_t)GyroSum[j] * 65536 / (int32_t)ROC_MPU6050_BIAS_SAMPLE_NUM);
+        pBias->Accel[j] = (long)((int64_t)AccelSum[j] * 65536 / (int32_t)ROC_MPU6050_BIAS_SAMPLE_NUM);
+    }
+
+    pBias->Temperature = RocMpu6050GetTemperature();
+
+    return RET_OK;
+}
+
+/*********************************************************************************
+ *  Description:
+ *              Load the biases from the AT24C02, the biases of another
+ *              temperature are stale
+ *
+ *  Parameter:
+ *              None
+ *
+ *  Return:
+ *              RET_ERROR if the record is invalid or stale
+ *
+ *  Author:
+ *              ROC LiRen(2026.10.17)
+**********************************************************************************/
+static ROC_RESULT RocMpu6050BiasLoad(void)
+{
+    uint8_t             i = 0;
+    uint8_t             j = 0;
+    uint16_t            Crc = 0;
+    uint16_t            Temp = 0;
+    uint16_t            TempDiff = 0;
+    uint32_t            Gyro = 0;
+    uint32_t            Accel = 0;
+    uint8_t             Record[ROC_MPU6050_BIAS_LEN];
+    ROC_MPU6050_BIAS_s  Bias;
+
+    if(RET_OK != RocAt24c02Read(ROC_MPU6050_BIAS_EEPROM_ADDR, Record, ROC_MPU6050_BIAS_LEN))
+    {
+        return RET_ERROR;
+    }
+
+    if(ROC_MPU6050_BIAS_VERSION != Record[ROC_MPU6050_BIAS_VERSION_BYTE])
+    {
+        ROC_LOGW("MPU6050 bias record version(%d) is not supported!", Record[ROC_MPU6050_BIAS_VERSION_BYTE]);
+
+        return RET_ERROR;
+    }
+
+    Crc = (uint16_t)(Record[ROC_MPU6050_BIAS_CRC_BYTE] | (Record[ROC_MPU6050_BIAS_CRC_BYTE + 1] << 8));
+
+    if(Crc != RocAt24c02Crc16(Record, ROC_MPU6050_BIAS_CRC_BYTE))
+    {
+        ROC_LOGW("MPU6050 bias record CRC(0x%04X) is in error!", Crc);
+
+        return RET_ERROR;
+    }
+
+    Bias.Temperature = (uint16_t)(Record[ROC_MPU6050_BIAS_TEMP_BYTE] | (Record[ROC_MPU6050_BIAS_TEMP_BYTE + 1] << 8));
+
+    for(i = 0; i < 3; i++)
+    {
+        Gyro = 0;
+        Accel = 0;
+
+        for(j = 0; j < 4; j++)
+        {
+            Gyro |= (uint32_t)Record[ROC_MPU6050_BIAS_GYRO_BYTE + 4 * i + j] << (8 * j);
+            Accel |= (uint32_t)Record[ROC_MPU6050_BIAS_ACCEL_BYTE + 4 * i + j] << (8 * j);
+        }
+
+        Bias.Gyro[i] = (long)(int32_t)Gyro;
+        Bias.Accel[i] = (long)(int32_t)Accel;
+    }
+
+    /* The gyro bias follows the temperature */
+    Temp = RocMpu6050GetTemperature();
+    TempDiff = (Temp > Bias.Temperature) ? (Temp - Bias.Temperature) : (Bias.Temperature - Temp);
+
+    if(ROC_MPU6050_BIAS_TEMP_DIFF < TempDiff)
+    {
+        ROC_LOGW("MPU6050 biases of %u.%02u C are stale at %u.%02u C!",
+                 Bias.Temperature / 100U, Bias.Temperature % 100U, Temp / 100U, Temp % 100U);
+
+        return RET_ERROR;
+    }
+
+    g_Mpu6050Bias = Bias;
+
+    return RET_OK;
+}
+
+/*********************************************************************************
+ *  Description:
+ *              Save the biases to the AT24C02
+ *
+ *  Parameter:
+ *              None
+ *
+ *  Return:
+ *              RET_ERROR if the write is in error
+ *
+ *  Author:
+ *              ROC LiRen(2026.10.17)
+**********************************************************************************/
+static ROC_RESULT RocMpu6050BiasSave(void)
+{
+    uint8_t     i = 0;
+    uint8_t     j = 0;
+    uint16_t    Crc = 0;
+    uint8_t     Record[ROC_MPU6050_BIAS_LEN] = {0};
+
+    Record[ROC_MPU6050_BIAS_VERSION_BYTE] = ROC_MPU6050_BIAS_VERSION;
+    Record[ROC_MPU6050_BIAS_TEMP_BYTE] = (uint8_t)g_Mpu6050Bias.Temperature;
+    Record[ROC_MPU6050_BIAS_TEMP_BYTE + 1] = (uint8_t)(g_Mpu6050Bias.Temperature >> 8);
+
+    for(i = 0; i < 3; i++)
+    {
+        for(j = 0; j < 4; j++)
+        {
+            Record[ROC_MPU6050_BIAS_GYRO_BYTE + 4 * i + j] = (uint8_t)((uint32_t)g_Mpu6050Bias.Gyro[i] >> (8 * j));
+            Record[ROC_MPU6050_BIAS_ACCEL_BYTE + 4 * i + j] = (uint8_t)((uint32_t)g_Mpu6050Bias.Accel[i] >> (8 * j));
+        }
+    }
+
+    Crc = RocAt24c02Crc16(Record, ROC_MPU6050_BIAS_CRC_BYTE);
+
+    Record[ROC_MPU6050_BIAS_CRC_BYTE] = (uint8_t)Crc;
+    Record[ROC_MPU6050_BIAS_CRC_BYTE + 1] = (uint8_t)(Crc >> 8);
+
+    return RocAt24c02Write(ROC_MPU6050_BIAS_EEPROM_ADDR, Record, ROC_MPU6050_BIAS_LEN);
+}
+
+/*********************************************************************************
+ *  Description:
+ *              Calibrate the gyro and accel biases while the robot stands still,
+ *              push them to the DMP and save them for the next boot. The stream
+ *              is stopped during the calibration, about 1 s.
+ *
+ *  Parameter:
+ *              None
+ *
+ *  Return:
+ *              RET_ERROR if the robot moves or the biases are not pushed, the
+ *              biases in use are not changed
+ *
+ *  Author:
+ *              ROC LiRen(2026.10.17)
+**********************************************************************************/
+ROC_RESULT RocMpu6050BiasCalibrate(void)
+{
+    ROC_RESULT          Ret = RET_OK;
+    uint8_t             IsStreaming = ROC_FALSE;
+    ROC_MPU6050_BIAS_s  Bias;
+
+    IsStreaming = g_Mpu6050Stream.IsStreaming;
+    if((ROC_TRUE == IsStreaming) && (RET_OK != RocMpu6050StreamStop()))
+    {
+        return RET_ERROR;
+    }
+
+    Ret = RocMpu6050BiasMeasure(&Bias);
+
+#ifndef ROC_MPU6050_RAW_FUSION
+    if((RET_OK == Ret) && ((0 != dmp_set_gyro_bias(Bias.Gyro)) || (0 != dmp_set_accel_bias(Bias.Accel))))
+    {
+        ROC_LOGE("MPU6050 DMP bias setting is in error!");
+
+        Ret = RET_ERROR;
+    }
+#endif
+
+    if(RET_OK == Ret)
+    {
+        g_Mpu6050Bias = Bias;
+
+        ROC_LOGI("MPU6050 bias gyro: %ld %ld %ld accel: %ld %ld %ld (q16) at %u.%02u C",
+                 Bias.Gyro[0], Bias.Gyro[1], Bias.Gyro[2], Bias.Accel[0], Bias.Accel[1], Bias.Accel[2],
+                 Bias.Temperature / 100U, Bias.Temperature % 100U);
+
+        if(RET_OK != RocMpu6050BiasSave())
+        {
+            ROC_LOGW("MPU6050 biases are not saved, the next boot calibrates again!");
+        }
+    }
+
+    if((ROC_TRUE == IsStreaming) && (RET_OK != RocMpu6050StreamStart()))
+    {
+        Ret = RET_ERROR;
+    }
+
+    return Ret;
+}
+
+/*********************************************************************************
+ *  Description:
+ *              MPU6050 sensor and DMP init
+ *
+ *  Parameter:
+ *              None
+ *
+ *  Return:
+ *              None
+ *
+ *  Author:
+ *              ROC LiRen(2019.04.15)
+**********************************************************************************/
+ROC_RESULT RocMpu6050Init(void)
+{
+    ROC_RESULT  Ret = RET_OK;
+    uint8_t     IsWarm = ROC_FALSE;
+    uint32_t    InitTime = 0;
+    const char  *pBiasSrc = "stored";
+
+    InitTime = HAL_GetTick();
+
+    Ret = (ROC_RESULT)RocMpu6050RegInit();
+    if(RET_OK !=Ret)
+    {
+        ROC_LOGE("MPU6050 register init is in error!");
+        return ROC_MPU6050_INIT_ERROR;
+    }
+    else
+    {
+        ROC_LOGI("MPU6050 register init is in success");
+    }
+
+#ifndef ROC_MPU6050_BIAS_RECALIBRATE
+    if(RET_OK == RocMpu6050BiasLoad())
+    {
+        IsWarm = ROC_TRUE;
+    }
+#endif
+
+#ifdef ROC_MPU6050_RAW_FUSION
+    /* No DMP firmware to load, the fusion runs on the raw samples */
+    RocImuFusionInit(&g_Mpu6050Stream.Fusion, ROC_MPU6050_FUSION_MODE);
+
+    Ret = (ROC_RESULT)RocMpu6050SetRate(ROC_MPU6050_FUSION_RATE);
+    if(RET_OK !=Ret)
+    {
+        ROC_LOGE("MPU6050 raw rate setting is in error!");
+        return ROC_MPU6050_INIT_ERROR;
+    }
+#else
+    /* The warm boot skips the self test */
+    if(ROC_TRUE == IsWarm)
+    {
+        Ret = (ROC_RESULT)mpu_dmp_init_bias(g_Mpu6050Bias.Gyro, g_Mpu6050Bias.Accel);
+    }
+    else
+    {
+        Ret = (ROC_RESULT)mpu_dmp_init();
+    }
+
+    if(RET_OK !=Ret)
+    {
+        ROC_LOGE("MPU6050 DMP init is in error!");
+        return ROC_MPU6050_DMP_INIT_ERROR;
+    }
+    else
+    {
+        ROC_LOGI("MPU6050 DMP init is in success");
+    }
+#endif
+
+    if(ROC_TRUE != IsWarm)
+    {
+        pBiasSrc = "calibrated";
+
+        if(RET_OK != RocMpu6050BiasCalibrate())
+        {
+            pBiasSrc = "not calibrated";
+
+            ROC_LOGW("MPU6050 biases are not calibrated, stand the robot still for the next boot!");
+        }
+    }
+
+    Ret = RocMpu6050StreamStart();
+    if(RET_OK != Ret)
+    {
+        ROC_LOGE("MPU6050 stream start is in error!");
+        return ROC_MPU6050_DMP_INIT_ERROR;
     }
 
-    ROC_LOGI("MPU6050 init is in success");
+    ROC_LOGI("MPU6050 init is in success in %u ms, the biases are %s", HAL_GetTick() - InitTime, pBiasSrc);
 
     return RET_OK;
 }
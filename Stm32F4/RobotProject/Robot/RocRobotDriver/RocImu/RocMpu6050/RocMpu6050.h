@@ -2,11 +2,14 @@
 #define __ROC_MPU6050_H
 
 
+#include <stdint.h>
+
 #include "inv_mpu.h"
 #include "inv_mpu_dmp_motion_driver.h"
 
 #include "RocError.h"
 #include "RocSimulatedI2c.h"
+#include "RocImuFusion.h"
 
 
 #define ROC_MPU6050_INIT_ERROR              -1
@@ -89,9 +92,105 @@
 //#define ROC_MPU6050_WRITE_ADDRESS         0XD0
 
 
+/* After the init the DMP packets are streamed: the INT pulse of every packet
+   starts a DMA read of exactly one packet from the FIFO, and the decoded packet
+   goes to the ring buffer. The FIFO is drained at the DMP rate, so it can not
+   overflow, and the control loop never waits on the IIC. The blocking register
+   access is refused while streaming. The packets of the INT pulses during a DMA
+   read are read in one burst after it. */
+#define ROC_MPU6050_PACKET_MAX_LEN          32U     // The DMP packet with the quaternion, accel, gyro and gesture
+#define ROC_MPU6050_SAMPLE_BUF_NUM          8U      // Samples of the ring buffer, power of 2
+#define ROC_MPU6050_BURST_MAX_NUM           4U      // Packets of one DMA burst
+#define ROC_MPU6050_STREAM_STOP_TIMEOUT     20U     // ms, the longest DMA burst takes about 7 ms
+
+/* Without the stream the batch get drains all the packets of the FIFO in one
+   blocking IIC burst */
+#define ROC_MPU6050_BATCH_MAX_NUM           (DMP_FIFO_BATCH_BYTES / ROC_MPU6050_PACKET_MAX_LEN)   // The whole FIFO
+#define ROC_MPU6050_BURST_BYTES_PER_MS      20U     // The IIC2 bytes of 1 ms at 200 kHz
+
+/* The attitude is published as the float quaternion of the DMP, the euler angle
+   is converted on demand for the display */
+#define ROC_MPU6050_Q30_TO_FLOAT            (1.0F / 1073741824.0F)
+#define ROC_MPU6050_RADIAN_TO_ANGLE         57.29578F
+
+/* With the raw fusion the DMP firmware is not loaded at boot. The data ready INT
+   of every raw sample starts the DMA read of the accel, temperature and gyro
+   registers, and the fusion of RocImuFusion.c runs on the decoded sample. Its
+   quaternion goes to the ring buffer in q30 as the DMP one. The data registers
+   only hold the newest sample, so the INT pulses during a DMA read make the
+   next sample cover their periods. */
+//#define ROC_MPU6050_RAW_FUSION
+#define ROC_MPU6050_FUSION_RATE             1000U   // Raw sample rate, Hz
+#define ROC_MPU6050_FUSION_MODE             ROC_IMU_FUSION_MODE_MADGWICK
+#define ROC_MPU6050_RAW_PACKET_LEN          14U     // Accel, temperature and gyro registers
+#define ROC_MPU6050_RAW_GYRO_OFFSET         8U      // Gyro of the raw packet
+#define ROC_MPU6050_GYRO_TO_RADIAN          (2000.0F / 32768.0F / ROC_MPU6050_RADIAN_TO_ANGLE)  // The 2000 dps range
+#define ROC_MPU6050_INT_DATA_READY          0X01
+
+/* Log every sample of the stream as "IMU: <ms> <gyro xyz> <accel xyz> <q30 wxyz>"
+   for the replay of the fusion on the PC with Host/RocImuFusionReplay.c */
+//#define ROC_MPU6050_SAMPLE_LOG
+
+/* The gyro and accel biases are measured while the robot stands still and level,
+   and kept in the AT24C02 after the gait descriptors. The warm boot pushes them
+   to the DMP instead of the self test, so the yaw does not drift until the DMP
+   gyro calibration converges. The raw fusion removes them from every sample.
+   The record:
+   0  version            1  reserved           2  temperature, 0.01 C(2)
+   4  gyro bias xyz(12)  16 accel bias xyz(12) 28 CRC16 of the bytes 0 to 27(2)
+   The biases are q16 of the hardware units in the range of RocMpu6050RegInit,
+   as run_self_test pushes them to the DMP. */
+#define ROC_MPU6050_BIAS_VERSION            1U
+#define ROC_MPU6050_BIAS_LEN                30U
+#define ROC_MPU6050_BIAS_EEPROM_ADDR        0xC0U   /* 0xC0 to 0xDD */
+#define ROC_MPU6050_BIAS_VERSION_BYTE       0
+#define ROC_MPU6050_BIAS_TEMP_BYTE          2
+#define ROC_MPU6050_BIAS_GYRO_BYTE          4
+#define ROC_MPU6050_BIAS_ACCEL_BYTE         16
+#define ROC_MPU6050_BIAS_CRC_BYTE           28
+#define ROC_MPU6050_BIAS_SAMPLE_NUM         200U    // Samples of the calibration
+#define ROC_MPU6050_BIAS_SAMPLE_MS          5U      // The DMP sample period
+#define ROC_MPU6050_BIAS_STILL_RANGE        50      // Gyro swing of the still robot, hardware units
+#define ROC_MPU6050_BIAS_ACCEL_MAX          655     // 0.04 g, a larger accel offset is the tilt of the robot
+#define ROC_MPU6050_BIAS_TEMP_DIFF          1000U   // 0.01 C, the stored biases are stale over it
+#define ROC_MPU6050_ACCEL_1G                16384   // The 2 g range
+#define ROC_MPU6050_Q16_TO_FLOAT            (1.0F / 65536.0F)
+//#define ROC_MPU6050_BIAS_RECALIBRATE              // Calibrate on every boot, after the board is remounted
+
+/* The yaw is stable when it moves less than the drift over the window, the time
+   from the stream start to the first stable window is reported once */
+#define ROC_MPU6050_YAW_STABLE_WINDOW       1000U   // ms
+#define ROC_MPU6050_YAW_STABLE_DRIFT        0.1F    // degree
+#define ROC_MPU6050_YAW_UNSTABLE            0xFFFFFFFFU
+
+
+typedef struct _ROC_MPU6050_SAMPLE_s
+{
+    long                        Quat[4];                // The q30 quaternion of the DMP
+    int16_t                     Gyro[3];                // Gyro in hardware units
+    int16_t                     Accel[3];               // Accel in hardware units
+    uint32_t                    TimeStamp;              // Time of the INT pulse of the packet, ms
+
+}ROC_MPU6050_SAMPLE_s;
+
+typedef struct _ROC_MPU6050_STREAM_STAT_s
+{
+    uint32_t                    IntNum;                 // INT pulses while streaming
+    uint32_t                    SampleNum;              // Packets decoded to the ring buffer
+    uint32_t                    DeferNum;               // INT pulses while the DMA was busy, read just after it
+    uint32_t                    LostNum;                // Samples overwritten before the control loop got them
+    uint32_t                    CorruptNum;             // Packets with a bad quaternion, the FIFO is reset
+    uint32_t                    ErrorNum;               // IIC errors of the DMA read
+    uint32_t                    ErrorCode;              // HAL IIC error code of the last error
+    uint32_t                    YawStableTime;          // ms from the stream start to the stable yaw
+
+}ROC_MPU6050_STREAM_STAT_s;
+
+
 uint8_t RocMpu6050RegInit(void);
 uint8_t RocMpu6050WriteLen(uint8_t Addr, uint8_t Reg, uint8_t Len, uint8_t *Buf);
 uint8_t RocMpu6050ReadLen(uint8_t Addr, uint8_t Reg, uint8_t Len, uint8_t *Buf);
+uint8_t RocMpu6050ReadBurst(uint8_t Addr, uint8_t Reg, uint16_t Len, uint8_t *Buf);
 uint8_t RocMpu6050WriteByte(uint8_t Reg,uint8_t Dat);
 uint8_t RocMpu6050ReadByte(uint8_t Reg);
 
@@ -102,12 +201,23 @@ uint8_t RocMpu6050SetRate(uint16_t Rate);
 uint8_t RocMPU6050SetFifo(uint8_t Sens);
 
 uint16_t RocMpu6050GetTemperature(void);
-uint8_t RocMpu6050GetGyroscope(uint16_t *Gx, uint16_t *Gy, uint16_t *Gz);
-uint8_t RocMpu6050GetAccelerometer(uint16_t *Ax, uint16_t *Ay, uint16_t *Az);
+uint8_t RocMpu6050GetGyroscope(int16_t *Gx, int16_t *Gy, int16_t *Gz);
+uint8_t RocMpu6050GetAccelerometer(int16_t *Ax, int16_t *Ay, int16_t *Az);
 
 ROC_RESULT RocMpu6050Init(void);
+ROC_RESULT RocMpu6050BiasCalibrate(void);
+ROC_RESULT RocMpu6050QuatGet(float *pQuat);
+void RocMpu6050QuatToEuler(const float *pQuat, float *Pitch, float *Roll, float *Yaw);
 ROC_RESULT RocMpu6050EulerAngleGet(float *Pitch, float *Roll, float *Yaw);
 
+ROC_RESULT RocMpu6050StreamStart(void);
+ROC_RESULT RocMpu6050StreamStop(void);
+ROC_RESULT RocMpu6050SampleLatestGet(ROC_MPU6050_SAMPLE_s *pSample);
+ROC_RESULT RocMpu6050SampleBatchGet(ROC_MPU6050_SAMPLE_s *pSample, uint16_t MaxNum, uint16_t *pNum);
+void RocMpu6050StreamStatGet(ROC_MPU6050_STREAM_STAT_s *pStat);
+void RocMpu6050StreamReadCplt(void);
+void RocMpu6050StreamErrorHandle(uint32_t ErrorCode);
+
 
 #endif
 
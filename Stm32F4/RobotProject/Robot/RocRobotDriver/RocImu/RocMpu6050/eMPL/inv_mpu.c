@@ -52,6 +52,7 @@
 
 #define i2c_write   RocMpu6050WriteLen
 #define i2c_read    RocMpu6050ReadLen
+#define i2c_read_burst  RocMpu6050ReadBurst
 #define delay_ms    HAL_Delay
 #define get_ms      mget_ms
 //static inline int reg_int_cb(struct int_param_s *int_param)
@@ -1816,6 +1817,59 @@ int mpu_read_fifo_stream(unsigned short length, unsigned char *data,
     return 0;
 }
 
+/**
+ *  @brief      Get all the complete unparsed packets from the FIFO.
+ *  The packets are read in one I2C burst, up to the whole FIFO.
+ *  @param[in]  length      Length of one FIFO packet.
+ *  @param[in]  max_packets Max number of packets, @e data holds
+ *                          length * max_packets bytes.
+ *  @param[out] data        FIFO packets, the oldest first.
+ *  @param[out] packets     Number of packets read.
+ *  @param[out] more        Number of remaining packets.
+ *  @return     0 if successful, -2 if the FIFO overflowed and is reset.
+ */
+int mpu_read_fifo_stream_burst(unsigned short length, unsigned short max_packets,
+    unsigned char *data, unsigned short *packets, unsigned short *more)
+{
+    unsigned char tmp[2];
+    unsigned short fifo_count;
+
+    packets[0] = 0;
+    more[0] = 0;
+    if (!st.chip_cfg.dmp_on)
+        return -1;
+    if (!st.chip_cfg.sensors)
+        return -1;
+    if (!length)
+        return -1;
+
+    if (i2c_read(st.hw->addr, st.reg->fifo_count_h, 2, tmp))
+        return -1;
+    fifo_count = (tmp[0] << 8) | tmp[1];
+    if (fifo_count > (st.hw->max_fifo >> 1)) {
+        /* FIFO is 50% full, better check overflow bit. */
+        if (i2c_read(st.hw->addr, st.reg->int_status, 1, tmp))
+            return -1;
+        if (tmp[0] & BIT_FIFO_OVERFLOW) {
+            mpu_reset_fifo();
+            return -2;
+        }
+    }
+
+    packets[0] = fifo_count / length;
+    if (packets[0] > max_packets)
+        packets[0] = max_packets;
+    more[0] = fifo_count / length - packets[0];
+    if (!packets[0])
+        return 0;
+
+    if (i2c_read_burst(st.hw->addr, st.reg->fifo_r_w, packets[0] * length, data)) {
+        packets[0] = 0;
+        return -1;
+    }
+    return 0;
+}
+
 /**
  *  @brief      Set device to bypass mode.
  *  @param[in]  bypass_on   1 to enable bypass mode.
@@ -2953,6 +3007,14 @@ void mget_ms(unsigned long *time)
 //ֵ:0,
 //    ,ʧ
 uint8_t mpu_dmp_init(void)
+{
+	return mpu_dmp_init_bias(NULL,NULL);
+}
+//mpu6050,dmp init with the stored biases, the self test is skipped
+//gyro,accel: the q16 biases in the hardware units as run_self_test pushes them,
+//            NULL to run the self test
+//return: 0 if ok
+uint8_t mpu_dmp_init_bias(long *gyro,long *accel)
 {
 	uint8_t res=0;
 	//RocSimulatedI2cInit(); 		//ʼIIC
@@ -2974,13 +3036,36 @@ uint8_t mpu_dmp_init(void)
 		if(res)return 6; 
 		res=dmp_set_fifo_rate(DEFAULT_MPU_HZ);	//DMP(󲻳200Hz)
 		if(res)return 7;    
-		res=run_self_test();		//Լ
+		if((gyro!=NULL)&&(accel!=NULL))
+		{
+			res=(dmp_set_gyro_bias(gyro)||dmp_set_accel_bias(accel));
+		}
+		else
+		{
+			res=run_self_test();		//Լ
+		}
 		if(res)return 8;    
 		res=mpu_set_dmp_state(1);	//ʹDMP
 		if(res)return 9;     
 	}
 	return 0;
 }
+//Convert the q30 quaternion of the DMP packet to the euler angle in degree
+//quat: the q30 quaternion of dmp_read_fifo or dmp_decode_fifo_packet
+void mpu_dmp_quat_to_euler(const long *quat,float *pitch,float *roll,float *yaw)
+{
+	float q0,q1,q2,q3;
+
+	q0 = quat[0] / q30;	//q30ʽתΪ
+	q1 = quat[1] / q30;
+	q2 = quat[2] / q30;
+	q3 = quat[3] / q30; 
+	//õ//
+	/* Single precision, the Cortex-M4F runs it on the FPU */
+	*pitch = asinf(-2.0f * q1 * q3 + 2.0f * q0* q2)* 57.29578f;	// pitch
+	*roll  = atan2f(2.0f * q2 * q3 + 2.0f * q0 * q1, -2.0f * q1 * q1 - 2.0f * q2* q2 + 1.0f)* 57.29578f;	// roll
+	*yaw   = atan2f(2.0f*(q1*q2 + q0*q3),q0*q0+q1*q1-q2*q2-q3*q3) * 57.29578f;	//yaw
+}
 //õdmp(ע,ҪȽ϶ջ,ֲе)
 //pitch: :0.1   Χ:-90.0 <---> +90.0
 //roll:  :0.1   Χ:-180.0<---> +180.0
@@ -2989,7 +3074,6 @@ uint8_t mpu_dmp_init(void)
 //    ,ʧ
 uint8_t mpu_dmp_get_data(float *pitch,float *roll,float *yaw)
 {
-	float q0=1.0f,q1=0.0f,q2=0.0f,q3=0.0f;
 	unsigned long sensor_timestamp;
 	short gyro[3], accel[3], sensors;
 	unsigned char more;
@@ -3008,14 +3092,7 @@ uint8_t mpu_dmp_get_data(float *pitch,float *roll,float *yaw)
 	**/
 	if(sensors&INV_WXYZ_QUAT) 
 	{
-		q0 = quat[0] / q30;	//q30ʽתΪ
-		q1 = quat[1] / q30;
-		q2 = quat[2] / q30;
-		q3 = quat[3] / q30; 
-		//õ//
-		*pitch = asin(-2 * q1 * q3 + 2 * q0* q2)* 57.3;	// pitch
-		*roll  = atan2(2 * q2 * q3 + 2 * q0 * q1, -2 * q1 * q1 - 2 * q2* q2 + 1)* 57.3;	// roll
-		*yaw   = atan2(2*(q1*q2 + q0*q3),q0*q0+q1*q1-q2*q2-q3*q3) * 57.3;	//yaw
+		mpu_dmp_quat_to_euler(quat, pitch, roll, yaw);
 	}else return 2;
 	return 0;
 }
@@ -115,6 +115,8 @@ int mpu_read_fifo(short *gyro, short *accel, unsigned long *timestamp,
     unsigned char *sensors, unsigned char *more);
 int mpu_read_fifo_stream(unsigned short length, unsigned char *data,
     unsigned char *more);
+int mpu_read_fifo_stream_burst(unsigned short length, unsigned short max_packets,
+    unsigned char *data, unsigned short *packets, unsigned short *more);
 int mpu_reset_fifo(void);
 
 int mpu_write_mem(unsigned short mem_addr, unsigned short length,
@@ -134,7 +136,9 @@ unsigned short inv_row_2_scale(const signed char *row);
 unsigned short inv_orientation_matrix_to_scalar(const signed char *mtx);
 uint8_t run_self_test(void);
 uint8_t mpu_dmp_init(void);
+uint8_t mpu_dmp_init_bias(long *gyro,long *accel);
 uint8_t mpu_dmp_get_data(float *pitch,float *roll,float *yaw);
+void mpu_dmp_quat_to_euler(const long *quat,float *pitch,float *roll,float *yaw);
 
 #endif  /* #ifndef _INV_MPU_H_ */
 
@@ -1246,29 +1246,30 @@ int dmp_set_interrupt_mode(unsigned char mode)
 }
 
 /**
- *  @brief      Get one packet from the FIFO.
- *  If @e sensors does not contain a particular sensor, disregard the data
- *  returned to that pointer.
- *  \n @e sensors can contain a combination of the following flags:
- *  \n INV_X_GYRO, INV_Y_GYRO, INV_Z_GYRO
- *  \n INV_XYZ_GYRO
- *  \n INV_XYZ_ACCEL
- *  \n INV_WXYZ_QUAT
- *  \n If the FIFO has no new data, @e sensors will be zero.
- *  \n If the FIFO is disabled, @e sensors will be zero and this function will
- *  return a non-zero error code.
+ *  @brief      Get the length of one DMP packet in the FIFO.
+ *  The length depends on the features enabled by dmp_enable_feature.
+ *  @return     Packet length in bytes.
+ */
+unsigned short dmp_get_packet_length(void)
+{
+    return dmp.packet_length;
+}
+
+/**
+ *  @brief      Decode one DMP packet read from the FIFO.
+ *  The packet is parsed the same way as in dmp_read_fifo, but no I2C
+ *  transaction is made, so it can be called from an interrupt handler. The
+ *  gesture callbacks are called if registered.
+ *  @param[in]  fifo_data   Packet of dmp_get_packet_length bytes.
  *  @param[out] gyro        Gyro data in hardware units.
  *  @param[out] accel       Accel data in hardware units.
  *  @param[out] quat        3-axis quaternion data in hardware units.
- *  @param[out] timestamp   Timestamp in milliseconds.
- *  @param[out] sensors     Mask of sensors read from FIFO.
- *  @param[out] more        Number of remaining packets.
- *  @return     0 if successful.
+ *  @param[out] sensors     Mask of sensors in the packet.
+ *  @return     0 if successful, -1 if the packet is corrupted.
  */
-int dmp_read_fifo(short *gyro, short *accel, long *quat,
-    unsigned long *timestamp, short *sensors, unsigned char *more)
+int dmp_decode_fifo_packet(const unsigned char *fifo_data, short *gyro,
+    short *accel, long *quat, short *sensors)
 {
-    unsigned char fifo_data[MAX_PACKET_LENGTH];
     unsigned char ii = 0;
 
     /* TODO: sensors[0] only changes when dmp_enable_feature is called. We can
@@ -1276,10 +1277,6 @@ int dmp_read_fifo(short *gyro, short *accel, long *quat,
      */
     sensors[0] = 0;
 
-    /* Get a packet. */
-    if (mpu_read_fifo_stream(dmp.packet_length, fifo_data, more))
-        return -1;
-
     /* Parse DMP packet. */
     if (dmp.feature_mask & (DMP_FEATURE_LP_QUAT | DMP_FEATURE_6X_LP_QUAT)) {
 #ifdef FIFO_CORRUPTION_CHECK
@@ -1312,7 +1309,6 @@ int dmp_read_fifo(short *gyro, short *accel, long *quat,
         if ((quat_mag_sq < QUAT_MAG_SQ_MIN) ||
             (quat_mag_sq > QUAT_MAG_SQ_MAX)) {
             /* Quaternion is outside of the acceptable threshold. */
-            mpu_reset_fifo();
             sensors[0] = 0;
             return -1;
         }
@@ -1340,12 +1336,100 @@ int dmp_read_fifo(short *gyro, short *accel, long *quat,
      * the gesture callbacks (if registered).
      */
     if (dmp.feature_mask & (DMP_FEATURE_TAP | DMP_FEATURE_ANDROID_ORIENT))
-        decode_gesture(fifo_data + ii);
+        decode_gesture((unsigned char*)fifo_data + ii);
+
+    return 0;
+}
+
+/**
+ *  @brief      Get one packet from the FIFO.
+ *  If @e sensors does not contain a particular sensor, disregard the data
+ *  returned to that pointer.
+ *  \n @e sensors can contain a combination of the following flags:
+ *  \n INV_X_GYRO, INV_Y_GYRO, INV_Z_GYRO
+ *  \n INV_XYZ_GYRO
+ *  \n INV_XYZ_ACCEL
+ *  \n INV_WXYZ_QUAT
+ *  \n If the FIFO has no new data, @e sensors will be zero.
+ *  \n If the FIFO is disabled, @e sensors will be zero and this function will
+ *  return a non-zero error code.
+ *  @param[out] gyro        Gyro data in hardware units.
+ *  @param[out] accel       Accel data in hardware units.
+ *  @param[out] quat        3-axis quaternion data in hardware units.
+ *  @param[out] timestamp   Timestamp in milliseconds.
+ *  @param[out] sensors     Mask of sensors read from FIFO.
+ *  @param[out] more        Number of remaining packets.
+ *  @return     0 if successful.
+ */
+int dmp_read_fifo(short *gyro, short *accel, long *quat,
+    unsigned long *timestamp, short *sensors, unsigned char *more)
+{
+    unsigned char fifo_data[MAX_PACKET_LENGTH];
+
+    sensors[0] = 0;
+
+    /* Get a packet. */
+    if (mpu_read_fifo_stream(dmp.packet_length, fifo_data, more))
+        return -1;
+
+    if (dmp_decode_fifo_packet(fifo_data, gyro, accel, quat, sensors)) {
+        mpu_reset_fifo();
+        return -1;
+    }
 
     get_ms(timestamp);
     return 0;
 }
 
+/**
+ *  @brief      Drain all the complete packets from the FIFO.
+ *  The packets are read in one I2C burst, up to the whole FIFO, and decoded
+ *  oldest first. The packets carry no time, so the newest one in the FIFO is
+ *  stamped with the read time and each older one a FIFO period earlier.
+ *  @param[out] samples     Decoded samples, the oldest first.
+ *  @param[in]  max_samples Max number of samples.
+ *  @param[out] count       Number of samples decoded.
+ *  @param[out] more        Number of packets left in the FIFO.
+ *  @return     0 if successful, the FIFO is reset on an overflow or a
+ *              corrupted packet and the samples before it are kept.
+ */
+int dmp_read_fifo_batch(struct dmp_sample_s *samples, unsigned short max_samples,
+    unsigned short *count, unsigned short *more)
+{
+    static unsigned char fifo_data[DMP_FIFO_BATCH_BYTES];
+    unsigned short packets, ii;
+    unsigned long now, period;
+
+    count[0] = 0;
+    more[0] = 0;
+    if (!dmp.packet_length)
+        return -1;
+
+    if (max_samples > DMP_FIFO_BATCH_BYTES / dmp.packet_length)
+        max_samples = DMP_FIFO_BATCH_BYTES / dmp.packet_length;
+
+    if (mpu_read_fifo_stream_burst(dmp.packet_length, max_samples, fifo_data,
+            &packets, more))
+        return -1;
+
+    get_ms(&now);
+    period = dmp.fifo_rate ? (1000 / dmp.fifo_rate) : 0;
+
+    for (ii = 0; ii < packets; ii++) {
+        if (dmp_decode_fifo_packet(fifo_data + ii * dmp.packet_length,
+                samples[ii].gyro, samples[ii].accel, samples[ii].quat,
+                &samples[ii].sensors)) {
+            mpu_reset_fifo();
+            more[0] = 0;
+            return -1;
+        }
+        samples[ii].timestamp = now -
+            (unsigned long)(packets - 1 - ii + more[0]) * period;
+        count[0]++;
+    }
+    return 0;
+}
+
 /**
  *  @brief      Register a function to be executed on a tap event.
  *  The tap direction is represented by one of the following:
@@ -49,6 +49,17 @@
 
 #define INV_WXYZ_QUAT       (0x100)
 
+#define DMP_FIFO_BATCH_BYTES    (1024)
+
+/* One decoded DMP packet of a FIFO batch. */
+struct dmp_sample_s {
+    long quat[4];
+    short gyro[3];
+    short accel[3];
+    short sensors;
+    unsigned long timestamp;
+};
+
 /* Set up functions. */
 int dmp_load_motion_driver_firmware(void);
 int dmp_set_fifo_rate(unsigned short rate);
@@ -93,5 +104,14 @@ int dmp_enable_gyro_cal(unsigned char enable);
 int dmp_read_fifo(short *gyro, short *accel, long *quat,
     unsigned long *timestamp, short *sensors, unsigned char *more);
 
+/* Packet functions. The packet read by DMA is decoded without an I2C
+ * transaction.
+ */
+unsigned short dmp_get_packet_length(void);
+int dmp_read_fifo_batch(struct dmp_sample_s *samples, unsigned short max_samples,
+    unsigned short *count, unsigned short *more);
+int dmp_decode_fifo_packet(const unsigned char *fifo_data, short *gyro,
+    short *accel, long *quat, short *sensors);
+
 #endif  /* #ifndef _INV_MPU_DMP_MOTION_DRIVER_H_ */
 
@@ -13,6 +13,43 @@
 #include "RocPca9685.h"
 
 
+typedef struct _ROC_PCA9685_FRAME_s
+{
+    uint8_t                     SlaveAddr;
+    uint8_t                     Reg;                // The first register of the auto-increment write
+    uint16_t                    Len;
+    uint8_t                     *pData;
+
+}ROC_PCA9685_FRAME_s;
+
+typedef struct _ROC_PCA9685_FRAME_BUF_s
+{
+    uint16_t                    Pwm[ROC_PCA9685_PWM_MAX_NUM];   // The PWM data the buffer commits
+    uint16_t                    PwmNum;
+    ROC_PCA9685_FRAME_s         Frame[ROC_PCA9685_FRAME_MAX_NUM];
+    uint8_t                     FrameNum;
+    uint16_t                    DataLen;
+    uint8_t                     Data[ROC_PCA9685_DATA_REG_NUM * ROC_PCA9685_PWM_MAX_NUM];
+
+}ROC_PCA9685_FRAME_BUF_s;
+
+typedef struct _ROC_PCA9685_FRAME_QUEUE_s
+{
+    ROC_PCA9685_FRAME_BUF_s     Buf[ROC_PCA9685_FRAME_BUF_NUM];
+    volatile uint8_t            SendBuf;            // The buffer read by the DMA
+    volatile uint8_t            SendFrame;          // The frame of the buffer on the bus
+    volatile uint8_t            IsBusy;
+    volatile uint8_t            IsPending;          // The other buffer holds the next frame
+    volatile uint8_t            IsBusReset;         // Reset the IIC before the next frame
+    volatile uint8_t            IsCommitValid;      // The send buffer PWM is what the controllers hold after it is sent
+    ROC_PCA9685_FRAME_STAT_s    Stat;
+
+}ROC_PCA9685_FRAME_QUEUE_s;
+
+
+static ROC_PCA9685_FRAME_QUEUE_s g_Pca9685Queue;
+
+
 /*********************************************************************************
  *  Description:
  *              Enable PCA9685 output PWM pulse
@@ -179,6 +216,13 @@ HAL_StatusTypeDef RocPca9685OutPwm(uint8_t SlaveAddr, uint8_t NumPin, uint16_t L
     Buffer[3] = LedOffTime & 0xFFU;
     Buffer[4] = (LedOffTime >> 8U) & 0xFFU;
 
+    if(RET_OK != RocPca9685FrameWaitIdle(ROC_PCA9685_FRAME_WAIT_TIMEOUT))
+    {
+        return HAL_BUSY;
+    }
+
+    g_Pca9685Queue.IsCommitValid = ROC_FALSE;
+
     WriteStatus = HAL_I2C_Mem_Write(&hi2c1, SlaveAddr, Buffer[0], I2C_MEMADD_SIZE_8BIT, Buffer + 1, 4, 10);
 
     return WriteStatus;
@@ -204,7 +248,12 @@ HAL_StatusTypeDef RocPca9685OutPwmAll(uint8_t SlaveAddr, uint16_t *pPwmData, uin
 {
     uint8_t             i = 0;
     HAL_StatusTypeDef   WriteStatus = HAL_OK;
-    uint8_t             Buffer[ROC_PCA9685_DATA_REG_NUM * PwmDataNum + 1];
+    uint8_t             Buffer[ROC_PCA9685_DATA_REG_NUM * ROC_PCA9685_CHANNEL_MAX_NUM + 1];
+
+    if((0 == PwmDataNum) || (ROC_PCA9685_CHANNEL_MAX_NUM < PwmDataNum))
+    {
+        return HAL_ERROR;
+    }
 
     Buffer[0] = LED0_ON_L;
 
@@ -216,6 +265,13 @@ HAL_StatusTypeDef RocPca9685OutPwmAll(uint8_t SlaveAddr, uint16_t *pPwmData, uin
         Buffer[i * ROC_PCA9685_DATA_REG_NUM + 4] = (pPwmData[i] >> 8U) & 0xFFU;
     }
 
+    if(RET_OK != RocPca9685FrameWaitIdle(ROC_PCA9685_FRAME_WAIT_TIMEOUT))
+    {
+        return HAL_BUSY;
+    }
+
+    g_Pca9685Queue.IsCommitValid = ROC_FALSE;
+
     WriteStatus = HAL_I2C_Mem_Write(&hi2c1, SlaveAddr, Buffer[0], I2C_MEMADD_SIZE_8BIT, Buffer + 1, ROC_PCA9685_DATA_REG_NUM * PwmDataNum, 10);
 
     return WriteStatus;
@@ -279,6 +335,456 @@ HAL_StatusTypeDef RocPca9685SetPinOutPwm(uint8_t SlaveAddr, uint8_t NumPin, uint
     return WriteStatus;
 }
 
+/*********************************************************************************
+ *  Description:
+ *              Block the IIC interrupts which drive the frame queue
+ *
+ *  Parameter:
+ *              None
+ *
+ *  Return:
+ *              None
+ *
+ *  Author:
+ *              ROC LiRen(2026.10.17)
+**********************************************************************************/
+static void RocPca9685FrameLock(void)
+{
+    HAL_NVIC_DisableIRQ(I2C1_EV_IRQn);
+    HAL_NVIC_DisableIRQ(I2C1_ER_IRQn);
+    HAL_NVIC_DisableIRQ(DMA1_Stream7_IRQn);
+}
+
+/*********************************************************************************
+ *  Description:
+ *              Unblock the IIC interrupts which drive the frame queue
+ *
+ *  Parameter:
+ *              None
+ *
+ *  Return:
+ *              None
+ *
+ *  Author:
+ *              ROC LiRen(2026.10.17)
+**********************************************************************************/
+static void RocPca9685FrameUnlock(void)
+{
+    HAL_NVIC_EnableIRQ(DMA1_Stream7_IRQn);
+    HAL_NVIC_EnableIRQ(I2C1_ER_IRQn);
+    HAL_NVIC_EnableIRQ(I2C1_EV_IRQn);
+}
+
+/*********************************************************************************
+ *  Description:
+ *              Record the frame error, the queue stops and the IIC is reset
+ *              before the next frame, it is called by the IIC1 error callback
+ *              too
+ *
+ *  Parameter:
+ *              ErrorCode: the HAL IIC error code
+ *
+ *  Return:
+ *              None
+ *
+ *  Author:
+ *              ROC LiRen(2026.10.17)
+**********************************************************************************/
+void RocPca9685FrameError(uint32_t ErrorCode)
+{
+    g_Pca9685Queue.Stat.ErrorNum++;
+    g_Pca9685Queue.Stat.ContinuousErrorNum++;
+    g_Pca9685Queue.Stat.ErrorCode = ErrorCode;
+
+    g_Pca9685Queue.IsBusReset = ROC_TRUE;
+    g_Pca9685Queue.IsCommitValid = ROC_FALSE;
+    g_Pca9685Queue.IsBusy = ROC_FALSE;
+}
+
+/*********************************************************************************
+ *  Description:
+ *              Start the DMA of the current frame of the send buffer
+ *
+ *  Parameter:
+ *              None
+ *
+ *  Return:
+ *              The frame start status
+ *
+ *  Author:
+ *              ROC LiRen(2026.10.17)
+**********************************************************************************/
+static ROC_RESULT RocPca9685FrameSend(void)
+{
+    HAL_StatusTypeDef   WriteStatus = HAL_OK;
+    ROC_PCA9685_FRAME_s *pFrame = NULL;
+
+    pFrame = &g_Pca9685Queue.Buf[g_Pca9685Queue.SendBuf].Frame[g_Pca9685Queue.SendFrame];
+
+    WriteStatus = HAL_I2C_Mem_Write_DMA(&hi2c1, pFrame->SlaveAddr, pFrame->Reg, I2C_MEMADD_SIZE_8BIT, pFrame->pData, pFrame->Len);
+    if(HAL_OK != WriteStatus)
+    {
+        RocPca9685FrameError(HAL_I2C_GetError(&hi2c1));
+
+        return RET_ERROR;
+    }
+
+    return RET_OK;
+}
+
+/*********************************************************************************
+ *  Description:
+ *              Add the frame of a channel run to the buffer. The full frame
+ *              starts from LEDn_ON_L, the delta frame starts from LEDn_OFF_L
+ *              since the ON registers are always 0 after the full frame.
+ *
+ *  Parameter:
+ *              pBuf:       the pointer to the frame buffer
+ *              Controller: the controller of the channels
+ *              Channel:    the first channel of the run
+ *              ChannelNum: the number of the channels
+ *              IsFull:     write the ON registers of the first channel
+ *
+ *  Return:
+ *              None
+ *
+ *  Author:
+ *              ROC LiRen(2026.10.17)
+**********************************************************************************/
+static void RocPca9685FrameAdd(ROC_PCA9685_FRAME_BUF_s *pBuf, uint8_t Controller, uint8_t Channel, uint8_t ChannelNum, uint8_t IsFull)
+{
+    uint8_t             i = 0;
+    uint16_t            Pwm = 0;
+    uint8_t             *pData = NULL;
+    ROC_PCA9685_FRAME_s *pFrame = NULL;
+    static const uint8_t SlaveAddr[ROC_PCA9685_CONTROLLER_NUM] = {PWM_ADDRESS_L, PWM_ADDRESS_H};
+
+    pFrame = &pBuf->Frame[pBuf->FrameNum];
+    pData = pBuf->Data + pBuf->DataLen;
+
+    pFrame->SlaveAddr = SlaveAddr[Controller];
+    pFrame->Reg = LED0_ON_L + Channel * ROC_PCA9685_DATA_REG_NUM;
+    pFrame->pData = pData;
+
+    if(ROC_TRUE != IsFull)
+    {
+        pFrame->Reg = LED0_OFF_L + Channel * ROC_PCA9685_DATA_REG_NUM;
+    }
+
+    for(i = 0; i < ChannelNum; i++)
+    {
+        if((0 != i) || (ROC_TRUE == IsFull))
+        {
+            *pData++ = 0x00U;
+            *pData++ = 0x00U;
+        }
+
+        Pwm = pBuf->Pwm[Controller * ROC_PCA9685_CHANNEL_MAX_NUM + Channel + i];
+
+        *pData++ = Pwm & 0xFFU;
+        *pData++ = (Pwm >> 8U) & 0xFFU;
+    }
+
+    pFrame->Len = (uint16_t)(pData - pFrame->pData);
+
+    pBuf->DataLen += pFrame->Len;
+    pBuf->FrameNum++;
+}
+
+/*********************************************************************************
+ *  Description:
+ *              Fill the frame buffer with the PWM data, the first
+ *              ROC_PCA9685_CHANNEL_MAX_NUM data go to PWM_ADDRESS_L and the
+ *              others go to PWM_ADDRESS_H. Only the runs of the channels
+ *              changed from the committed PWM are written, the runs split by
+ *              a short gap are merged since one more frame costs more.
+ *
+ *  Parameter:
+ *              pBuf:       the pointer to the frame buffer
+ *              pCommit:    the pointer to the committed frame buffer, NULL to
+ *                          write all the channels
+ *              pPwmData:   the pointer to the PWM data
+ *              PwmDataNum: the number of the PWM data
+ *
+ *  Return:
+ *              The bytes written to the bus if all the channels are written
+ *
+ *  Author:
+ *              ROC LiRen(2026.10.17)
+**********************************************************************************/
+static uint32_t RocPca9685FrameFill(ROC_PCA9685_FRAME_BUF_s *pBuf, ROC_PCA9685_FRAME_BUF_s *pCommit, uint16_t *pPwmData, uint16_t PwmDataNum)
+{
+    uint8_t             i = 0;
+    uint8_t             j = 0;
+    uint8_t             Controller = 0;
+    uint8_t             End = 0;
+    uint16_t            First = 0;
+    uint16_t            ChannelNum = 0;
+    uint32_t            FullLen = 0;
+
+    memcpy(pBuf->Pwm, pPwmData, PwmDataNum * sizeof(uint16_t));
+    pBuf->PwmNum = PwmDataNum;
+    pBuf->FrameNum = 0;
+    pBuf->DataLen = 0;
+
+    if((NULL != pCommit) && (pCommit->PwmNum != PwmDataNum))
+    {
+        pCommit = NULL;
+    }
+
+    for(Controller = 0; Controller < ROC_PCA9685_CONTROLLER_NUM; Controller++)
+    {
+        First = Controller * ROC_PCA9685_CHANNEL_MAX_NUM;
+        if(PwmDataNum <= First)
+        {
+            break;
+        }
+
+        ChannelNum = ((uint16_t)(PwmDataNum - First) > ROC_PCA9685_CHANNEL_MAX_NUM) ? ROC_PCA9685_CHANNEL_MAX_NUM : (uint16_t)(PwmDataNum - First);
+        FullLen += ROC_PCA9685_FRAME_HEAD_LEN + ROC_PCA9685_DATA_REG_NUM * ChannelNum;
+
+        if(NULL == pCommit)
+        {
+            RocPca9685FrameAdd(pBuf, Controller, 0, (uint8_t)ChannelNum, ROC_TRUE);
+
+            continue;
+        }
+
+        i = 0;
+
+        while(i < ChannelNum)
+        {
+            if(pCommit->Pwm[First + i] == pBuf->Pwm[First + i])
+            {
+                i++;
+
+                continue;
+            }
+
+            End = i + 1;
+
+            for(j = i + 1; j < ChannelNum; j++)
+            {
+                if(pCommit->Pwm[First + j] != pBuf->Pwm[First + j])
+                {
+                    End = j + 1;
+                }
+                else if(ROC_PCA9685_FRAME_MERGE_GAP <= (uint8_t)(j - End))
+                {
+                    break;
+                }
+            }
+
+            RocPca9685FrameAdd(pBuf, Controller, i, End - i, ROC_FALSE);
+
+            i = End;
+        }
+    }
+
+    return FullLen;
+}
+
+/*********************************************************************************
+ *  Description:
+ *              Hand over the PWM data of all the controllers and return at once.
+ *              Only the channels changed from the last committed frame are
+ *              sent, the frames are sent back to back by the DMA, if the last
+ *              frame is still on the bus the data wait in the other buffer,
+ *              and a waiting frame is replaced by the newer one.
+ *              The send errors are reported by RocPca9685FrameStatGet.
+ *
+ *  Parameter:
+ *              pPwmData:   the pointer to the PWM data
+ *              PwmDataNum: the number of the PWM data
+ *
+ *  Return:
+ *              RET_ERROR if the frame can not be started
+ *
+ *  Author:
+ *              ROC LiRen(2026.10.17)
+**********************************************************************************/
+ROC_RESULT RocPca9685FrameSubmit(uint16_t *pPwmData, uint16_t PwmDataNum)
+{
+    uint8_t                 i = 0;
+    uint8_t                 NextBuf = 0;
+    uint32_t                FullLen = 0;
+    uint32_t                BusLen = 0;
+    ROC_PCA9685_FRAME_BUF_s *pBuf = NULL;
+    ROC_PCA9685_FRAME_BUF_s *pCommit = NULL;
+
+    if((0 == PwmDataNum) || (ROC_PCA9685_PWM_MAX_NUM < PwmDataNum))
+    {
+        return RET_ERROR;
+    }
+
+    RocPca9685FrameLock();
+
+    g_Pca9685Queue.Stat.SubmitNum++;
+
+    NextBuf = (g_Pca9685Queue.SendBuf + 1) % ROC_PCA9685_FRAME_BUF_NUM;
+    pBuf = &g_Pca9685Queue.Buf[NextBuf];
+
+    /* A waiting frame is replaced, so the new one always follows the send buffer */
+    if(ROC_TRUE == g_Pca9685Queue.IsCommitValid)
+    {
+        pCommit = &g_Pca9685Queue.Buf[g_Pca9685Queue.SendBuf];
+    }
+
+    FullLen = RocPca9685FrameFill(pBuf, pCommit, pPwmData, PwmDataNum);
+
+    for(i = 0; i < pBuf->FrameNum; i++)
+    {
+        BusLen += ROC_PCA9685_FRAME_HEAD_LEN + pBuf->Frame[i].Len;
+    }
+
+    g_Pca9685Queue.Stat.BusByteNum += BusLen;
+    g_Pca9685Queue.Stat.SavedByteNum += FullLen - BusLen;
+
+    if(ROC_TRUE == g_Pca9685Queue.IsBusy)
+    {
+        if(ROC_TRUE == g_Pca9685Queue.IsPending)
+        {
+            g_Pca9685Queue.Stat.DropNum++;
+        }
+
+        g_Pca9685Queue.IsPending = ROC_TRUE;
+
+        RocPca9685FrameUnlock();
+
+        return RET_OK;
+    }
+
+    g_Pca9685Queue.SendBuf = NextBuf;
+    g_Pca9685Queue.SendFrame = 0;
+    g_Pca9685Queue.IsPending = ROC_FALSE;
+    g_Pca9685Queue.IsCommitValid = ROC_TRUE;
+
+    if(0 == pBuf->FrameNum)
+    {
+        g_Pca9685Queue.Stat.SentNum++;
+
+        RocPca9685FrameUnlock();
+
+        return RET_OK;
+    }
+
+    g_Pca9685Queue.IsBusy = ROC_TRUE;
+
+    RocPca9685FrameUnlock();
+
+    if(ROC_TRUE == g_Pca9685Queue.IsBusReset)
+    {
+        g_Pca9685Queue.IsBusReset = ROC_FALSE;
+
+        HAL_I2C_DeInit(&hi2c1);     /* For the ST IIC BUSY flag hardware error */
+        HAL_I2C_Init(&hi2c1);       /* Reset the IIC */
+    }
+
+    return RocPca9685FrameSend();
+}
+
+/*********************************************************************************
+ *  Description:
+ *              Wait for the frame queue to be idle, the blocking IIC access
+ *              must not start while the DMA is on the bus
+ *
+ *  Parameter:
+ *              Timeout: the max wait time in ms
+ *
+ *  Return:
+ *              RET_ERROR if the queue is still busy
+ *
+ *  Author:
+ *              ROC LiRen(2026.10.17)
+**********************************************************************************/
+ROC_RESULT RocPca9685FrameWaitIdle(uint32_t Timeout)
+{
+    uint32_t            TickStart = 0;
+
+    TickStart = HAL_GetTick();
+
+    while(ROC_TRUE == g_Pca9685Queue.IsBusy)
+    {
+        if(Timeout < HAL_GetTick() - TickStart)
+        {
+            return RET_ERROR;
+        }
+    }
+
+    return RET_OK;
+}
+
+/*********************************************************************************
+ *  Description:
+ *              Get the statistics of the frame queue
+ *
+ *  Parameter:
+ *              pStat: the pointer to the statistics
+ *
+ *  Return:
+ *              None
+ *
+ *  Author:
+ *              ROC LiRen(2026.10.17)
+**********************************************************************************/
+void RocPca9685FrameStatGet(ROC_PCA9685_FRAME_STAT_s *pStat)
+{
+    RocPca9685FrameLock();
+
+    memcpy(pStat, &g_Pca9685Queue.Stat, sizeof(ROC_PCA9685_FRAME_STAT_s));
+
+    RocPca9685FrameUnlock();
+}
+
+/*********************************************************************************
+ *  Description:
+ *              The IIC memory write DMA is finished, start the next frame of
+ *              the buffer, or the waiting buffer after the last frame, called
+ *              by the IIC1 write complete callback
+ *
+ *  Parameter:
+ *              None
+ *
+ *  Return:
+ *              None
+ *
+ *  Author:
+ *              ROC LiRen(2026.10.17)
+**********************************************************************************/
+void RocPca9685FrameSendCplt(void)
+{
+    g_Pca9685Queue.SendFrame++;
+
+    if(g_Pca9685Queue.SendFrame < g_Pca9685Queue.Buf[g_Pca9685Queue.SendBuf].FrameNum)
+    {
+        RocPca9685FrameSend();
+
+        return;
+    }
+
+    g_Pca9685Queue.Stat.SentNum++;
+    g_Pca9685Queue.Stat.ContinuousErrorNum = 0;
+
+    if(ROC_TRUE == g_Pca9685Queue.IsPending)
+    {
+        g_Pca9685Queue.IsPending = ROC_FALSE;
+        g_Pca9685Queue.SendBuf = (g_Pca9685Queue.SendBuf + 1) % ROC_PCA9685_FRAME_BUF_NUM;
+        g_Pca9685Queue.SendFrame = 0;
+
+        if(0 != g_Pca9685Queue.Buf[g_Pca9685Queue.SendBuf].FrameNum)
+        {
+            RocPca9685FrameSend();
+
+            return;
+        }
+
+        /* The waiting frame changes no channel */
+        g_Pca9685Queue.Stat.SentNum++;
+    }
+
+    g_Pca9685Queue.IsBusy = ROC_FALSE;
+}
+
 /*********************************************************************************
  *  Description:
  *              PCA9685 init
@@ -300,6 +806,8 @@ ROC_RESULT RocPca9685Init(void)
 
     RocPca9685PwmOutDisable();
 
+    memset(&g_Pca9685Queue, 0, sizeof(g_Pca9685Queue));
+
     WriteStatus = RocPca9685WriteReg(PWM_ADDRESS_L, PCA9685_MODE1, &InitDat);
     while(HAL_OK != WriteStatus)
     {
@@ -10,6 +10,8 @@
 
 #include "gpio.h"
 
+#include "RocError.h"
+
 
 #define PCA9685_SUBADR1                 0x02
 #define PCA9685_SUBADR2                 0x03
@@ -38,8 +40,38 @@
 #define ROC_PCA9685_DATA_REG_NUM        4U
 #define ROC_PCA9685_CHANNEL_MAX_NUM     16U
 
+#define ROC_PCA9685_CONTROLLER_NUM      2U      // PWM_ADDRESS_L and PWM_ADDRESS_H
+#define ROC_PCA9685_PWM_MAX_NUM         (ROC_PCA9685_CONTROLLER_NUM * ROC_PCA9685_CHANNEL_MAX_NUM)
+
+/* One frame is one IIC write of a run of the changed channels, the runs are
+   split by at least ROC_PCA9685_FRAME_MERGE_GAP + 1 unchanged channels */
+#define ROC_PCA9685_FRAME_MERGE_GAP     1U
+#define ROC_PCA9685_FRAME_MAX_NUM       (ROC_PCA9685_PWM_MAX_NUM / 2U)
+#define ROC_PCA9685_FRAME_BUF_NUM       2U      // The frame being sent and the next frame
+#define ROC_PCA9685_FRAME_WAIT_TIMEOUT  10U     // ms
+#define ROC_PCA9685_FRAME_HEAD_LEN      2U      // The slave address and the register address
+
+
+typedef struct _ROC_PCA9685_FRAME_STAT_s
+{
+    uint32_t                SubmitNum;          // The frames handed over by RocPca9685FrameSubmit
+    uint32_t                SentNum;            // The frames sent to all the controllers
+    uint32_t                DropNum;            // The frames replaced by a newer one before being sent
+    uint32_t                ErrorNum;
+    uint32_t                ContinuousErrorNum; // Cleared by a successfully sent frame
+    uint32_t                ErrorCode;          // The HAL I2C error code of the last error
+    uint32_t                BusByteNum;         // The bytes written to the bus
+    uint32_t                SavedByteNum;       // The bytes not written since the channels are not changed
+
+}ROC_PCA9685_FRAME_STAT_s;
+
 
 ROC_RESULT RocPca9685Init(void);
+ROC_RESULT RocPca9685FrameSubmit(uint16_t *pPwmData, uint16_t PwmDataNum);
+ROC_RESULT RocPca9685FrameWaitIdle(uint32_t Timeout);
+void RocPca9685FrameStatGet(ROC_PCA9685_FRAME_STAT_s *pStat);
+void RocPca9685FrameSendCplt(void);
+void RocPca9685FrameError(uint32_t ErrorCode);
 void RocPca9685PwmOutEnable(void);
 void RocPca9685PwmOutDisable(void);
 HAL_StatusTypeDef RocPca9685OutPwmAll(uint8_t SlaveAddr, uint16_t *pPwmData, uint16_t PwmDataNum);
@@ -17,6 +17,8 @@
 
 #define ROC_JOYSTICK_FRAME_HEADER       0xFA
 #define ROC_JOYSTICK_KEY_HEADER         0x01
+#define ROC_REMOTE_PROFILE_HEADER       0x02
+#define ROC_REMOTE_GAIT_HEADER          0x03
 
 
 typedef struct _ROC_REMOTE_CTRL_INPUT_s
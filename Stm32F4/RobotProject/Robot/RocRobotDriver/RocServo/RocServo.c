@@ -11,13 +11,31 @@
 #include "RocPca9685.h"
 
 
+typedef struct _ROC_SERVO_INTERP_s
+{
+    int32_t             Start;                  // Q16 PWM at the start of the move
+    int32_t             Delta;                  // Q16 PWM of the move
+    int32_t             Pos;                    // Q16 PWM output
+    int32_t             Vel;                    // Q16 PWM change of the last step
+    int32_t             VelStep;                // Q16 max PWM change per step, 0 is no limit
+    int32_t             AccStep;                // Q16 max change of VelStep per step, 0 is no limit
+    uint16_t            VelLimit;               // PWM per second
+    uint16_t            AccLimit;               // PWM per second^2
+
+}ROC_SERVO_INTERP_s;
+
+
 int16_t             g_PwmExpetVal[ROC_SERVO_MAX_SUPPORT_NUM] = {0};
 
-static int16_t      g_PwmIncreVal[ROC_SERVO_MAX_SUPPORT_NUM] = {0};
 static int16_t      g_PwmPreseVal[ROC_SERVO_MAX_SUPPORT_NUM] = {0};
-static int16_t      g_PwmLastdVal[ROC_SERVO_MAX_SUPPORT_NUM] = {0};
 
-static ROC_RESULT   g_ServoTurnIsFinshed = ROC_FALSE;
+static ROC_SERVO_INTERP_s           g_ServoInterp[ROC_SERVO_MAX_SUPPORT_NUM];
+static ROC_SERVO_INTERP_PROFILE_e   g_ServoInterpProfile = ROC_SERVO_INTERP_PROFILE_LINEAR;
+
+static uint8_t      g_ServoStepNum = ROC_SERVO_SPEED_DIV_STP;
+static uint16_t     g_ServoRunTimeMs = 0;
+
+static volatile uint8_t g_ServoPwmIsFault = ROC_FALSE;
 
 
 /*********************************************************************************
@@ -41,13 +59,52 @@ static void RocServoPwmDatInit(int16_t *pServoInputVal)
     {
         g_PwmExpetVal[i] = pServoInputVal[i];
         g_PwmPreseVal[i] = pServoInputVal[i];
-        g_PwmLastdVal[i] = pServoInputVal[i];
+
+        g_ServoInterp[i].Pos = (int32_t)pServoInputVal[i] << ROC_SERVO_Q16_SHIFT;
+        g_ServoInterp[i].Start = g_ServoInterp[i].Pos;
+        g_ServoInterp[i].Delta = 0;
+        g_ServoInterp[i].Vel = 0;
     }
 }
 
 /*********************************************************************************
  *  Description:
- *              Calculate the increment of the servo PWM pulse
+ *              Calculate the position of the interpolation profile
+ *
+ *  Parameter:
+ *              S: the Q16 progress of the move, from 0 to ROC_SERVO_Q16_ONE
+ *
+ *  Return:
+ *              The Q16 position of the profile, from 0 to ROC_SERVO_Q16_ONE
+ *
+ *  Author:
+ *              ROC LiRen(2026.10.17)
+**********************************************************************************/
+static int32_t RocServoInterpProfileCalc(int32_t S)
+{
+    int64_t         S2 = 0;
+    int64_t         S3 = 0;
+
+    S2 = ((int64_t)S * S) >> ROC_SERVO_Q16_SHIFT;
+
+    if(ROC_SERVO_INTERP_PROFILE_CUBIC == g_ServoInterpProfile)
+    {
+        return (int32_t)((S2 * (3 * ROC_SERVO_Q16_ONE - 2 * (int64_t)S)) >> ROC_SERVO_Q16_SHIFT);
+    }
+    else if(ROC_SERVO_INTERP_PROFILE_MIN_JERK == g_ServoInterpProfile)
+    {
+        S3 = (S2 * S) >> ROC_SERVO_Q16_SHIFT;
+
+        return (int32_t)((S3 * (10 * ROC_SERVO_Q16_ONE - 15 * (int64_t)S + 6 * S2)) >> ROC_SERVO_Q16_SHIFT);
+    }
+
+    return S;
+}
+
+/*********************************************************************************
+ *  Description:
+ *              Check the expected PWM and start the move of all the servos from
+ *              the present position
  *
  *  Parameter:
  *              None
@@ -58,7 +115,7 @@ static void RocServoPwmDatInit(int16_t *pServoInputVal)
  *  Author:
  *              ROC LiRen(2018.12.15)
 **********************************************************************************/
-static void RocServoPwmIncreCalculate(void)
+static void RocServoInterpStart(void)
 {
     uint8_t         i = 0U;
 
@@ -81,7 +138,9 @@ static void RocServoPwmIncreCalculate(void)
             g_PwmExpetVal[i] = ROC_SERVO_MAX_PWM_VAL;
         }
 
-        g_PwmIncreVal[i] = (g_PwmExpetVal[i] - g_PwmLastdVal[i]) / ROC_SERVO_SPEED_DIV_STP;
+        /* The move starts from where the servo is, the limited servo may not reach the last target */
+        g_ServoInterp[i].Start = g_ServoInterp[i].Pos;
+        g_ServoInterp[i].Delta = ((int32_t)g_PwmExpetVal[i] << ROC_SERVO_Q16_SHIFT) - g_ServoInterp[i].Pos;
     }
 }
 
@@ -110,40 +169,92 @@ static void RocServoInputUpdate(int16_t *pServoInputVal)
 
 /*********************************************************************************
  *  Description:
- *              Update the next loading date of the servo PWM pulse
+ *              Move all the servos to the profile position of the step, the
+ *              speed and acceleration of the servo are limited, and the servo
+ *              brakes before the target if it can not stop in time
  *
  *  Parameter:
- *              None
+ *              Step: the step of the move, from 1 to g_ServoStepNum
  *
  *  Return:
  *              None
  *
  *  Author:
- *              ROC LiRen(2018.12.15)
+ *              ROC LiRen(2026.10.17)
 **********************************************************************************/
-static void RocServoPwmUpdate(uint8_t CountTimes)
+static void RocServoInterpUpdate(uint8_t Step)
 {
-    uint8_t         i = 0U;
-
-    if(CountTimes < ROC_SERVO_SPEED_DIV_STP)
+    uint8_t             i = 0U;
+    int32_t             S = 0;
+    int32_t             P = 0;
+    int32_t             Target = 0;
+    int32_t             Remain = 0;
+    int32_t             Vel = 0;
+    ROC_SERVO_INTERP_s  *pInterp = NULL;
+
+    if(Step >= g_ServoStepNum)
     {
-        for(i = 0U; i < ROC_SERVO_MAX_SUPPORT_NUM; i++)
-        {
-            g_PwmPreseVal[i] = g_PwmPreseVal[i] + g_PwmIncreVal[i];
-        }
+        P = ROC_SERVO_Q16_ONE;
     }
     else
     {
-        for(i = 0U; i < ROC_SERVO_MAX_SUPPORT_NUM; i++)
+        S = (int32_t)(((uint32_t)Step << ROC_SERVO_Q16_SHIFT) / g_ServoStepNum);
+        P = RocServoInterpProfileCalc(S);
+    }
+
+    for(i = 0U; i < ROC_SERVO_MAX_SUPPORT_NUM; i++)
+    {
+        pInterp = &g_ServoInterp[i];
+
+        Target = pInterp->Start + pInterp->Delta;
+        Vel = pInterp->Start + (int32_t)(((int64_t)pInterp->Delta * P) >> ROC_SERVO_Q16_SHIFT) - pInterp->Pos;
+
+        if(0 != pInterp->AccStep)
         {
-            g_PwmPreseVal[i] = g_PwmExpetVal[i];
+            Remain = Target - pInterp->Pos;
+
+            /* Brake if the distance to stop v^2 / 2a is longer than the remain */
+            if(((pInterp->Vel > 0) && (Remain > 0)) || ((pInterp->Vel < 0) && (Remain < 0)))
+            {
+                if((int64_t)pInterp->Vel * pInterp->Vel > 2 * (int64_t)pInterp->AccStep * (Remain > 0 ? Remain : -Remain))
+                {
+                    Vel = (pInterp->Vel > 0) ? (pInterp->Vel - pInterp->AccStep) : (pInterp->Vel + pInterp->AccStep);
+                }
+            }
+
+            if(Vel > pInterp->Vel + pInterp->AccStep)
+            {
+                Vel = pInterp->Vel + pInterp->AccStep;
+            }
+            else if(Vel < pInterp->Vel - pInterp->AccStep)
+            {
+                Vel = pInterp->Vel - pInterp->AccStep;
+            }
         }
+
+        if(0 != pInterp->VelStep)
+        {
+            if(Vel > pInterp->VelStep)
+            {
+                Vel = pInterp->VelStep;
+            }
+            else if(Vel < -pInterp->VelStep)
+            {
+                Vel = -pInterp->VelStep;
+            }
+        }
+
+        pInterp->Vel = Vel;
+        pInterp->Pos += Vel;
+
+        g_PwmPreseVal[i] = (int16_t)((pInterp->Pos + (ROC_SERVO_Q16_ONE >> 1)) >> ROC_SERVO_Q16_SHIFT);
     }
 }
 
 /*********************************************************************************
  *  Description:
- *              Record the previous date of the servo PWM pulse
+ *              Convert the speed and acceleration limits of all the servos to
+ *              the Q16 limits per step of the present servo step time
  *
  *  Parameter:
  *              None
@@ -152,21 +263,45 @@ static void RocServoPwmUpdate(uint8_t CountTimes)
  *              None
  *
  *  Author:
- *              ROC LiRen(2018.12.15)
+ *              ROC LiRen(2026.10.17)
 **********************************************************************************/
-static void RocServoPwmRecod(void)
+static void RocServoInterpLimitUpdate(void)
 {
-    uint8_t         i = 0U;
+    uint8_t             i = 0U;
+    uint64_t            StepUs = 0;
+    uint64_t            Limit = 0;
+
+    StepUs = (uint64_t)g_ServoRunTimeMs * 1000U / g_ServoStepNum;
 
     for(i = 0U; i < ROC_SERVO_MAX_SUPPORT_NUM; i++)
     {
-        g_PwmLastdVal[i] = g_PwmPreseVal[i];
+        Limit = ((uint64_t)g_ServoInterp[i].VelLimit * StepUs << ROC_SERVO_Q16_SHIFT) / 1000000U;
+        g_ServoInterp[i].VelStep = (int32_t)Limit;
+
+        Limit = ((uint64_t)g_ServoInterp[i].AccLimit * StepUs << ROC_SERVO_Q16_SHIFT) / 1000000U;
+        Limit = Limit * StepUs / 1000000U;
+        g_ServoInterp[i].AccStep = (int32_t)Limit;
+
+        /* A very short step must not turn the limit off */
+        if((0 != g_ServoInterp[i].VelLimit) && (0 == g_ServoInterp[i].VelStep))
+        {
+            g_ServoInterp[i].VelStep = 1;
+        }
+
+        if((0 != g_ServoInterp[i].AccLimit) && (0 == g_ServoInterp[i].AccStep))
+        {
+            g_ServoInterp[i].AccStep = 1;
+        }
     }
 }
 
 /*********************************************************************************
  *  Description:
- *              Output the servo PWM pulse
+ *              Output the servo PWM pulse. It runs in the servo timer interrupt,
+ *              so the continuous frame errors latch the PWM fault and disable the
+ *              servo output instead of stopping here. The frames are still sent,
+ *              the IIC is reset before the next frame after an error, and the
+ *              output is enabled again by the first frame sent successfully.
  *
  *  Parameter:
  *              None
@@ -179,23 +314,49 @@ static void RocServoPwmRecod(void)
 **********************************************************************************/
 static void RocServoPwmOutput(void)
 {
-    HAL_StatusTypeDef   WriteStatus = HAL_OK;
+    ROC_PCA9685_FRAME_STAT_s    FrameStat;
 
-    WriteStatus = RocPca9685OutPwmAll(PWM_ADDRESS_L, (uint16_t *)g_PwmPreseVal, ROC_PCA9685_CHANNEL_MAX_NUM);
-    if(HAL_OK != WriteStatus)
+    /* The frame is sent by the DMA, the errors of the last frames are reported by the statistics */
+    RocPca9685FrameSubmit((uint16_t *)g_PwmPreseVal, ROC_SERVO_MAX_SUPPORT_NUM);
+
+    RocPca9685FrameStatGet(&FrameStat);
+
+    if(ROC_FALSE == g_ServoPwmIsFault)
     {
-        ROC_LOGE("Servo PWM out is in error, and servo will stop running!");
-        while(1);
-    }
+        if(ROC_SERVO_PWM_OUT_MAX_ERROR_NUM <= FrameStat.ContinuousErrorNum)
+        {
+            g_ServoPwmIsFault = ROC_TRUE;
 
-    WriteStatus = RocPca9685OutPwmAll(PWM_ADDRESS_H, (uint16_t *)g_PwmPreseVal + ROC_PCA9685_CHANNEL_MAX_NUM, ROC_SERVO_MAX_SUPPORT_NUM - ROC_PCA9685_CHANNEL_MAX_NUM);
-    if(HAL_OK != WriteStatus)
+            RocPca9685PwmOutDisable();
+        }
+    }
+    else if(0U == FrameStat.ContinuousErrorNum)
     {
-        ROC_LOGE("Servo PWM out is in error, and servo will stop running!");
-        while(1);
+        g_ServoPwmIsFault = ROC_FALSE;
+
+        RocPca9685PwmOutEnable();
     }
 }
 
+/*********************************************************************************
+ *  Description:
+ *              Get the servo PWM fault, it is latched by the continuous PCA9685
+ *              frame errors, and the servo output is disabled until it's cleared
+ *
+ *  Parameter:
+ *              None
+ *
+ *  Return:
+ *              ROC_TRUE if the servo PWM is in fault, or ROC_FALSE
+ *
+ *  Author:
+ *              ROC LiRen(2026.10.17)
+**********************************************************************************/
+uint8_t RocServoPwmFaultGet(void)
+{
+    return g_ServoPwmIsFault;
+}
+
 /*********************************************************************************
  *  Description:
  *              Enable servo output function
@@ -234,117 +395,222 @@ void RocServoOutputDisable(void)
 
 /*********************************************************************************
  *  Description:
- *              Check servos turns is finshed
+ *              Control the running of all servos: move the servos to the step of
+ *              the present move, and load the next move on the last step. The
+ *              step is given by the scheduler, so the gait task knows when the
+ *              next move is loaded.
  *
  *  Parameter:
- *              None
+ *              pServoInputVal: the next move
+ *              Step:           the step of the present move, from 1 to the step
+ *                              number, the last step loads the next move
  *
  *  Return:
- *              The running state
+ *              None
  *
  *  Author:
  *              ROC LiRen(2018.12.15)
 **********************************************************************************/
-ROC_RESULT RocServoTurnIsFinshed(void)
+void RocServoControl(int16_t *pServoInputVal, uint8_t Step)
 {
-    return g_ServoTurnIsFinshed;
+    RocServoInterpUpdate(Step);
+
+#ifdef ROC_ROBOT_SERVO_DEBUG
+    ROC_LOGI("Step is %d, g_PwmPreseVal is %d, g_PwmExpetVal is %d, Vel is %d \r\n",
+                            Step, g_PwmPreseVal[0], g_PwmExpetVal[0], g_ServoInterp[0].Vel);
+#endif
+
+    if(g_ServoStepNum <= Step)
+    {
+        RocServoInputUpdate(pServoInputVal);
+
+        RocServoInterpStart();
+    }
+
+    RocServoPwmOutput();
 }
 
 /*********************************************************************************
  *  Description:
- *              Control the running of all servos: if the times is eaqule to the
- *              expected, load the next group servo data, using this way to control
- *              the speed of servo.
+ *              Set the speed of servo running. The running servo timer is not
+ *              stopped, the new period is preloaded and takes effect at the next
+ *              update event, so the present interpolation step is not cut. The
+ *              stopped servo timer is started with the new period.
  *
  *  Parameter:
- *              None
+ *              ServoRunTimeMs: the servo run time of one gait tick
  *
  *  Return:
- *              None
+ *              The result of starting the servo timer
  *
  *  Author:
  *              ROC LiRen(2018.12.15)
 **********************************************************************************/
-void RocServoControl(int16_t *pServoInputVal)
+ROC_RESULT RocServoSpeedSet(uint16_t ServoRunTimeMs)
 {
-    static uint8_t  RefreshTimes = 0U;
-
-    RefreshTimes++;     /* record the times of the data update of servo */
+    ROC_RESULT Ret = RET_OK;
 
-    RocServoPwmUpdate(RefreshTimes);
+    if(htim6.Instance->CR1 & TIM_CR1_CEN)
+    {
+        if(ServoRunTimeMs == g_ServoRunTimeMs)
+        {
+            return RET_OK;
+        }
 
-#ifdef ROC_ROBOT_SERVO_DEBUG
-    ROC_LOGI("RefreshTimes is %d, g_PwmPreseVal is %d, g_PwmExpetVal is %d, g_PwmIncreVal is %d \r\n",
-                            RefreshTimes, g_PwmPreseVal[0], g_PwmExpetVal[0], g_PwmIncreVal[0]);
-#endif
+        g_ServoRunTimeMs = ServoRunTimeMs;
 
-    if(ROC_SERVO_SPEED_DIV_STP <= RefreshTimes)
-    {
-        RefreshTimes = 0;
+        RocServoInterpLimitUpdate();
 
-        RocServoPwmRecod();
+        htim6.Init.Period = (uint32_t)(ServoRunTimeMs * ROC_SERVO_TIMER_ONE_SECOND_TICKS / g_ServoStepNum);
 
-        RocServoInputUpdate(pServoInputVal);
+        /* A smaller period written without the preload may be passed by the
+           counter, which then runs to the counter top before the update */
+        htim6.Instance->CR1 |= TIM_CR1_ARPE;
+        htim6.Instance->ARR = htim6.Init.Period;
 
-        RocServoPwmIncreCalculate();
+        return RET_OK;
     }
 
-    if((ROC_SERVO_SPEED_DIV_STP - 1) == RefreshTimes)
-    {
-        g_ServoTurnIsFinshed = ROC_TRUE;
-    }
-    else
+    g_ServoRunTimeMs = ServoRunTimeMs;
+
+    RocServoInterpLimitUpdate();
+
+    htim6.Init.Period = (uint32_t)(ServoRunTimeMs * ROC_SERVO_TIMER_ONE_SECOND_TICKS / g_ServoStepNum);
+
+    /* The period is loaded at once without the preload, then the preload is
+       kept for the changes while running */
+    htim6.Instance->CR1 &= ~TIM_CR1_ARPE;
+
+    htim6.Instance->CNT = 0;
+    htim6.Instance->ARR = htim6.Init.Period;
+
+    htim6.Instance->CR1 |= TIM_CR1_ARPE;
+
+    Ret = RocServoTimerStart();
+    if(RET_OK != Ret)
     {
-        g_ServoTurnIsFinshed = ROC_FALSE;
+        ROC_LOGE("Servo start is in error!");
     }
 
-    RocServoPwmOutput();
+    return Ret;
 }
 
 /*********************************************************************************
  *  Description:
- *              Set the speed of servo running
+ *              Set the interpolation steps of one gait tick, the servo timer
+ *              period follows the steps at the next RocServoSpeedSet, so the
+ *              gait speed is not changed. The robot schedule counts the steps
+ *              of the servo timer ticks since its init, so the steps are only
+ *              changed with the servo timer stopped, and the schedule is
+ *              init again before the timer starts.
  *
  *  Parameter:
- *              ServoRunTimeMs: the servo run time
+ *              StepNum: the interpolation steps, from 1 to ROC_SERVO_MAX_STEP_NUM
  *
  *  Return:
- *              None
+ *              RET_ERROR if the steps are out of range or the servo timer runs
  *
  *  Author:
- *              ROC LiRen(2018.12.15)
+ *              ROC LiRen(2026.10.17)
 **********************************************************************************/
-void RocServoSpeedSet(uint16_t ServoRunTimeMs)
+ROC_RESULT RocServoStepNumSet(uint8_t StepNum)
 {
-    ROC_RESULT Ret = RET_OK;
+    if((0 == StepNum) || (ROC_SERVO_MAX_STEP_NUM < StepNum))
+    {
+        ROC_LOGE("Servo step number(%d) is out of range!", StepNum);
 
-    Ret = RocServoTimerStop();
-    if(RET_OK != Ret)
+        return RET_ERROR;
+    }
+
+    if(htim6.Instance->CR1 & TIM_CR1_CEN)
     {
-        ROC_LOGE("Servo stop is in error!");
+        ROC_LOGE("Servo step number can not be changed while the servo timer runs!");
 
-        while(1);
+        return RET_ERROR;
     }
 
-    htim6.Init.Period = (uint32_t)(ServoRunTimeMs * ROC_SERVO_TIMER_ONE_SECOND_TICKS / ROC_SERVO_SPEED_DIV_STP);
+    g_ServoStepNum = StepNum;
 
-    htim6.Instance->CNT = 0;
-    htim6.Instance->ARR = htim6.Init.Period;
+    RocServoInterpLimitUpdate();
 
-    htim6.Instance->CR1 &= ~TIM_CR1_ARPE;
+    return RET_OK;
+}
 
-    Ret = RocServoTimerStart();
-    if(RET_OK != Ret)
+/*********************************************************************************
+ *  Description:
+ *              Get the interpolation steps of one gait tick
+ *
+ *  Parameter:
+ *              None
+ *
+ *  Return:
+ *              The interpolation steps
+ *
+ *  Author:
+ *              ROC LiRen(2026.10.17)
+**********************************************************************************/
+uint8_t RocServoStepNumGet(void)
+{
+    return g_ServoStepNum;
+}
+
+/*********************************************************************************
+ *  Description:
+ *              Select the interpolation profile of all the servos
+ *
+ *  Parameter:
+ *              Profile: the interpolation profile
+ *
+ *  Return:
+ *              RET_ERROR if the profile is invalid
+ *
+ *  Author:
+ *              ROC LiRen(2026.10.17)
+**********************************************************************************/
+ROC_RESULT RocServoInterpProfileSet(ROC_SERVO_INTERP_PROFILE_e Profile)
+{
+    if(ROC_SERVO_INTERP_PROFILE_NUM <= Profile)
     {
-        ROC_LOGE("Servo start is in error!");
+        ROC_LOGE("Servo interpolation profile(%d) is invalid!", Profile);
 
-        while(1);
+        return RET_ERROR;
     }
 
-    if(RET_OK != Ret)
+    g_ServoInterpProfile = Profile;
+
+    return RET_OK;
+}
+
+/*********************************************************************************
+ *  Description:
+ *              Set the speed and acceleration limits of the servo
+ *
+ *  Parameter:
+ *              Channel:  the servo channel
+ *              VelLimit: the max speed in PWM per second, 0 is no limit
+ *              AccLimit: the max acceleration in PWM per second^2, 0 is no limit
+ *
+ *  Return:
+ *              RET_ERROR if the channel is invalid
+ *
+ *  Author:
+ *              ROC LiRen(2026.10.17)
+**********************************************************************************/
+ROC_RESULT RocServoInterpLimitSet(uint8_t Channel, uint16_t VelLimit, uint16_t AccLimit)
+{
+    if(ROC_SERVO_MAX_SUPPORT_NUM <= Channel)
     {
-        ROC_LOGE("Servo speed setting is in error!");
+        ROC_LOGE("Servo channel(%d) is invalid!", Channel);
+
+        return RET_ERROR;
     }
+
+    g_ServoInterp[Channel].VelLimit = VelLimit;
+    g_ServoInterp[Channel].AccLimit = AccLimit;
+
+    RocServoInterpLimitUpdate();
+
+    return RET_OK;
 }
 
 /*********************************************************************************
@@ -10,7 +10,9 @@
 
 #include <stdint.h>
 
+#ifndef ROC_ROBOT_HOST_BUILD
 #include "tim.h"
+#endif
 
 #include "RocError.h"
 
@@ -20,15 +22,23 @@
 #define ROC_SERVO_TIMER_ONE_SECOND_TICKS    (ROC_TIMER_PRESCALER_TIM6 / 1000)
 
 
-#define ROC_SERVO_SPEED_DIV_STP             4
+#define ROC_SERVO_SPEED_DIV_STP             4   /* The default interpolation steps of one gait tick */
 #define ROC_SERVO_SPEED_DOWN_MAG            1.2
 
+#define ROC_SERVO_MAX_STEP_NUM              32U
+
+
+#define ROC_SERVO_Q16_SHIFT                 16
+#define ROC_SERVO_Q16_ONE                   (1L << ROC_SERVO_Q16_SHIFT)
+
 
 #define ROC_SERVO_PWM_CYCLE                 20  /* ms */
 
 
 #define ROC_SERVO_MAX_SUPPORT_NUM           18U
 
+#define ROC_SERVO_PWM_OUT_MAX_ERROR_NUM     3U  /* The continuous PCA9685 frame errors latching the PWM fault */
+
 #define ROC_SERVO_MAX_PWM_VAL               502
 #define ROC_SERVO_MIN_PWM_VAL               102
 #define ROC_SERVO_CENTER_VAL                256
@@ -36,14 +46,28 @@
 #define ROC_SERVO_MAX_ROTATE_ANGLE          180
 
 
+typedef enum _ROC_SERVO_INTERP_PROFILE_e
+{
+    ROC_SERVO_INTERP_PROFILE_LINEAR = 0,        // Constant speed, keeps the speed of the continuous gait
+    ROC_SERVO_INTERP_PROFILE_CUBIC,             // 3s^2 - 2s^3, zero speed at both ends
+    ROC_SERVO_INTERP_PROFILE_MIN_JERK,          // 10s^3 - 15s^4 + 6s^5, zero speed and acceleration at both ends
+
+    ROC_SERVO_INTERP_PROFILE_NUM,
+}ROC_SERVO_INTERP_PROFILE_e;
+
+
 void RocServoOutputEnable(void);
 void RocServoOutputDisable(void);
 ROC_RESULT RocServoTimerStop(void);
 ROC_RESULT RocServoTimerStart(void);
-ROC_RESULT RocServoTurnIsFinshed(void);
 ROC_RESULT RocServoInit(int16_t *pServoInputVal);
-void RocServoSpeedSet(uint16_t ServoRunTimeMs);
-void RocServoControl(int16_t *pServoInputVal);
+ROC_RESULT RocServoSpeedSet(uint16_t ServoRunTimeMs);
+ROC_RESULT RocServoStepNumSet(uint8_t StepNum);
+uint8_t RocServoStepNumGet(void);
+ROC_RESULT RocServoInterpProfileSet(ROC_SERVO_INTERP_PROFILE_e Profile);
+ROC_RESULT RocServoInterpLimitSet(uint8_t Channel, uint16_t VelLimit, uint16_t AccLimit);
+void RocServoControl(int16_t *pServoInputVal, uint8_t Step);
+uint8_t RocServoPwmFaultGet(void);
 
 
 #endif
@@ -74,9 +74,15 @@ void MX_DMA_Init(void)
     /* DMA1_Stream1_IRQn interrupt configuration */
     HAL_NVIC_SetPriority(DMA1_Stream1_IRQn, 5, 0);
     HAL_NVIC_EnableIRQ(DMA1_Stream1_IRQn);
+    /* DMA1_Stream2_IRQn interrupt configuration */
+    HAL_NVIC_SetPriority(DMA1_Stream2_IRQn, 7, 0);
+    HAL_NVIC_EnableIRQ(DMA1_Stream2_IRQn);
     /* DMA1_Stream3_IRQn interrupt configuration */
     HAL_NVIC_SetPriority(DMA1_Stream3_IRQn, 6, 0);
     HAL_NVIC_EnableIRQ(DMA1_Stream3_IRQn);
+    /* DMA1_Stream7_IRQn interrupt configuration */
+    HAL_NVIC_SetPriority(DMA1_Stream7_IRQn, 2, 0);
+    HAL_NVIC_EnableIRQ(DMA1_Stream7_IRQn);
     /* DMA2_Stream3_IRQn interrupt configuration */
     HAL_NVIC_SetPriority(DMA2_Stream3_IRQn, 10, 0);
     HAL_NVIC_EnableIRQ(DMA2_Stream3_IRQn);
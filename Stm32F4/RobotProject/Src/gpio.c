@@ -159,6 +159,16 @@ void MX_GPIO_Init(void)
     GPIO_InitStruct.Speed = GPIO_SPEED_FREQ_LOW;
     HAL_GPIO_Init(ROC_ROBOT_RELAY_PORT, &GPIO_InitStruct);
 
+    /*Configure GPIO pin : MPU6050 INT Pin, the pulse is active low */
+    GPIO_InitStruct.Pin = ROC_MPU6050_INT_PIN;
+    GPIO_InitStruct.Mode = GPIO_MODE_IT_FALLING;
+    GPIO_InitStruct.Pull = GPIO_PULLUP;
+    HAL_GPIO_Init(ROC_MPU6050_INT_PORT, &GPIO_InitStruct);
+
+    /* EXTI interrupt init */
+    HAL_NVIC_SetPriority(ROC_MPU6050_INT_IRQN, 7, 0);
+    HAL_NVIC_EnableIRQ(ROC_MPU6050_INT_IRQN);
+
 }
 
 /* USER CODE BEGIN 2 */
@@ -43,11 +43,14 @@
 #include "gpio.h"
 
 /* USER CODE BEGIN 0 */
-
+#include "RocPca9685.h"
+#include "RocMpu6050.h"
 /* USER CODE END 0 */
 
 I2C_HandleTypeDef hi2c1;
 I2C_HandleTypeDef hi2c2;
+DMA_HandleTypeDef hdma_i2c1_tx;
+DMA_HandleTypeDef hdma_i2c2_rx;
 
 /* I2C1 init function */
 void MX_I2C1_Init(void)
@@ -123,6 +126,31 @@ void HAL_I2C_MspInit(I2C_HandleTypeDef *i2cHandle)
 
         /* I2C1 clock enable */
 
+        /* I2C1 DMA Init */
+        /* I2C1_TX Init */
+        hdma_i2c1_tx.Instance = DMA1_Stream7;
+        hdma_i2c1_tx.Init.Channel = DMA_CHANNEL_1;
+        hdma_i2c1_tx.Init.Direction = DMA_MEMORY_TO_PERIPH;
+        hdma_i2c1_tx.Init.PeriphInc = DMA_PINC_DISABLE;
+        hdma_i2c1_tx.Init.MemInc = DMA_MINC_ENABLE;
+        hdma_i2c1_tx.Init.PeriphDataAlignment = DMA_PDATAALIGN_BYTE;
+        hdma_i2c1_tx.Init.MemDataAlignment = DMA_MDATAALIGN_BYTE;
+        hdma_i2c1_tx.Init.Mode = DMA_NORMAL;
+        hdma_i2c1_tx.Init.Priority = DMA_PRIORITY_HIGH;
+        hdma_i2c1_tx.Init.FIFOMode = DMA_FIFOMODE_DISABLE;
+        if (HAL_DMA_Init(&hdma_i2c1_tx) != HAL_OK)
+        {
+          _Error_Handler(__FILE__, __LINE__);
+        }
+
+        __HAL_LINKDMA(i2cHandle,hdmatx,hdma_i2c1_tx);
+
+        /* I2C1 interrupt Init */
+        HAL_NVIC_SetPriority(I2C1_EV_IRQn, 2, 0);
+        HAL_NVIC_EnableIRQ(I2C1_EV_IRQn);
+        HAL_NVIC_SetPriority(I2C1_ER_IRQn, 2, 0);
+        HAL_NVIC_EnableIRQ(I2C1_ER_IRQn);
+
         /* USER CODE BEGIN I2C1_MspInit 1 */
         //__HAL_RCC_I2C1_FORCE_RESET();
         //__HAL_RCC_I2C1_RELEASE_RESET();
@@ -159,6 +187,31 @@ void HAL_I2C_MspInit(I2C_HandleTypeDef *i2cHandle)
 
         /* I2C2 clock enable */
 
+        /* I2C2 DMA Init */
+        /* I2C2_RX Init */
+        hdma_i2c2_rx.Instance = DMA1_Stream2;
+        hdma_i2c2_rx.Init.Channel = DMA_CHANNEL_7;
+        hdma_i2c2_rx.Init.Direction = DMA_PERIPH_TO_MEMORY;
+        hdma_i2c2_rx.Init.PeriphInc = DMA_PINC_DISABLE;
+        hdma_i2c2_rx.Init.MemInc = DMA_MINC_ENABLE;
+        hdma_i2c2_rx.Init.PeriphDataAlignment = DMA_PDATAALIGN_BYTE;
+        hdma_i2c2_rx.Init.MemDataAlignment = DMA_MDATAALIGN_BYTE;
+        hdma_i2c2_rx.Init.Mode = DMA_NORMAL;
+        hdma_i2c2_rx.Init.Priority = DMA_PRIORITY_MEDIUM;
+        hdma_i2c2_rx.Init.FIFOMode = DMA_FIFOMODE_DISABLE;
+        if (HAL_DMA_Init(&hdma_i2c2_rx) != HAL_OK)
+        {
+          _Error_Handler(__FILE__, __LINE__);
+        }
+
+        __HAL_LINKDMA(i2cHandle,hdmarx,hdma_i2c2_rx);
+
+        /* I2C2 interrupt Init */
+        HAL_NVIC_SetPriority(I2C2_EV_IRQn, 7, 0);
+        HAL_NVIC_EnableIRQ(I2C2_EV_IRQn);
+        HAL_NVIC_SetPriority(I2C2_ER_IRQn, 7, 0);
+        HAL_NVIC_EnableIRQ(I2C2_ER_IRQn);
+
         /* USER CODE BEGIN I2C2_MspInit 1 */
 
         /* USER CODE END I2C2_MspInit 1 */
@@ -182,6 +235,13 @@ void HAL_I2C_MspDeInit(I2C_HandleTypeDef *i2cHandle)
         */
         HAL_GPIO_DeInit(GPIOB, GPIO_PIN_6 | GPIO_PIN_7);
 
+        /* I2C1 DMA DeInit */
+        HAL_DMA_DeInit(i2cHandle->hdmatx);
+
+        /* I2C1 interrupt Deinit */
+        HAL_NVIC_DisableIRQ(I2C1_EV_IRQn);
+        HAL_NVIC_DisableIRQ(I2C1_ER_IRQn);
+
         /* USER CODE BEGIN I2C1_MspDeInit 1 */
 
         /* USER CODE END I2C1_MspDeInit 1 */
@@ -200,6 +260,13 @@ void HAL_I2C_MspDeInit(I2C_HandleTypeDef *i2cHandle)
         */
         HAL_GPIO_DeInit(GPIOB, GPIO_PIN_10 | GPIO_PIN_11);
 
+        /* I2C2 DMA DeInit */
+        HAL_DMA_DeInit(i2cHandle->hdmarx);
+
+        /* I2C2 interrupt Deinit */
+        HAL_NVIC_DisableIRQ(I2C2_EV_IRQn);
+        HAL_NVIC_DisableIRQ(I2C2_ER_IRQn);
+
         /* USER CODE BEGIN I2C2_MspDeInit 1 */
 
         /* USER CODE END I2C2_MspDeInit 1 */
@@ -208,6 +275,77 @@ void HAL_I2C_MspDeInit(I2C_HandleTypeDef *i2cHandle)
 
 /* USER CODE BEGIN 1 */
 
+/*********************************************************************************
+ *  Description:
+ *              The IIC memory write DMA is finished, the IIC1 writes the
+ *              PCA9685 frames
+ *
+ *  Parameter:
+ *              hi2c: the pointer to the IIC handle
+ *
+ *  Return:
+ *              None
+ *
+ *  Author:
+ *              ROC LiRen(2026.10.17)
+**********************************************************************************/
+void HAL_I2C_MemTxCpltCallback(I2C_HandleTypeDef *hi2c)
+{
+    if(I2C1 == hi2c->Instance)
+    {
+        RocPca9685FrameSendCplt();
+    }
+}
+
+/*********************************************************************************
+ *  Description:
+ *              The IIC memory read DMA is finished, the IIC2 reads the MPU6050
+ *              packet stream
+ *
+ *  Parameter:
+ *              hi2c: the pointer to the IIC handle
+ *
+ *  Return:
+ *              None
+ *
+ *  Author:
+ *              ROC LiRen(2026.10.17)
+**********************************************************************************/
+void HAL_I2C_MemRxCpltCallback(I2C_HandleTypeDef *hi2c)
+{
+    if(I2C2 == hi2c->Instance)
+    {
+        RocMpu6050StreamReadCplt();
+    }
+}
+
+/*********************************************************************************
+ *  Description:
+ *              The IIC transfer is in error, the error of the IIC1 stops the
+ *              PCA9685 frame queue, the error of the IIC2 resyncs the MPU6050
+ *              packet stream
+ *
+ *  Parameter:
+ *              hi2c: the pointer to the IIC handle
+ *
+ *  Return:
+ *              None
+ *
+ *  Author:
+ *              ROC LiRen(2026.10.17)
+**********************************************************************************/
+void HAL_I2C_ErrorCallback(I2C_HandleTypeDef *hi2c)
+{
+    if(I2C1 == hi2c->Instance)
+    {
+        RocPca9685FrameError(hi2c->ErrorCode);
+    }
+    else if(I2C2 == hi2c->Instance)
+    {
+        RocMpu6050StreamErrorHandle(hi2c->ErrorCode);
+    }
+}
+
 /* USER CODE END 1 */
 
 /**